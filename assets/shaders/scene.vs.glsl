@@ -0,0 +1,18 @@
+layout (location = 0) in vec3 aPos;
+
+// World matrices of Scene::Render, an Affine3x4 (three texels) per entity index
+uniform samplerBuffer uStorage0;
+uniform int uBaseInstance;
+uniform mat4 uView;
+uniform mat4 uProj;
+
+void main() {
+  int row = (gl_InstanceID + uBaseInstance) * 3;
+  vec4 p = vec4(aPos, 1.0);
+  vec3 world = vec3(
+    dot(texelFetch(uStorage0, row), p),
+    dot(texelFetch(uStorage0, row + 1), p),
+    dot(texelFetch(uStorage0, row + 2), p)
+  );
+  gl_Position = uProj * uView * vec4(world, 1.0);
+}
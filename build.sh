@@ -51,6 +51,7 @@ while [[ $# -gt 0 ]]; do
       "--release") build_type=Release; shift ;;
       "--rebuild") rebuild=1; shift ;;
       "--test") test=1; shift;;
+      "--bench") bench=1; shift;;
       "--force" | "-f") force=1; shift ;;
       "--args")
         record_args=1
@@ -113,6 +114,8 @@ if [[ $is_win -eq 1 ]]; then exe=.exe; else exe= ; fi
 
 if [[ $test -eq 1 ]]; then
   exec="$build_dir/tests/SonoTest$exe ${program_args[@]}"
+elif [[ $bench -eq 1 ]]; then
+  exec="$build_dir/sono-bench/SonoBench$exe ${program_args[@]}"
 else
   exec="$build_dir/sono-editor/SonoEditor$exe ${program_args[@]}"
 fi
@@ -0,0 +1,24 @@
+# Run at build time by the SonoBenchCommit target, writes OUTPUT with the current short commit.
+# The header is only rewritten when the commit changes so main.cpp is not rebuilt every time.
+set(SN_BENCH_GIT_COMMIT "unknown")
+if (GIT_EXECUTABLE)
+  execute_process(
+    COMMAND ${GIT_EXECUTABLE} rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE GIT_COMMIT
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    RESULT_VARIABLE GIT_RESULT
+    ERROR_QUIET
+  )
+  if (GIT_RESULT EQUAL 0 AND GIT_COMMIT)
+    set(SN_BENCH_GIT_COMMIT ${GIT_COMMIT})
+  endif()
+endif()
+
+set(CONTENT "#define SN_BENCH_GIT_COMMIT \"${SN_BENCH_GIT_COMMIT}\"\n")
+if (EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} PREVIOUS)
+endif()
+if (NOT "${PREVIOUS}" STREQUAL "${CONTENT}")
+  file(WRITE ${OUTPUT} "${CONTENT}")
+endif()
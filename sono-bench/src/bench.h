@@ -0,0 +1,167 @@
+#ifndef SN_BENCH_H
+#define SN_BENCH_H
+
+#include <core/common/defines.h>
+#include <core/common/types.h>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// @brief Passed to every benchmark; the body runs `iterations` times inside the timed region.
+struct BenchState {
+  u64 iterations;
+  u64 itemsPerIteration = 1; // Set by the benchmark to report per-item timings
+  b8 skipped = false;         // Set when the benchmark cannot run on this machine
+};
+
+using BenchFn = void (*)(BenchState &);
+
+struct BenchCase {
+  const char *name;
+  BenchFn fn;
+};
+
+struct BenchResult {
+  std::string name;
+  u64 iterations;
+  f64 nsPerIteration;
+  f64 nsPerItem;
+  b8 skipped;
+};
+
+/// @brief One step of a thread sweep against its single thread run, see ComputeScaling
+struct ScalingResult {
+  std::string name;
+  u32 threads;
+  f64 speedup;
+  f64 efficiency;
+};
+
+class BenchRegistry {
+public:
+  static std::vector<BenchCase> &Get() {
+    static std::vector<BenchCase> s_Cases;
+    return s_Cases;
+  }
+
+  struct Registrar {
+    Registrar(const char *name, BenchFn fn) { Get().push_back({name, fn}); }
+  };
+};
+
+/// @brief Distance between two floats in units in the last place, 0 for bitwise equal values
+/// and for +0 / -0. NaN against anything is the maximum distance.
+inline u32 UlpDistance(f32 a, f32 b) {
+  if (a == b) return 0;
+  if (std::isnan(a) || std::isnan(b)) return UINT32_MAX;
+  // Map the sign magnitude bit patterns onto a monotonic integer line
+  auto ordered = [](f32 f) -> i64 {
+    const i32 bits = std::bit_cast<i32>(f);
+    return bits < 0 ? (i64)INT32_MIN - bits : (i64)bits;
+  };
+  const i64 d = ordered(a) - ordered(b);
+  return (u32)std::min<i64>(d < 0 ? -d : d, UINT32_MAX);
+}
+
+/// @brief Passed to every parity check; Compare the Sono and glm results component by component.
+/// A component passes when it is within ulpTolerance ULPs or absTolerance of the glm value, the
+/// absolute floor keeps results that should be exactly zero from failing on rounding noise.
+struct ParityState {
+  u32 ulpTolerance;
+  f32 absTolerance = 1e-6f;
+
+  u64 components = 0;
+  u64 bitwiseEqual = 0;
+  u64 failures = 0;
+  u32 maxUlp = 0;
+  f64 maxAbsError = 0.0;
+
+  void Compare(const f32 *sono, const f32 *glm, usize count) {
+    for (usize i = 0; i < count; i++) {
+      const u32 ulp = UlpDistance(sono[i], glm[i]);
+      const f64 absError = std::fabs((f64)sono[i] - (f64)glm[i]);
+      components++;
+      bitwiseEqual += std::memcmp(&sono[i], &glm[i], sizeof(f32)) == 0;
+      maxUlp = std::max(maxUlp, ulp);
+      maxAbsError = std::max(maxAbsError, absError);
+      if (ulp > ulpTolerance && absError > absTolerance) failures++;
+    }
+  }
+
+  template <typename S, typename G>
+  void Compare(const S &sono, const G &glm) {
+    static_assert(sizeof(S) == sizeof(G) && sizeof(S) % sizeof(f32) == 0);
+    Compare(
+      reinterpret_cast<const f32 *>(&sono), reinterpret_cast<const f32 *>(&glm),
+      sizeof(S) / sizeof(f32)
+    );
+  }
+};
+
+using ParityFn = void (*)(ParityState &);
+
+struct ParityCase {
+  const char *name;
+  u32 ulpTolerance;
+  ParityFn fn;
+};
+
+struct ParityResult {
+  std::string name;
+  ParityState state;
+  b8 passed;
+};
+
+class ParityRegistry {
+public:
+  static std::vector<ParityCase> &Get() {
+    static std::vector<ParityCase> s_Cases;
+    return s_Cases;
+  }
+
+  struct Registrar {
+    Registrar(const char *name, u32 ulpTolerance, ParityFn fn) {
+      Get().push_back({name, ulpTolerance, fn});
+    }
+  };
+};
+
+/// @brief Keep the compiler from discarding a computed value
+template <typename T>
+inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *s_Sink;
+  s_Sink = &value;
+#endif
+}
+
+/// @brief Prevent the compiler from caching memory across the barrier
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+#define SN_BENCHMARK_IMPL(fn, name)                                                                \
+  static void fn(BenchState &state);                                                               \
+  static BenchRegistry::Registrar ANON_VAR(s_BenchRegistrar_)(name, fn);                           \
+  static void fn(BenchState &state)
+
+/// Define and register a benchmark: SN_BENCHMARK("Group/Name") { for (...state.iterations) }
+#define SN_BENCHMARK(name) SN_BENCHMARK_IMPL(ANON_VAR(Bench_), name)
+
+#define SN_PARITY_IMPL(fn, name, ulpTolerance)                                                     \
+  static void fn(ParityState &parity);                                                             \
+  static ParityRegistry::Registrar ANON_VAR(s_ParityRegistrar_)(name, ulpTolerance, fn);           \
+  static void fn(ParityState &parity)
+
+/// Define and register a glm parity check: SN_PARITY("Group/Name", maxUlp) { parity.Compare() }
+#define SN_PARITY(name, ulpTolerance) SN_PARITY_IMPL(ANON_VAR(Parity_), name, ulpTolerance)
+
+#endif // !SN_BENCH_H
@@ -0,0 +1,359 @@
+#include "bench.h"
+#include <core/math/batch.h>
+#include <core/math/frustum.h>
+#include <core/math/math.h>
+#include <core/math/quantize.h>
+
+#include <random>
+
+constexpr usize kVectorCount = 4096;
+
+struct SoaBuffers {
+  std::vector<f32> x, y, z, ox, oy, oz, ex, ey, ez;
+
+  SoaBuffers() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<f32> dist(-10.0f, 10.0f);
+    for (std::vector<f32> *v : {&x, &y, &z}) {
+      v->resize(kVectorCount);
+      for (f32 &f : *v) f = dist(rng);
+    }
+    for (std::vector<f32> *v : {&ox, &oy, &oz, &ex, &ey, &ez}) v->resize(kVectorCount);
+  }
+
+  Sono::ConstVec3Soa In() const { return {x.data(), y.data(), z.data()}; }
+  Sono::Vec3Soa Out() { return {ox.data(), oy.data(), oz.data()}; }
+  Sono::Vec3Soa OutExtents() { return {ex.data(), ey.data(), ez.data()}; }
+};
+
+// --------------------------------------------------------------------------------
+static Mat4 BenchMatrix() {
+  Mat4 m = Mat4::Rotation(0.7f, Vec3(0.2f, 1.0f, -0.4f));
+  m.SetTranslation(1.0f, 2.0f, 3.0f);
+  return m;
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+static void RunAtLevel(BenchState &state, Sono::SimdLevel level, Fn &&fn) {
+  const Sono::SimdLevel initial = Sono::GetSimdLevel();
+  if (!Sono::SetSimdLevel(level)) {
+    state.skipped = true;
+    return;
+  }
+  SoaBuffers buffers;
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    fn(buffers);
+    ClobberMemory();
+  }
+  Sono::SetSimdLevel(initial);
+}
+
+// Per vector operator loop over an array of Vec4, what callers wrote before the batch API
+SN_BENCHMARK("Batch/TransformPoints/AoS Vec4 * Mat4") {
+  const Mat4 m = BenchMatrix();
+  std::vector<Vec4> points(kVectorCount, Vec4(1.0f, 2.0f, 3.0f, 1.0f));
+  std::vector<Vec4> out(kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) out[j] = points[j] * m;
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+// --------------------------------------------------------------------------------
+static void BenchTransformPoints(BenchState &state, Sono::SimdLevel level) {
+  const Mat4 m = BenchMatrix();
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    Sono::TransformPoints(m, b.In(), kVectorCount, b.Out());
+  });
+}
+// --------------------------------------------------------------------------------
+static void BenchNormalize(BenchState &state, Sono::SimdLevel level) {
+  RunAtLevel(state, level, [&](SoaBuffers &b) { Sono::Normalize(b.Out(), kVectorCount); });
+}
+// --------------------------------------------------------------------------------
+static void BenchTransformAABBs(BenchState &state, Sono::SimdLevel level) {
+  const Mat4 m = BenchMatrix();
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    Sono::TransformAABBs(m, b.In(), b.In(), kVectorCount, b.Out(), b.OutExtents());
+  });
+}
+
+SN_BENCHMARK("Batch/TransformPoints/scalar") {
+  BenchTransformPoints(state, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Batch/TransformPoints/sse2") { BenchTransformPoints(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/TransformPoints/avx2") { BenchTransformPoints(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/TransformPoints/avx512") {
+  BenchTransformPoints(state, Sono::SimdLevel::AVX512);
+}
+
+SN_BENCHMARK("Batch/Normalize/scalar") { BenchNormalize(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("Batch/Normalize/sse2") { BenchNormalize(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/Normalize/avx2") { BenchNormalize(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/Normalize/avx512") { BenchNormalize(state, Sono::SimdLevel::AVX512); }
+
+SN_BENCHMARK("Batch/TransformAABBs/scalar") { BenchTransformAABBs(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("Batch/TransformAABBs/sse2") { BenchTransformAABBs(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/TransformAABBs/avx2") { BenchTransformAABBs(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/TransformAABBs/avx512") { BenchTransformAABBs(state, Sono::SimdLevel::AVX512); }
+
+// --------------------------------------------------------------------------------
+static std::vector<Quaternion> MakeQuaternions() {
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<Quaternion> quats(kVectorCount);
+  for (Quaternion &q : quats) {
+    q = Quaternion(dist(rng), dist(rng), dist(rng), dist(rng));
+    q.Normalize();
+  }
+  return quats;
+}
+// --------------------------------------------------------------------------------
+static void BenchQuaternionsToMat4(BenchState &state, Sono::SimdLevel level) {
+  const std::vector<Quaternion> quats = MakeQuaternions();
+  std::vector<Mat4> out(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &) {
+    Sono::QuaternionsToMat4(quats.data(), kVectorCount, out.data());
+  });
+}
+
+SN_BENCHMARK("Batch/QuaternionsToMat4/per quaternion ToMat4") {
+  const std::vector<Quaternion> quats = MakeQuaternions();
+  std::vector<Mat4> out(kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) out[j] = quats[j].ToMat4();
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("Batch/QuaternionsToMat4/scalar") {
+  BenchQuaternionsToMat4(state, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Batch/QuaternionsToMat4/sse2") {
+  BenchQuaternionsToMat4(state, Sono::SimdLevel::SSE2);
+}
+SN_BENCHMARK("Batch/QuaternionsToMat4/avx2") {
+  BenchQuaternionsToMat4(state, Sono::SimdLevel::AVX2);
+}
+SN_BENCHMARK("Batch/QuaternionsToMat4/avx512") {
+  BenchQuaternionsToMat4(state, Sono::SimdLevel::AVX512);
+}
+
+// --------------------------------------------------------------------------------
+/// Camera looking down -z from the origin over the [-10, 10] cube, roughly half the bounds land
+/// inside so visibility is unpredictable
+static Frustum BenchFrustum() {
+  const Mat4 view = Mat4::LookAt(Vec3(0.0f, 0.0f, 12.0f), Vec3::Zero, Vec3::Up);
+  return Frustum::FromViewProjection(view * Mat4::Perspective(1.2f, 16.0f / 9.0f, 0.1f, 100.0f));
+}
+// --------------------------------------------------------------------------------
+static void BenchCullSpheres(BenchState &state, Sono::SimdLevel level) {
+  const Frustum frustum = BenchFrustum();
+  std::vector<f32> radii(kVectorCount, 0.5f);
+  std::vector<u32> visible(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    DoNotOptimize(Sono::CullSpheres(frustum, b.In(), radii.data(), kVectorCount, visible.data()));
+  });
+}
+// --------------------------------------------------------------------------------
+static void BenchCullAABBs(BenchState &state, Sono::SimdLevel level) {
+  const Frustum frustum = BenchFrustum();
+  const std::vector<f32> half(kVectorCount, 0.5f);
+  const Sono::ConstVec3Soa extents(half.data(), half.data(), half.data());
+  std::vector<u32> visible(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    DoNotOptimize(Sono::CullAABBs(frustum, b.In(), extents, kVectorCount, visible.data()));
+  });
+}
+
+// What a renderer loop does without the batch API: one branchy test per object
+SN_BENCHMARK("Batch/CullSpheres/per sphere Intersects") {
+  const Frustum frustum = BenchFrustum();
+  SoaBuffers b;
+  std::vector<u32> visible;
+  visible.reserve(kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    visible.clear();
+    for (usize j = 0; j < kVectorCount; j++) {
+      if (frustum.Intersects(BoundingSphere(Vec3(b.x[j], b.y[j], b.z[j]), 0.5f))) {
+        visible.push_back((u32)j);
+      }
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(visible.data());
+}
+
+SN_BENCHMARK("Batch/CullSpheres/scalar") { BenchCullSpheres(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("Batch/CullSpheres/sse2") { BenchCullSpheres(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/CullSpheres/avx2") { BenchCullSpheres(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/CullSpheres/avx512") { BenchCullSpheres(state, Sono::SimdLevel::AVX512); }
+
+SN_BENCHMARK("Batch/CullAABBs/scalar") { BenchCullAABBs(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("Batch/CullAABBs/sse2") { BenchCullAABBs(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/CullAABBs/avx2") { BenchCullAABBs(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/CullAABBs/avx512") { BenchCullAABBs(state, Sono::SimdLevel::AVX512); }
+
+// --------------------------------------------------------------------------------
+static void BenchPackQuaternions(BenchState &state, Sono::SimdLevel level) {
+  const std::vector<Quaternion> quats = MakeQuaternions();
+  std::vector<u32> packed(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &) {
+    Sono::PackQuaternions(quats.data(), kVectorCount, 10, packed.data());
+  });
+}
+// --------------------------------------------------------------------------------
+static void BenchUnpackQuaternions(BenchState &state, Sono::SimdLevel level) {
+  const std::vector<Quaternion> quats = MakeQuaternions();
+  std::vector<u32> packed(kVectorCount);
+  for (usize j = 0; j < kVectorCount; j++) packed[j] = (u32)Sono::PackQuaternion(quats[j], 10);
+  std::vector<Quaternion> out(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &) {
+    Sono::UnpackQuaternions(packed.data(), kVectorCount, 10, out.data());
+  });
+}
+// --------------------------------------------------------------------------------
+static void BenchFloatsToHalves(BenchState &state, Sono::SimdLevel level) {
+  std::vector<u16> halves(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    Sono::FloatsToHalves(b.x.data(), kVectorCount, halves.data());
+  });
+}
+
+SN_BENCHMARK("Batch/PackQuaternions/per quaternion PackQuaternion") {
+  const std::vector<Quaternion> quats = MakeQuaternions();
+  std::vector<u32> packed(kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) packed[j] = (u32)Sono::PackQuaternion(quats[j], 10);
+    ClobberMemory();
+  }
+  DoNotOptimize(packed.data());
+}
+
+SN_BENCHMARK("Batch/PackQuaternions/scalar") {
+  BenchPackQuaternions(state, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Batch/PackQuaternions/sse2") { BenchPackQuaternions(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/PackQuaternions/avx2") { BenchPackQuaternions(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/PackQuaternions/avx512") {
+  BenchPackQuaternions(state, Sono::SimdLevel::AVX512);
+}
+
+SN_BENCHMARK("Batch/UnpackQuaternions/scalar") {
+  BenchUnpackQuaternions(state, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Batch/UnpackQuaternions/sse2") {
+  BenchUnpackQuaternions(state, Sono::SimdLevel::SSE2);
+}
+SN_BENCHMARK("Batch/UnpackQuaternions/avx2") {
+  BenchUnpackQuaternions(state, Sono::SimdLevel::AVX2);
+}
+SN_BENCHMARK("Batch/UnpackQuaternions/avx512") {
+  BenchUnpackQuaternions(state, Sono::SimdLevel::AVX512);
+}
+
+SN_BENCHMARK("Batch/FloatsToHalves/per float FloatToHalf") {
+  SoaBuffers b;
+  std::vector<u16> halves(kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) halves[j] = Sono::FloatToHalf(b.x[j]);
+    ClobberMemory();
+  }
+  DoNotOptimize(halves.data());
+}
+
+SN_BENCHMARK("Batch/FloatsToHalves/scalar") { BenchFloatsToHalves(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("Batch/FloatsToHalves/sse2") { BenchFloatsToHalves(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/FloatsToHalves/avx2") { BenchFloatsToHalves(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/FloatsToHalves/avx512") { BenchFloatsToHalves(state, Sono::SimdLevel::AVX512); }
+
+// --------------------------------------------------------------------------------
+static void BenchEvaluateEase(BenchState &state, Sono::SimdLevel level) {
+  std::vector<f32> t(kVectorCount), eased(kVectorCount);
+  for (usize i = 0; i < kVectorCount; i++) t[i] = (f32)i / (f32)kVectorCount;
+  RunAtLevel(state, level, [&](SoaBuffers &) {
+    Sono::EvaluateEase(Ease::OUT_ELASTIC, t.data(), kVectorCount, eased.data());
+  });
+}
+
+SN_BENCHMARK("Batch/EvaluateEase/per value EaseOutElastic") {
+  std::vector<f32> t(kVectorCount), eased(kVectorCount);
+  for (usize i = 0; i < kVectorCount; i++) t[i] = (f32)i / (f32)kVectorCount;
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) eased[j] = Sono::EaseOutElastic(t[j]);
+    ClobberMemory();
+  }
+  DoNotOptimize(eased.data());
+}
+
+SN_BENCHMARK("Batch/EvaluateEase/scalar") { BenchEvaluateEase(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("Batch/EvaluateEase/sse2") { BenchEvaluateEase(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/EvaluateEase/avx2") { BenchEvaluateEase(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/EvaluateEase/avx512") { BenchEvaluateEase(state, Sono::SimdLevel::AVX512); }
+
+// --------------------------------------------------------------------------------
+static void BenchEncodeOctahedral(BenchState &state, Sono::SimdLevel level) {
+  std::vector<i16> ox(kVectorCount), oy(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    Sono::EncodeOctahedral(b.In(), kVectorCount, ox.data(), oy.data());
+  });
+}
+
+SN_BENCHMARK("Batch/EncodeOctahedral/per vector EncodeOctahedral") {
+  SoaBuffers b;
+  std::vector<i16> codes(2 * kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) {
+      Sono::EncodeOctahedral(Vec3(b.x[j], b.y[j], b.z[j]), &codes[2 * j]);
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(codes.data());
+}
+
+SN_BENCHMARK("Batch/EncodeOctahedral/scalar") {
+  BenchEncodeOctahedral(state, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Batch/EncodeOctahedral/sse2") { BenchEncodeOctahedral(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/EncodeOctahedral/avx2") { BenchEncodeOctahedral(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/EncodeOctahedral/avx512") {
+  BenchEncodeOctahedral(state, Sono::SimdLevel::AVX512);
+}
+
+// --------------------------------------------------------------------------------
+static void BenchFloatsToSnorm16(BenchState &state, Sono::SimdLevel level) {
+  std::vector<i16> codes(kVectorCount);
+  RunAtLevel(state, level, [&](SoaBuffers &b) {
+    Sono::FloatsToSnorm16(b.x.data(), kVectorCount, codes.data());
+  });
+}
+
+SN_BENCHMARK("Batch/FloatsToSnorm16/per float FloatToSnorm16") {
+  SoaBuffers b;
+  std::vector<i16> codes(kVectorCount);
+  state.itemsPerIteration = kVectorCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVectorCount; j++) codes[j] = Sono::FloatToSnorm16(b.x[j]);
+    ClobberMemory();
+  }
+  DoNotOptimize(codes.data());
+}
+
+SN_BENCHMARK("Batch/FloatsToSnorm16/scalar") {
+  BenchFloatsToSnorm16(state, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Batch/FloatsToSnorm16/sse2") { BenchFloatsToSnorm16(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("Batch/FloatsToSnorm16/avx2") { BenchFloatsToSnorm16(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("Batch/FloatsToSnorm16/avx512") {
+  BenchFloatsToSnorm16(state, Sono::SimdLevel::AVX512);
+}
@@ -0,0 +1,200 @@
+#include "bench.h"
+#include <core/math/batch.h>
+#include <core/math/bvh.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+struct BvhFixture {
+  std::vector<AABB> boxes;
+  std::vector<u32> items;
+  std::vector<i32> leaves;
+  Bvh bvh;
+  // SoA copies for the batch culling baseline
+  std::vector<f32> cx, cy, cz, ex, ey, ez;
+};
+
+// --------------------------------------------------------------------------------
+/// count boxes of 0.1 to 2 units scattered through a 1000 unit cube, as objects of an open world
+/// level would be. Built once per size and reused across runs.
+static BvhFixture &BenchBoxes(usize count) {
+  static std::vector<std::pair<usize, std::unique_ptr<BvhFixture>>> s_Fixtures;
+  for (auto &[size, fixture] : s_Fixtures) {
+    if (size == count) return *fixture;
+  }
+
+  auto fixture = std::make_unique<BvhFixture>();
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<f32> pos(-500.0f, 500.0f);
+  std::uniform_real_distribution<f32> size(0.05f, 1.0f);
+  for (usize i = 0; i < count; i++) {
+    const Vec3 c(pos(rng), pos(rng), pos(rng)), e(size(rng), size(rng), size(rng));
+    fixture->boxes.push_back(AABB::FromCenterExtents(c, e));
+    fixture->items.push_back((u32)i);
+    fixture->cx.push_back(c.x);
+    fixture->cy.push_back(c.y);
+    fixture->cz.push_back(c.z);
+    fixture->ex.push_back(e.x);
+    fixture->ey.push_back(e.y);
+    fixture->ez.push_back(e.z);
+  }
+  fixture->leaves.resize(count);
+  fixture->bvh.Build(fixture->items.data(), fixture->boxes.data(), count, fixture->leaves.data());
+  s_Fixtures.emplace_back(count, std::move(fixture));
+  return *s_Fixtures.back().second;
+}
+// --------------------------------------------------------------------------------
+/// Looking into the cube from one face, about 7% of the boxes inside
+static Frustum BenchFrustum() {
+  const Mat4 view = Mat4::LookAt(Vec3(0.0f, 0.0f, 600.0f), Vec3::Zero, Vec3::Up);
+  return Frustum::FromViewProjection(view * Mat4::Perspective(0.9f, 16.0f / 9.0f, 0.1f, 500.0f));
+}
+// --------------------------------------------------------------------------------
+/// 64 query boxes of 20 units, what a proximity or trigger check asks
+static std::vector<AABB> BenchQueryBoxes() {
+  std::mt19937 rng(6);
+  std::uniform_real_distribution<f32> pos(-500.0f, 500.0f);
+  std::vector<AABB> queries;
+  for (i32 i = 0; i < 64; i++) {
+    queries.push_back(AABB::FromCenterExtents(Vec3(pos(rng), pos(rng), pos(rng)), Vec3(10.0f)));
+  }
+  return queries;
+}
+
+// --------------------------------------------------------------------------------
+static void BenchBuild(BenchState &state, usize count) {
+  BvhFixture &fixture = BenchBoxes(count);
+  Bvh bvh;
+  state.itemsPerIteration = count;
+  for (u64 i = 0; i < state.iterations; i++) {
+    bvh.Build(fixture.items.data(), fixture.boxes.data(), count);
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Bvh/Build SAH/10k boxes") { BenchBuild(state, 10000); }
+SN_BENCHMARK("Bvh/Build SAH/100k boxes") { BenchBuild(state, 100000); }
+SN_BENCHMARK("Bvh/Build SAH/1M boxes") { BenchBuild(state, 1000000); }
+
+// --------------------------------------------------------------------------------
+/// Per iteration: move every movedEvery-th box back and forth by a unit and Refit. Items are
+/// the moved boxes.
+static void BenchRefit(BenchState &state, usize count, usize movedEvery) {
+  BvhFixture &fixture = BenchBoxes(count);
+  Bvh &bvh = fixture.bvh;
+  state.itemsPerIteration = count / movedEvery;
+  for (u64 i = 0; i < state.iterations; i++) {
+    const Vec3 d(i % 2 ? -1.0f : 1.0f, 0.0f, 0.0f);
+    for (usize k = 0; k < count; k += movedEvery) {
+      AABB &box = fixture.boxes[k];
+      box = AABB(box.min + d, box.max + d);
+      bvh.SetLeafBounds(fixture.leaves[k], box);
+    }
+    bvh.Refit();
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Bvh/Refit/100k boxes 1% moved") { BenchRefit(state, 100000, 100); }
+SN_BENCHMARK("Bvh/Refit/100k boxes 100% moved") { BenchRefit(state, 100000, 1); }
+
+// --------------------------------------------------------------------------------
+SN_BENCHMARK("Bvh/Query AABB/100k boxes 64 queries") {
+  BvhFixture &fixture = BenchBoxes(100000);
+  const std::vector<AABB> queries = BenchQueryBoxes();
+  state.itemsPerIteration = queries.size();
+  for (u64 i = 0; i < state.iterations; i++) {
+    u32 hits = 0;
+    for (const AABB &q : queries) fixture.bvh.QueryAABB(q, [&](u32) { hits++; });
+    DoNotOptimize(hits);
+  }
+}
+SN_BENCHMARK("Bvh/Query AABB/100k boxes 64 queries brute force") {
+  BvhFixture &fixture = BenchBoxes(100000);
+  const std::vector<AABB> queries = BenchQueryBoxes();
+  state.itemsPerIteration = queries.size();
+  for (u64 i = 0; i < state.iterations; i++) {
+    u32 hits = 0;
+    for (const AABB &q : queries) {
+      for (const AABB &b : fixture.boxes) {
+        hits += b.min.x <= q.max.x && b.max.x >= q.min.x && b.min.y <= q.max.y &&
+          b.max.y >= q.min.y && b.min.z <= q.max.z && b.max.z >= q.min.z;
+      }
+    }
+    DoNotOptimize(hits);
+  }
+}
+
+// --------------------------------------------------------------------------------
+/// The boxes in the frustum, by the tree or by the SIMD batch test over every box, which is
+/// what the renderer does without a hierarchy
+static void BenchQueryFrustum(BenchState &state, usize count, b8 batch) {
+  BvhFixture &f = BenchBoxes(count);
+  const Frustum frustum = BenchFrustum();
+  std::vector<u32> visible(count);
+  state.itemsPerIteration = count;
+  for (u64 i = 0; i < state.iterations; i++) {
+    if (batch) {
+      DoNotOptimize(Sono::CullAABBs(
+        frustum, {f.cx.data(), f.cy.data(), f.cz.data()}, {f.ex.data(), f.ey.data(), f.ez.data()},
+        count, visible.data()
+      ));
+      continue;
+    }
+    usize visibleCount = 0;
+    f.bvh.QueryFrustum(frustum, [&](u32 item) { visible[visibleCount++] = item; });
+    DoNotOptimize(visibleCount);
+  }
+}
+
+SN_BENCHMARK("Bvh/Query frustum/100k boxes") { BenchQueryFrustum(state, 100000, false); }
+SN_BENCHMARK("Bvh/Query frustum/100k boxes batch CullAABBs") {
+  BenchQueryFrustum(state, 100000, true);
+}
+SN_BENCHMARK("Bvh/Query frustum/1M boxes") { BenchQueryFrustum(state, 1000000, false); }
+SN_BENCHMARK("Bvh/Query frustum/1M boxes batch CullAABBs") {
+  BenchQueryFrustum(state, 1000000, true);
+}
+
+// --------------------------------------------------------------------------------
+/// 64 rays from the cube's faces through it, closest box hit of each
+static void BenchRaycast(BenchState &state, b8 bruteForce) {
+  BvhFixture &fixture = BenchBoxes(100000);
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<std::pair<Vec3, Vec3>> rays;
+  for (i32 r = 0; r < 64; r++) {
+    const Vec3 origin(dist(rng) * 500.0f, dist(rng) * 500.0f, 600.0f);
+    rays.emplace_back(origin, Vec3(dist(rng) * 0.3f, dist(rng) * 0.3f, -1.0f));
+  }
+
+  state.itemsPerIteration = rays.size();
+  for (u64 i = 0; i < state.iterations; i++) {
+    f32 sum = 0.0f;
+    for (const auto &[origin, dir] : rays) {
+      f32 best = 1e30f;
+      if (!bruteForce) {
+        auto closer = [&](u32, f32 t) { return best = std::min(best, t); };
+        fixture.bvh.Raycast(origin, dir, best, closer);
+      } else {
+        const Vec3 inv(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+        for (const AABB &b : fixture.boxes) {
+          f32 tMin = 0.0f, tMax = best;
+          for (i32 a = 0; a < 3; a++) {
+            f32 t0 = (b.min[a] - origin[a]) * inv[a], t1 = (b.max[a] - origin[a]) * inv[a];
+            if (t0 > t1) std::swap(t0, t1);
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+          }
+          if (tMin <= tMax) best = tMin;
+        }
+      }
+      sum += best;
+    }
+    DoNotOptimize(sum);
+  }
+}
+
+SN_BENCHMARK("Bvh/Raycast closest/100k boxes 64 rays") { BenchRaycast(state, false); }
+SN_BENCHMARK("Bvh/Raycast closest/100k boxes 64 rays brute force") { BenchRaycast(state, true); }
@@ -0,0 +1,138 @@
+#include "bench.h"
+#include <render/camera.h>
+#include <render/draw_list.h>
+#include <render/render_pass.h>
+#include <render/resource/material.h>
+#include <render/resource/mesh.h>
+#include <render/scene.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+/// Counts what it is asked to do, stands in for a backend pass
+class CountingPass : public RenderPass {
+public:
+  CountingPass()
+    : RenderPass(RenderPassDesc{Color3(0u)}) {}
+
+  void BindPipeline(RenderPipeline *) override { binds++; }
+  void BindVertexArray(VertexArray *) override { binds++; }
+  void BindVertexBuffer(Buffer *) override { binds++; }
+  void BindIndexBuffer(Buffer *) override { binds++; }
+  void BindTexture(Texture *, u32) override { binds++; }
+  void BindStorageBuffer(Buffer *, u32) override { binds++; }
+  void Draw(u32, u32, u32, u32) override { draws++; }
+  void DrawIndexed(u32, u32, u32, u32) override { draws++; }
+
+  u64 binds = 0, draws = 0;
+};
+
+struct DrawFixture {
+  // Only the addresses of the backend objects are used
+  u8 pipelines[8][16];
+  u8 vertexArrays[256][16];
+  u8 buffers[2 * 256][16];
+  u8 textures[64][16];
+  Mesh meshes[256];
+  Material materials[64];
+  Scene scene;
+  Camera camera;
+  DrawList list;
+};
+
+// --------------------------------------------------------------------------------
+/// count nodes in a 200 unit cube drawn with 256 meshes, 64 materials (8 of them transparent) and
+/// 8 pipelines, seen from outside the cube. Each mesh is drawn with one of two materials, as
+/// props of a level are. Built once per size and reused across runs.
+static DrawFixture &BenchDraws(usize count) {
+  static std::vector<std::pair<usize, std::unique_ptr<DrawFixture>>> s_Fixtures;
+  for (auto &[size, fixture] : s_Fixtures) {
+    if (size == count) return *fixture;
+  }
+
+  auto fixture = std::make_unique<DrawFixture>();
+  DrawFixture &f = *fixture;
+  for (u32 i = 0; i < 256; i++) {
+    f.meshes[i].pVertexArray = reinterpret_cast<VertexArray *>(f.vertexArrays[i]);
+    f.meshes[i].pVertexBuffer = reinterpret_cast<Buffer *>(f.buffers[2 * i]);
+    f.meshes[i].pIndexBuffer = reinterpret_cast<Buffer *>(f.buffers[2 * i + 1]);
+    f.meshes[i].subMeshes = {{0, 36}};
+  }
+  for (u32 i = 0; i < 64; i++) {
+    f.materials[i].pipeline = reinterpret_cast<RenderPipeline *>(f.pipelines[i % 8]);
+    f.materials[i].textures[0] = reinterpret_cast<Texture *>(f.textures[i]);
+    f.materials[i].layer = i < 56 ? RenderLayer::Opaque : RenderLayer::Transparent;
+  }
+
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<f32> pos(-100.0f, 100.0f);
+  for (usize i = 0; i < count; i++) {
+    const Entity e = f.scene.CreateEntity();
+    f.scene.GetComponent<Transform>(e).SetPosition(Vec3(pos(rng), pos(rng), pos(rng)));
+    f.scene.SetBounds(e, BoundingSphere(Vec3::Zero, 1.0f));
+    const u32 mesh = rng() % 256;
+    const Material *material = &f.materials[(mesh * 7 + rng() % 2) % 64];
+    f.scene.AddComponent<MeshRef>(e, &f.meshes[mesh], 0u, material);
+  }
+  f.scene.UpdateTransforms();
+  f.camera.SetPerspective(Sono::Radians(90.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+  f.camera.SetPosition(Vec3(0.0f, 0.0f, 250.0f));
+  f.camera.LookAt(Vec3::Zero);
+  f.scene.ExtractDraws(f.camera, f.list);
+  s_Fixtures.emplace_back(count, std::move(fixture));
+  return *s_Fixtures.back().second;
+}
+
+// --------------------------------------------------------------------------------
+/// Cull, build the packets and sort them, items are nodes
+static void BenchExtract(BenchState &state, usize count) {
+  DrawFixture &f = BenchDraws(count);
+  state.itemsPerIteration = count;
+  for (u64 i = 0; i < state.iterations; i++) {
+    f.scene.ExtractDraws(f.camera, f.list);
+    DoNotOptimize(f.list.GetSize());
+  }
+}
+
+SN_BENCHMARK("DrawList/Extract and sort/10k nodes") { BenchExtract(state, 10000); }
+SN_BENCHMARK("DrawList/Extract and sort/100k nodes") { BenchExtract(state, 100000); }
+
+// --------------------------------------------------------------------------------
+/// The extracted packets in a random order, sorted again each iteration
+static void BenchSort(BenchState &state, b8 radix) {
+  DrawFixture &f = BenchDraws(100000);
+  std::vector<DrawPacket> shuffled = f.list.GetPackets();
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(10));
+  DrawList list;
+  std::vector<DrawPacket> packets;
+  state.itemsPerIteration = shuffled.size();
+  for (u64 i = 0; i < state.iterations; i++) {
+    if (radix) {
+      list.Clear();
+      for (const DrawPacket &p : shuffled) list.Add(p.key, p.ref, p.slot);
+      list.Sort();
+      DoNotOptimize(list.GetPackets().data());
+    } else {
+      packets = shuffled;
+      std::sort(packets.begin(), packets.end(), [](const DrawPacket &a, const DrawPacket &b) {
+        return a.key < b.key;
+      });
+      DoNotOptimize(packets.data());
+    }
+  }
+}
+
+SN_BENCHMARK("DrawList/Sort radix/100k nodes") { BenchSort(state, true); }
+SN_BENCHMARK("DrawList/Sort std::sort/100k nodes") { BenchSort(state, false); }
+
+// --------------------------------------------------------------------------------
+/// Record the sorted draws into a pass that only counts, items are draws
+SN_BENCHMARK("DrawList/Record/100k nodes") {
+  DrawFixture &f = BenchDraws(100000);
+  CountingPass pass;
+  state.itemsPerIteration = f.list.GetSize();
+  for (u64 i = 0; i < state.iterations; i++) {
+    DoNotOptimize(f.scene.RecordDraws(f.list, &pass).draws);
+  }
+}
@@ -0,0 +1,81 @@
+#include "bench.h"
+#include <core/event/event_dispatcher.h>
+
+#include <functional>
+
+constexpr u32 kListenersPerType = 100;
+
+static u64 s_Sink = 0;
+
+// --------------------------------------------------------------------------------
+static Event MakeMouseMove() {
+  Event e;
+  e.time = 0;
+  e.tick = 0;
+  e.type = EventType::MOUSE_MOVE;
+  e.payload = MouseMoveEvent{1.0, 2.0};
+  return e;
+}
+// --------------------------------------------------------------------------------
+static void RegisterListeners() {
+  EventDispatcher::Clear();
+  for (u32 i = 0; i < kListenersPerType; i++) {
+    EventDispatcher::Register<MouseMoveEvent>([i](const MouseMoveEvent &e) {
+      s_Sink += i + (u64)e.xpos;
+    });
+    EventDispatcher::Register<KeyEvent>([i](const KeyEvent &e) { s_Sink += i + e.key; });
+    EventDispatcher::Register<MouseButtonEvent>([i](const MouseButtonEvent &e) {
+      s_Sink += i + e.button;
+    });
+  }
+}
+
+// Previous design: every listener is a std::function visited for every event and filters
+// the payload itself with std::get_if.
+SN_BENCHMARK("EventDispatch/FlatStdFunction/300 listeners") {
+  std::vector<std::function<void(const Event &)>> callbacks;
+  for (u32 i = 0; i < kListenersPerType; i++) {
+    callbacks.emplace_back([i](const Event &e) {
+      if (auto *p = std::get_if<MouseMoveEvent>(&e.payload)) s_Sink += i + (u64)p->xpos;
+    });
+    callbacks.emplace_back([i](const Event &e) {
+      if (auto *p = std::get_if<KeyEvent>(&e.payload)) s_Sink += i + p->key;
+    });
+    callbacks.emplace_back([i](const Event &e) {
+      if (auto *p = std::get_if<MouseButtonEvent>(&e.payload)) s_Sink += i + p->button;
+    });
+  }
+
+  const Event e = MakeMouseMove();
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (auto &cb : callbacks) cb(e);
+    ClobberMemory();
+  }
+  DoNotOptimize(s_Sink);
+}
+
+SN_BENCHMARK("EventDispatch/TypeIndexed/300 listeners") {
+  RegisterListeners();
+
+  const Event e = MakeMouseMove();
+  for (u64 i = 0; i < state.iterations; i++) {
+    EventDispatcher::Dispatch(e);
+    ClobberMemory();
+  }
+  DoNotOptimize(s_Sink);
+  EventDispatcher::Clear();
+}
+
+SN_BENCHMARK("EventDispatch/TypeIndexed/no listener for type") {
+  RegisterListeners();
+
+  Event e = MakeMouseMove();
+  e.type = EventType::WINDOW_RESIZE;
+  e.payload = WindowResizeEvent{800, 600};
+  for (u64 i = 0; i < state.iterations; i++) {
+    EventDispatcher::Dispatch(e);
+    ClobberMemory();
+  }
+  DoNotOptimize(s_Sink);
+  EventDispatcher::Clear();
+}
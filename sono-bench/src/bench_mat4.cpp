@@ -0,0 +1,409 @@
+#include "bench.h"
+#include "glm_compat.h"
+#include <core/math/affine3x4.h>
+#include <core/math/transform.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+constexpr usize kMatrixCount = 1024;
+
+// --------------------------------------------------------------------------------
+static std::vector<Mat4> MakeMatrices(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+
+  std::vector<Mat4> matrices(kMatrixCount);
+  for (Mat4 &m : matrices) {
+    Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+    q.Normalize();
+    m = q.ToMat4();
+    m.SetTranslation(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f);
+  }
+  return matrices;
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+static void RunBinary(BenchState &state, Fn &&fn) {
+  const std::vector<Mat4> a = MakeMatrices(1);
+  const std::vector<Mat4> b = MakeMatrices(2);
+  std::vector<Mat4> out(kMatrixCount);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) fn(a[i], b[i], out[i]);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+static void RunUnary(BenchState &state, Fn &&fn) {
+  const std::vector<Mat4> a = MakeMatrices(3);
+  std::vector<Mat4> out(kMatrixCount);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) fn(a[i], out[i]);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("Mat4/Multiply/Scalar") {
+  RunBinary(state, [](const Mat4 &a, const Mat4 &b, Mat4 &out) {
+    Sono::Scalar::Mat4Multiply(a.ValuePtr(), b.ValuePtr(), out.ValuePtr());
+  });
+}
+
+SN_BENCHMARK("Mat4/Multiply/Kernel") {
+  RunBinary(state, [](const Mat4 &a, const Mat4 &b, Mat4 &out) { out = a * b; });
+}
+
+SN_BENCHMARK("Mat4/Multiply/glm") {
+  RunBinary(state, [](const Mat4 &a, const Mat4 &b, Mat4 &out) {
+    const glm::mat4 &ga = reinterpret_cast<const glm::mat4 &>(a);
+    const glm::mat4 &gb = reinterpret_cast<const glm::mat4 &>(b);
+    reinterpret_cast<glm::mat4 &>(out) = gb * ga;
+  });
+}
+
+SN_PARITY("Mat4/Multiply", 4) {
+  const std::vector<Mat4> a = MakeMatrices(1), b = MakeMatrices(2);
+  for (usize i = 0; i < kMatrixCount; i++) parity.Compare(a[i] * b[i], ToGlm(b[i]) * ToGlm(a[i]));
+}
+
+SN_BENCHMARK("Mat4/Inverse/Scalar") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) {
+    Sono::Scalar::Mat4Inverse(m.ValuePtr(), out.ValuePtr());
+  });
+}
+
+SN_BENCHMARK("Mat4/Inverse/Kernel") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) { out = m.Inversed(); });
+}
+
+SN_BENCHMARK("Mat4/Inverse/glm") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) {
+    reinterpret_cast<glm::mat4 &>(out) = glm::inverse(reinterpret_cast<const glm::mat4 &>(m));
+  });
+}
+
+// Both use cofactor expansion but group the products differently
+SN_PARITY("Mat4/Inverse", 64) {
+  parity.absTolerance = 1e-5f;
+  for (const Mat4 &m : MakeMatrices(3)) parity.Compare(m.Inversed(), glm::inverse(ToGlm(m)));
+}
+
+SN_BENCHMARK("Mat4/InverseAffine/Scalar") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) {
+    Sono::Scalar::Mat4InverseAffine(m.ValuePtr(), out.ValuePtr());
+  });
+}
+
+SN_BENCHMARK("Mat4/InverseAffine/Kernel") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) { out = m.InversedAffine(); });
+}
+
+SN_BENCHMARK("Mat4/Transpose/Kernel") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) { out = m.Transposed(); });
+}
+
+SN_BENCHMARK("Mat4/Transpose/glm") {
+  RunUnary(state, [](const Mat4 &m, Mat4 &out) {
+    reinterpret_cast<glm::mat4 &>(out) = glm::transpose(reinterpret_cast<const glm::mat4 &>(m));
+  });
+}
+
+SN_PARITY("Mat4/Transpose", 0) {
+  for (const Mat4 &m : MakeMatrices(3)) parity.Compare(m.Transposed(), glm::transpose(ToGlm(m)));
+}
+
+SN_BENCHMARK("Mat4/Vec4MulMat4/Kernel") {
+  const std::vector<Mat4> matrices = MakeMatrices(4);
+  Vec4 v(1.0f, 2.0f, 3.0f, 1.0f);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (const Mat4 &m : matrices) v = v * m;
+    DoNotOptimize(v);
+  }
+}
+
+// Reference for Transform::GetLocalModelMatrix before it was written out
+SN_BENCHMARK("Transform/LocalModelMatrix/Composed") {
+  Transform t(Vec3(1.0f, 2.0f, 3.0f), Vec3(0.3f, 0.2f, 0.1f), Vec3(2.0f));
+  Mat4 m;
+  for (u64 it = 0; it < state.iterations; it++) {
+    m = Mat4::Scale(t.GetScale()) * t.GetRotation().ToMat4() * Mat4::Translation(t.GetPosition());
+    DoNotOptimize(m);
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Transform/LocalModelMatrix/Direct") {
+  Transform t(Vec3(1.0f, 2.0f, 3.0f), Vec3(0.3f, 0.2f, 0.1f), Vec3(2.0f));
+  Mat4 m;
+  for (u64 it = 0; it < state.iterations; it++) {
+    m = t.GetLocalModelMatrix();
+    DoNotOptimize(m);
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Mat4/Vec4MulMat4/glm") {
+  const std::vector<Mat4> matrices = MakeMatrices(4);
+  glm::vec4 v(1.0f, 2.0f, 3.0f, 1.0f);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (const Mat4 &m : matrices) v = reinterpret_cast<const glm::mat4 &>(m) * v;
+    DoNotOptimize(v);
+  }
+}
+
+SN_PARITY("Mat4/Vec4MulMat4", 4) {
+  const Vec4 v(1.0f, -2.0f, 3.0f, 1.0f);
+  for (const Mat4 &m : MakeMatrices(4)) parity.Compare(v * m, ToGlm(m) * ToGlm(v));
+}
+
+// ================================================================================
+// Affine 3x4, the same transforms as MakeMatrices without the constant column
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+static std::vector<Affine3x4> MakeAffines(u32 seed) {
+  std::vector<Affine3x4> affines;
+  affines.reserve(kMatrixCount);
+  for (const Mat4 &m : MakeMatrices(seed)) affines.emplace_back(m);
+  return affines;
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+static void RunAffine(BenchState &state, Fn &&fn) {
+  const std::vector<Affine3x4> a = MakeAffines(1);
+  const std::vector<Affine3x4> b = MakeAffines(2);
+  std::vector<Affine3x4> out(kMatrixCount);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) fn(a[i], b[i], out[i]);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("Affine3x4/Multiply/Scalar") {
+  RunAffine(state, [](const Affine3x4 &a, const Affine3x4 &b, Affine3x4 &out) {
+    Sono::Scalar::Affine3x4Multiply(a.ValuePtr(), b.ValuePtr(), out.ValuePtr());
+  });
+}
+
+SN_BENCHMARK("Affine3x4/Multiply/Kernel") {
+  RunAffine(state, [](const Affine3x4 &a, const Affine3x4 &b, Affine3x4 &out) { out = a * b; });
+}
+
+SN_PARITY("Affine3x4/Multiply", 4) {
+  const std::vector<Mat4> a = MakeMatrices(1), b = MakeMatrices(2);
+  for (usize i = 0; i < kMatrixCount; i++) {
+    parity.Compare((Affine3x4(a[i]) * Affine3x4(b[i])).ToMat4(), ToGlm(b[i]) * ToGlm(a[i]));
+  }
+}
+
+SN_BENCHMARK("Affine3x4/Inverse/Kernel") {
+  RunAffine(state, [](const Affine3x4 &a, const Affine3x4 &, Affine3x4 &out) {
+    out = a.Inversed();
+  });
+}
+
+// Adjugate through cross products against glm's full cofactor expansion
+SN_PARITY("Affine3x4/Inverse", 64) {
+  parity.absTolerance = 1e-5f;
+  for (const Mat4 &m : MakeMatrices(3)) {
+    parity.Compare(Affine3x4(m).Inversed().ToMat4(), glm::inverse(ToGlm(m)));
+  }
+}
+
+SN_BENCHMARK("Affine3x4/TransformPoint/Affine3x4") {
+  const std::vector<Affine3x4> affines = MakeAffines(4);
+  Vec3 p(1.0f, 2.0f, 3.0f);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (const Affine3x4 &m : affines) p = m.TransformPoint(p);
+    DoNotOptimize(p);
+  }
+}
+
+SN_BENCHMARK("Affine3x4/TransformPoint/Mat4") {
+  const std::vector<Mat4> matrices = MakeMatrices(4);
+  Vec4 p(1.0f, 2.0f, 3.0f, 1.0f);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (const Mat4 &m : matrices) p = p * m;
+    DoNotOptimize(p);
+  }
+}
+
+// ================================================================================
+// View and projection
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+static std::vector<Vec3> MakeEyes(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-50.0f, 50.0f);
+  std::vector<Vec3> eyes(kMatrixCount);
+  for (Vec3 &e : eyes) e = Vec3(dist(rng), dist(rng), dist(rng));
+  return eyes;
+}
+
+SN_BENCHMARK("Mat4/LookAt/Sono") {
+  const std::vector<Vec3> eyes = MakeEyes(5);
+  const Vec3 target(1.0f, 2.0f, 3.0f);
+  std::vector<Mat4> out(kMatrixCount);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) out[i] = Mat4::LookAt(eyes[i], target, Vec3::Up);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("Mat4/LookAt/glm") {
+  std::vector<glm::vec3> eyes;
+  for (const Vec3 &e : MakeEyes(5)) eyes.push_back(ToGlm(e));
+  const glm::vec3 target(1.0f, 2.0f, 3.0f);
+  std::vector<glm::mat4> out(kMatrixCount);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) {
+      out[i] = glm::lookAt(eyes[i], target, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+// Sono normalizes by dividing by the length, glm by multiplying with the inverse square root
+SN_PARITY("Mat4/LookAt", 8) {
+  parity.absTolerance = 1e-5f;
+  const Vec3 target(1.0f, 2.0f, 3.0f);
+  for (const Vec3 &eye : MakeEyes(5)) {
+    parity.Compare(
+      Mat4::LookAt(eye, target, Vec3::Up),
+      glm::lookAt(ToGlm(eye), ToGlm(target), glm::vec3(0.0f, 1.0f, 0.0f))
+    );
+  }
+}
+
+SN_BENCHMARK("Mat4/Perspective/Sono") {
+  std::vector<Mat4> out(kMatrixCount);
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) {
+      out[i] = Mat4::Perspective(0.5f + 0.001f * (f32)i, 16.0f / 9.0f, 0.1f, 1000.0f);
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("Mat4/Perspective/glm") {
+  std::vector<glm::mat4> out(kMatrixCount);
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < kMatrixCount; i++) {
+      out[i] = glm::perspective(0.5f + 0.001f * (f32)i, 16.0f / 9.0f, 0.1f, 1000.0f);
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_PARITY("Mat4/Perspective", 2) {
+  for (usize i = 0; i < kMatrixCount; i++) {
+    const f32 fov = 0.5f + 0.001f * (f32)i;
+    parity.Compare(
+      Mat4::Perspective(fov, 16.0f / 9.0f, 0.1f, 1000.0f),
+      glm::perspective(fov, 16.0f / 9.0f, 0.1f, 1000.0f)
+    );
+  }
+}
+
+// ================================================================================
+// Transform updates
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+static std::vector<Transform> MakeTransforms(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<Transform> transforms(kMatrixCount);
+  for (Transform &t : transforms) {
+    Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+    q.Normalize();
+    t.SetPosition(Vec3(dist(rng), dist(rng), dist(rng)) * 20.0f);
+    t.SetRotation(q);
+    t.Scale(Vec3(1.5f + dist(rng), 1.5f + dist(rng), 1.5f + dist(rng)));
+  }
+  return transforms;
+}
+// --------------------------------------------------------------------------------
+static glm::mat4 GlmModelMatrix(const Transform &t) {
+  const glm::mat4 identity(1.0f);
+  return glm::translate(identity, ToGlm(t.GetPosition())) * glm::mat4_cast(ToGlm(t.GetRotation())) *
+    glm::scale(identity, ToGlm(t.GetScale()));
+}
+
+// Move every transform a little and rebuild its model matrix, a typical per frame update
+SN_BENCHMARK("Transform/Update/Sono") {
+  std::vector<Transform> transforms = MakeTransforms(6);
+  const Vec3 step(0.01f, 0.0f, -0.01f);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (Transform &t : transforms) {
+      t.SetPosition(t.GetPosition() + step);
+      t.UpdateModelMatrix();
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(transforms.data());
+}
+
+SN_BENCHMARK("Transform/Update/glm") {
+  struct GlmTransform {
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    glm::mat4 model;
+  };
+  std::vector<GlmTransform> transforms;
+  for (const Transform &t : MakeTransforms(6)) {
+    transforms.push_back({ToGlm(t.GetPosition()), ToGlm(t.GetRotation()), ToGlm(t.GetScale()), {}});
+  }
+  const glm::vec3 step(0.01f, 0.0f, -0.01f);
+  const glm::mat4 identity(1.0f);
+
+  state.itemsPerIteration = kMatrixCount;
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (GlmTransform &t : transforms) {
+      t.position += step;
+      t.model = glm::translate(identity, t.position) * glm::mat4_cast(t.rotation) *
+        glm::scale(identity, t.scale);
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(transforms.data());
+}
+
+SN_PARITY("Transform/LocalModelMatrix", 4) {
+  parity.absTolerance = 1e-5f;
+  for (const Transform &t : MakeTransforms(6)) {
+    parity.Compare(t.GetLocalModelMatrix(), GlmModelMatrix(t));
+  }
+}
@@ -0,0 +1,151 @@
+#include "bench.h"
+#include <core/math/batch.h>
+#include <core/math/triangle_bvh.h>
+#include <render/camera.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct TerrainFixture {
+  std::vector<Vec3> positions;
+  std::vector<u32> indices;
+  TriangleBvh bvh;
+};
+
+// --------------------------------------------------------------------------------
+/// A rolling heightfield of side x side quads over 1000 units, two triangles each, the kind of
+/// mesh that dominates a level's triangle count. Built once per size and reused across runs.
+static TerrainFixture &BenchTerrain(u32 side) {
+  static std::vector<std::pair<u32, std::unique_ptr<TerrainFixture>>> s_Fixtures;
+  for (auto &[size, fixture] : s_Fixtures) {
+    if (size == side) return *fixture;
+  }
+
+  auto fixture = std::make_unique<TerrainFixture>();
+  const f32 step = 1000.0f / (f32)side;
+  for (u32 z = 0; z <= side; z++) {
+    for (u32 x = 0; x <= side; x++) {
+      const f32 px = (f32)x * step - 500.0f, pz = (f32)z * step - 500.0f;
+      const f32 height = 20.0f * std::sin(px * 0.02f) * std::cos(pz * 0.03f);
+      fixture->positions.emplace_back(px, height, pz);
+    }
+  }
+  for (u32 z = 0; z < side; z++) {
+    for (u32 x = 0; x < side; x++) {
+      const u32 a = z * (side + 1) + x, b = a + 1, c = a + side + 1, d = c + 1;
+      fixture->indices.insert(fixture->indices.end(), {a, c, b, b, c, d});
+    }
+  }
+  fixture->bvh.Build(
+    fixture->positions.data(), fixture->positions.size(), fixture->indices.data(),
+    fixture->indices.size()
+  );
+  s_Fixtures.emplace_back(side, std::move(fixture));
+  return *s_Fixtures.back().second;
+}
+// --------------------------------------------------------------------------------
+/// 64 mouse positions spread over a 1920x1080 view from above the terrain
+static std::vector<Ray> BenchPickRays() {
+  Camera camera;
+  camera.SetPerspective(Sono::Radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+  camera.SetPosition(Vec3(0.0f, 150.0f, 400.0f));
+  camera.LookAt(Vec3::Zero);
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<f32> x(0.0f, 1920.0f), y(0.0f, 1080.0f);
+  std::vector<Ray> rays;
+  for (i32 i = 0; i < 64; i++) {
+    rays.push_back(camera.ScreenPointToRay(Vec2(x(rng), y(rng)), Vec2(1920.0f, 1080.0f)));
+  }
+  return rays;
+}
+
+// --------------------------------------------------------------------------------
+static void BenchBuild(BenchState &state, u32 side) {
+  TerrainFixture &fixture = BenchTerrain(side);
+  TriangleBvh bvh;
+  state.itemsPerIteration = fixture.indices.size() / 3;
+  for (u64 i = 0; i < state.iterations; i++) {
+    bvh.Build(
+      fixture.positions.data(), fixture.positions.size(), fixture.indices.data(),
+      fixture.indices.size()
+    );
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Picking/TriangleBvh build/200k triangles") { BenchBuild(state, 316); }
+SN_BENCHMARK("Picking/TriangleBvh build/2M triangles") { BenchBuild(state, 1000); }
+
+// --------------------------------------------------------------------------------
+/// Closest hit of 64 rays, items are rays so ns/item is the latency of one pick
+static void BenchRaycast(BenchState &state, u32 side, Sono::SimdLevel level) {
+  const Sono::SimdLevel initial = Sono::GetSimdLevel();
+  if (!Sono::SetSimdLevel(level)) {
+    state.skipped = true;
+    return;
+  }
+  TerrainFixture &fixture = BenchTerrain(side);
+  const std::vector<Ray> rays = BenchPickRays();
+  state.itemsPerIteration = rays.size();
+  for (u64 i = 0; i < state.iterations; i++) {
+    f32 sum = 0.0f;
+    for (const Ray &ray : rays) {
+      RayHit hit = {0.0f, 0};
+      if (fixture.bvh.Raycast(ray, INFINITY, hit)) sum += hit.t;
+    }
+    DoNotOptimize(sum);
+  }
+  Sono::SetSimdLevel(initial);
+}
+
+SN_BENCHMARK("Picking/Raycast closest/2M triangles 64 rays scalar") {
+  BenchRaycast(state, 1000, Sono::SimdLevel::SCALAR);
+}
+SN_BENCHMARK("Picking/Raycast closest/2M triangles 64 rays sse2") {
+  BenchRaycast(state, 1000, Sono::SimdLevel::SSE2);
+}
+SN_BENCHMARK("Picking/Raycast closest/2M triangles 64 rays avx2") {
+  BenchRaycast(state, 1000, Sono::SimdLevel::AVX2);
+}
+SN_BENCHMARK("Picking/Raycast closest/2M triangles 64 rays avx512") {
+  BenchRaycast(state, 1000, Sono::SimdLevel::AVX512);
+}
+
+// --------------------------------------------------------------------------------
+/// Every triangle through the batch test, the cost without a hierarchy. 4 rays, items are rays.
+SN_BENCHMARK("Picking/Raycast closest/2M triangles 4 rays brute force batch") {
+  TerrainFixture &fixture = BenchTerrain(1000);
+  const usize count = fixture.indices.size() / 3;
+  std::vector<f32> v0[3], e1[3], e2[3];
+  for (i32 axis = 0; axis < 3; axis++) {
+    v0[axis].resize(count);
+    e1[axis].resize(count);
+    e2[axis].resize(count);
+  }
+  for (usize t = 0; t < count; t++) {
+    const Vec3 &a = fixture.positions[fixture.indices[3 * t]];
+    const Vec3 b = fixture.positions[fixture.indices[3 * t + 1]] - a;
+    const Vec3 c = fixture.positions[fixture.indices[3 * t + 2]] - a;
+    for (i32 axis = 0; axis < 3; axis++) {
+      v0[axis][t] = a[axis];
+      e1[axis][t] = b[axis];
+      e2[axis][t] = c[axis];
+    }
+  }
+  const std::vector<Ray> rays = BenchPickRays();
+  state.itemsPerIteration = 4;
+  for (u64 i = 0; i < state.iterations; i++) {
+    f32 sum = 0.0f;
+    for (usize r = 0; r < 4; r++) {
+      u32 index = 0;
+      sum += Sono::IntersectRayTriangles(
+        rays[r].origin, rays[r].dir, {v0[0].data(), v0[1].data(), v0[2].data()},
+        {e1[0].data(), e1[1].data(), e1[2].data()}, {e2[0].data(), e2[1].data(), e2[2].data()},
+        count, INFINITY, &index
+      );
+    }
+    DoNotOptimize(sum);
+  }
+}
@@ -0,0 +1,156 @@
+#include "bench.h"
+#include "glm_compat.h"
+
+#include <random>
+
+constexpr usize kQuaternionCount = 1024;
+
+// --------------------------------------------------------------------------------
+static std::vector<Quaternion> MakeQuaternions(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<Quaternion> quats(kQuaternionCount);
+  for (Quaternion &q : quats) {
+    q = Quaternion(dist(rng), dist(rng), dist(rng), dist(rng));
+    q.Normalize();
+  }
+  return quats;
+}
+// --------------------------------------------------------------------------------
+static std::vector<Vec3> MakePoints(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-10.0f, 10.0f);
+  std::vector<Vec3> points(kQuaternionCount);
+  for (Vec3 &p : points) p = Vec3(dist(rng), dist(rng), dist(rng));
+  return points;
+}
+// --------------------------------------------------------------------------------
+static std::vector<glm::quat> ToGlm(const std::vector<Quaternion> &quats) {
+  std::vector<glm::quat> out;
+  for (const Quaternion &q : quats) out.push_back(::ToGlm(q));
+  return out;
+}
+// --------------------------------------------------------------------------------
+static std::vector<glm::vec3> ToGlm(const std::vector<Vec3> &points) {
+  std::vector<glm::vec3> out;
+  for (const Vec3 &p : points) out.push_back(::ToGlm(p));
+  return out;
+}
+// --------------------------------------------------------------------------------
+template <typename A, typename B, typename Fn>
+static void Run(BenchState &state, const std::vector<A> &a, const std::vector<B> &b, Fn &&fn) {
+  using R = decltype(fn(a[0], b[0]));
+  std::vector<R> out(a.size());
+  state.itemsPerIteration = a.size();
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < a.size(); i++) out[i] = fn(a[i], b[i]);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("Quaternion/Multiply/Sono") {
+  Run(state, MakeQuaternions(1), MakeQuaternions(2), [](const Quaternion &a, const Quaternion &b) {
+    return a * b;
+  });
+}
+
+SN_BENCHMARK("Quaternion/Multiply/glm") {
+  Run(
+    state, ToGlm(MakeQuaternions(1)), ToGlm(MakeQuaternions(2)),
+    [](const glm::quat &a, const glm::quat &b) { return a * b; }
+  );
+}
+
+SN_PARITY("Quaternion/Multiply", 0) {
+  const std::vector<Quaternion> a = MakeQuaternions(1), b = MakeQuaternions(2);
+  for (usize i = 0; i < a.size(); i++) {
+    parity.Compare(a[i] * b[i], FromGlm(::ToGlm(a[i]) * ::ToGlm(b[i])));
+  }
+}
+
+SN_BENCHMARK("Quaternion/RotateVec3/Sono") {
+  Run(state, MakeQuaternions(1), MakePoints(2), [](const Quaternion &q, const Vec3 &v) {
+    return q * v;
+  });
+}
+
+SN_BENCHMARK("Quaternion/RotateVec3/glm") {
+  Run(
+    state, ToGlm(MakeQuaternions(1)), ToGlm(MakePoints(2)),
+    [](const glm::quat &q, const glm::vec3 &v) { return q * v; }
+  );
+}
+
+// Reference for operator* before it was expanded into cross products
+SN_BENCHMARK("Quaternion/RotateVec3/Sandwich") {
+  Run(state, MakeQuaternions(1), MakePoints(2), [](const Quaternion &q, const Vec3 &v) {
+    const Quaternion r = q * Quaternion(0.0f, v.x, v.y, v.z) * q.Inversed();
+    return Vec3(r.x, r.y, r.z);
+  });
+}
+
+// Both rotate with two cross products but group the terms differently
+SN_PARITY("Quaternion/RotateVec3", 16) {
+  parity.absTolerance = 1e-5f;
+  const std::vector<Quaternion> q = MakeQuaternions(1);
+  const std::vector<Vec3> v = MakePoints(2);
+  for (usize i = 0; i < q.size(); i++) parity.Compare(q[i] * v[i], ::ToGlm(q[i]) * ::ToGlm(v[i]));
+}
+
+SN_BENCHMARK("Quaternion/Basis/ThreeRotations") {
+  const std::vector<Quaternion> quats = MakeQuaternions(1);
+  Run(state, quats, quats, [](const Quaternion &q, const Quaternion &) {
+    return Quaternion::Basis{q * Vec3::Right, q * Vec3::Up, q * Vec3::Forward};
+  });
+}
+
+SN_BENCHMARK("Quaternion/Basis/ToBasis") {
+  const std::vector<Quaternion> quats = MakeQuaternions(1);
+  Run(state, quats, quats, [](const Quaternion &q, const Quaternion &) { return q.ToBasis(); });
+}
+
+SN_BENCHMARK("Quaternion/ToMat4/Sono") {
+  const std::vector<Quaternion> quats = MakeQuaternions(1);
+  Run(state, quats, quats, [](const Quaternion &q, const Quaternion &) { return q.ToMat4(); });
+}
+
+SN_BENCHMARK("Quaternion/ToMat4/glm") {
+  const std::vector<glm::quat> quats = ToGlm(MakeQuaternions(1));
+  Run(state, quats, quats, [](const glm::quat &q, const glm::quat &) { return glm::mat4_cast(q); });
+}
+
+SN_PARITY("Quaternion/ToMat4", 0) {
+  for (const Quaternion &q : MakeQuaternions(1)) {
+    parity.Compare(q.ToMat4(), glm::mat4_cast(::ToGlm(q)));
+  }
+}
+
+SN_BENCHMARK("Quaternion/FromAxisAngle/Sono") {
+  const std::vector<Vec3> axes = MakePoints(1);
+  std::vector<f32> angles(axes.size());
+  for (usize i = 0; i < angles.size(); i++) angles[i] = 0.01f * (f32)i;
+  Run(state, axes, angles, [](const Vec3 &axis, f32 angle) {
+    return Quaternion::FromAxisAngle(axis, angle);
+  });
+}
+
+SN_BENCHMARK("Quaternion/FromAxisAngle/glm") {
+  const std::vector<glm::vec3> axes = ToGlm(MakePoints(1));
+  std::vector<f32> angles(axes.size());
+  for (usize i = 0; i < angles.size(); i++) angles[i] = 0.01f * (f32)i;
+  Run(state, axes, angles, [](const glm::vec3 &axis, f32 angle) {
+    return glm::angleAxis(angle, glm::normalize(axis));
+  });
+}
+
+SN_PARITY("Quaternion/FromAxisAngle", 4) {
+  const std::vector<Vec3> axes = MakePoints(1);
+  for (usize i = 0; i < axes.size(); i++) {
+    const f32 angle = 0.01f * (f32)i;
+    parity.Compare(
+      Quaternion::FromAxisAngle(axes[i], angle),
+      FromGlm(glm::angleAxis(angle, glm::normalize(::ToGlm(axes[i]))))
+    );
+  }
+}
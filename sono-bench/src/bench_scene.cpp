@@ -0,0 +1,279 @@
+#include "bench.h"
+#include <core/thread/thread_pool.h>
+#include <render/buffer_base.h>
+#include <render/scene.h>
+#include <render/scene_snapshot.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+
+struct SceneFixture {
+  Scene scene;
+  std::vector<Entity> touched; // 1% of the nodes, picked at random
+};
+
+// --------------------------------------------------------------------------------
+/// count nodes as a forest of complete 4-ary trees five levels deep (341 nodes, three in four
+/// are leaves), each created depth first as a recursive loader would, so the creation order is not
+/// the level order. Built once per size and reused across runs.
+static SceneFixture &BenchScene(usize count) {
+  static std::vector<std::pair<usize, std::unique_ptr<SceneFixture>>> s_Fixtures;
+  for (auto &[size, fixture] : s_Fixtures) {
+    if (size == count) return *fixture;
+  }
+
+  constexpr usize kTreeSize = 1 + 4 + 16 + 64 + 256;
+  auto fixture = std::make_unique<SceneFixture>();
+  Scene &scene = fixture->scene;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  for (usize base = 0; base < count; base += kTreeSize) {
+    const usize treeSize = std::min(kTreeSize, count - base);
+    std::vector<std::pair<usize, i32>> stack = {{0, -1}}; // heap index, parent entity
+    while (!stack.empty()) {
+      const auto [heap, parent] = stack.back();
+      stack.pop_back();
+      const Entity e = scene.AddNode(parent);
+      Transform &t = scene.GetComponent<Transform>(e);
+      t.SetPosition(Vec3(dist(rng), dist(rng), dist(rng)) * 5.0f);
+      t.SetRotation(Quaternion::FromAxisAngle(Vec3(dist(rng), 1.0f, dist(rng)), dist(rng)));
+      for (usize c = 4 * heap + 4; c > 4 * heap; c--) {
+        if (c < treeSize) stack.emplace_back(c, (i32)e);
+      }
+    }
+  }
+  scene.UpdateTransforms();
+
+  for (usize i = 0; i < count / 100; i++) fixture->touched.push_back((Entity)(rng() % count));
+  s_Fixtures.emplace_back(count, std::move(fixture));
+  return *s_Fixtures.back().second;
+}
+// --------------------------------------------------------------------------------
+/// Per iteration: touch 1% or all of the nodes, then UpdateTransforms. Touched nodes take their
+/// descendants along, with this tree shape about 5% of the matrices are recomputed for 1%.
+static void BenchUpdateTransforms(BenchState &state, usize count, b8 moveAll) {
+  SceneFixture &fixture = BenchScene(count);
+  Scene &scene = fixture.scene;
+  state.itemsPerIteration = count;
+  for (u64 i = 0; i < state.iterations; i++) {
+    // Setting the position marks the node dirty, the update is what is measured
+    auto touch = [&](Entity e) {
+      Transform &t = scene.GetComponent<Transform>(e);
+      t.SetPosition(t.GetPosition());
+    };
+    if (moveAll) {
+      // Split too when there is a pool, or the serial touch loop caps the scaling
+      auto touchRange = [&](usize begin, usize end) {
+        for (usize e = begin; e < end; e++) touch((Entity)e);
+      };
+      if (ThreadPool *pool = ThreadPool::GetPtr()) {
+        pool->ParallelFor(count, 16384, touchRange);
+      } else {
+        touchRange(0, count);
+      }
+    } else {
+      for (Entity e : fixture.touched) touch(e);
+    }
+    scene.UpdateTransforms();
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Scene/UpdateTransforms/10k nodes 1% dirty") {
+  BenchUpdateTransforms(state, 10000, false);
+}
+SN_BENCHMARK("Scene/UpdateTransforms/10k nodes 100% dirty") {
+  BenchUpdateTransforms(state, 10000, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms/100k nodes 1% dirty") {
+  BenchUpdateTransforms(state, 100000, false);
+}
+SN_BENCHMARK("Scene/UpdateTransforms/100k nodes 100% dirty") {
+  BenchUpdateTransforms(state, 100000, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms/1M nodes 1% dirty") {
+  BenchUpdateTransforms(state, 1000000, false);
+}
+SN_BENCHMARK("Scene/UpdateTransforms/1M nodes 100% dirty") {
+  BenchUpdateTransforms(state, 1000000, true);
+}
+
+// --------------------------------------------------------------------------------
+/// BenchUpdateTransforms on 100k nodes plus publishing a snapshot that a renderer acquires, the
+/// difference to the plain update is the cost of the publish
+static void BenchPublishSnapshot(BenchState &state, b8 moveAll) {
+  SceneSnapshot snapshot;
+  BenchScene(100000).scene.PublishSnapshot(snapshot);
+  BenchState update = state;
+  update.iterations = 1;
+  for (u64 i = 0; i < state.iterations; i++) {
+    BenchUpdateTransforms(update, 100000, moveAll);
+    BenchScene(100000).scene.PublishSnapshot(snapshot);
+    DoNotOptimize(snapshot.Acquire().frame);
+  }
+  state.itemsPerIteration = update.itemsPerIteration;
+}
+
+SN_BENCHMARK("Scene/UpdateTransforms and PublishSnapshot/100k nodes 1% dirty") {
+  BenchPublishSnapshot(state, false);
+}
+SN_BENCHMARK("Scene/UpdateTransforms and PublishSnapshot/100k nodes 100% dirty") {
+  BenchPublishSnapshot(state, true);
+}
+
+// --------------------------------------------------------------------------------
+/// Stands in for a GPU buffer, an update costs the copy of its bytes
+class CopyBuffer : public Buffer {
+public:
+  explicit CopyBuffer(usize count)
+    : Buffer(BufferDesc{count, (u32)sizeof(Affine3x4), BufferUsage::Storage})
+    , m_Bytes(count * sizeof(Affine3x4)) {}
+
+  void Bind() const override {}
+  void Unbind() const override {}
+  void *Map() override { return m_Bytes.data(); }
+  void Unmap() override {}
+  void Update(const void *data, usize size, usize offset) override {
+    std::memcpy(m_Bytes.data() + offset, data, size);
+  }
+  void Release() override {}
+
+private:
+  std::vector<u8> m_Bytes;
+};
+
+/// BenchUpdateTransforms on 100k nodes plus bringing a transform buffer up to date, by the
+/// changed matrices or by sending them all every frame
+static void BenchTransformUpload(BenchState &state, b8 full) {
+  Scene &scene = BenchScene(100000).scene;
+  CopyBuffer buffer(scene.GetEntityCapacity());
+  TransformBuffer upload;
+  upload.Upload(scene, &buffer);
+  BenchState update = state;
+  update.iterations = 1;
+  for (u64 i = 0; i < state.iterations; i++) {
+    BenchUpdateTransforms(update, 100000, false);
+    if (full) upload.Invalidate();
+    DoNotOptimize(upload.Upload(scene, &buffer).matrices);
+  }
+  state.itemsPerIteration = update.itemsPerIteration;
+}
+
+SN_BENCHMARK("Scene/UpdateTransforms and TransformBuffer upload/100k nodes 1% dirty") {
+  BenchTransformUpload(state, false);
+}
+SN_BENCHMARK("Scene/UpdateTransforms and TransformBuffer upload/100k nodes 1% dirty full") {
+  BenchTransformUpload(state, true);
+}
+
+// --------------------------------------------------------------------------------
+/// The 1M node update with the levels split across threadCount threads (the caller included).
+/// SonoBench prints the speedup of each thread count over the 1 thread run of the same name.
+static void BenchUpdateTransformsThreads(BenchState &state, u32 threadCount, b8 moveAll) {
+  if (threadCount > std::max(1u, std::thread::hardware_concurrency())) {
+    state.skipped = true;
+    return;
+  }
+  ThreadPool pool(threadCount - 1);
+  BenchUpdateTransforms(state, 1000000, moveAll);
+}
+
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 1 thread") {
+  BenchUpdateTransformsThreads(state, 1, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 2 threads") {
+  BenchUpdateTransformsThreads(state, 2, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 3 threads") {
+  BenchUpdateTransformsThreads(state, 3, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 4 threads") {
+  BenchUpdateTransformsThreads(state, 4, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 6 threads") {
+  BenchUpdateTransformsThreads(state, 6, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 8 threads") {
+  BenchUpdateTransformsThreads(state, 8, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 12 threads") {
+  BenchUpdateTransformsThreads(state, 12, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 100% dirty 16 threads") {
+  BenchUpdateTransformsThreads(state, 16, true);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 1% dirty 1 thread") {
+  BenchUpdateTransformsThreads(state, 1, false);
+}
+SN_BENCHMARK("Scene/UpdateTransforms MT/1M 1% dirty 8 threads") {
+  BenchUpdateTransformsThreads(state, 8, false);
+}
+
+// --------------------------------------------------------------------------------
+/// View<Transform, MeshRef> over the 100k node scene where one node in every meshEvery has a
+/// mesh, reading the world position and the submesh as a draw collection pass would
+static void BenchMeshView(BenchState &state, u32 meshEvery) {
+  static std::vector<std::pair<u32, std::unique_ptr<Scene>>> s_Scenes;
+  Scene *scene = nullptr;
+  for (auto &[every, s] : s_Scenes) {
+    if (every == meshEvery) scene = s.get();
+  }
+  if (!scene) {
+    auto s = std::make_unique<Scene>();
+    for (u32 i = 0; i < 100000; i++) s->AddNode(i < 1000 ? -1 : (i32)(i / 4 - 250));
+    for (Entity e = 0; e < 100000; e += meshEvery) s->AddComponent<MeshRef>(e, nullptr, e & 3);
+    s->UpdateTransforms();
+    scene = s.get();
+    s_Scenes.emplace_back(meshEvery, std::move(s));
+  }
+
+  state.itemsPerIteration = 100000 / meshEvery;
+  for (u64 i = 0; i < state.iterations; i++) {
+    f32 sum = 0.0f;
+    u32 subMeshes = 0;
+    scene->GetView<Transform, MeshRef>().Each([&](Entity, Transform &t, MeshRef &mesh) {
+      sum += t.GetModelMatrix().TransformPoint(Vec3::Zero).x;
+      subMeshes += mesh.subMesh;
+    });
+    DoNotOptimize(sum);
+    DoNotOptimize(subMeshes);
+  }
+}
+
+SN_BENCHMARK("Scene/View<Transform, MeshRef>/100k nodes all meshes") { BenchMeshView(state, 1); }
+SN_BENCHMARK("Scene/View<Transform, MeshRef>/100k nodes 10% meshes") { BenchMeshView(state, 10); }
+
+// --------------------------------------------------------------------------------
+/// Per iteration: destroy the oldest churn projectiles and spawn as many with a MeshRef (root
+/// nodes, as projectiles or particles would be), then UpdateTransforms on the 100k node scene.
+/// Items are the churned entities.
+static void BenchEntityChurn(BenchState &state, usize churn) {
+  Scene scene;
+  for (u32 i = 0; i < 100000; i++) scene.AddNode(i < 1000 ? -1 : (i32)(i / 4 - 250));
+  std::deque<Entity> projectiles;
+  auto spawn = [&] {
+    const Entity e = scene.CreateEntity();
+    scene.AddComponent<MeshRef>(e);
+    scene.GetComponent<Transform>(e).SetPosition(Vec3((f32)projectiles.size(), 0.0f, 0.0f));
+    projectiles.push_back(e);
+  };
+  for (usize i = 0; i < 4 * churn; i++) spawn();
+  scene.UpdateTransforms();
+
+  state.itemsPerIteration = churn;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize k = 0; k < churn; k++) {
+      scene.DestroyEntity(projectiles.front());
+      projectiles.pop_front();
+      spawn();
+    }
+    scene.UpdateTransforms();
+    ClobberMemory();
+  }
+}
+
+SN_BENCHMARK("Scene/Entity churn/100k nodes 100 per frame") { BenchEntityChurn(state, 100); }
+SN_BENCHMARK("Scene/Entity churn/100k nodes 1000 per frame") { BenchEntityChurn(state, 1000); }
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include <core/resource/mapped_file.h>
+#include <render/scene_file.h>
+
+#include <filesystem>
+#include <memory>
+#include <random>
+
+// --------------------------------------------------------------------------------
+/// 1M nodes as a forest of 4-ary trees five levels deep, named, with a MeshRef submesh on every
+/// leaf stored as a column. Written to a temporary file once and reused by the load benchmarks.
+static const std::string &BenchSceneFile(std::vector<u8> *bytes = nullptr) {
+  static std::string s_Path;
+  static std::vector<u8> s_Bytes;
+  if (s_Path.empty()) {
+    constexpr usize kCount = 1000000, kTreeSize = 1 + 4 + 16 + 64 + 256;
+    Scene scene;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    for (usize base = 0; base < kCount; base += kTreeSize) {
+      const usize treeSize = std::min(kTreeSize, kCount - base);
+      for (usize heap = 0; heap < treeSize; heap++) {
+        const Entity e = scene.AddNode(heap == 0 ? NULL_ENTITY : (Entity)(base + (heap - 1) / 4));
+        scene.SetName(e, "node" + std::to_string(base + heap));
+        Transform &t = scene.GetComponent<Transform>(e);
+        t.SetPosition(Vec3(dist(rng), dist(rng), dist(rng)) * 5.0f);
+        t.SetRotation(Quaternion::FromAxisAngle(Vec3(dist(rng), 1.0f, dist(rng)), dist(rng)));
+        if (heap >= 85) scene.AddComponent<MeshRef>(e, nullptr, (u32)(heap & 3));
+      }
+    }
+    SceneFile::Write(scene, s_Bytes, {SceneColumn::Of<MeshRef>(1)});
+    s_Path = (std::filesystem::temp_directory_path() / "sono_bench_1m.snscene").string();
+    SceneFile::Save(scene, s_Path.c_str(), {SceneColumn::Of<MeshRef>(1)});
+  }
+  if (bytes) *bytes = s_Bytes;
+  return s_Path;
+}
+
+SN_BENCHMARK("SceneFile/Write/1M nodes") {
+  static std::unique_ptr<Scene> s_Scene;
+  if (!s_Scene) {
+    std::vector<u8> bytes;
+    BenchSceneFile(&bytes);
+    SceneFileView view;
+    view.Open(bytes.data(), bytes.size());
+    s_Scene = std::make_unique<Scene>();
+    SceneFile::Load(view, *s_Scene, {SceneColumn::Of<MeshRef>(1)});
+  }
+  state.itemsPerIteration = 1000000;
+  std::vector<u8> out;
+  for (u64 i = 0; i < state.iterations; i++) {
+    SceneFile::Write(*s_Scene, out, {SceneColumn::Of<MeshRef>(1)});
+    DoNotOptimize(out.data());
+  }
+}
+
+SN_BENCHMARK("SceneFile/Validate/1M nodes mapped") {
+  MappedFile file;
+  file.Open(BenchSceneFile().c_str());
+  state.itemsPerIteration = 1000000;
+  for (u64 i = 0; i < state.iterations; i++) {
+    SceneFileView view;
+    DoNotOptimize(view.Open(file.GetData(), file.GetSize()));
+  }
+}
+
+// --------------------------------------------------------------------------------
+/// Map, validate and load the 1M node file into a fresh Scene, optionally followed by the first
+/// UpdateTransforms. Freeing the Scene of the previous iteration is part of the time.
+static void BenchLoad(BenchState &state, b8 update) {
+  const std::string &path = BenchSceneFile();
+  state.itemsPerIteration = 1000000;
+  for (u64 i = 0; i < state.iterations; i++) {
+    auto scene = std::make_unique<Scene>();
+    SceneFile::Load(path.c_str(), *scene, {SceneColumn::Of<MeshRef>(1)});
+    if (update) scene->UpdateTransforms();
+    DoNotOptimize(scene->GetNodeCount());
+  }
+}
+
+SN_BENCHMARK("SceneFile/Load/1M nodes mapped") { BenchLoad(state, false); }
+SN_BENCHMARK("SceneFile/Load/1M nodes mapped + UpdateTransforms") { BenchLoad(state, true); }
@@ -0,0 +1,54 @@
+#include "bench.h"
+#include <core/animation/tween_system.h>
+#include <core/common/time.h>
+#include <core/math/math.h>
+
+// A frame of UI and camera animation: kTweenCount values, each read once per frame
+constexpr usize kTweenCount = 512;
+
+// --------------------------------------------------------------------------------
+static Ease BenchEase(usize i) {
+  constexpr Ease eases[] = {Ease::OUT_CUBIC, Ease::IN_OUT_SINE, Ease::OUT_BACK, Ease::OUT_EXPO};
+  return eases[i % 4];
+}
+
+// What Interpolated<T> did before the tween system: a clock read and an easing call per read
+SN_BENCHMARK("Tween/512 values per frame/clock and easing per read") {
+  struct Value {
+    Sono::TransitionFn fn;
+    f32 startTime, speed, start, end;
+  };
+  std::vector<Value> values(kTweenCount);
+  const f32 now = Time::Now();
+  for (usize i = 0; i < kTweenCount; i++) {
+    values[i] = {Sono::GetEaseFunction(BenchEase(i)), now, 1e-3f, 0.0f, (f32)i};
+  }
+
+  state.itemsPerIteration = kTweenCount;
+  f32 sum = 0.0f;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (const Value &v : values) {
+      const f32 t = (Time::Now() - v.startTime) * v.speed;
+      sum += t >= 1.0f ? v.end : Sono::Lerp(v.start, v.end, v.fn(t));
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(sum);
+}
+
+SN_BENCHMARK("Tween/512 values per frame/TweenSystem Update and reads") {
+  TweenSystem tweens;
+  std::vector<TweenHandle> handles(kTweenCount);
+  for (usize i = 0; i < kTweenCount; i++) {
+    handles[i] = tweens.Start(0.0f, (f32)i, 1e6f, BenchEase(i));
+  }
+
+  state.itemsPerIteration = kTweenCount;
+  f32 sum = 0.0f;
+  for (u64 i = 0; i < state.iterations; i++) {
+    tweens.Update(1.0f / 60.0f);
+    for (TweenHandle h : handles) sum += tweens.GetValue<f32>(h);
+    ClobberMemory();
+  }
+  DoNotOptimize(sum);
+}
@@ -0,0 +1,179 @@
+#include "bench.h"
+#include "glm_compat.h"
+
+#include <random>
+
+constexpr usize kVectorCount = 1024;
+
+// --------------------------------------------------------------------------------
+static std::vector<Vec3> MakeVec3s(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-10.0f, 10.0f);
+  std::vector<Vec3> v(kVectorCount);
+  for (Vec3 &e : v) e = Vec3(dist(rng), dist(rng), dist(rng));
+  return v;
+}
+// --------------------------------------------------------------------------------
+static std::vector<Vec4> MakeVec4s(u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-10.0f, 10.0f);
+  std::vector<Vec4> v(kVectorCount);
+  for (Vec4 &e : v) e = Vec4(dist(rng), dist(rng), dist(rng), dist(rng));
+  return v;
+}
+// --------------------------------------------------------------------------------
+template <typename In, typename Out>
+static std::vector<Out> Convert(const std::vector<In> &in) {
+  std::vector<Out> out;
+  out.reserve(in.size());
+  for (const In &e : in) out.push_back(ToGlm(e));
+  return out;
+}
+// --------------------------------------------------------------------------------
+template <typename T, typename Fn>
+static void RunUnary(BenchState &state, const std::vector<T> &a, Fn &&fn) {
+  using R = decltype(fn(a[0]));
+  std::vector<R> out(a.size());
+  state.itemsPerIteration = a.size();
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < a.size(); i++) out[i] = fn(a[i]);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+// --------------------------------------------------------------------------------
+template <typename T, typename Fn>
+static void RunBinary(
+  BenchState &state, const std::vector<T> &a, const std::vector<T> &b, Fn &&fn
+) {
+  using R = decltype(fn(a[0], b[0]));
+  std::vector<R> out(a.size());
+  state.itemsPerIteration = a.size();
+  for (u64 it = 0; it < state.iterations; it++) {
+    for (usize i = 0; i < a.size(); i++) out[i] = fn(a[i], b[i]);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+// ================================================================================
+// Vec3
+// ================================================================================
+
+SN_BENCHMARK("Vec3/Add/Sono") {
+  RunBinary(state, MakeVec3s(1), MakeVec3s(2), [](const Vec3 &a, const Vec3 &b) { return a + b; });
+}
+
+SN_BENCHMARK("Vec3/Add/glm") {
+  RunBinary(
+    state, Convert<Vec3, glm::vec3>(MakeVec3s(1)), Convert<Vec3, glm::vec3>(MakeVec3s(2)),
+    [](const glm::vec3 &a, const glm::vec3 &b) { return a + b; }
+  );
+}
+
+SN_PARITY("Vec3/Add", 0) {
+  const std::vector<Vec3> a = MakeVec3s(1), b = MakeVec3s(2);
+  for (usize i = 0; i < a.size(); i++) parity.Compare(a[i] + b[i], ToGlm(a[i]) + ToGlm(b[i]));
+}
+
+SN_BENCHMARK("Vec3/Dot/Sono") {
+  RunBinary(state, MakeVec3s(1), MakeVec3s(2), [](const Vec3 &a, const Vec3 &b) {
+    return a.Dot(b);
+  });
+}
+
+SN_BENCHMARK("Vec3/Dot/glm") {
+  RunBinary(
+    state, Convert<Vec3, glm::vec3>(MakeVec3s(1)), Convert<Vec3, glm::vec3>(MakeVec3s(2)),
+    [](const glm::vec3 &a, const glm::vec3 &b) { return glm::dot(a, b); }
+  );
+}
+
+SN_PARITY("Vec3/Dot", 2) {
+  parity.absTolerance = 1e-4f;
+  const std::vector<Vec3> a = MakeVec3s(1), b = MakeVec3s(2);
+  for (usize i = 0; i < a.size(); i++) {
+    parity.Compare(a[i].Dot(b[i]), glm::dot(ToGlm(a[i]), ToGlm(b[i])));
+  }
+}
+
+SN_BENCHMARK("Vec3/Cross/Sono") {
+  RunBinary(state, MakeVec3s(1), MakeVec3s(2), [](const Vec3 &a, const Vec3 &b) {
+    return a.Cross(b);
+  });
+}
+
+SN_BENCHMARK("Vec3/Cross/glm") {
+  RunBinary(
+    state, Convert<Vec3, glm::vec3>(MakeVec3s(1)), Convert<Vec3, glm::vec3>(MakeVec3s(2)),
+    [](const glm::vec3 &a, const glm::vec3 &b) { return glm::cross(a, b); }
+  );
+}
+
+SN_PARITY("Vec3/Cross", 2) {
+  const std::vector<Vec3> a = MakeVec3s(1), b = MakeVec3s(2);
+  for (usize i = 0; i < a.size(); i++) {
+    parity.Compare(a[i].Cross(b[i]), glm::cross(ToGlm(a[i]), ToGlm(b[i])));
+  }
+}
+
+SN_BENCHMARK("Vec3/Normalize/Sono") {
+  RunUnary(state, MakeVec3s(1), [](const Vec3 &a) { return a.Normalized(); });
+}
+
+SN_BENCHMARK("Vec3/Normalize/glm") {
+  RunUnary(state, Convert<Vec3, glm::vec3>(MakeVec3s(1)), [](const glm::vec3 &a) {
+    return glm::normalize(a);
+  });
+}
+
+// Sono divides by the length while glm multiplies by its inverse square root
+SN_PARITY("Vec3/Normalize", 2) {
+  for (const Vec3 &v : MakeVec3s(1)) parity.Compare(v.Normalized(), glm::normalize(ToGlm(v)));
+}
+
+// ================================================================================
+// Vec4
+// ================================================================================
+
+SN_BENCHMARK("Vec4/MulAdd/Sono") {
+  RunBinary(state, MakeVec4s(1), MakeVec4s(2), [](const Vec4 &a, const Vec4 &b) {
+    return a * 0.5f + b;
+  });
+}
+
+SN_BENCHMARK("Vec4/MulAdd/glm") {
+  RunBinary(
+    state, Convert<Vec4, glm::vec4>(MakeVec4s(1)), Convert<Vec4, glm::vec4>(MakeVec4s(2)),
+    [](const glm::vec4 &a, const glm::vec4 &b) { return a * 0.5f + b; }
+  );
+}
+
+SN_PARITY("Vec4/MulAdd", 0) {
+  const std::vector<Vec4> a = MakeVec4s(1), b = MakeVec4s(2);
+  for (usize i = 0; i < a.size(); i++) {
+    parity.Compare(a[i] * 0.5f + b[i], ToGlm(a[i]) * 0.5f + ToGlm(b[i]));
+  }
+}
+
+SN_BENCHMARK("Vec4/Dot/Sono") {
+  RunBinary(state, MakeVec4s(1), MakeVec4s(2), [](const Vec4 &a, const Vec4 &b) {
+    return a.Dot(b);
+  });
+}
+
+SN_BENCHMARK("Vec4/Dot/glm") {
+  RunBinary(
+    state, Convert<Vec4, glm::vec4>(MakeVec4s(1)), Convert<Vec4, glm::vec4>(MakeVec4s(2)),
+    [](const glm::vec4 &a, const glm::vec4 &b) { return glm::dot(a, b); }
+  );
+}
+
+// glm sums the four products pairwise, Sono left to right, so cancellation differs between them
+SN_PARITY("Vec4/Dot", 2) {
+  parity.absTolerance = 1e-4f;
+  const std::vector<Vec4> a = MakeVec4s(1), b = MakeVec4s(2);
+  for (usize i = 0; i < a.size(); i++) {
+    parity.Compare(a[i].Dot(b[i]), glm::dot(ToGlm(a[i]), ToGlm(b[i])));
+  }
+}
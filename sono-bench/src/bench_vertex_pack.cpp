@@ -0,0 +1,78 @@
+#include "bench.h"
+#include <core/math/batch.h>
+#include <core/math/half.h>
+#include <core/math/quantize.h>
+#include <render/vertex_pack.h>
+#include <render/vertex_type.h>
+
+#include <cstring>
+#include <random>
+
+// A mesh of kVertexCount VertexPNT (32 bytes) packed to FLOAT3 position, octahedral SHORT2_SNORM
+// normal and HALF2 texcoord (20 bytes)
+constexpr usize kVertexCount = 100000;
+
+// --------------------------------------------------------------------------------
+static std::vector<VertexPNT> MakeVertices() {
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<VertexPNT> vertices(kVertexCount);
+  for (VertexPNT &v : vertices) {
+    Vec3 n(dist(rng), dist(rng), dist(rng));
+    n.Normalize();
+    v = VertexPNT(Vec3(dist(rng), dist(rng), dist(rng)) * 10.0f, n, Vec2(dist(rng), dist(rng)));
+  }
+  return vertices;
+}
+// --------------------------------------------------------------------------------
+static VertexLayout CompactLayout() {
+  return VertexLayout()
+    .Push(VAS_POSITION, VAT_FLOAT3)
+    .Push(VAS_NORMAL, VAT_SHORT2_SNORM)
+    .Push(VAS_TEXCOORD, VAT_HALF2);
+}
+// --------------------------------------------------------------------------------
+static void BenchRepack(BenchState &state, Sono::SimdLevel level) {
+  const Sono::SimdLevel initial = Sono::GetSimdLevel();
+  if (!Sono::SetSimdLevel(level)) {
+    state.skipped = true;
+    return;
+  }
+  const std::vector<VertexPNT> vertices = MakeVertices();
+  const VertexLayout source = VertexTraits<VertexPNT>::GetLayout(), compact = CompactLayout();
+  std::vector<u8> out(kVertexCount * compact.GetStride());
+  state.itemsPerIteration = kVertexCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    Sono::RepackVertices(vertices.data(), source, kVertexCount, out.data(), compact);
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+  Sono::SetSimdLevel(initial);
+}
+
+// The same packing written per vertex with the scalar codecs
+SN_BENCHMARK("VertexPack/100k VertexPNT/per vertex loop") {
+  const std::vector<VertexPNT> vertices = MakeVertices();
+  constexpr usize kStride = 20;
+  std::vector<u8> out(kVertexCount * kStride);
+  state.itemsPerIteration = kVertexCount;
+  for (u64 i = 0; i < state.iterations; i++) {
+    for (usize j = 0; j < kVertexCount; j++) {
+      const VertexPNT &v = vertices[j];
+      u8 *p = out.data() + j * kStride;
+      i16 normal[2];
+      Sono::EncodeOctahedral(Vec3(v.normal[0], v.normal[1], v.normal[2]), normal);
+      const u16 uv[2] = {Sono::FloatToHalf(v.texCoords[0]), Sono::FloatToHalf(v.texCoords[1])};
+      std::memcpy(p, v.position, 12);
+      std::memcpy(p + 12, normal, 4);
+      std::memcpy(p + 16, uv, 4);
+    }
+    ClobberMemory();
+  }
+  DoNotOptimize(out.data());
+}
+
+SN_BENCHMARK("VertexPack/100k VertexPNT/scalar") { BenchRepack(state, Sono::SimdLevel::SCALAR); }
+SN_BENCHMARK("VertexPack/100k VertexPNT/sse2") { BenchRepack(state, Sono::SimdLevel::SSE2); }
+SN_BENCHMARK("VertexPack/100k VertexPNT/avx2") { BenchRepack(state, Sono::SimdLevel::AVX2); }
+SN_BENCHMARK("VertexPack/100k VertexPNT/avx512") { BenchRepack(state, Sono::SimdLevel::AVX512); }
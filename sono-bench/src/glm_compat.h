@@ -0,0 +1,29 @@
+#ifndef SN_BENCH_GLM_COMPAT_H
+#define SN_BENCH_GLM_COMPAT_H
+
+#include <core/math/mat4.h>
+#include <core/math/quaternion.h>
+#include <core/math/vec3.h>
+#include <core/math/vec4.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// Sono matrices are row major with row vectors and glm is column major with column vectors, so
+// the same 16 floats hold the same transform: Sono n[i][j] == glm m[i][j]. A Sono product A * B
+// is glm B * A, v * M is glm M * v and M * v is glm v * M. Quaternions only differ in member
+// order.
+
+// --------------------------------------------------------------------------------
+inline glm::vec3 ToGlm(const Vec3 &v) { return glm::vec3(v.x, v.y, v.z); }
+// --------------------------------------------------------------------------------
+inline glm::vec4 ToGlm(const Vec4 &v) { return glm::vec4(v.x, v.y, v.z, v.w); }
+// --------------------------------------------------------------------------------
+inline glm::mat4 ToGlm(const Mat4 &m) { return glm::make_mat4(m.ValuePtr()); }
+// --------------------------------------------------------------------------------
+inline glm::quat ToGlm(const Quaternion &q) { return glm::quat(q.w, q.x, q.y, q.z); }
+// --------------------------------------------------------------------------------
+inline Quaternion FromGlm(const glm::quat &q) { return Quaternion(q.w, q.x, q.y, q.z); }
+
+#endif // !SN_BENCH_GLM_COMPAT_H
@@ -0,0 +1,248 @@
+#include "bench.h"
+#include "bench_commit.h"
+#include <core/math/batch.h>
+#include <core/math/simd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using BenchClock = std::chrono::steady_clock;
+
+constexpr f64 kMinBenchSeconds = 0.2;
+constexpr u32 kRepetitions = 5;
+
+// --------------------------------------------------------------------------------
+static f64 RunOnce(const BenchCase &bench, BenchState &state) {
+  auto start = BenchClock::now();
+  bench.fn(state);
+  return std::chrono::duration<f64>(BenchClock::now() - start).count();
+}
+// --------------------------------------------------------------------------------
+static BenchResult RunBench(const BenchCase &bench) {
+  // Grow the iteration count until a single run is long enough to time reliably
+  BenchState state{1};
+  f64 seconds = RunOnce(bench, state);
+  if (state.skipped) return BenchResult{bench.name, 0, 0.0, 0.0, true};
+
+  while (seconds < kMinBenchSeconds && state.iterations < (1ull << 40)) {
+    const f64 scale = seconds > 0.0 ? std::min(10.0, 1.4 * kMinBenchSeconds / seconds) : 10.0;
+    state.iterations = std::max<u64>(state.iterations + 1, (u64)(state.iterations * scale));
+    seconds = RunOnce(bench, state);
+  }
+
+  // Report the best of a few repetitions to filter out scheduler noise
+  f64 best = seconds;
+  for (u32 i = 1; i < kRepetitions; i++) {
+    best = std::min(best, RunOnce(bench, state));
+  }
+
+  BenchResult result;
+  result.name = bench.name;
+  result.iterations = state.iterations;
+  result.nsPerIteration = best * 1e9 / (f64)state.iterations;
+  result.nsPerItem = result.nsPerIteration / (f64)std::max<u64>(1, state.itemsPerIteration);
+  result.skipped = false;
+  return result;
+}
+// --------------------------------------------------------------------------------
+/// Benchmarks named "<base> <n> thread(s)" form a thread sweep, every n > 1 is compared against
+/// the "<base> 1 thread" run. Efficiency is speedup / n, 1.0 being linear scaling.
+static std::vector<ScalingResult> ComputeScaling(const std::vector<BenchResult> &benches) {
+  std::vector<ScalingResult> scaling;
+  for (const BenchResult &r : benches) {
+    if (r.skipped) continue;
+    const usize suffix = r.name.rfind(" thread");
+    if (suffix == std::string::npos || suffix == 0) continue;
+    const std::string tail = r.name.substr(suffix);
+    if (tail != " thread" && tail != " threads") continue;
+    const usize space = r.name.rfind(' ', suffix - 1);
+    if (space == std::string::npos) continue;
+
+    const u32 threads = (u32)std::strtoul(r.name.c_str() + space + 1, nullptr, 10);
+    if (threads <= 1) continue;
+    const std::string serial = r.name.substr(0, space) + " 1 thread";
+    auto base = std::find_if(benches.begin(), benches.end(), [&serial](const BenchResult &b) {
+      return !b.skipped && b.name == serial;
+    });
+    if (base == benches.end()) continue;
+
+    const f64 speedup = base->nsPerIteration / r.nsPerIteration;
+    scaling.push_back({r.name, threads, speedup, speedup / (f64)threads});
+  }
+  return scaling;
+}
+// --------------------------------------------------------------------------------
+static ParityResult RunParity(const ParityCase &check) {
+  ParityResult result{check.name, ParityState{check.ulpTolerance}, false};
+  check.fn(result.state);
+  result.passed = result.state.components > 0 && result.state.failures == 0;
+  return result;
+}
+// --------------------------------------------------------------------------------
+static const char *CompilerName() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc";
+#else
+  return "unknown";
+#endif
+}
+// --------------------------------------------------------------------------------
+static void WriteJson(
+  std::ostream &out, const std::vector<BenchResult> &benches,
+  const std::vector<ScalingResult> &scaling, const std::vector<ParityResult> &parities
+) {
+  // Benchmark names are plain ascii paths, nothing in them needs escaping
+  out << "{\n"
+      << "  \"commit\": \"" << SN_BENCH_GIT_COMMIT << "\",\n"
+      << "  \"compiler\": \"" << CompilerName() << "\",\n"
+      << "  \"simd\": \"" << Sono::Simd::BACKEND_NAME << "\",\n"
+      << "  \"batchSimd\": \"" << Sono::ToString(Sono::GetSimdLevel()) << "\",\n"
+      << "  \"benchmarks\": [";
+  for (usize i = 0; i < benches.size(); i++) {
+    const BenchResult &r = benches[i];
+    // clang-format off
+    out << (i ? "," : "") << "\n    {"
+        << "\"name\": \"" << r.name << "\", "
+        << "\"skipped\": " << (r.skipped ? "true" : "false") << ", "
+        << "\"iterations\": " << r.iterations << ", "
+        << "\"nsPerIteration\": " << r.nsPerIteration << ", "
+        << "\"nsPerItem\": " << r.nsPerItem
+        << "}";
+    // clang-format on
+  }
+  out << "\n  ],\n  \"scaling\": [";
+  for (usize i = 0; i < scaling.size(); i++) {
+    const ScalingResult &r = scaling[i];
+    // clang-format off
+    out << (i ? "," : "") << "\n    {"
+        << "\"name\": \"" << r.name << "\", "
+        << "\"threads\": " << r.threads << ", "
+        << "\"speedup\": " << r.speedup << ", "
+        << "\"efficiency\": " << r.efficiency
+        << "}";
+    // clang-format on
+  }
+  out << "\n  ],\n  \"parity\": [";
+  for (usize i = 0; i < parities.size(); i++) {
+    const ParityResult &r = parities[i];
+    // clang-format off
+    out << (i ? "," : "") << "\n    {"
+        << "\"name\": \"" << r.name << "\", "
+        << "\"passed\": " << (r.passed ? "true" : "false") << ", "
+        << "\"components\": " << r.state.components << ", "
+        << "\"bitwiseEqual\": " << r.state.bitwiseEqual << ", "
+        << "\"failures\": " << r.state.failures << ", "
+        << "\"maxUlp\": " << r.state.maxUlp << ", "
+        << "\"ulpTolerance\": " << r.state.ulpTolerance << ", "
+        << "\"maxAbsError\": " << r.state.maxAbsError
+        << "}";
+    // clang-format on
+  }
+  out << "\n  ]\n}\n";
+}
+// --------------------------------------------------------------------------------
+static void PrintUsage() {
+  std::printf(
+    "usage: SonoBench [filter] [--json <file|->] [--parity-only]\n"
+    "  filter         only run benchmarks and parity checks whose name contains it\n"
+    "  --json <file>  write the results as json, '-' prints them to stdout instead of the table\n"
+    "  --parity-only  skip the timed benchmarks\n"
+  );
+}
+// --------------------------------------------------------------------------------
+i32 main(i32 argc, char **argv) {
+  const char *filter = nullptr;
+  const char *jsonPath = nullptr;
+  b8 parityOnly = false;
+
+  for (i32 i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+      jsonPath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--parity-only")) {
+      parityOnly = true;
+    } else if (argv[i][0] == '-') {
+      PrintUsage();
+      return 1;
+    } else {
+      filter = argv[i];
+    }
+  }
+  // The table goes to stdout unless stdout carries the json
+  const b8 printTable = !jsonPath || std::strcmp(jsonPath, "-") != 0;
+
+  std::vector<BenchResult> benches;
+  if (!parityOnly) {
+    if (printTable) {
+      std::printf("%-56s %14s %14s %14s\n", "Benchmark", "Iterations", "ns/iter", "ns/item");
+      std::printf("%s\n", std::string(101, '-').c_str());
+    }
+
+    for (const BenchCase &bench : BenchRegistry::Get()) {
+      if (filter && !std::strstr(bench.name, filter)) continue;
+      const BenchResult &r = benches.emplace_back(RunBench(bench));
+      if (!printTable) continue;
+      if (r.skipped) {
+        std::printf("%-56s %14s\n", r.name.c_str(), "skipped");
+        continue;
+      }
+      std::printf(
+        "%-56s %14llu %14.2f %14.3f\n", r.name.c_str(), (unsigned long long)r.iterations,
+        r.nsPerIteration, r.nsPerItem
+      );
+    }
+  }
+
+  const std::vector<ScalingResult> scaling = ComputeScaling(benches);
+  if (printTable && !scaling.empty()) {
+    std::printf("\n%-56s %14s %14s %14s\n", "Thread scaling", "threads", "speedup", "efficiency");
+    std::printf("%s\n", std::string(101, '-').c_str());
+    for (const ScalingResult &r : scaling) {
+      std::printf(
+        "%-56s %14u %13.2fx %13.1f%%\n", r.name.c_str(), r.threads, r.speedup,
+        100.0 * r.efficiency
+      );
+    }
+  }
+
+  std::vector<ParityResult> parities;
+  u32 failed = 0;
+  if (printTable) {
+    std::printf("\n%-56s %14s %14s %14s\n", "Parity vs glm", "bitwise", "max ulp", "max abs");
+    std::printf("%s\n", std::string(101, '-').c_str());
+  }
+  for (const ParityCase &check : ParityRegistry::Get()) {
+    if (filter && !std::strstr(check.name, filter)) continue;
+    const ParityResult &r = parities.emplace_back(RunParity(check));
+    failed += !r.passed;
+    if (!printTable) continue;
+    std::printf(
+      "%-56s %13.1f%% %14u %14.3g%s\n", r.name.c_str(),
+      100.0 * (f64)r.state.bitwiseEqual / (f64)std::max<u64>(1, r.state.components),
+      r.state.maxUlp, r.state.maxAbsError, r.passed ? "" : "  FAILED"
+    );
+  }
+
+  if (jsonPath) {
+    if (!std::strcmp(jsonPath, "-")) {
+      WriteJson(std::cout, benches, scaling, parities);
+    } else {
+      std::ofstream file(jsonPath);
+      if (!file.is_open()) {
+        std::fprintf(stderr, "could not open %s\n", jsonPath);
+        return 1;
+      }
+      WriteJson(file, benches, scaling, parities);
+    }
+  }
+
+  // A parity regression fails the run so CI can gate on it
+  return failed ? 2 : 0;
+}
@@ -3,6 +3,7 @@
 #include <core/common/logger.h>
 #include <core/common/time.h>
 #include <core/global.h>
+#include <core/math/bounds.h>
 #include <core/math/mat4.h>
 #include <core/math/transform.h>
 #include <core/math/vec3.h>
@@ -277,13 +278,21 @@ public:
       g_RenderSys->Submit<SetUniformCommand<Vec3>>("uLight.specular", lightColor);
       g_RenderSys->Submit<SetUniformCommand<Mat4>>("uProj", cam.GetProjectionMatrix());
       g_RenderSys->Submit<SetUniformCommand<Mat4>>("uView", cam.GetViewMatrix());
-      g_RenderSys->Submit<DrawIndexedCommand>(
-        cubeMesh.pVertexArray,
-        0,
-        cubeMesh.pIndexBuffer->GetCount(),
-        cubeTransform.GetModelMatrix()
-      );
+      // Cubes outside the view never reach the command queue
+      const Frustum &frustum = cam.GetFrustum();
+      const BoundingSphere cubeBounds = BoundingSphere::FromAABB(AABB(Vec3(-0.5f), Vec3(0.5f)));
+      if (frustum.Intersects(cubeBounds.Transformed(cubeTransform.GetModelMatrix()))) {
+        g_RenderSys->Submit<DrawIndexedCommand>(
+          cubeMesh.pVertexArray,
+          0,
+          cubeMesh.pIndexBuffer->GetCount(),
+          cubeTransform.GetModelMatrix()
+        );
+      }
       for (int i = 0; i < 40; ++i) {
+        if (!frustum.Intersects(cubeBounds.Transformed(cubeTransforms[i].GetModelMatrix()))) {
+          continue;
+        }
         g_RenderSys->Submit<DrawIndexedCommand>(
           cubeMesh.pVertexArray,
           0,
@@ -312,6 +321,13 @@ public:
   void OnImGuiFrame() override {
     if (ImGui::Begin("Debug")) {
       ImGui::Text("FPS: %.0f", Time::GetFPS());
+#ifdef SN_DEBUG_PROFILER
+      const Sono::Profiler &profiler = Sono::Profiler::Get();
+      ImGui::Text(
+        "Input latency p50/p99: %.2f / %.2f ms", profiler.GetCounter(INPUT_LATENCY_P50),
+        profiler.GetCounter(INPUT_LATENCY_P99)
+      );
+#endif
       ImGui::Text("Frame Data");
       const ArenaAllocator &frameAlloc = g_RenderSys->GetFrameAllocator();
       float progress = ((f32)frameAlloc.GetMarker() / (f32)frameAlloc.GetSize());
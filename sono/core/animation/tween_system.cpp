@@ -0,0 +1,169 @@
+#include "tween_system.h"
+#include "core/math/batch.h"
+#include <algorithm>
+
+// --------------------------------------------------------------------------------
+void TweenSystem::Shutdown() {
+  System::Shutdown();
+  for (Pool &pool : m_Pools) pool = Pool();
+  m_Slots.clear();
+  m_FreeSlots.clear();
+}
+// --------------------------------------------------------------------------------
+TweenHandle TweenSystem::StartComponents(
+  const f32 *from, const f32 *to, f32 duration, Ease ease
+) {
+  SN_ASSERT(ease < Ease::COUNT, "Unknown easing curve");
+  u32 index;
+  if (!m_FreeSlots.empty()) {
+    index = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+  } else {
+    index = (u32)m_Slots.size();
+    m_Slots.emplace_back();
+  }
+
+  Slot &slot = m_Slots[index];
+  slot.alive = true;
+  slot.ease = ease;
+  slot.duration = duration;
+  const TweenHandle handle{index, slot.generation};
+  RestartComponents(handle, from, to);
+  return handle;
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::RestartComponents(TweenHandle handle, const f32 *from, const f32 *to) {
+  SN_ASSERT(IsAlive(handle), "Stale tween handle");
+  Slot &slot = m_Slots[handle.index];
+  std::copy(to, to + 4, slot.target);
+  if (slot.position != NOT_RUNNING) Stop(m_Pools[(u32)slot.ease], slot.position);
+  slot.elapsed = 0.0f;
+  if (slot.duration > 0.0f) {
+    Run(handle.index, from);
+  } else {
+    slot.elapsed = slot.duration;
+  }
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::ReadValue(TweenHandle handle, f32 *out) const {
+  const Slot &slot = GetSlot(handle);
+  if (slot.position == NOT_RUNNING) {
+    std::copy(slot.target, slot.target + 4, out);
+    return;
+  }
+  const Pool &pool = m_Pools[(u32)slot.ease];
+  for (u32 c = 0; c < 4; c++) out[c] = pool.value[c][slot.position];
+}
+// --------------------------------------------------------------------------------
+const TweenSystem::Slot &TweenSystem::GetSlot(TweenHandle handle) const {
+  SN_ASSERT(IsAlive(handle), "Stale tween handle");
+  return m_Slots[handle.index];
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::SetDuration(TweenHandle handle, f32 durationInSec) {
+  SN_ASSERT(IsAlive(handle), "Stale tween handle");
+  Slot &slot = m_Slots[handle.index];
+  slot.duration = durationInSec;
+  if (slot.position == NOT_RUNNING) return;
+
+  Pool &pool = m_Pools[(u32)slot.ease];
+  if (durationInSec > 0.0f) {
+    pool.invDuration[slot.position] = 1.0f / durationInSec;
+  } else {
+    Stop(pool, slot.position);
+  }
+}
+// --------------------------------------------------------------------------------
+f32 TweenSystem::GetElapsed(TweenHandle handle) const {
+  const Slot &slot = GetSlot(handle);
+  if (slot.position == NOT_RUNNING) return slot.elapsed;
+  return m_Pools[(u32)slot.ease].elapsed[slot.position];
+}
+// --------------------------------------------------------------------------------
+b8 TweenSystem::IsAlive(TweenHandle handle) const {
+  return handle.index < m_Slots.size() && m_Slots[handle.index].alive &&
+    m_Slots[handle.index].generation == handle.generation;
+}
+// --------------------------------------------------------------------------------
+b8 TweenSystem::IsRunning(TweenHandle handle) const {
+  return GetSlot(handle).position != NOT_RUNNING;
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::Release(TweenHandle handle) {
+  if (!IsAlive(handle)) return;
+  Slot &slot = m_Slots[handle.index];
+  if (slot.position != NOT_RUNNING) Stop(m_Pools[(u32)slot.ease], slot.position);
+  slot.alive = false;
+  slot.generation = slot.generation + 1 == 0 ? 1 : slot.generation + 1;
+  m_FreeSlots.push_back(handle.index);
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::Update(f32 dt) {
+  for (u32 e = 0; e < EASE_COUNT; e++) {
+    Pool &pool = m_Pools[e];
+    const usize count = pool.slots.size();
+    if (count == 0) continue;
+
+    f32 *elapsed = pool.elapsed.data();
+    const f32 *invDuration = pool.invDuration.data();
+    f32 *eased = pool.eased.data();
+    for (usize i = 0; i < count; i++) {
+      elapsed[i] += dt;
+      eased[i] = std::min(elapsed[i] * invDuration[i], 1.0f);
+    }
+    Sono::EvaluateEase((Ease)e, eased, count, eased);
+    for (u32 c = 0; c < 4; c++) {
+      const f32 *from = pool.from[c].data(), *to = pool.to[c].data();
+      f32 *value = pool.value[c].data();
+      for (usize i = 0; i < count; i++) value[i] = from[i] + (to[i] - from[i]) * eased[i];
+    }
+
+    // Walking backwards, whatever Stop moves into place i was already visited and is running
+    for (usize i = count; i-- > 0;) {
+      if (elapsed[i] * invDuration[i] >= 1.0f) Stop(pool, (u32)i);
+    }
+  }
+}
+// --------------------------------------------------------------------------------
+usize TweenSystem::GetRunningCount() const {
+  usize count = 0;
+  for (const Pool &pool : m_Pools) count += pool.slots.size();
+  return count;
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::Run(u32 slotIndex, const f32 *from) {
+  Slot &slot = m_Slots[slotIndex];
+  Pool &pool = m_Pools[(u32)slot.ease];
+  slot.position = (u32)pool.slots.size();
+  pool.slots.push_back(slotIndex);
+  pool.elapsed.push_back(0.0f);
+  pool.invDuration.push_back(1.0f / slot.duration);
+  pool.eased.push_back(0.0f);
+  for (u32 c = 0; c < 4; c++) {
+    pool.from[c].push_back(from[c]);
+    pool.to[c].push_back(slot.target[c]);
+    pool.value[c].push_back(from[c]);
+  }
+}
+// --------------------------------------------------------------------------------
+void TweenSystem::Stop(Pool &pool, u32 position) {
+  Slot &slot = m_Slots[pool.slots[position]];
+  slot.elapsed = pool.elapsed[position];
+  slot.position = NOT_RUNNING;
+
+  const u32 last = (u32)pool.slots.size() - 1;
+  if (position != last) m_Slots[pool.slots[last]].position = position;
+  auto moveLast = [&](auto &v) {
+    v[position] = v[last];
+    v.pop_back();
+  };
+  moveLast(pool.slots);
+  moveLast(pool.elapsed);
+  moveLast(pool.invDuration);
+  moveLast(pool.eased);
+  for (u32 c = 0; c < 4; c++) {
+    moveLast(pool.from[c]);
+    moveLast(pool.to[c]);
+    moveLast(pool.value[c]);
+  }
+}
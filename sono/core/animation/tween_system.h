@@ -0,0 +1,164 @@
+#ifndef SN_TWEEN_SYSTEM_H
+#define SN_TWEEN_SYSTEM_H
+
+#include <core/common/singleton.h>
+#include <core/common/types.h>
+#include <core/math/ease.h>
+#include <core/system.h>
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/// @brief Refers to one tween of the TweenSystem. Stale handles (released tweens) are caught by
+/// the generation check, a default constructed handle is never valid.
+struct TweenHandle {
+  u32 index = 0;
+  u32 generation = 0;
+
+  constexpr b8 IsValid() const { return generation != 0; }
+};
+
+/// Values that tween component wise: f32, Vec2, Vec3, Vec4 and other plain groups of up to four
+/// floats. Not meant for rotations, a component wise quaternion lerp does not keep unit length.
+template <typename T>
+constexpr b8 IS_TWEENABLE = std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(f32) == 0 &&
+  sizeof(T) <= 4 * sizeof(f32);
+
+/// @brief Owns every running animation. Tweens are kept in one structure of arrays pool per
+/// easing curve and all of them advance in Update, once per frame: a clamp loop, one batch easing
+/// call (Sono::EvaluateEase) and a lerp loop per component, whatever the number of tweens.
+/// Reading a value is an index lookup, no clock read and no easing call.
+///
+/// A finished tween leaves its pool and holds its end value until Release, so callers can keep
+/// reading it. Release every handle that is no longer needed, the slot is reused afterwards.
+class TweenSystem
+  : public Singleton<TweenSystem>
+  , public System {
+public:
+  TweenSystem() = default;
+
+  ~TweenSystem() = default;
+
+  const char *GetName() const override { return "TweenSystem"; }
+
+  void Shutdown() override;
+
+  /// @brief Animate from -> to over durationInSec seconds. A duration of zero or less finishes
+  /// at once.
+  template <typename T>
+  TweenHandle Start(const T &from, const T &to, f32 durationInSec, Ease ease = Ease::LINEAR) {
+    static_assert(IS_TWEENABLE<T>);
+    f32 a[4], b[4];
+    ToComponents(from, a);
+    ToComponents(to, b);
+    return StartComponents(a, b, durationInSec, ease);
+  }
+
+  /// @brief Run the tween again from -> to, with its duration and curve
+  template <typename T>
+  void Restart(TweenHandle handle, const T &from, const T &to) {
+    static_assert(IS_TWEENABLE<T>);
+    f32 a[4], b[4];
+    ToComponents(from, a);
+    ToComponents(to, b);
+    RestartComponents(handle, a, b);
+  }
+
+  /// @brief Head for to from wherever the tween is now
+  template <typename T>
+  void Retarget(TweenHandle handle, const T &to) {
+    Restart(handle, GetValue<T>(handle), to);
+  }
+
+  template <typename T>
+  T GetValue(TweenHandle handle) const {
+    static_assert(IS_TWEENABLE<T>);
+    f32 v[4];
+    ReadValue(handle, v);
+    return FromComponents<T>(v);
+  }
+
+  template <typename T>
+  T GetTarget(TweenHandle handle) const {
+    static_assert(IS_TWEENABLE<T>);
+    return FromComponents<T>(GetSlot(handle).target);
+  }
+
+  /// @brief Takes effect from the next Update, the elapsed time is kept
+  void SetDuration(TweenHandle handle, f32 durationInSec);
+
+  f32 GetElapsed(TweenHandle handle) const;
+
+  /// @brief Whether handle still refers to a tween, running or finished
+  b8 IsAlive(TweenHandle handle) const;
+
+  b8 IsRunning(TweenHandle handle) const;
+
+  /// @brief Free the tween, handle is stale afterwards. Releasing a stale handle does nothing.
+  void Release(TweenHandle handle);
+
+  /// @brief Advance every running tween by dt seconds
+  void Update(f32 dt);
+
+  usize GetRunningCount() const;
+
+private:
+  static constexpr u32 NOT_RUNNING = ~0u;
+  static constexpr u32 EASE_COUNT = (u32)Ease::COUNT;
+
+  struct Slot {
+    u32 generation = 1;
+    u32 position = NOT_RUNNING; // index in the pool of its curve
+    f32 duration = 0.0f;
+    f32 elapsed = 0.0f;         // only kept here once finished, the pool owns it while running
+    Ease ease = Ease::LINEAR;
+    b8 alive = false;
+    f32 target[4] = {};
+  };
+
+  /// Running tweens of one curve, index i of every array is the same tween
+  struct Pool {
+    std::vector<f32> elapsed;
+    std::vector<f32> invDuration;
+    std::vector<f32> eased;
+    std::vector<f32> from[4];
+    std::vector<f32> to[4];
+    std::vector<f32> value[4];
+    std::vector<u32> slots;
+  };
+
+  template <typename T>
+  static void ToComponents(const T &v, f32 *out) {
+    out[0] = out[1] = out[2] = out[3] = 0.0f;
+    std::memcpy(out, &v, sizeof(T));
+  }
+
+  template <typename T>
+  static T FromComponents(const f32 *v) {
+    T out;
+    std::memcpy(&out, v, sizeof(T));
+    return out;
+  }
+
+  TweenHandle StartComponents(const f32 *from, const f32 *to, f32 duration, Ease ease);
+
+  void RestartComponents(TweenHandle handle, const f32 *from, const f32 *to);
+
+  void ReadValue(TweenHandle handle, f32 *out) const;
+
+  const Slot &GetSlot(TweenHandle handle) const;
+
+  /// Add the tween in slotIndex to its pool at elapsed time zero
+  void Run(u32 slotIndex, const f32 *from);
+
+  /// Take the tween at position out of pool, the last one moves into its place
+  void Stop(Pool &pool, u32 position);
+
+private:
+  Pool m_Pools[EASE_COUNT];
+  std::vector<Slot> m_Slots;
+  std::vector<u32> m_FreeSlots;
+};
+
+#endif // !SN_TWEEN_SYSTEM_H
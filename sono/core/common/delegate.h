@@ -0,0 +1,119 @@
+#ifndef SN_DELEGATE_H
+#define SN_DELEGATE_H
+
+#include "types.h"
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, usize Capacity = 32>
+class Delegate;
+
+/// @brief Type-erased callable stored inline (no heap allocation).
+///
+/// Callables larger than Capacity are rejected at compile time. Trivially copyable
+/// callables (lambdas capturing pointers/PODs) are moved with a plain memcpy.
+template <typename R, typename... Args, usize Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+  Delegate() = default;
+
+  template <typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, Delegate>>>
+  Delegate(Fn &&fn) {
+    using F = std::decay_t<Fn>;
+    static_assert(sizeof(F) <= Capacity, "Callable does not fit in the delegate storage");
+    static_assert(alignof(F) <= alignof(std::max_align_t), "Callable is over-aligned");
+    static_assert(std::is_nothrow_move_constructible_v<F>, "Callable must be nothrow movable");
+
+    ::new (static_cast<void *>(m_Storage)) F(std::forward<Fn>(fn));
+    m_Invoke = [](void *storage, Args... args) -> R {
+      return (*std::launder(reinterpret_cast<F *>(storage)))(std::forward<Args>(args)...);
+    };
+    if constexpr (!(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>)) {
+      m_Manage = [](Op op, void *dst, void *src) {
+        F *from = std::launder(reinterpret_cast<F *>(src));
+        switch (op) {
+          case Op::MOVE:
+            ::new (dst) F(std::move(*from));
+            from->~F();
+            break;
+          case Op::COPY:
+            ::new (dst) F(*from);
+            break;
+          case Op::DESTROY:
+            from->~F();
+            break;
+        }
+      };
+    }
+  }
+
+  Delegate(const Delegate &other) { CopyFrom(other); }
+
+  Delegate(Delegate &&other) noexcept { MoveFrom(other); }
+
+  Delegate &operator=(const Delegate &other) {
+    if (this != &other) {
+      Reset();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+
+  Delegate &operator=(Delegate &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~Delegate() { Reset(); }
+
+  R operator()(Args... args) const {
+    return m_Invoke(const_cast<u8 *>(m_Storage), std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const { return m_Invoke != nullptr; }
+
+  void Reset() {
+    if (m_Manage) m_Manage(Op::DESTROY, nullptr, m_Storage);
+    m_Invoke = nullptr;
+    m_Manage = nullptr;
+  }
+
+private:
+  enum class Op : u8 { MOVE, COPY, DESTROY };
+
+  void CopyFrom(const Delegate &other) {
+    if (!other.m_Invoke) return;
+    if (other.m_Manage) {
+      other.m_Manage(Op::COPY, m_Storage, const_cast<u8 *>(other.m_Storage));
+    } else {
+      std::memcpy(m_Storage, other.m_Storage, Capacity);
+    }
+    m_Invoke = other.m_Invoke;
+    m_Manage = other.m_Manage;
+  }
+
+  void MoveFrom(Delegate &other) {
+    if (!other.m_Invoke) return;
+    if (other.m_Manage) {
+      other.m_Manage(Op::MOVE, m_Storage, other.m_Storage);
+    } else {
+      std::memcpy(m_Storage, other.m_Storage, Capacity);
+    }
+    m_Invoke = other.m_Invoke;
+    m_Manage = other.m_Manage;
+    other.m_Invoke = nullptr;
+    other.m_Manage = nullptr;
+  }
+
+private:
+  alignas(std::max_align_t) u8 m_Storage[Capacity];
+  R (*m_Invoke)(void *, Args...) = nullptr;
+  void (*m_Manage)(Op, void *, void *) = nullptr;
+};
+
+#endif // !SN_DELEGATE_H
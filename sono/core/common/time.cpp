@@ -21,9 +21,18 @@ void Time::Tick() {
 
 f32 Time::DeltaTime() { return m_DeltaTime; }
 
+void Time::SetDeltaTime(f32 dt) { m_DeltaTime = dt; }
+
 /// return the curent time fragment in seconds
 f32 Time::Now() { return Duration(HiResClock::now() - m_StartTime).count(); }
 
+u64 Time::Ticks() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()
+  )
+    .count();
+}
+
 f32 Time::TotalTime() { return m_TotalTime; }
 
 u64 Time::FrameCount() { return m_FrameCount; }
@@ -13,8 +13,14 @@ public:
 
   static f32 Now();
 
+  /// @brief Monotonic clock reading in nanoseconds, safe to call from any thread
+  static u64 Ticks();
+
   static f32 DeltaTime();
 
+  /// @brief Override the delta time of the current frame (input replay reuses recorded steps)
+  static void SetDeltaTime(f32 dt);
+
   static f32 TotalTime();
 
   static u64 FrameCount();
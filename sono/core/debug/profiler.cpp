@@ -29,12 +29,14 @@ void Profiler::Init() {}
 void Profiler::Shutdown() { m_SessionAlloc.FreeInternalBuffer(); };
 
 void Profiler::BeginSession() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   for (auto *sink : m_Sinks) {
     sink->WriteHeader();
   }
 }
 // --------------------------------------------------------------------------------
 void Profiler::Record(const ProfileEvent &event) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   for (auto *sink : m_Sinks) {
     sink->WriteEvent(event);
   }
@@ -46,7 +48,23 @@ void Profiler::Record(const ProfileEvent &event) {
   }
 }
 // --------------------------------------------------------------------------------
+void Profiler::RecordCounter(const char *name, f64 value) {
+  ProfileCounter counter = {name, Time::Now(), value};
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto *sink : m_Sinks) {
+    sink->WriteCounter(counter);
+  }
+  m_Counters[name] = value;
+}
+// --------------------------------------------------------------------------------
+f64 Profiler::GetCounter(const char *name) const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto it = m_Counters.find(name);
+  return it != m_Counters.end() ? it->second : 0.0;
+}
+// --------------------------------------------------------------------------------
 f32 Profiler::GetEventDuration(const char *name) const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   if (m_EventDurations.find(name) != m_EventDurations.end()) {
     return m_EventDurations.at(name);
   }
@@ -54,6 +72,7 @@ f32 Profiler::GetEventDuration(const char *name) const {
 }
 // --------------------------------------------------------------------------------
 std::string Profiler::GenerateSessionReport() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   // Calculate total time
   f32 totalTime = 0.0f;
   i32 maxStrLen = 0;
@@ -94,6 +113,7 @@ std::string Profiler::GenerateSessionReport() const {
 }
 // --------------------------------------------------------------------------------
 void Profiler::EndSession() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
   for (auto *sink : m_Sinks) {
     sink->WriteFooter();
     sink->Flush();
@@ -129,6 +149,10 @@ void ConsoleProfileSink::WriteEvent(const ProfileEvent &e) {
   LOG_TRACE_F("%s: %.2fms", e.name, e.Duration(TimeUnit::MILISECONDS));
 }
 // --------------------------------------------------------------------------------
+void ConsoleProfileSink::WriteCounter(const ProfileCounter &c) {
+  LOG_TRACE_F("%s: %.3f", c.name, c.value);
+}
+// --------------------------------------------------------------------------------
 void ConsoleProfileSink::WriteFooter() {}
 // --------------------------------------------------------------------------------
 void ConsoleProfileSink::Flush() { fflush(stdout); }
@@ -175,6 +199,23 @@ void JsonTraceSink::WriteEvent(const ProfileEvent &e) {
   // clang-format on
 }
 // --------------------------------------------------------------------------------
+void JsonTraceSink::WriteCounter(const ProfileCounter &c) {
+  if (!m_First) m_File << ",\n";
+  m_First = false;
+  // clang-format off
+  m_File
+    << "{"
+       "\"cat\": \"PERF\","
+       "\"name\":\"" << c.name << "\","
+       "\"ph\": \"C\","
+       "\"ts\":" << Sono::FormatSecondsToUnit(c.time, TimeUnit::MILISECONDS) << ","
+       "\"pid\":" << getpid() << ","
+       "\"args\": {\"value\":" << c.value << "}"
+    << "}";
+  m_File.flush();
+  // clang-format on
+}
+// --------------------------------------------------------------------------------
 void JsonTraceSink::WriteFooter() {
   m_File << "\n]\n}\n";
   m_File.flush();
@@ -17,9 +17,11 @@
 #include "core/common/defines.h"
 #define PROFILE_SCOPE(name) ::Sono::ProfileScope ANON_VAR(__prof)(name)
 #define PROFILE_FUNCTION()  PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_COUNTER(name, value) ::Sono::Profiler::Get().RecordCounter(name, value)
 #else
 #define PROFILE_SCOPE(name)
 #define PROFILE_FUNCTION()
+#define PROFILE_COUNTER(name, value)
 #endif
 
 namespace Sono {
@@ -35,11 +37,19 @@ struct ProfileEvent {
   }
 };
 
+/// A named value sampled at a point in time (e.g. per-frame input latency)
+struct ProfileCounter {
+  const char *name;
+  f32 time; // sample time in seconds
+  f64 value;
+};
+
 class IProfileSink {
 public:
   virtual ~IProfileSink() = default;
   virtual void WriteHeader() = 0;
   virtual void WriteEvent(const ProfileEvent &frame) = 0;
+  virtual void WriteCounter(const ProfileCounter &counter) = 0;
   virtual void WriteFooter() = 0;
   virtual void Flush() = 0;
 };
@@ -48,6 +58,7 @@ class ConsoleProfileSink : public IProfileSink {
 public:
   void WriteHeader() override;
   void WriteEvent(const ProfileEvent &event) override;
+  void WriteCounter(const ProfileCounter &counter) override;
   void WriteFooter() override;
   void Flush() override;
 };
@@ -58,6 +69,7 @@ public:
 
   void WriteHeader() override;
   void WriteEvent(const ProfileEvent &e) override;
+  void WriteCounter(const ProfileCounter &counter) override;
   void WriteFooter() override;
   void Flush() override;
 
@@ -79,6 +91,7 @@ public:
 
   template <typename T, typename... Args>
   void AddSinks(Args &&...args) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     T *sink = m_SessionAlloc.New<T>(std::forward<Args>(args)...);
     ASSERT(sink && "Can not allocate memory for sink");
     m_Sinks.push_back(sink);
@@ -87,12 +100,17 @@ public:
   void EndSession();
   b8 HasSession();
   void Record(const ProfileEvent &frame);
+  void RecordCounter(const char *name, f64 value);
+  /// Last value recorded for a counter, 0 if it was never recorded
+  f64 GetCounter(const char *name) const;
 
 private:
-  std::mutex m_Mutex;
+  // Scopes and counters may be recorded from any thread, every member below is guarded
+  mutable std::mutex m_Mutex;
   std::vector<IProfileSink *> m_Sinks;
 
   std::unordered_map<const char *, f32> m_EventDurations;
+  std::unordered_map<const char *, f64> m_Counters;
   ArenaAllocator m_SessionAlloc;
 };
 
@@ -0,0 +1,109 @@
+#ifndef SN_COMPONENT_POOL_H
+#define SN_COMPONENT_POOL_H
+
+#include <core/common/snassert.h>
+#include <core/common/types.h>
+#include <core/ecs/entity.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+/// @brief Type erased part of a ComponentPool, the entity side of the sparse set
+class ComponentPoolBase {
+public:
+  virtual ~ComponentPoolBase() = default;
+
+  virtual void Remove(Entity e) = 0;
+
+  /// @brief Whether e has a component, false for stale handles to a recycled index
+  b8 Has(Entity e) const {
+    const u32 index = EntityHandle::GetIndex(e);
+    return index < m_Sparse.size() && m_Sparse[index] != INVALID &&
+           m_Entities[m_Sparse[index]] == e;
+  }
+
+  /// @brief Number of components, the length of the dense arrays
+  usize GetSize() const { return m_Entities.size(); }
+
+  /// @brief Owner of each component, parallel to the component array
+  const Entity *GetEntities() const { return m_Entities.data(); }
+
+  /// @brief Position of e's component in the dense arrays, e must have one
+  u32 GetIndex(Entity e) const {
+    ASSERT(Has(e));
+    return m_Sparse[EntityHandle::GetIndex(e)];
+  }
+
+protected:
+  static constexpr u32 INVALID = U32_MAX;
+
+  std::vector<u32> m_Sparse;      // Per entity index, into the dense arrays or INVALID
+  std::vector<Entity> m_Entities; // Dense
+};
+
+/// @brief Components of one type as a sparse set. The components are packed in one array with
+/// no holes, so iterating them is a linear walk, and a per entity index finds an entity's one.
+/// Add, Remove and Has are O(1), amortized for Add. Remove moves the last component into the
+/// hole, which invalidates pointers into the pool and changes the iteration order.
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+  /// @brief Construct e's component from args, replacing the one it had
+  template <typename... Args>
+  T &Add(Entity e, Args &&...args) {
+    if (Has(e)) return m_Data[GetIndex(e)] = T{std::forward<Args>(args)...};
+
+    const u32 index = EntityHandle::GetIndex(e);
+    if (index >= m_Sparse.size()) m_Sparse.resize(index + 1, INVALID);
+    SN_ASSERT(m_Sparse[index] == INVALID, "Component of a destroyed entity was not removed");
+    m_Sparse[index] = (u32)m_Data.size();
+    m_Entities.push_back(e);
+    return m_Data.emplace_back(T{std::forward<Args>(args)...});
+  }
+
+  void Remove(Entity e) override {
+    if (!Has(e)) return;
+    const u32 index = GetIndex(e);
+    const Entity last = m_Entities.back();
+    if (index + 1 != m_Data.size()) m_Data[index] = std::move(m_Data.back());
+    m_Entities[index] = last;
+    m_Sparse[EntityHandle::GetIndex(last)] = index;
+    m_Sparse[EntityHandle::GetIndex(e)] = INVALID;
+    m_Data.pop_back();
+    m_Entities.pop_back();
+  }
+
+  void Reserve(usize count) {
+    m_Data.reserve(count);
+    m_Entities.reserve(count);
+  }
+
+  T &Get(Entity e) { return m_Data[GetIndex(e)]; }
+  const T &Get(Entity e) const { return m_Data[GetIndex(e)]; }
+
+  /// @brief e's component or nullptr
+  T *Find(Entity e) { return Has(e) ? &m_Data[GetIndex(e)] : nullptr; }
+
+  /// @brief The packed components, GetSize() of them
+  T *GetData() { return m_Data.data(); }
+  const T *GetData() const { return m_Data.data(); }
+
+private:
+  std::vector<T> m_Data;
+};
+
+// --------------------------------------------------------------------------------
+inline u32 NextComponentTypeId() {
+  static std::atomic<u32> s_NextId{0};
+  return s_NextId.fetch_add(1, std::memory_order_relaxed);
+}
+// --------------------------------------------------------------------------------
+/// @brief Small dense id per component type, assigned on first use
+template <typename T>
+u32 GetComponentTypeId() {
+  static const u32 s_Id = NextComponentTypeId();
+  return s_Id;
+}
+
+#endif // !SN_COMPONENT_POOL_H
@@ -0,0 +1,31 @@
+#ifndef SN_ENTITY_H
+#define SN_ENTITY_H
+
+#include "core/common/types.h"
+
+/// @brief Index of the entity's slot in the per entity arrays in the low bits, and in the high
+/// bits how many times that index was reused. A handle to a destroyed entity keeps its old
+/// generation, so it stops matching once the index is recycled.
+using Entity = u32;
+
+class EntityHandle {
+public:
+  // Both combined must be 32
+  static constexpr u32 INDEX_BITS = 22;
+  static constexpr u32 GENERATION_BITS = 10;
+
+  static constexpr u32 MAX_INDEX = (1u << INDEX_BITS) - 1; // Reserved for NULL_ENTITY
+  static constexpr u32 MAX_GENERATION = (1u << GENERATION_BITS) - 1;
+
+  static inline constexpr Entity Make(u32 index, u32 generation) {
+    return (generation << INDEX_BITS) | index;
+  }
+
+  static inline constexpr u32 GetIndex(Entity e) { return e & MAX_INDEX; }
+
+  static inline constexpr u32 GetGeneration(Entity e) { return e >> INDEX_BITS; }
+};
+
+constexpr Entity NULL_ENTITY = U32_MAX;
+
+#endif // !SN_ENTITY_H
@@ -8,12 +8,15 @@
 #include <core/math/transform.h>
 #include <core/math/vec3.h>
 #include <core/event/event_dispatcher.h>
+#include <core/event/event_coalescer.h>
+#include <core/event/event_recorder.h>
 #include <core/input/mouse.h>
+#include <core/input/input_latency.h>
 #include <render/render_command.h>
 
+/// Input events are applied in one batch by InputSystem::InjectEvents, this only handles the rest
 inline void HandleEvent(const Event &ev) {
   // S_LOG_TRACE(ev.ToString());
-  static InputSystem *is = InputSystem::GetPtr();
   static RenderSystem *rs = RenderSystem::GetPtr();
 
   switch (ev.type) {
@@ -21,7 +24,6 @@ inline void HandleEvent(const Event &ev) {
     case EventType::MOUSE_MOVE:
     case EventType::MOUSE_BUTTON:
     case EventType::MOUSE_SCROLL:
-      is->InjectEvent(ev);
       break;
     case EventType::WINDOW_RESIZE: {
       auto &k = std::get<WindowResizeEvent>(ev.payload);
@@ -34,15 +36,47 @@ inline void HandleEvent(const Event &ev) {
   }
 }
 
+/// Command line options understood by SONO_IMPLEMENT_MAIN
+///   --record-input <file>  write every frame's event stream to file
+///   --replay-input <file>  drive input from a recording on its original frame boundaries
+struct LaunchOptions {
+  const char *recordInputPath = nullptr;
+  const char *replayInputPath = nullptr;
+};
+
+inline LaunchOptions ParseLaunchOptions(i32 argc, char **argv) {
+  LaunchOptions options;
+  for (i32 i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--record-input" && i + 1 < argc) {
+      options.recordInputPath = argv[++i];
+    } else if (arg == "--replay-input" && i + 1 < argc) {
+      options.replayInputPath = argv[++i];
+    } else {
+      LOG_WARN_F("Ignoring unknown argument %s", argv[i]);
+    }
+  }
+  return options;
+}
+
 #define SONO_IMPLEMENT_MAIN(AppType, ...)                                                          \
-  i32 main(void) {                                                                                 \
+  i32 main(i32 argc, char **argv) {                                                                \
+    LaunchOptions options = ParseLaunchOptions(argc, argv);                                        \
     std::unique_ptr<Sono::Global> global = std::make_unique<Sono::Global>();                       \
     global->Init();                                                                                \
     MemorySystem *ms = MemorySystem::GetPtr();                                                     \
     RenderSystem *rs = RenderSystem::GetPtr();                                                     \
     EventSystem *es = EventSystem::GetPtr();                                                       \
     InputSystem *is = InputSystem::GetPtr();                                                       \
+    TweenSystem *ts = TweenSystem::GetPtr();                                                       \
     AppType app = AppType(__VA_ARGS__);                                                            \
+    std::vector<Event> frameEvents;                                                                \
+    frameEvents.reserve(256);                                                                      \
+    EventRecorder recorder;                                                                        \
+    EventReplayer replayer;                                                                        \
+    InputLatencyTracker latency;                                                                   \
+    if (options.recordInputPath) recorder.Open(options.recordInputPath);                           \
+    if (options.replayInputPath) replayer.Open(options.replayInputPath);                           \
     RenderWindow *win = app.CreateWindow(rs);                                                      \
     app.Init();                                                                                    \
     rs->InitImGui(win);                                                                            \
@@ -53,11 +87,29 @@ inline void HandleEvent(const Event &ev) {
         {                                                                                          \
           PROFILE_SCOPE("MAIN_LOOP::Handle Events");                                               \
           glfwPollEvents();                                                                        \
-          while (auto *ev = es->Pop()) {                                                           \
-            HandleEvent(*ev);                                                                      \
-            EventDispatcher::Dispatch(*ev);                                                        \
+          frameEvents.clear();                                                                     \
+          es->Drain(frameEvents);                                                                  \
+          if (replayer.IsOpen()) {                                                                 \
+            f32 replayDelta = Time::DeltaTime();                                                   \
+            if (replayer.InjectFrame(frameEvents, replayDelta)) {                                  \
+              Time::SetDeltaTime(replayDelta);                                                     \
+            } else {                                                                               \
+              win->SetShouldClose(true);                                                           \
+            }                                                                                      \
+          }                                                                                        \
+          recorder.RecordFrame(frameEvents.data(), frameEvents.size(), Time::DeltaTime());         \
+          latency.BeginFrame(frameEvents.data(), frameEvents.size());                              \
+          EventCoalescer::Coalesce(frameEvents);                                                   \
+          is->InjectEvents(frameEvents.data(), frameEvents.size());                                \
+          for (const Event &ev : frameEvents) {                                                    \
+            HandleEvent(ev);                                                                       \
+            EventDispatcher::Dispatch(ev);                                                         \
           }                                                                                        \
         }                                                                                          \
+        {                                                                                          \
+          PROFILE_SCOPE("MAIN_LOOP::Tweens");                                                      \
+          ts->Update(Time::DeltaTime());                                                           \
+        }                                                                                          \
         {                                                                                          \
           PROFILE_SCOPE("MAIN_LOOP::RENDER::RenderOneFrame");                                      \
           app.Update();                                                                            \
@@ -66,10 +118,12 @@ inline void HandleEvent(const Event &ev) {
           rs->EndImGuiFrame();                                                                     \
           rs->EndFrame();                                                                          \
         }                                                                                          \
+        latency.EndFrame(rs->GetLastPresentTicks());                                               \
         is->EndFrame();                                                                            \
         Time::Tick();                                                                              \
       }                                                                                            \
     }                                                                                              \
+    recorder.Close();                                                                              \
     rs->ShutdownImGui();                                                                           \
     global->Shutdown();                                                                            \
     return 0;                                                                                      \
@@ -0,0 +1,42 @@
+#include "event_coalescer.h"
+#include <bitset>
+
+constexpr i32 kMaxKeys = 512;
+
+// --------------------------------------------------------------------------------
+usize EventCoalescer::Coalesce(std::vector<Event> &events) {
+  const usize count = events.size();
+  if (count < 2) return 0;
+
+  std::bitset<kMaxKeys> seenKeys;
+  std::bitset<kMaxKeys> keyDown;
+
+  usize write = 0;
+  for (usize read = 0; read < count; read++) {
+    Event &ev = events[read];
+
+    if (write > 0) {
+      Event &prev = events[write - 1];
+      const b8 mergeable = (ev.type == EventType::MOUSE_MOVE || ev.type == EventType::MOUSE_SCROLL);
+      if (mergeable && prev.type == ev.type) {
+        prev.payload = ev.payload;
+        continue;
+      }
+    }
+
+    if (ev.type == EventType::KEY) {
+      const auto &k = std::get<KeyEvent>(ev.payload);
+      if (k.key >= 0 && k.key < kMaxKeys) {
+        if (seenKeys.test(k.key) && keyDown.test(k.key) == (k.down != 0)) continue;
+        seenKeys.set(k.key);
+        keyDown.set(k.key, k.down);
+      }
+    }
+
+    if (write != read) events[write] = ev;
+    write++;
+  }
+
+  events.resize(write);
+  return count - write;
+}
@@ -0,0 +1,27 @@
+#ifndef SN_EVENT_COALESCER_H
+#define SN_EVENT_COALESCER_H
+
+#include <core/event/events.h>
+#include <vector>
+
+/// @brief Collapses redundant events of one frame batch before they reach input and listeners.
+///
+/// - A run of consecutive MOUSE_MOVE events becomes its last position. InputSystem derives the
+///   delta from successive positions, so the frame delta is unchanged.
+/// - A run of consecutive MOUSE_SCROLL events becomes its last value (InputSystem treats the
+///   scroll value as an absolute wheel position).
+/// - A KEY event that repeats the last state seen for that key in the batch is dropped;
+///   press/release transitions are always kept.
+///
+/// Merged events keep the time/tick of the first event they replace so latency is measured
+/// from the oldest input they represent.
+class EventCoalescer {
+public:
+  EventCoalescer() = delete;
+
+  /// @brief Coalesce events in place, preserving the order of the kept events.
+  /// @return Number of events removed
+  static usize Coalesce(std::vector<Event> &events);
+};
+
+#endif // !SN_EVENT_COALESCER_H
@@ -2,33 +2,133 @@
 #define SN_SYS_EVENT_DISPATCHER_H
 
 #include "events.h"
-#include <functional>
+#include <core/common/delegate.h>
+#include <array>
 #include <vector>
 
+/// Listener handle: payload index in the top 8 bits, listener id in the low 24 bits
+using ListenerHandle = u32;
+
+constexpr ListenerHandle INVALID_LISTENER = 0;
+
 class EventDispatcher {
-  template <typename T>
-  using EventCallbackFn = std::function<void(const T &)>;
+  using Listener = Delegate<void(const Event &), 32>;
+
+  struct Entry {
+    u32 id;
+    Listener fn;
+  };
 
 public:
-  template <typename T>
-  static void Register(EventCallbackFn<T> cb) {
-    m_Callbacks.emplace_back([=](const Event &e) {
-      if (auto *p = std::get_if<T>(&e.payload)) {
-        cb(*p);
+  /// @brief Register fn to be called with every event carrying a T payload.
+  /// The callable is stored inline, it must fit in the delegate storage.
+  template <typename T, typename Fn>
+  static ListenerHandle Register(Fn &&fn) {
+    constexpr usize index = EventPayloadIndex<T>;
+    static_assert(index < EVENT_PAYLOAD_COUNT, "T is not an EventPayload alternative");
+    static_assert(index != 0, "Cannot listen to std::monostate");
+
+    using F = std::decay_t<Fn>;
+    return AddListener(index, Listener([cb = F(std::forward<Fn>(fn))](const Event &e) {
+                         cb(*std::get_if<T>(&e.payload));
+                       }));
+  }
+
+  /// @brief Remove a listener. Safe to call from inside a callback.
+  static void Unregister(ListenerHandle handle) {
+    if (handle == INVALID_LISTENER) return;
+    const usize index = handle >> 24;
+    if (index >= EVENT_PAYLOAD_COUNT) return;
+
+    const u32 id = handle & 0x00ff'ffff;
+    for (usize i = 0; i < m_Pending.size(); i++) {
+      if (m_Pending[i].index == index && m_Pending[i].entry.id == id) {
+        m_Pending.erase(m_Pending.begin() + i);
+        return;
       }
-    });
+    }
+
+    auto &table = m_Listeners[index];
+    for (usize i = 0; i < table.size(); i++) {
+      if (table[i].id != id) continue;
+      if (m_DispatchDepth > 0) {
+        // The listener may be the one running, so keep its closure alive and only
+        // mark it dead. Flush() destroys it once dispatch returns
+        table[i].id = 0;
+        m_NeedsCompaction = true;
+      } else {
+        table.erase(table.begin() + i);
+      }
+      return;
+    }
   }
 
   static void Dispatch(const Event &e) {
-    for (auto &cb : m_Callbacks) {
-      cb(e);
+    auto &table = m_Listeners[e.payload.index()];
+
+    m_DispatchDepth++;
+    for (usize i = 0; i < table.size(); i++) {
+      if (table[i].id != 0) table[i].fn(e);
+    }
+    m_DispatchDepth--;
+
+    if (m_DispatchDepth == 0 && (m_NeedsCompaction || !m_Pending.empty())) Flush();
+  }
+
+  static usize GetListenerCount(usize payloadIndex) { return m_Listeners[payloadIndex].size(); }
+
+  static void Clear() {
+    for (auto &table : m_Listeners) table.clear();
+    m_Pending.clear();
+    m_NeedsCompaction = false;
+  }
+
+private:
+  struct PendingEntry {
+    usize index;
+    Entry entry;
+  };
+
+  static ListenerHandle AddListener(usize index, Listener &&fn) {
+    const u32 id = m_NextId++;
+    if (m_NextId > 0x00ff'ffff) m_NextId = 1;
+
+    // Growing a table while it is iterated would move the running delegate, so
+    // listeners registered from a callback are added once dispatch returns
+    if (m_DispatchDepth > 0) {
+      m_Pending.push_back({index, {id, std::move(fn)}});
+    } else {
+      m_Listeners[index].push_back({id, std::move(fn)});
+    }
+    return static_cast<ListenerHandle>(index << 24) | id;
+  }
+
+  static void Flush() {
+    if (m_NeedsCompaction) {
+      for (auto &table : m_Listeners) {
+        std::erase_if(table, [](const Entry &entry) { return entry.id == 0; });
+      }
+      m_NeedsCompaction = false;
+    }
+    for (auto &pending : m_Pending) {
+      m_Listeners[pending.index].push_back(std::move(pending.entry));
     }
+    m_Pending.clear();
   }
 
 private:
-  static std::vector<EventCallbackFn<Event>> m_Callbacks;
+  static std::array<std::vector<Entry>, EVENT_PAYLOAD_COUNT> m_Listeners;
+  static std::vector<PendingEntry> m_Pending;
+  static u32 m_NextId;
+  static u32 m_DispatchDepth;
+  static b8 m_NeedsCompaction;
 };
 
-inline std::vector<EventDispatcher::EventCallbackFn<Event>> EventDispatcher::m_Callbacks;
+inline std::array<std::vector<EventDispatcher::Entry>, EVENT_PAYLOAD_COUNT>
+  EventDispatcher::m_Listeners;
+inline std::vector<EventDispatcher::PendingEntry> EventDispatcher::m_Pending;
+inline u32 EventDispatcher::m_NextId = 1;
+inline u32 EventDispatcher::m_DispatchDepth = 0;
+inline b8 EventDispatcher::m_NeedsCompaction = false;
 
 #endif // !SN_SYS_EVENT_DISPATCHER_H
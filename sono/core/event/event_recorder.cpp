@@ -0,0 +1,270 @@
+#include "event_recorder.h"
+#include <core/common/time.h>
+#include <cstring>
+
+constexpr usize kFlushThreshold = 64 * 1024;
+
+// ================================================================================
+// Encoding helpers
+// ================================================================================
+
+static void WriteVarint(std::vector<u8> &out, u64 v) {
+  while (v >= 0x80) {
+    out.push_back((u8)(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back((u8)v);
+}
+// --------------------------------------------------------------------------------
+static u64 ZigZag(i64 v) { return ((u64)v << 1) ^ (u64)(v >> 63); }
+// --------------------------------------------------------------------------------
+static i64 UnZigZag(u64 v) { return (i64)(v >> 1) ^ -(i64)(v & 1); }
+// --------------------------------------------------------------------------------
+template <typename T>
+static void WriteRaw(std::vector<u8> &out, T v) {
+  const usize at = out.size();
+  out.resize(at + sizeof(T));
+  std::memcpy(out.data() + at, &v, sizeof(T));
+}
+// --------------------------------------------------------------------------------
+static b8 ReadVarint(const u8 *data, usize size, usize &cursor, u64 &v) {
+  v = 0;
+  for (u32 shift = 0; shift < 64; shift += 7) {
+    if (cursor >= size) return false;
+    const u8 byte = data[cursor++];
+    v |= (u64)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+  return false;
+}
+// --------------------------------------------------------------------------------
+template <typename T>
+static b8 ReadRaw(const u8 *data, usize size, usize &cursor, T &v) {
+  if (cursor > size || size - cursor < sizeof(T)) return false;
+  std::memcpy(&v, data + cursor, sizeof(T));
+  cursor += sizeof(T);
+  return true;
+}
+
+// ================================================================================
+// Frame codec
+// ================================================================================
+
+i64 EncodeEventFrame(
+  std::vector<u8> &out, const Event *events, usize count, f32 deltaTime, i64 prevTime
+) {
+  WriteVarint(out, count);
+  WriteRaw(out, deltaTime);
+
+  for (usize i = 0; i < count; i++) {
+    const Event &e = events[i];
+    u8 flags = 0;
+    if (auto *k = std::get_if<KeyEvent>(&e.payload)) flags = k->down ? 1 : 0;
+    if (auto *b = std::get_if<MouseButtonEvent>(&e.payload)) flags = b->pressed ? 1 : 0;
+
+    out.push_back((u8)((u8)e.type | (flags << 4)));
+    WriteVarint(out, ZigZag(e.time - prevTime));
+    prevTime = e.time;
+
+    switch (e.type) {
+      case EventType::KEY:
+        WriteVarint(out, ZigZag(std::get<KeyEvent>(e.payload).key));
+        break;
+      case EventType::MOUSE_MOVE: {
+        const auto &m = std::get<MouseMoveEvent>(e.payload);
+        WriteRaw(out, m.xpos);
+        WriteRaw(out, m.ypos);
+        break;
+      }
+      case EventType::MOUSE_BUTTON:
+        out.push_back((u8)std::get<MouseButtonEvent>(e.payload).button);
+        break;
+      case EventType::MOUSE_SCROLL: {
+        const auto &s = std::get<MouseScrollEvent>(e.payload);
+        WriteRaw(out, s.scrollX);
+        WriteRaw(out, s.scrollY);
+        break;
+      }
+      case EventType::WINDOW_RESIZE: {
+        const auto &r = std::get<WindowResizeEvent>(e.payload);
+        WriteVarint(out, ZigZag(r.width));
+        WriteVarint(out, ZigZag(r.height));
+        break;
+      }
+      case EventType::TEXT:
+      case EventType::QUIT:
+        break;
+    }
+  }
+  return prevTime;
+}
+// --------------------------------------------------------------------------------
+b8 DecodeEventFrame(
+  const u8 *data, usize size, usize &cursor, std::vector<Event> &out, f32 &deltaTime, i64 &prevTime
+) {
+  u64 count = 0;
+  if (!ReadVarint(data, size, cursor, count)) return false;
+  if (!ReadRaw(data, size, cursor, deltaTime)) return false;
+
+  for (u64 i = 0; i < count; i++) {
+    u8 header = 0;
+    u64 dt = 0;
+    if (!ReadRaw(data, size, cursor, header)) return false;
+    if (!ReadVarint(data, size, cursor, dt)) return false;
+
+    Event e;
+    e.time = prevTime + UnZigZag(dt);
+    e.tick = 0;
+    e.type = (EventType)(header & 0x0f);
+    prevTime = e.time;
+    const b8 flag = (header >> 4) & 1;
+
+    switch (e.type) {
+      case EventType::KEY: {
+        u64 key = 0;
+        if (!ReadVarint(data, size, cursor, key)) return false;
+        e.payload = KeyEvent{(i32)UnZigZag(key), flag};
+        break;
+      }
+      case EventType::MOUSE_MOVE: {
+        MouseMoveEvent m;
+        if (!ReadRaw(data, size, cursor, m.xpos) || !ReadRaw(data, size, cursor, m.ypos))
+          return false;
+        e.payload = m;
+        break;
+      }
+      case EventType::MOUSE_BUTTON: {
+        u8 button = 0;
+        if (!ReadRaw(data, size, cursor, button)) return false;
+        e.payload = MouseButtonEvent{button, flag};
+        break;
+      }
+      case EventType::MOUSE_SCROLL: {
+        MouseScrollEvent s;
+        if (!ReadRaw(data, size, cursor, s.scrollX) || !ReadRaw(data, size, cursor, s.scrollY))
+          return false;
+        e.payload = s;
+        break;
+      }
+      case EventType::WINDOW_RESIZE: {
+        u64 w = 0, h = 0;
+        if (!ReadVarint(data, size, cursor, w) || !ReadVarint(data, size, cursor, h)) return false;
+        e.payload = WindowResizeEvent{(i32)UnZigZag(w), (i32)UnZigZag(h)};
+        break;
+      }
+      case EventType::TEXT:
+      case EventType::QUIT:
+        e.payload = std::monostate{};
+        break;
+      default:
+        return false;
+    }
+    out.push_back(e);
+  }
+  return true;
+}
+
+// ================================================================================
+// EventRecorder
+// ================================================================================
+
+EventRecorder::~EventRecorder() { Close(); }
+// --------------------------------------------------------------------------------
+b8 EventRecorder::Open(const char *path) {
+  m_File.open(path, std::ios::binary | std::ios::trunc);
+  if (!m_File.is_open()) {
+    LOG_ERROR_F("EventRecorder: failed to open %s", path);
+    return false;
+  }
+
+  m_Buffer.clear();
+  WriteRaw(m_Buffer, EVENT_RECORD_MAGIC);
+  WriteRaw(m_Buffer, EVENT_RECORD_VERSION);
+  WriteRaw(m_Buffer, (u16)0);
+  m_PrevTime = 0;
+  m_FrameCount = 0;
+  LOG_INFO_F("EventRecorder: recording input to %s", path);
+  return true;
+}
+// --------------------------------------------------------------------------------
+void EventRecorder::Close() {
+  if (!m_File.is_open()) return;
+  FlushBuffer();
+  m_File.close();
+  LOG_INFO_F("EventRecorder: recorded %llu frames", (unsigned long long)m_FrameCount);
+}
+// --------------------------------------------------------------------------------
+void EventRecorder::RecordFrame(const Event *events, usize count, f32 deltaTime) {
+  if (!m_File.is_open()) return;
+  m_PrevTime = EncodeEventFrame(m_Buffer, events, count, deltaTime, m_PrevTime);
+  m_FrameCount++;
+  if (m_Buffer.size() >= kFlushThreshold) FlushBuffer();
+}
+// --------------------------------------------------------------------------------
+void EventRecorder::FlushBuffer() {
+  m_File.write(reinterpret_cast<const char *>(m_Buffer.data()), m_Buffer.size());
+  m_Buffer.clear();
+}
+
+// ================================================================================
+// EventReplayer
+// ================================================================================
+
+b8 EventReplayer::Open(const char *path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    LOG_ERROR_F("EventReplayer: failed to open %s", path);
+    return false;
+  }
+
+  const std::streamsize size = file.tellg();
+  file.seekg(0);
+  std::vector<u8> data((usize)std::max<std::streamsize>(size, 0));
+  file.read(reinterpret_cast<char *>(data.data()), size);
+
+  usize cursor = 0;
+  u32 magic = 0;
+  u16 version = 0, reserved = 0;
+  if (!ReadRaw(data.data(), data.size(), cursor, magic) || magic != EVENT_RECORD_MAGIC
+      || !ReadRaw(data.data(), data.size(), cursor, version) || version != EVENT_RECORD_VERSION
+      || !ReadRaw(data.data(), data.size(), cursor, reserved)) {
+    LOG_ERROR_F("EventReplayer: %s is not a version %d input recording", path, EVENT_RECORD_VERSION);
+    return false;
+  }
+
+  m_Data = std::move(data);
+  m_Cursor = cursor;
+  m_PrevTime = 0;
+  m_FrameCount = 0;
+  LOG_INFO_F("EventReplayer: replaying input from %s", path);
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 EventReplayer::NextFrame(std::vector<Event> &out, f32 &deltaTime) {
+  if (IsFinished()) return false;
+  if (!DecodeEventFrame(m_Data.data(), m_Data.size(), m_Cursor, out, deltaTime, m_PrevTime)) {
+    LOG_ERROR("EventReplayer: recording is corrupted, stopping replay");
+    m_Cursor = m_Data.size();
+    return false;
+  }
+  m_FrameCount++;
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 EventReplayer::InjectFrame(std::vector<Event> &events, f32 &deltaTime) {
+  // Drop live input so only the recording drives the simulation
+  std::erase_if(events, [](const Event &e) { return e.type != EventType::WINDOW_RESIZE; });
+
+  m_Frame.clear();
+  if (!NextFrame(m_Frame, deltaTime)) return false;
+
+  // Recorded timestamps belong to another session, restamp them for latency tracking
+  const u64 now = Time::Ticks();
+  for (Event &e : m_Frame) {
+    if (e.type == EventType::WINDOW_RESIZE) continue;
+    e.time = (i64)now;
+    e.tick = now;
+    events.push_back(e);
+  }
+  return true;
+}
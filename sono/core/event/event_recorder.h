@@ -0,0 +1,87 @@
+#ifndef SN_EVENT_RECORDER_H
+#define SN_EVENT_RECORDER_H
+
+#include <core/event/events.h>
+#include <fstream>
+#include <vector>
+
+// Input recording file layout (little endian)
+//   header : u32 magic "SNEV", u16 version, u16 reserved
+//   frame  : varint eventCount, f32 deltaTime, eventCount * event
+//   event  : u8 (type | flags << 4), varint zigzag(time - previous time), payload
+//
+// Payloads: KEY varint zigzag key (flag = down), MOUSE_MOVE 2 * f64, MOUSE_BUTTON u8 button
+// (flag = pressed), MOUSE_SCROLL 2 * f32, WINDOW_RESIZE 2 * varint, TEXT/QUIT nothing.
+
+constexpr u32 EVENT_RECORD_MAGIC = 0x56454E53; // "SNEV"
+constexpr u16 EVENT_RECORD_VERSION = 1;
+
+/// @brief Serialize one frame of events into out (appended). Returns the updated previous time.
+i64 EncodeEventFrame(
+  std::vector<u8> &out, const Event *events, usize count, f32 deltaTime, i64 prevTime
+);
+
+/// @brief Decode one frame starting at cursor. Returns false on truncated or malformed data.
+b8 DecodeEventFrame(
+  const u8 *data, usize size, usize &cursor, std::vector<Event> &out, f32 &deltaTime, i64 &prevTime
+);
+
+/// @brief Writes the per-frame EventSystem stream to a file for later replay
+class EventRecorder {
+public:
+  EventRecorder() = default;
+
+  ~EventRecorder();
+
+  b8 Open(const char *path);
+
+  void Close();
+
+  b8 IsOpen() const { return m_File.is_open(); }
+
+  /// @brief Record every event drained this frame and the delta time the frame simulated
+  void RecordFrame(const Event *events, usize count, f32 deltaTime);
+
+  u64 GetFrameCount() const { return m_FrameCount; }
+
+private:
+  void FlushBuffer();
+
+private:
+  std::ofstream m_File;
+  std::vector<u8> m_Buffer;
+  i64 m_PrevTime = 0;
+  u64 m_FrameCount = 0;
+};
+
+/// @brief Plays a recording back, one recorded frame per engine frame
+class EventReplayer {
+public:
+  EventReplayer() = default;
+
+  b8 Open(const char *path);
+
+  b8 IsOpen() const { return !m_Data.empty(); }
+
+  b8 IsFinished() const { return m_Cursor >= m_Data.size(); }
+
+  /// @brief Read the next recorded frame into out (appended)
+  /// @return false once the recording is exhausted or corrupted
+  b8 NextFrame(std::vector<Event> &out, f32 &deltaTime);
+
+  /// @brief Replace the live input events of a drained batch with the next recorded frame.
+  /// Live window events are kept so the viewport follows the real window.
+  /// @return false once the recording is exhausted
+  b8 InjectFrame(std::vector<Event> &events, f32 &deltaTime);
+
+  u64 GetFrameCount() const { return m_FrameCount; }
+
+private:
+  std::vector<u8> m_Data;
+  std::vector<Event> m_Frame;
+  usize m_Cursor = 0;
+  i64 m_PrevTime = 0;
+  u64 m_FrameCount = 0;
+};
+
+#endif // !SN_EVENT_RECORDER_H
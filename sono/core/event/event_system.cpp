@@ -1,28 +1,160 @@
 #include "event_system.h"
+#include <core/common/time.h>
+
+// Chunk lifetime
+// --------------
+// A producer that loaded m_Tail may still dereference that chunk after the consumer has
+// drained it. Producers therefore pin the chunk before touching it and re-validate m_Tail
+// afterwards; the consumer first moves m_Tail past a drained chunk and only recycles it once
+// its pin count reads zero. Chunks are never returned to the heap while the queue is alive,
+// so a late pin on a recycled chunk is harmless: the re-validation fails and it is undone.
+// Recycled chunks are linked back after the current tail, ready for the next burst.
 
 // --------------------------------------------------------------------------------
 EventSystem::EventSystem()
-  : m_Head(0)
-  , m_Tail(0) {}
+  : m_Tail(nullptr)
+  , m_FreeStack(nullptr)
+  , m_Owned(nullptr)
+  , m_ChunkCount(0)
+  , m_Head(nullptr)
+  , m_ReadIndex(0) {
+  m_Head = AllocateChunk();
+  m_Tail.store(m_Head, std::memory_order_relaxed);
+}
 // --------------------------------------------------------------------------------
-EventSystem::~EventSystem() {}
+EventSystem::~EventSystem() {
+  Chunk *chunk = m_Owned.load(std::memory_order_acquire);
+  while (chunk) {
+    Chunk *next = chunk->ownerNext;
+    delete chunk;
+    chunk = next;
+  }
+}
 // --------------------------------------------------------------------------------
 void EventSystem::Push(const Event &e) {
-  Event *ev = &m_EventQueue[m_Head & MAX_EVENTS];
-  if (m_Head - m_Tail >= MAX_EVENTS) {
-    LOG_ERROR("SystemEventQueue: events overflow");
-    m_Tail++;
+  const u64 tick = Time::Ticks();
+
+  for (;;) {
+    Chunk *chunk = m_Tail.load();
+    chunk->pins.fetch_add(1);
+    if (m_Tail.load() != chunk) {
+      chunk->pins.fetch_sub(1, std::memory_order_release);
+      continue;
+    }
+
+    const u32 index = chunk->reserved.fetch_add(1, std::memory_order_relaxed);
+    if (index < CHUNK_SIZE) {
+      Slot &slot = chunk->slots[index];
+      slot.event = e;
+      slot.event.tick = tick;
+      slot.ready.store(1, std::memory_order_release);
+      chunk->pins.fetch_sub(1, std::memory_order_release);
+      return;
+    }
+
+    // The chunk is full: link a successor (unless another producer beat us to it),
+    // advance the tail and retry there
+    Chunk *next = chunk->next.load(std::memory_order_acquire);
+    if (!next) {
+      Chunk *fresh = AllocateChunk();
+      if (chunk->next.compare_exchange_strong(next, fresh, std::memory_order_acq_rel)) {
+        next = fresh;
+      } else {
+        ReleaseChunk(fresh);
+      }
+    }
+    Chunk *expected = chunk;
+    m_Tail.compare_exchange_strong(expected, next);
+    chunk->pins.fetch_sub(1, std::memory_order_release);
+  }
+}
+// --------------------------------------------------------------------------------
+usize EventSystem::Drain(std::vector<Event> &out) {
+  usize count = 0;
+
+  for (;;) {
+    if (m_ReadIndex < CHUNK_SIZE) {
+      Slot &slot = m_Head->slots[m_ReadIndex];
+      // Stop at the first slot that is reserved but not yet written to keep push order
+      if (!slot.ready.load(std::memory_order_acquire)) break;
+      out.push_back(slot.event);
+      slot.ready.store(0, std::memory_order_relaxed);
+      m_ReadIndex++;
+      count++;
+      continue;
+    }
+
+    Chunk *next = m_Head->next.load(std::memory_order_acquire);
+    if (!next) break;
+
+    // Make sure no new producer can validate the drained chunk before retiring it
+    Chunk *expected = m_Head;
+    m_Tail.compare_exchange_strong(expected, next);
+    m_Retired.push_back(m_Head);
+    m_Head = next;
+    m_ReadIndex = 0;
   }
-  m_Head++;
 
-  ev->time = e.time;
-  ev->type = e.type;
-  ev->payload = e.payload;
+  RecycleChunks();
+  return count;
+}
+// --------------------------------------------------------------------------------
+EventSystem::Chunk *EventSystem::AllocateChunk() {
+  Chunk *chunk = new Chunk();
+  chunk->ownerNext = m_Owned.load(std::memory_order_relaxed);
+  while (!m_Owned.compare_exchange_weak(
+    chunk->ownerNext, chunk, std::memory_order_release, std::memory_order_relaxed
+  ));
+  m_ChunkCount.fetch_add(1, std::memory_order_relaxed);
+  return chunk;
+}
+// --------------------------------------------------------------------------------
+void EventSystem::ReleaseChunk(Chunk *chunk) {
+  chunk->freeNext = m_FreeStack.load(std::memory_order_relaxed);
+  while (!m_FreeStack.compare_exchange_weak(
+    chunk->freeNext, chunk, std::memory_order_release, std::memory_order_relaxed
+  ));
 }
 // --------------------------------------------------------------------------------
-Event *EventSystem::Pop() {
-  if (m_Tail >= m_Head) {
-    return nullptr;
+void EventSystem::RecycleChunks() {
+  // Chunks allocated by producers that lost the race to link a successor
+  Chunk *orphan = m_FreeStack.exchange(nullptr, std::memory_order_acquire);
+  while (orphan) {
+    Chunk *next = orphan->freeNext;
+    m_Free.push_back(orphan);
+    orphan = next;
+  }
+
+  for (usize i = 0; i < m_Retired.size();) {
+    Chunk *chunk = m_Retired[i];
+    if (chunk->pins.load() != 0) {
+      i++;
+      continue;
+    }
+    chunk->reserved.store(0, std::memory_order_relaxed);
+    chunk->next.store(nullptr, std::memory_order_relaxed);
+    m_Free.push_back(chunk);
+    m_Retired[i] = m_Retired.back();
+    m_Retired.pop_back();
+  }
+
+  if (m_Free.empty()) return;
+
+  // Append the free chunks after the last linked chunk so producers can grow into them
+  // without allocating. Every chunk from m_Head onwards is live, so walking is safe.
+  Chunk *last = m_Head;
+  while (!m_Free.empty()) {
+    Chunk *next = last->next.load(std::memory_order_acquire);
+    if (next) {
+      last = next;
+      continue;
+    }
+    Chunk *chunk = m_Free.back();
+    if (last->next.compare_exchange_strong(next, chunk, std::memory_order_acq_rel)) {
+      m_Free.pop_back();
+      last = chunk;
+    } else {
+      last = next;
+    }
   }
-  return &m_EventQueue[m_Tail++ & MAX_EVENTS];
 }
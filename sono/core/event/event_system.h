@@ -4,29 +4,72 @@
 #include <core/common/singleton.h>
 #include <core/system.h>
 #include <core/event/events.h>
+#include <atomic>
+#include <vector>
 
 #define SN_QUEUE_EVENT(e) EventSystem::GetPtr()->Push(e);
 
+/// @brief Multi-producer single-consumer event queue.
+///
+/// Producers (GLFW callbacks, worker threads, ...) never take a lock: a slot is
+/// claimed with a single fetch_add on the tail chunk. When a chunk is full the queue
+/// links another one instead of dropping events. Only the main thread may call Drain().
 class EventSystem
   : public Singleton<EventSystem>
   , public System {
 public:
+  /// @brief Number of events a single chunk holds
+  static constexpr u32 CHUNK_SIZE = 256;
+
   EventSystem();
 
   ~EventSystem();
 
   const char *GetName() const override { return "EventSystem"; }
 
+  /// @brief Enqueue a copy of e and stamp it with the monotonic push tick. Thread safe.
   void Push(const Event &e);
 
-  Event *Pop();
+  /// @brief Append every published event to out, in push order. Consumer thread only.
+  /// @return Number of events drained
+  usize Drain(std::vector<Event> &out);
+
+  /// @brief Number of chunks allocated so far (grows with the largest burst seen)
+  usize GetChunkCount() const { return m_ChunkCount.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    Event event;
+    std::atomic<b8> ready;
+  };
+
+  struct Chunk {
+    std::atomic<u32> reserved; // Slots claimed by producers, may overshoot CHUNK_SIZE
+    std::atomic<u32> pins;     // Producers currently dereferencing this chunk
+    std::atomic<Chunk *> next; // Successor in the queue
+    Chunk *freeNext;           // Link in m_FreeStack
+    Chunk *ownerNext;          // Link in m_Owned, walked on destruction
+    Slot slots[CHUNK_SIZE];
+  };
+
+  Chunk *AllocateChunk();
+
+  void ReleaseChunk(Chunk *chunk);
+
+  void RecycleChunks();
 
 private:
-  static constexpr usize MAX_EVENTS = 255;
+  // Producer side
+  alignas(64) std::atomic<Chunk *> m_Tail;
+  std::atomic<Chunk *> m_FreeStack;
+  std::atomic<Chunk *> m_Owned;
+  std::atomic<usize> m_ChunkCount;
 
-  Event m_EventQueue[MAX_EVENTS + 1];
-  usize m_Head;
-  usize m_Tail;
+  // Consumer side
+  alignas(64) Chunk *m_Head;
+  u32 m_ReadIndex;
+  std::vector<Chunk *> m_Retired;
+  std::vector<Chunk *> m_Free;
 };
 
 #endif // !SN_EVENT_SYSTEM_H
@@ -85,8 +85,26 @@ using EventPayload = std::variant<
 
 // clang-format on
 
+namespace detail {
+template <typename T, typename... Ts>
+constexpr usize IndexOfType(const std::variant<Ts...> *) {
+  usize index = 0;
+  b8 found = false;
+  ((found = found || std::is_same_v<T, Ts>, index += found ? 0 : 1), ...);
+  return index;
+}
+} // namespace detail
+
+/// @brief Index of the payload type T in EventPayload, usable as a compile time constant
+template <typename T>
+inline constexpr usize EventPayloadIndex =
+  detail::IndexOfType<T>(static_cast<const EventPayload *>(nullptr));
+
+inline constexpr usize EVENT_PAYLOAD_COUNT = std::variant_size_v<EventPayload>;
+
 struct Event {
-  i64 time;
+  i64 time; // Source timestamp in Time::Ticks() nanoseconds, taken where the input arrived
+  u64 tick; // Monotonic Time::Ticks() stamped by EventSystem::Push
   EventType type;
   EventPayload payload;
 
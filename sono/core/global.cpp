@@ -15,6 +15,9 @@ void Global::Init() {
   m_MemSys = std::make_unique<MemorySystem>();
   m_MemSys->Init();
 
+  m_ThreadPool = std::make_unique<ThreadPool>();
+  m_ThreadPool->Init();
+
   m_RenderSystem = std::make_unique<GLRenderSystem>();
   m_RenderSystem->Init();
 
@@ -24,6 +27,9 @@ void Global::Init() {
   m_InputSystem = std::make_unique<InputSystem>(m_MemSys->GetGlobalAllocator());
   m_InputSystem->Init();
 
+  m_TweenSystem = std::make_unique<TweenSystem>();
+  m_TweenSystem->Init();
+
 #ifdef SN_DEBUG_PROFILER
   m_Profiler = std::make_unique<Profiler>();
   // m_Profiler->AddSinks<Sono::ConsoleProfileSink>();
@@ -44,11 +50,15 @@ void Global::Shutdown() {
   m_Profiler->Shutdown();
 #endif
 
+  m_TweenSystem->Shutdown();
+
   m_InputSystem->Shutdown();
 
   m_EventSystem->Shutdown();
 
   m_RenderSystem->Shutdown();
 
+  m_ThreadPool->Shutdown();
+
   m_MemSys->Shutdown();
 }
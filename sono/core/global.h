@@ -1,11 +1,13 @@
 #ifndef GLOBAL_H
 #define GLOBAL_H
 
+#include <core/animation/tween_system.h>
 #include <core/common/singleton.h>
 #include <core/event/event_system.h>
 #include <core/memory/memory_system.h>
 #include <core/input/input_system.h>
 #include <core/debug/profiler.h>
+#include <core/thread/thread_pool.h>
 #include <render/render_system.h>
 #include <memory>
 
@@ -21,9 +23,11 @@ public:
 
 private:
   std::unique_ptr<MemorySystem> m_MemSys;
+  std::unique_ptr<ThreadPool> m_ThreadPool;
   std::unique_ptr<RenderSystem> m_RenderSystem;
   std::unique_ptr<EventSystem> m_EventSystem;
   std::unique_ptr<InputSystem> m_InputSystem;
+  std::unique_ptr<TweenSystem> m_TweenSystem;
 
 #ifdef SN_DEBUG_PROFILER
   std::unique_ptr<Profiler> m_Profiler;
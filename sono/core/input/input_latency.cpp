@@ -0,0 +1,65 @@
+#include "input_latency.h"
+#include "core/debug/profiler.h"
+#include <algorithm>
+#include <cmath>
+
+// --------------------------------------------------------------------------------
+static b8 IsInputEvent(EventType type) {
+  switch (type) {
+    case EventType::KEY:
+    case EventType::MOUSE_MOVE:
+    case EventType::MOUSE_BUTTON:
+    case EventType::MOUSE_SCROLL:
+    case EventType::TEXT:
+      return true;
+    case EventType::QUIT:
+    case EventType::WINDOW_RESIZE:
+      return false;
+  }
+  return false;
+}
+// --------------------------------------------------------------------------------
+void InputLatencyTracker::BeginFrame(const Event *events, usize count) {
+  m_PendingTimes.clear();
+  for (usize i = 0; i < count; i++) {
+    if (IsInputEvent(events[i].type) && events[i].time > 0) {
+      m_PendingTimes.push_back((u64)events[i].time);
+    }
+  }
+}
+// --------------------------------------------------------------------------------
+void InputLatencyTracker::EndFrame(u64 presentTicks) {
+  if (m_PendingTimes.empty()) return;
+
+  m_Latencies.clear();
+  for (u64 t : m_PendingTimes) {
+    m_Latencies.push_back(presentTicks > t ? presentTicks - t : 0);
+  }
+  m_PendingTimes.clear();
+
+  m_Stats = ComputeStats(m_Latencies);
+  PROFILE_COUNTER(INPUT_LATENCY_P50, m_Stats.p50Ms);
+  PROFILE_COUNTER(INPUT_LATENCY_P95, m_Stats.p95Ms);
+  PROFILE_COUNTER(INPUT_LATENCY_P99, m_Stats.p99Ms);
+  PROFILE_COUNTER(INPUT_LATENCY_MAX, m_Stats.maxMs);
+}
+// --------------------------------------------------------------------------------
+InputLatencyStats InputLatencyTracker::ComputeStats(std::vector<u64> &latenciesNs) {
+  InputLatencyStats stats;
+  if (latenciesNs.empty()) return stats;
+
+  // Nearest-rank percentile: the smallest sample with at least p of the samples at or
+  // below it. nth_element keeps this O(n) for the handful of events per frame
+  auto percentile = [&latenciesNs](f64 p) {
+    const usize rank = (usize)std::max(std::ceil(p * (f64)latenciesNs.size()), 1.0) - 1;
+    std::nth_element(latenciesNs.begin(), latenciesNs.begin() + rank, latenciesNs.end());
+    return (f64)latenciesNs[rank] * 1e-6;
+  };
+
+  stats.samples = (u32)latenciesNs.size();
+  stats.p50Ms = percentile(0.50);
+  stats.p95Ms = percentile(0.95);
+  stats.p99Ms = percentile(0.99);
+  stats.maxMs = (f64)*std::max_element(latenciesNs.begin(), latenciesNs.end()) * 1e-6;
+  return stats;
+}
@@ -0,0 +1,44 @@
+#ifndef SN_INPUT_LATENCY_H
+#define SN_INPUT_LATENCY_H
+
+#include <core/event/events.h>
+#include <vector>
+
+// Profiler counter names, inline so every TU shares the same pointer key
+inline constexpr const char *INPUT_LATENCY_P50 = "Input Latency p50 (ms)";
+inline constexpr const char *INPUT_LATENCY_P95 = "Input Latency p95 (ms)";
+inline constexpr const char *INPUT_LATENCY_P99 = "Input Latency p99 (ms)";
+inline constexpr const char *INPUT_LATENCY_MAX = "Input Latency max (ms)";
+
+struct InputLatencyStats {
+  f64 p50Ms = 0.0;
+  f64 p95Ms = 0.0;
+  f64 p99Ms = 0.0;
+  f64 maxMs = 0.0;
+  u32 samples = 0;
+};
+
+/// @brief Measures input-to-present latency: the time from an input reaching its GLFW callback
+/// (Event::time) to SwapBuffers returning for the frame that consumed it.
+class InputLatencyTracker {
+public:
+  /// @brief Remember the source timestamps of the input events consumed this frame.
+  /// Call with the raw drained batch, before coalescing merges events.
+  void BeginFrame(const Event *events, usize count);
+
+  /// @brief Resolve this frame's samples against the present timestamp and publish the
+  /// percentiles as profiler counters. Frames without input keep the previous stats.
+  void EndFrame(u64 presentTicks);
+
+  const InputLatencyStats &GetLastFrameStats() const { return m_Stats; }
+
+  /// @brief Compute latency percentiles of the given samples (nanoseconds, reordered in place)
+  static InputLatencyStats ComputeStats(std::vector<u64> &latenciesNs);
+
+private:
+  std::vector<u64> m_PendingTimes;
+  std::vector<u64> m_Latencies;
+  InputLatencyStats m_Stats;
+};
+
+#endif // !SN_INPUT_LATENCY_H
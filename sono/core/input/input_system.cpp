@@ -78,6 +78,63 @@ void InputSystem::InjectEvent(const Event &e) {
   }
 }
 // --------------------------------------------------------------------------------
+void InputSystem::InjectEvents(const Event *events, usize count) {
+  if (count == 0) return;
+  // Activated once for the batch, then the states are written directly
+  ActivateMouse();
+  ActivateKeyboard();
+  MouseState &mouse = *m_MouseState;
+  KeyState &keys = *m_KeyState;
+
+  const MouseMoveEvent *firstMove = nullptr, *lastMove = nullptr;
+  const MouseScrollEvent *lastScroll = nullptr;
+  for (usize i = 0; i < count; i++) {
+    const Event &e = events[i];
+    switch (e.type) {
+      case EventType::KEY: {
+        const KeyEvent &k = *std::get_if<KeyEvent>(&e.payload);
+        if (k.key >= 0 && k.key < 512) keys.currKeys.set(k.key, k.down);
+        break;
+      }
+      case EventType::MOUSE_MOVE:
+        lastMove = std::get_if<MouseMoveEvent>(&e.payload);
+        if (!firstMove) firstMove = lastMove;
+        break;
+      case EventType::MOUSE_BUTTON: {
+        const MouseButtonEvent &b = *std::get_if<MouseButtonEvent>(&e.payload);
+        mouse.currBtns.set(b.button, b.pressed);
+        break;
+      }
+      case EventType::MOUSE_SCROLL:
+        lastScroll = std::get_if<MouseScrollEvent>(&e.payload);
+        break;
+      case EventType::TEXT:
+      case EventType::QUIT:
+      case EventType::WINDOW_RESIZE:
+        break;
+    }
+  }
+
+  // The steps between moves add up, the batch delta is the last position minus the start
+  if (lastMove) {
+    if (m_FirstMouse) {
+      mouse.prePosX = firstMove->xpos;
+      mouse.prePosY = firstMove->ypos;
+      m_FirstMouse = false;
+    }
+    mouse.posX = lastMove->xpos;
+    mouse.posY = lastMove->ypos;
+    mouse.deltaX += mouse.posX - mouse.prePosX;
+    mouse.deltaY += mouse.posY - mouse.prePosY;
+    mouse.prePosX = mouse.posX;
+    mouse.prePosY = mouse.posY;
+  }
+  if (lastScroll) {
+    mouse.scrollDelta = lastScroll->scrollY - mouse.scrollY;
+    mouse.scrollY = lastScroll->scrollY;
+  }
+}
+// --------------------------------------------------------------------------------
 void InputSystem::ActivateMouse() {
   if (!m_MouseState) {
     m_MouseState = m_Allocator.New<MouseState>();
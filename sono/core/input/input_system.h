@@ -42,6 +42,10 @@ public:
 
   void InjectEvent(const Event &e);
 
+  /// @brief Apply a whole frame batch (already coalesced) to the device states. The mouse
+  /// moves of the batch add one delta, from the position before it to its last move.
+  void InjectEvents(const Event *events, usize count);
+
   void EndFrame();
 
   void ActivateMouse();
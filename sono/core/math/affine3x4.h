@@ -0,0 +1,127 @@
+#ifndef SN_AFFINE3X4_H
+#define SN_AFFINE3X4_H
+
+#include "affine3x4_kernels.h"
+#include "core/common/types.h"
+#include "core/math/quaternion.h"
+#include "mat4.h"
+#include "vec3.h"
+#include "vec4.h"
+
+/// @brief Affine transform (rotation, scale, shear and translation) stored in 12 floats instead
+/// of 16. It composes and inverts like a Mat4 whose column 3 is (0, 0, 0, 1), with a quarter less
+/// memory and about half the flops.
+///
+/// n[c] is column c of that Mat4, i.e. (m[0][c], m[1][c], m[2][c], m[3][c]), so the three rows
+/// are also the three vec4 attributes of an instance buffer and a shader rebuilds the matrix with
+/// a transpose. Use ToMat4() only where a full matrix is really needed, e.g. a uniform upload.
+struct Affine3x4 {
+  f32 n[3][4];
+
+  Affine3x4() = default;
+
+  // clang-format off
+  constexpr Affine3x4(const Vec4 &c0, const Vec4 &c1, const Vec4 &c2) {
+    n[0][0] = c0.x; n[0][1] = c0.y; n[0][2] = c0.z; n[0][3] = c0.w;
+    n[1][0] = c1.x; n[1][1] = c1.y; n[1][2] = c1.z; n[1][3] = c1.w;
+    n[2][0] = c2.x; n[2][1] = c2.y; n[2][2] = c2.z; n[2][3] = c2.w;
+  }
+  // clang-format on
+
+  /// @brief Drops column 3 of m, which must be (0, 0, 0, 1) for the result to be the same
+  /// transform
+  constexpr explicit Affine3x4(const Mat4 &m) {
+    for (i32 c = 0; c < 3; c++) {
+      for (i32 r = 0; r < 4; r++) n[c][r] = m.n[r][c];
+    }
+  }
+
+  /// @brief Scale(s) * R * Translation(t), the Transform local matrix. Written out as the
+  /// rotation columns scaled by s with t in the last lane, no matrix products. The rotation terms
+  /// are those of Quaternion::ToMat4, built in place: going through a Mat4 and transposing it
+  /// cost four times the arithmetic (stack round trips).
+  static constexpr Affine3x4 FromTRS(const Vec3 &t, const Quaternion &q, const Vec3 &s) {
+    const f32 xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const f32 xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const f32 wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    // clang-format off
+    return Affine3x4(
+      Vec4((1 - 2 * (yy + zz)) * s.x,      2 * (xy - wz) * s.y,       2 * (xz + wy) * s.z, t.x),
+      Vec4(     2 * (xy + wz) * s.x, (1 - 2 * (xx + zz)) * s.y,       2 * (yz - wx) * s.z, t.y),
+      Vec4(     2 * (xz - wy) * s.x,      2 * (yz + wx) * s.y, (1 - 2 * (xx + yy)) * s.z, t.z)
+    );
+    // clang-format on
+  }
+
+  constexpr Mat4 ToMat4() const {
+    // clang-format off
+    return Mat4(
+      n[0][0], n[1][0], n[2][0], 0.0f,
+      n[0][1], n[1][1], n[2][1], 0.0f,
+      n[0][2], n[1][2], n[2][2], 0.0f,
+      n[0][3], n[1][3], n[2][3], 1.0f
+    );
+    // clang-format on
+  }
+
+  constexpr Vec3 GetTranslation() const { return Vec3(n[0][3], n[1][3], n[2][3]); }
+
+  constexpr void SetTranslation(const Vec3 &v) {
+    n[0][3] = v.x;
+    n[1][3] = v.y;
+    n[2][3] = v.z;
+  }
+
+  /// @brief (p, 1) * M, same result as Vec4(p, 1) * ToMat4()
+  constexpr Vec3 TransformPoint(const Vec3 &p) const {
+    return Vec3(
+      n[0][0] * p.x + n[0][1] * p.y + n[0][2] * p.z + n[0][3],
+      n[1][0] * p.x + n[1][1] * p.y + n[1][2] * p.z + n[1][3],
+      n[2][0] * p.x + n[2][1] * p.y + n[2][2] * p.z + n[2][3]
+    );
+  }
+
+  /// @brief (d, 0) * M, ignores the translation
+  constexpr Vec3 TransformDirection(const Vec3 &d) const {
+    return Vec3(
+      n[0][0] * d.x + n[0][1] * d.y + n[0][2] * d.z,
+      n[1][0] * d.x + n[1][1] * d.y + n[1][2] * d.z,
+      n[2][0] * d.x + n[2][1] * d.y + n[2][2] * d.z
+    );
+  }
+
+  /// @brief this applied first, then rhs, matching Mat4 A * B
+  inline Affine3x4 operator*(const Affine3x4 &rhs) const {
+    Affine3x4 r;
+    Sono::Affine3x4Multiply(ValuePtr(), rhs.ValuePtr(), r.ValuePtr());
+    return r;
+  }
+
+  inline Affine3x4 &operator*=(const Affine3x4 &rhs) {
+    Sono::Affine3x4Multiply(ValuePtr(), rhs.ValuePtr(), ValuePtr());
+    return *this;
+  }
+
+  /// @brief A singular 3x3 part yields non finite values
+  inline Affine3x4 Inversed() const {
+    Affine3x4 r;
+    Sono::Affine3x4Inverse(ValuePtr(), r.ValuePtr());
+    return r;
+  }
+
+  inline const f32 *ValuePtr() const { return &n[0][0]; }
+
+  inline f32 *ValuePtr() { return &n[0][0]; }
+
+  static const Affine3x4 Identity;
+};
+
+inline constexpr Affine3x4 Affine3x4::Identity(
+  Vec4(1.0f, 0.0f, 0.0f, 0.0f), Vec4(0.0f, 1.0f, 0.0f, 0.0f), Vec4(0.0f, 0.0f, 1.0f, 0.0f)
+);
+
+static_assert(std::is_trivially_copyable_v<Affine3x4> && std::is_standard_layout_v<Affine3x4>);
+static_assert(sizeof(Affine3x4) == 12 * sizeof(f32));
+
+#endif // !SN_AFFINE3X4_H
@@ -0,0 +1,165 @@
+#ifndef SN_AFFINE3X4_KERNELS_H
+#define SN_AFFINE3X4_KERNELS_H
+
+#include "mat4_kernels.h"
+#include "simd.h"
+#include <core/common/types.h>
+
+// Affine transform kernels over 12 floats (Affine3x4::n[col][row]). Row c holds column c of the
+// equivalent row vector Mat4, so its last float is the translation component and a point
+// transforms as p'[c] = dot(n[c], (p, 1)). The implicit fourth column is (0, 0, 0, 1) and never
+// stored or multiplied. Every kernel reads all of its inputs before writing, so out may alias
+// either operand.
+
+namespace Sono {
+
+namespace Scalar {
+
+// --------------------------------------------------------------------------------
+/// out = a * b, a applied first like the Mat4 product
+inline void Affine3x4Multiply(const f32 *a, const f32 *b, f32 *out) {
+  f32 r[12];
+  for (i32 c = 0; c < 3; c++) {
+    const f32 b0 = b[c * 4 + 0], b1 = b[c * 4 + 1], b2 = b[c * 4 + 2];
+    for (i32 i = 0; i < 4; i++) r[c * 4 + i] = b0 * a[i] + b1 * a[4 + i] + b2 * a[8 + i];
+    r[c * 4 + 3] += b[c * 4 + 3];
+  }
+  for (i32 i = 0; i < 12; i++) out[i] = r[i];
+}
+// --------------------------------------------------------------------------------
+/// Inverse through the cross products of the 3x3 rows, see Scalar::Mat4InverseAffine. The
+/// adjugate columns come out as the columns of the inverse, which is what the rows store.
+/// @return false if the 3x3 part is singular
+inline b8 Affine3x4Inverse(const f32 *m, f32 *out) {
+  const f32 a0[3] = {m[0], m[1], m[2]};
+  const f32 a1[3] = {m[4], m[5], m[6]};
+  const f32 a2[3] = {m[8], m[9], m[10]};
+  const f32 t[3] = {m[3], m[7], m[11]};
+
+  f32 c[3][3] = {
+    {a1[1] * a2[2] - a1[2] * a2[1], a1[2] * a2[0] - a1[0] * a2[2], a1[0] * a2[1] - a1[1] * a2[0]},
+    {a2[1] * a0[2] - a2[2] * a0[1], a2[2] * a0[0] - a2[0] * a0[2], a2[0] * a0[1] - a2[1] * a0[0]},
+    {a0[1] * a1[2] - a0[2] * a1[1], a0[2] * a1[0] - a0[0] * a1[2], a0[0] * a1[1] - a0[1] * a1[0]},
+  };
+
+  const f32 det = a0[0] * c[0][0] + a0[1] * c[0][1] + a0[2] * c[0][2];
+  const f32 invDet = 1.0f / det;
+
+  f32 r[12];
+  for (i32 i = 0; i < 3; i++) {
+    r[i * 4 + 0] = c[0][i] * invDet;
+    r[i * 4 + 1] = c[1][i] * invDet;
+    r[i * 4 + 2] = c[2][i] * invDet;
+    r[i * 4 + 3] = -(t[0] * r[i * 4 + 0] + t[1] * r[i * 4 + 1] + t[2] * r[i * 4 + 2]);
+  }
+
+  for (i32 i = 0; i < 12; i++) out[i] = r[i];
+  return det != 0.0f;
+}
+
+} // namespace Scalar
+
+#if defined(SN_SIMD_SSE)
+// ================================================================================
+// SSE / AVX
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+inline void Affine3x4Multiply(const f32 *a, const f32 *b, f32 *out) {
+  using namespace Simd;
+  const __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+  const __m128 a0 = _mm_loadu_ps(a + 0);
+  const __m128 a1 = _mm_loadu_ps(a + 4);
+  const __m128 a2 = _mm_loadu_ps(a + 8);
+
+  // The translation goes in last, the same summation order as Mat4Multiply
+  auto row = [&](__m128 br) {
+    __m128 r = _mm_mul_ps(Splat<0>(br), a0);
+    r = MulAdd(Splat<1>(br), a1, r);
+    r = MulAdd(Splat<2>(br), a2, r);
+    return _mm_add_ps(r, _mm_and_ps(br, wMask));
+  };
+  const __m128 r0 = row(_mm_loadu_ps(b + 0));
+  const __m128 r1 = row(_mm_loadu_ps(b + 4));
+  const __m128 r2 = row(_mm_loadu_ps(b + 8));
+  _mm_storeu_ps(out + 0, r0);
+  _mm_storeu_ps(out + 4, r1);
+  _mm_storeu_ps(out + 8, r2);
+}
+// --------------------------------------------------------------------------------
+/// See Scalar::Affine3x4Inverse. The new translation is built next to the adjugate columns so
+/// one transpose produces all three output rows.
+/// @return false if the 3x3 part is singular
+inline b8 Affine3x4Inverse(const f32 *m, f32 *out) {
+  using namespace Simd;
+  const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+  const __m128 m0 = _mm_loadu_ps(m + 0);
+  const __m128 m1 = _mm_loadu_ps(m + 4);
+  const __m128 m2 = _mm_loadu_ps(m + 8);
+  const __m128 a0 = _mm_and_ps(m0, xyzMask);
+  const __m128 a1 = _mm_and_ps(m1, xyzMask);
+  const __m128 a2 = _mm_and_ps(m2, xyzMask);
+
+  __m128 c0 = Cross3(a1, a2);
+  __m128 c1 = Cross3(a2, a0);
+  __m128 c2 = Cross3(a0, a1);
+
+  __m128 det = _mm_mul_ps(a0, c0);
+  det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+  det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+  const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+  c0 = _mm_mul_ps(c0, invDet);
+  c1 = _mm_mul_ps(c1, invDet);
+  c2 = _mm_mul_ps(c2, invDet);
+
+  __m128 nt = _mm_mul_ps(Splat<3>(m0), c0);
+  nt = MulAdd(Splat<3>(m1), c1, nt);
+  nt = MulAdd(Splat<3>(m2), c2, nt);
+  nt = _mm_sub_ps(_mm_setzero_ps(), nt);
+
+  _MM_TRANSPOSE4_PS(c0, c1, c2, nt);
+  _mm_storeu_ps(out + 0, c0);
+  _mm_storeu_ps(out + 4, c1);
+  _mm_storeu_ps(out + 8, c2);
+
+  return _mm_cvtss_f32(det) != 0.0f;
+}
+
+#elif defined(SN_SIMD_NEON)
+// ================================================================================
+// NEON
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+inline void Affine3x4Multiply(const f32 *a, const f32 *b, f32 *out) {
+  const float32x4_t a0 = vld1q_f32(a + 0);
+  const float32x4_t a1 = vld1q_f32(a + 4);
+  const float32x4_t a2 = vld1q_f32(a + 8);
+  const uint32x4_t wMask = {0, 0, 0, 0xffffffffu};
+
+  auto row = [&](float32x4_t br) {
+    float32x4_t r = vmulq_laneq_f32(a0, br, 0);
+    r = vfmaq_laneq_f32(r, a1, br, 1);
+    r = vfmaq_laneq_f32(r, a2, br, 2);
+    return vaddq_f32(r, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(br), wMask)));
+  };
+  const float32x4_t r0 = row(vld1q_f32(b + 0));
+  const float32x4_t r1 = row(vld1q_f32(b + 4));
+  const float32x4_t r2 = row(vld1q_f32(b + 8));
+  vst1q_f32(out + 0, r0);
+  vst1q_f32(out + 4, r1);
+  vst1q_f32(out + 8, r2);
+}
+// --------------------------------------------------------------------------------
+inline b8 Affine3x4Inverse(const f32 *m, f32 *out) { return Scalar::Affine3x4Inverse(m, out); }
+
+#else
+
+using Scalar::Affine3x4Inverse;
+using Scalar::Affine3x4Multiply;
+
+#endif
+
+} // namespace Sono
+
+#endif // !SN_AFFINE3X4_KERNELS_H
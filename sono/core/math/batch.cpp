@@ -0,0 +1,422 @@
+#include <core/common/snassert.h>
+#include <core/math/batch.h>
+#include <core/math/batch_kernels.h>
+#include <core/math/ease.h>
+#include <core/math/frustum.h>
+#include <core/math/quantize.h>
+#include <core/math/simd.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+using namespace Sono::BatchImpl;
+using Sono::SimdLevel;
+
+namespace {
+
+#if defined(SN_SIMD_SSE)
+// Baseline lanes, this translation unit is built without extra -m flags
+struct F4 {
+  using V = __m128;
+  using I = __m128i;
+  using M = __m128i;
+  static constexpr usize WIDTH = 4;
+
+  static V Load(const f32 *p) { return _mm_loadu_ps(p); }
+  static void Store(f32 *p, V v) { _mm_storeu_ps(p, v); }
+  static V Set1(f32 v) { return _mm_set1_ps(v); }
+  static V Add(V a, V b) { return _mm_add_ps(a, b); }
+  static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+  static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+  static V Div(V a, V b) { return _mm_div_ps(a, b); }
+  static V MulAdd(V a, V b, V c) { return Sono::Simd::MulAdd(a, b, c); }
+  static V Min(V a, V b) { return _mm_min_ps(a, b); }
+  static V Max(V a, V b) { return _mm_max_ps(a, b); }
+  static V Sqrt(V v) { return _mm_sqrt_ps(v); }
+  static V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static V InvSqrtOrZero(V v) {
+    const V inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(v));
+    return _mm_and_ps(inv, _mm_cmpgt_ps(v, _mm_setzero_ps()));
+  }
+  static u32 NonNegativeMask(V v) {
+    return (u32)_mm_movemask_ps(_mm_cmpge_ps(v, _mm_setzero_ps()));
+  }
+  static usize AppendIndices(u32 mask, usize base, u32 *out, usize n) {
+    return AppendIndicesBranchless<WIDTH>(mask, base, out, n);
+  }
+  static I Round(V v) { return _mm_cvtps_epi32(v); }
+  static V ToFloat(I v) { return _mm_cvtepi32_ps(v); }
+  static I AsInt(V v) { return _mm_castps_si128(v); }
+  static V AsFloat(I v) { return _mm_castsi128_ps(v); }
+  static V Select(M m, V a, V b) {
+    const V mf = _mm_castsi128_ps(m);
+    return _mm_or_ps(_mm_and_ps(mf, a), _mm_andnot_ps(mf, b));
+  }
+  static M Less(V a, V b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+  static I LoadU32(const u32 *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+  static void StoreU32(u32 *p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+  static I LoadU16(const u16 *p) {
+    const I v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+    return _mm_unpacklo_epi16(v, _mm_setzero_si128());
+  }
+  // SSE2 only has the signed saturating pack, shift into its range and flip the top bit back
+  static void StoreU16(u16 *p, I v) {
+    const I biased = _mm_sub_epi32(v, _mm_set1_epi32(0x8000));
+    const I packed = _mm_xor_si128(_mm_packs_epi32(biased, biased), _mm_set1_epi16(-0x8000));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(p), packed);
+  }
+  static void StoreU8(u8 *p, I v) {
+    const I words = _mm_packs_epi32(v, v);
+    const i32 bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    memcpy(p, &bytes, sizeof(bytes));
+  }
+  static I LoadU32Aos4(const u32 *p) { return LoadU32(p); }
+  static void StoreU32Aos4(u32 *p, I v) { StoreU32(p, v); }
+  static I Set1I(u32 v) { return _mm_set1_epi32((i32)v); }
+  static I AddI(I a, I b) { return _mm_add_epi32(a, b); }
+  static I SubI(I a, I b) { return _mm_sub_epi32(a, b); }
+  static I AndI(I a, I b) { return _mm_and_si128(a, b); }
+  static I OrI(I a, I b) { return _mm_or_si128(a, b); }
+  static I XorI(I a, I b) { return _mm_xor_si128(a, b); }
+  static I ShiftLeft(I v, u32 n) { return _mm_sll_epi32(v, _mm_cvtsi32_si128((i32)n)); }
+  static I ShiftRight(I v, u32 n) { return _mm_srl_epi32(v, _mm_cvtsi32_si128((i32)n)); }
+  static M GreaterI(I a, I b) { return _mm_cmpgt_epi32(a, b); }
+  static I SelectI(M m, I a, I b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+  }
+  static void LoadAos4(const f32 *p, V &a, V &b, V &c, V &d) {
+    a = _mm_loadu_ps(p);
+    b = _mm_loadu_ps(p + 4);
+    c = _mm_loadu_ps(p + 8);
+    d = _mm_loadu_ps(p + 12);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+  }
+  static void StoreAos4(f32 *p, usize stride, V a, V b, V c, V d) {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(p, a);
+    _mm_storeu_ps(p + stride, b);
+    _mm_storeu_ps(p + 2 * stride, c);
+    _mm_storeu_ps(p + 3 * stride, d);
+  }
+};
+#elif defined(SN_SIMD_NEON)
+struct F4 {
+  using V = float32x4_t;
+  using I = uint32x4_t;
+  using M = uint32x4_t;
+  static constexpr usize WIDTH = 4;
+
+  static V Load(const f32 *p) { return vld1q_f32(p); }
+  static void Store(f32 *p, V v) { vst1q_f32(p, v); }
+  static V Set1(f32 v) { return vdupq_n_f32(v); }
+  static V Add(V a, V b) { return vaddq_f32(a, b); }
+  static V Sub(V a, V b) { return vsubq_f32(a, b); }
+  static V Mul(V a, V b) { return vmulq_f32(a, b); }
+  static V Div(V a, V b) { return vdivq_f32(a, b); }
+  static V MulAdd(V a, V b, V c) { return vfmaq_f32(c, a, b); }
+  static V Min(V a, V b) { return vminq_f32(a, b); }
+  static V Max(V a, V b) { return vmaxq_f32(a, b); }
+  static V Sqrt(V v) { return vsqrtq_f32(v); }
+  static V Abs(V a) { return vabsq_f32(a); }
+  static V InvSqrtOrZero(V v) {
+    const V inv = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(v));
+    const uint32x4_t positive = vcgtq_f32(v, vdupq_n_f32(0.0f));
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(inv), positive));
+  }
+  static u32 NonNegativeMask(V v) {
+    const uint32x4_t bits = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(vcgeq_f32(v, vdupq_n_f32(0.0f)), bits));
+  }
+  static usize AppendIndices(u32 mask, usize base, u32 *out, usize n) {
+    return AppendIndicesBranchless<WIDTH>(mask, base, out, n);
+  }
+  static I Round(V v) { return vreinterpretq_u32_s32(vcvtnq_s32_f32(v)); }
+  static V ToFloat(I v) { return vcvtq_f32_s32(vreinterpretq_s32_u32(v)); }
+  static I AsInt(V v) { return vreinterpretq_u32_f32(v); }
+  static V AsFloat(I v) { return vreinterpretq_f32_u32(v); }
+  static V Select(M m, V a, V b) { return vbslq_f32(m, a, b); }
+  static M Less(V a, V b) { return vcltq_f32(a, b); }
+  static I LoadU32(const u32 *p) { return vld1q_u32(p); }
+  static void StoreU32(u32 *p, I v) { vst1q_u32(p, v); }
+  static I LoadU16(const u16 *p) { return vmovl_u16(vld1_u16(p)); }
+  static void StoreU16(u16 *p, I v) { vst1_u16(p, vmovn_u32(v)); }
+  static void StoreU8(u8 *p, I v) {
+    const uint16x4_t words = vmovn_u32(v);
+    u8 bytes[8];
+    vst1_u8(bytes, vmovn_u16(vcombine_u16(words, words)));
+    memcpy(p, bytes, 4);
+  }
+  static I LoadU32Aos4(const u32 *p) { return LoadU32(p); }
+  static void StoreU32Aos4(u32 *p, I v) { StoreU32(p, v); }
+  static I Set1I(u32 v) { return vdupq_n_u32(v); }
+  static I AddI(I a, I b) { return vaddq_u32(a, b); }
+  static I SubI(I a, I b) { return vsubq_u32(a, b); }
+  static I AndI(I a, I b) { return vandq_u32(a, b); }
+  static I OrI(I a, I b) { return vorrq_u32(a, b); }
+  static I XorI(I a, I b) { return veorq_u32(a, b); }
+  static I ShiftLeft(I v, u32 n) { return vshlq_u32(v, vdupq_n_s32((i32)n)); }
+  static I ShiftRight(I v, u32 n) { return vshlq_u32(v, vdupq_n_s32(-(i32)n)); }
+  static M GreaterI(I a, I b) {
+    return vcgtq_s32(vreinterpretq_s32_u32(a), vreinterpretq_s32_u32(b));
+  }
+  static I SelectI(M m, I a, I b) { return vbslq_u32(m, a, b); }
+  static void LoadAos4(const f32 *p, V &a, V &b, V &c, V &d) {
+    const float32x4x4_t groups = vld4q_f32(p);
+    a = groups.val[0];
+    b = groups.val[1];
+    c = groups.val[2];
+    d = groups.val[3];
+  }
+  static void StoreAos4(f32 *p, usize stride, V a, V b, V c, V d) {
+    const float32x4x2_t ab = vtrnq_f32(a, b);
+    const float32x4x2_t cd = vtrnq_f32(c, d);
+    vst1q_f32(p, vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0])));
+    vst1q_f32(p + stride, vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1])));
+    vst1q_f32(p + 2 * stride, vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0])));
+    vst1q_f32(p + 3 * stride, vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1])));
+  }
+};
+#endif
+
+constexpr Kernels s_ScalarKernels = MakeKernels<F1>();
+#if defined(SN_SIMD_SSE) || defined(SN_SIMD_NEON)
+constexpr Kernels s_BaselineKernels = MakeKernels<F4>();
+#endif
+
+// --------------------------------------------------------------------------------
+b8 CpuHasAvx2() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  return __builtin_cpu_supports("avx2") != 0 && __builtin_cpu_supports("fma") != 0 &&
+    __builtin_cpu_supports("f16c") != 0;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  i32 info[4];
+  __cpuid(info, 1);
+  const b8 osxsave = (info[2] & (1 << 27)) != 0;
+  const b8 fma = (info[2] & (1 << 12)) != 0 && (info[2] & (1 << 29)) != 0; // and F16C
+  if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+  __cpuidex(info, 7, 0);
+  return fma && (info[1] & (1 << 5)) != 0;
+#else
+  return false;
+#endif
+}
+// --------------------------------------------------------------------------------
+b8 CpuHasAvx512() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  return __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("fma") != 0;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  i32 info[4];
+  __cpuid(info, 1);
+  if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0xe6) != 0xe6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 16)) != 0;
+#else
+  return false;
+#endif
+}
+// --------------------------------------------------------------------------------
+const Kernels *GetKernels(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::SCALAR:
+      return &s_ScalarKernels;
+#if defined(SN_SIMD_SSE)
+    case SimdLevel::SSE2:
+      return &s_BaselineKernels;
+#elif defined(SN_SIMD_NEON)
+    case SimdLevel::NEON:
+      return &s_BaselineKernels;
+#endif
+    case SimdLevel::AVX2:
+      return CpuHasAvx2() ? GetKernelsAvx2() : nullptr;
+    case SimdLevel::AVX512:
+      return CpuHasAvx512() ? GetKernelsAvx512() : nullptr;
+    default:
+      return nullptr;
+  }
+}
+
+struct Dispatch {
+  SimdLevel level;
+  const Kernels *kernels;
+
+  Dispatch() {
+    constexpr SimdLevel preferred[] = {
+      SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE2, SimdLevel::NEON, SimdLevel::SCALAR
+    };
+    for (SimdLevel candidate : preferred) {
+      if (const Kernels *k = GetKernels(candidate)) {
+        level = candidate;
+        kernels = k;
+        return;
+      }
+    }
+  }
+};
+
+// --------------------------------------------------------------------------------
+Dispatch &GetDispatch() {
+  static Dispatch s_Dispatch;
+  return s_Dispatch;
+}
+
+} // namespace
+
+namespace Sono {
+
+// --------------------------------------------------------------------------------
+const char *ToString(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::SCALAR:
+      return "scalar";
+    case SimdLevel::SSE2:
+      return "sse2";
+    case SimdLevel::NEON:
+      return "neon";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+// --------------------------------------------------------------------------------
+b8 IsSimdLevelSupported(SimdLevel level) { return GetKernels(level) != nullptr; }
+// --------------------------------------------------------------------------------
+SimdLevel GetSimdLevel() { return GetDispatch().level; }
+// --------------------------------------------------------------------------------
+b8 SetSimdLevel(SimdLevel level) {
+  const Kernels *k = GetKernels(level);
+  if (!k) return false;
+  GetDispatch().level = level;
+  GetDispatch().kernels = k;
+  return true;
+}
+// --------------------------------------------------------------------------------
+void TransformPoints(const Mat4 &m, ConstVec3Soa in, usize count, Vec3Soa out) {
+  GetDispatch().kernels->transformPoints(
+    m.ValuePtr(), in.x, in.y, in.z, count, out.x, out.y, out.z
+  );
+}
+// --------------------------------------------------------------------------------
+void TransformDirections(const Mat4 &m, ConstVec3Soa in, usize count, Vec3Soa out) {
+  GetDispatch().kernels->transformDirections(
+    m.ValuePtr(), in.x, in.y, in.z, count, out.x, out.y, out.z
+  );
+}
+// --------------------------------------------------------------------------------
+void Normalize(Vec3Soa v, usize count) { GetDispatch().kernels->normalize(v.x, v.y, v.z, count); }
+// --------------------------------------------------------------------------------
+void Dot(ConstVec3Soa a, ConstVec3Soa b, usize count, f32 *out) {
+  GetDispatch().kernels->dot(a.x, a.y, a.z, b.x, b.y, b.z, count, out);
+}
+// --------------------------------------------------------------------------------
+void Cross(ConstVec3Soa a, ConstVec3Soa b, usize count, Vec3Soa out) {
+  GetDispatch().kernels->cross(a.x, a.y, a.z, b.x, b.y, b.z, count, out.x, out.y, out.z);
+}
+// --------------------------------------------------------------------------------
+void TransformAABBs(
+  const Mat4 &m, ConstVec3Soa centers, ConstVec3Soa extents, usize count, Vec3Soa outCenters,
+  Vec3Soa outExtents
+) {
+  GetDispatch().kernels->transformAABBs(
+    m.ValuePtr(), centers.x, centers.y, centers.z, extents.x, extents.y, extents.z, count,
+    outCenters.x, outCenters.y, outCenters.z, outExtents.x, outExtents.y, outExtents.z
+  );
+}
+
+// --------------------------------------------------------------------------------
+void QuaternionsToMat4(const Quaternion *q, usize count, Mat4 *out) {
+  GetDispatch().kernels->quaternionsToMat4(
+    reinterpret_cast<const f32 *>(q), count, reinterpret_cast<f32 *>(out)
+  );
+}
+// --------------------------------------------------------------------------------
+usize CullSpheres(
+  const Frustum &frustum, ConstVec3Soa centers, const f32 *radii, usize count, u32 *outIndices
+) {
+  return GetDispatch().kernels->cullSpheres(
+    frustum.ValuePtr(), centers.x, centers.y, centers.z, radii, count, outIndices
+  );
+}
+// --------------------------------------------------------------------------------
+usize CullAABBs(
+  const Frustum &frustum, ConstVec3Soa centers, ConstVec3Soa extents, usize count, u32 *outIndices
+) {
+  return GetDispatch().kernels->cullAABBs(
+    frustum.ValuePtr(), centers.x, centers.y, centers.z, extents.x, extents.y, extents.z, count,
+    outIndices
+  );
+}
+// --------------------------------------------------------------------------------
+void PackQuaternions(const Quaternion *q, usize count, u32 bits, u32 *out) {
+  SN_ASSERT(bits >= QUATERNION_PACK_MIN_BITS && bits <= 10, "Packed quaternion must fit a u32");
+  GetDispatch().kernels->packQuaternions(reinterpret_cast<const f32 *>(q), count, bits, out);
+}
+// --------------------------------------------------------------------------------
+void UnpackQuaternions(const u32 *packed, usize count, u32 bits, Quaternion *out) {
+  SN_ASSERT(bits >= QUATERNION_PACK_MIN_BITS && bits <= 10, "Packed quaternion must fit a u32");
+  GetDispatch().kernels->unpackQuaternions(packed, count, bits, reinterpret_cast<f32 *>(out));
+}
+// --------------------------------------------------------------------------------
+void QuantizePositions(const AABB &cell, ConstVec3Soa in, usize count, u32 bits, Vec3U16Soa out) {
+  SN_ASSERT(bits >= 1 && bits <= 16, "Quantized axis must fit a u16");
+  GetDispatch().kernels->quantizePositions(
+    &cell.min.x, in.x, in.y, in.z, count, bits, out.x, out.y, out.z
+  );
+}
+// --------------------------------------------------------------------------------
+void DequantizePositions(const AABB &cell, ConstVec3U16Soa in, usize count, u32 bits, Vec3Soa out) {
+  SN_ASSERT(bits >= 1 && bits <= 16, "Quantized axis must fit a u16");
+  GetDispatch().kernels->dequantizePositions(
+    &cell.min.x, in.x, in.y, in.z, count, bits, out.x, out.y, out.z
+  );
+}
+// --------------------------------------------------------------------------------
+void FloatsToHalves(const f32 *in, usize count, u16 *out) {
+  GetDispatch().kernels->floatsToHalves(in, count, out);
+}
+// --------------------------------------------------------------------------------
+void HalvesToFloats(const u16 *in, usize count, f32 *out) {
+  GetDispatch().kernels->halvesToFloats(in, count, out);
+}
+// --------------------------------------------------------------------------------
+void EvaluateEase(Ease ease, const f32 *t, usize count, f32 *out) {
+  SN_ASSERT(ease < Ease::COUNT, "Unknown easing curve");
+  GetDispatch().kernels->evaluateEase(ease, t, count, out);
+}
+// --------------------------------------------------------------------------------
+void FloatsToSnorm8(const f32 *in, usize count, i8 *out) {
+  GetDispatch().kernels->floatsToNorm8(in, count, -1.0f, 127.0f, reinterpret_cast<u8 *>(out));
+}
+// --------------------------------------------------------------------------------
+void FloatsToSnorm16(const f32 *in, usize count, i16 *out) {
+  GetDispatch().kernels->floatsToNorm16(in, count, -1.0f, 32767.0f, reinterpret_cast<u16 *>(out));
+}
+// --------------------------------------------------------------------------------
+void FloatsToUnorm8(const f32 *in, usize count, u8 *out) {
+  GetDispatch().kernels->floatsToNorm8(in, count, 0.0f, 255.0f, out);
+}
+// --------------------------------------------------------------------------------
+void FloatsToUnorm16(const f32 *in, usize count, u16 *out) {
+  GetDispatch().kernels->floatsToNorm16(in, count, 0.0f, 65535.0f, out);
+}
+// --------------------------------------------------------------------------------
+void EncodeOctahedral(ConstVec3Soa in, usize count, i16 *outX, i16 *outY) {
+  GetDispatch().kernels->encodeOctahedral(
+    in.x, in.y, in.z, count, reinterpret_cast<u16 *>(outX), reinterpret_cast<u16 *>(outY)
+  );
+}
+// --------------------------------------------------------------------------------
+f32 IntersectRayTriangles(
+  const Vec3 &origin, const Vec3 &dir, ConstVec3Soa v0, ConstVec3Soa edge1, ConstVec3Soa edge2,
+  usize count, f32 maxT, u32 *outIndex
+) {
+  const f32 ray[6] = {origin.x, origin.y, origin.z, dir.x, dir.y, dir.z};
+  return GetDispatch().kernels->intersectRayTriangles(
+    ray, v0.x, v0.y, v0.z, edge1.x, edge1.y, edge1.z, edge2.x, edge2.y, edge2.z, count, maxT,
+    outIndex
+  );
+}
+
+} // namespace Sono
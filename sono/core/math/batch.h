@@ -0,0 +1,175 @@
+#ifndef SN_BATCH_H
+#define SN_BATCH_H
+
+#include <core/common/types.h>
+#include <core/math/mat4.h>
+#include <core/math/quaternion.h>
+
+// Structure of arrays math over many vectors at once. Each stream is three parallel f32 arrays
+// and every operation processes 4, 8 or 16 lanes per step depending on the instruction set
+// picked at startup (SSE2 / NEON baseline, AVX2+FMA or AVX-512 when the CPU has them).
+//
+// Outputs may alias the inputs index for index, e.g. Normalize in place or TransformPoints
+// with out == in.
+
+// Only named by the culling, quantization and easing entry points, callers include their headers
+struct AABB;
+struct Frustum;
+enum class Ease : u8;
+
+namespace Sono {
+
+/// @brief Three parallel arrays holding the x, y and z components of a vector stream
+struct Vec3Soa {
+  f32 *x;
+  f32 *y;
+  f32 *z;
+};
+
+struct ConstVec3Soa {
+  const f32 *x;
+  const f32 *y;
+  const f32 *z;
+
+  ConstVec3Soa(const f32 *x, const f32 *y, const f32 *z)
+    : x(x)
+    , y(y)
+    , z(z) {}
+
+  ConstVec3Soa(const Vec3Soa &v)
+    : x(v.x)
+    , y(v.y)
+    , z(v.z) {}
+};
+
+/// @brief Quantized vector stream, see QuantizePositions
+struct Vec3U16Soa {
+  u16 *x;
+  u16 *y;
+  u16 *z;
+};
+
+struct ConstVec3U16Soa {
+  const u16 *x;
+  const u16 *y;
+  const u16 *z;
+
+  ConstVec3U16Soa(const u16 *x, const u16 *y, const u16 *z)
+    : x(x)
+    , y(y)
+    , z(z) {}
+
+  ConstVec3U16Soa(const Vec3U16Soa &v)
+    : x(v.x)
+    , y(v.y)
+    , z(v.z) {}
+};
+
+enum class SimdLevel : u8 { SCALAR, SSE2, NEON, AVX2, AVX512 };
+
+const char *ToString(SimdLevel level);
+
+/// @brief Whether this build and CPU can run the batch kernels at level
+b8 IsSimdLevelSupported(SimdLevel level);
+
+/// @brief The level the batch kernels currently run at, the widest supported one by default
+SimdLevel GetSimdLevel();
+
+/// @brief Force the batch kernels to a narrower level (tests and benchmarks)
+/// @return false if level is not supported, the current level is kept
+b8 SetSimdLevel(SimdLevel level);
+
+/// @brief out[i] = in[i] * m with w = 1 (row vector point transform, no perspective divide)
+void TransformPoints(const Mat4 &m, ConstVec3Soa in, usize count, Vec3Soa out);
+
+/// @brief out[i] = in[i] * m with w = 0, translation is ignored
+void TransformDirections(const Mat4 &m, ConstVec3Soa in, usize count, Vec3Soa out);
+
+/// @brief Normalize every vector in place, zero length vectors stay zero
+void Normalize(Vec3Soa v, usize count);
+
+/// @brief out[i] = a[i] . b[i]
+void Dot(ConstVec3Soa a, ConstVec3Soa b, usize count, f32 *out);
+
+/// @brief out[i] = a[i] x b[i]
+void Cross(ConstVec3Soa a, ConstVec3Soa b, usize count, Vec3Soa out);
+
+/// @brief Transform center / half extent boxes by an affine matrix. The results are the
+/// axis aligned boxes enclosing the transformed boxes.
+void TransformAABBs(
+  const Mat4 &m, ConstVec3Soa centers, ConstVec3Soa extents, usize count, Vec3Soa outCenters,
+  Vec3Soa outExtents
+);
+
+/// @brief out[i] = q[i].ToMat4() for an array of unit quaternions
+void QuaternionsToMat4(const Quaternion *q, usize count, Mat4 *out);
+
+/// @brief Frustum test for bounding spheres, the same test as Frustum::Intersects per sphere.
+/// The indices of the visible spheres are written to outIndices in increasing order, which
+/// needs room for count entries (entries past the returned size are scratch).
+/// @return the number of visible spheres
+usize CullSpheres(
+  const Frustum &frustum, ConstVec3Soa centers, const f32 *radii, usize count, u32 *outIndices
+);
+
+/// @brief Frustum test for center / half extent boxes, the same test as Frustum::Intersects per
+/// box and the same output contract as CullSpheres
+/// @return the number of visible boxes
+usize CullAABBs(
+  const Frustum &frustum, ConstVec3Soa centers, ConstVec3Soa extents, usize count, u32 *outIndices
+);
+
+/// @brief out[i] = Sono::PackQuaternion(q[i], bits), bit for bit on every level. bits is at most
+/// 10 so each code fits a u32.
+void PackQuaternions(const Quaternion *q, usize count, u32 bits, u32 *out);
+
+/// @brief out[i] = Sono::UnpackQuaternion(packed[i], bits) up to rounding
+void UnpackQuaternions(const u32 *packed, usize count, u32 bits, Quaternion *out);
+
+/// @brief The axis fields of Sono::PackPosition, one array per axis, bits at most 16
+void QuantizePositions(const AABB &cell, ConstVec3Soa in, usize count, u32 bits, Vec3U16Soa out);
+
+/// @brief Inverse of QuantizePositions, Sono::UnpackPosition per element up to rounding
+void DequantizePositions(const AABB &cell, ConstVec3U16Soa in, usize count, u32 bits, Vec3Soa out);
+
+/// @brief out[i] = Sono::FloatToHalf(in[i]), bit for bit on every level except for NaN payloads
+/// (the AVX2 and AVX-512 levels use the hardware conversion)
+void FloatsToHalves(const f32 *in, usize count, u16 *out);
+
+/// @brief out[i] = Sono::HalfToFloat(in[i]), exact
+void HalvesToFloats(const u16 *in, usize count, f32 *out);
+
+/// @brief out[i] = Sono::GetEaseFunction(ease)(t[i]) for t[i] in [0, 1], within about 1e-6 of
+/// the scalar curve (the sines and exponentials are polynomial approximations)
+void EvaluateEase(Ease ease, const f32 *t, usize count, f32 *out);
+
+/// @brief out[i] = Sono::FloatToSnorm8(in[i]), bit for bit on every level. The normalized
+/// conversions leave NaN inputs unspecified.
+void FloatsToSnorm8(const f32 *in, usize count, i8 *out);
+
+/// @brief out[i] = Sono::FloatToSnorm16(in[i]), bit for bit on every level
+void FloatsToSnorm16(const f32 *in, usize count, i16 *out);
+
+/// @brief out[i] = Sono::FloatToUnorm8(in[i]), bit for bit on every level
+void FloatsToUnorm8(const f32 *in, usize count, u8 *out);
+
+/// @brief out[i] = Sono::FloatToUnorm16(in[i]), bit for bit on every level
+void FloatsToUnorm16(const f32 *in, usize count, u16 *out);
+
+/// @brief Sono::EncodeOctahedral per vector, bit for bit on every level, the two components of
+/// vector i in outX[i] and outY[i]
+void EncodeOctahedral(ConstVec3Soa in, usize count, i16 *outX, i16 *outY);
+
+/// @brief Moller-Trumbore test of the ray origin + t * dir against triangles given by a corner
+/// v0 and the edges v1 - v0 and v2 - v0, hitting either side. Triangles with a zero edge never
+/// hit, so a stream can be padded with them.
+/// @return the smallest t in [0, maxT) of a hit, with its triangle in outIndex, or maxT with
+/// outIndex untouched when there is none. Levels agree up to rounding.
+f32 IntersectRayTriangles(
+  const Vec3 &origin, const Vec3 &dir, ConstVec3Soa v0, ConstVec3Soa edge1, ConstVec3Soa edge2,
+  usize count, f32 maxT, u32 *outIndex
+);
+
+} // namespace Sono
+
+#endif // !SN_BATCH_H
@@ -0,0 +1,144 @@
+// Built with -mavx2 -mfma -mf16c (/arch:AVX2), only reached after a runtime CPU check in batch.cpp.
+// Keep the includes to batch_kernels.h, see the note at its top.
+#include <core/math/batch_kernels.h>
+
+using namespace Sono::BatchImpl;
+
+#if defined(__AVX2__) && ((defined(__FMA__) && defined(__F16C__)) || defined(_MSC_VER))
+#include <immintrin.h>
+
+namespace {
+
+struct F8 {
+  using V = __m256;
+  using I = __m256i;
+  using M = __m256i;
+  static constexpr usize WIDTH = 8;
+
+  static V Load(const f32 *p) { return _mm256_loadu_ps(p); }
+  static void Store(f32 *p, V v) { _mm256_storeu_ps(p, v); }
+  static V Set1(f32 v) { return _mm256_set1_ps(v); }
+  static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+  static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+  static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+  static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+  static V MulAdd(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+  static V Min(V a, V b) { return _mm256_min_ps(a, b); }
+  static V Max(V a, V b) { return _mm256_max_ps(a, b); }
+  static V Sqrt(V v) { return _mm256_sqrt_ps(v); }
+  static V Abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  static V InvSqrtOrZero(V v) {
+    const V inv = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(v));
+    return _mm256_and_ps(inv, _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_GT_OQ));
+  }
+  static u32 NonNegativeMask(V v) {
+    return (u32)_mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_GE_OQ));
+  }
+  static usize AppendIndices(u32 mask, usize base, u32 *out, usize n) {
+    return AppendIndicesBranchless<WIDTH>(mask, base, out, n);
+  }
+  static I Round(V v) { return _mm256_cvtps_epi32(v); }
+  static V ToFloat(I v) { return _mm256_cvtepi32_ps(v); }
+  static I AsInt(V v) { return _mm256_castps_si256(v); }
+  static V AsFloat(I v) { return _mm256_castsi256_ps(v); }
+  static V Select(M m, V a, V b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m)); }
+  static M Less(V a, V b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+  static I LoadU32(const u32 *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void StoreU32(u32 *p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+  static I LoadU16(const u16 *p) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  // The pack works per 128 bit half, gather the two low quadwords afterwards
+  static void StoreU16(u16 *p, I v) {
+    const I packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm256_castsi256_si128(packed));
+  }
+  static void StoreU8(u8 *p, I v) {
+    const __m128i lo = _mm256_castsi256_si128(v), hi = _mm256_extracti128_si256(v, 1);
+    const __m128i words = _mm_packs_epi32(lo, hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(p), _mm_packus_epi16(words, words));
+  }
+  // Group order of LoadAos4 is 0 2 4 6 | 1 3 5 7
+  static I LoadU32Aos4(const u32 *p) {
+    return _mm256_permutevar8x32_epi32(LoadU32(p), _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7));
+  }
+  static void StoreU32Aos4(u32 *p, I v) {
+    StoreU32(p, _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+  }
+  static I Set1I(u32 v) { return _mm256_set1_epi32((i32)v); }
+  static I AddI(I a, I b) { return _mm256_add_epi32(a, b); }
+  static I SubI(I a, I b) { return _mm256_sub_epi32(a, b); }
+  static I AndI(I a, I b) { return _mm256_and_si256(a, b); }
+  static I OrI(I a, I b) { return _mm256_or_si256(a, b); }
+  static I XorI(I a, I b) { return _mm256_xor_si256(a, b); }
+  static I ShiftLeft(I v, u32 n) { return _mm256_sll_epi32(v, _mm_cvtsi32_si128((i32)n)); }
+  static I ShiftRight(I v, u32 n) { return _mm256_srl_epi32(v, _mm_cvtsi32_si128((i32)n)); }
+  static M GreaterI(I a, I b) { return _mm256_cmpgt_epi32(a, b); }
+  static I SelectI(M m, I a, I b) { return _mm256_blendv_epi8(b, a, m); }
+  // 4x4 transpose inside each 128 bit half
+  static void Transpose4(V &a, V &b, V &c, V &d) {
+    const V t0 = _mm256_unpacklo_ps(a, b), t1 = _mm256_unpackhi_ps(a, b);
+    const V t2 = _mm256_unpacklo_ps(c, d), t3 = _mm256_unpackhi_ps(c, d);
+    a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  // Lanes come out as groups 0 2 4 6 | 1 3 5 7, StoreAos4 applies the same transpose back
+  static void LoadAos4(const f32 *p, V &a, V &b, V &c, V &d) {
+    a = _mm256_loadu_ps(p);
+    b = _mm256_loadu_ps(p + 8);
+    c = _mm256_loadu_ps(p + 16);
+    d = _mm256_loadu_ps(p + 24);
+    Transpose4(a, b, c, d);
+  }
+  static void StoreAos4(f32 *p, usize stride, V a, V b, V c, V d) {
+    Transpose4(a, b, c, d);
+    const V groups[4] = {a, b, c, d};
+    for (usize k = 0; k < 4; k++) {
+      _mm_storeu_ps(p + 2 * k * stride, _mm256_castps256_ps128(groups[k]));
+      _mm_storeu_ps(p + (2 * k + 1) * stride, _mm256_extractf128_ps(groups[k], 1));
+    }
+  }
+};
+
+// --------------------------------------------------------------------------------
+/// F16C rounds to nearest even like Sono::FloatToHalf, only NaN payloads can differ
+void FloatsToHalvesF16c(const f32 *in, usize count, u16 *out) {
+  usize i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+  }
+  FloatsToHalvesBlock<F1>(in, count, out, i);
+}
+// --------------------------------------------------------------------------------
+void HalvesToFloatsF16c(const u16 *in, usize count, f32 *out) {
+  usize i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+  HalvesToFloatsBlock<F1>(in, count, out, i);
+}
+// --------------------------------------------------------------------------------
+constexpr Kernels MakeAvx2Kernels() {
+  Kernels k = MakeKernels<F8>();
+  k.floatsToHalves = &FloatsToHalvesF16c;
+  k.halvesToFloats = &HalvesToFloatsF16c;
+  return k;
+}
+
+constexpr Kernels s_Kernels = MakeAvx2Kernels();
+
+} // namespace
+
+const Kernels *Sono::BatchImpl::GetKernelsAvx2() { return &s_Kernels; }
+
+#else
+
+const Kernels *Sono::BatchImpl::GetKernelsAvx2() { return nullptr; }
+
+#endif
@@ -0,0 +1,158 @@
+// Built with -mavx512f -mfma (/arch:AVX512), only reached after a runtime CPU check in batch.cpp.
+// Keep the includes to batch_kernels.h, see the note at its top.
+#include <core/math/batch_kernels.h>
+
+using namespace Sono::BatchImpl;
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace {
+
+struct F16 {
+  using V = __m512;
+  using I = __m512i;
+  using M = __mmask16;
+  static constexpr usize WIDTH = 16;
+
+  static V Load(const f32 *p) { return _mm512_loadu_ps(p); }
+  static void Store(f32 *p, V v) { _mm512_storeu_ps(p, v); }
+  static V Set1(f32 v) { return _mm512_set1_ps(v); }
+  static V Add(V a, V b) { return _mm512_add_ps(a, b); }
+  static V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+  static V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+  static V Div(V a, V b) { return _mm512_maskz_div_ps(0xffff, a, b); }
+  static V MulAdd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+  static V Min(V a, V b) { return _mm512_maskz_min_ps(0xffff, a, b); } // see Transpose4
+  static V Max(V a, V b) { return _mm512_maskz_max_ps(0xffff, a, b); }
+  static V Sqrt(V v) { return _mm512_maskz_sqrt_ps(0xffff, v); }
+  static V Abs(V a) { return _mm512_abs_ps(a); }
+  static V InvSqrtOrZero(V v) {
+    const __mmask16 positive = _mm512_cmp_ps_mask(v, _mm512_setzero_ps(), _CMP_GT_OQ);
+    return _mm512_maskz_div_ps(positive, _mm512_set1_ps(1.0f), _mm512_maskz_sqrt_ps(positive, v));
+  }
+  static u32 NonNegativeMask(V v) {
+    return _mm512_cmp_ps_mask(v, _mm512_setzero_ps(), _CMP_GE_OQ);
+  }
+  // vpcompressd packs the visible indices together, no per lane store
+  static usize AppendIndices(u32 mask, usize base, u32 *out, usize n) {
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i indices = _mm512_add_epi32(_mm512_set1_epi32((i32)base), lanes);
+    _mm512_mask_compressstoreu_epi32(out + n, (__mmask16)mask, indices);
+  #if defined(_MSC_VER)
+    return n + __popcnt(mask);
+  #else
+    return n + (usize)__builtin_popcount(mask);
+  #endif
+  }
+  static I Round(V v) { return _mm512_maskz_cvtps_epi32(0xffff, v); }
+  static V ToFloat(I v) { return _mm512_maskz_cvtepi32_ps(0xffff, v); }
+  static I AsInt(V v) { return _mm512_castps_si512(v); }
+  static V AsFloat(I v) { return _mm512_castsi512_ps(v); }
+  static V Select(M m, V a, V b) { return _mm512_mask_blend_ps(m, b, a); }
+  static M Less(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static I LoadU32(const u32 *p) { return _mm512_loadu_si512(p); }
+  static void StoreU32(u32 *p, I v) { _mm512_storeu_si512(p, v); }
+  static I LoadU16(const u16 *p) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return _mm512_maskz_cvtepu16_epi32(0xffff, v);
+  }
+  static void StoreU16(u16 *p, I v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), _mm512_maskz_cvtepi32_epi16(0xffff, v));
+  }
+  static void StoreU8(u8 *p, I v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm512_maskz_cvtepi32_epi8(0xffff, v));
+  }
+  // Group order of LoadAos4 is a 4x4 transpose of 0..15, which is its own inverse
+  static I LoadU32Aos4(const u32 *p) { return Aos4Order(LoadU32(p)); }
+  static void StoreU32Aos4(u32 *p, I v) { StoreU32(p, Aos4Order(v)); }
+  static I Set1I(u32 v) { return _mm512_set1_epi32((i32)v); }
+  static I AddI(I a, I b) { return _mm512_add_epi32(a, b); }
+  static I SubI(I a, I b) { return _mm512_sub_epi32(a, b); }
+  static I AndI(I a, I b) { return _mm512_and_si512(a, b); }
+  static I OrI(I a, I b) { return _mm512_or_si512(a, b); }
+  static I XorI(I a, I b) { return _mm512_xor_si512(a, b); }
+  static I ShiftLeft(I v, u32 n) {
+    return _mm512_maskz_sll_epi32(0xffff, v, _mm_cvtsi32_si128((i32)n));
+  }
+  static I ShiftRight(I v, u32 n) {
+    return _mm512_maskz_srl_epi32(0xffff, v, _mm_cvtsi32_si128((i32)n));
+  }
+  static M GreaterI(I a, I b) { return _mm512_cmpgt_epi32_mask(a, b); }
+  static I SelectI(M m, I a, I b) { return _mm512_mask_blend_epi32(m, b, a); }
+  static I Aos4Order(I v) {
+    const I order = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    return _mm512_maskz_permutexvar_epi32(0xffff, order, v);
+  }
+  // 4x4 transpose inside each 128 bit quarter. The all lanes maskz forms avoid the
+  // _mm512_undefined_ps passthrough that GCC reports as maybe uninitialized.
+  static void Transpose4(V &a, V &b, V &c, V &d) {
+    constexpr __mmask16 all = 0xffff;
+    const V t0 = _mm512_maskz_unpacklo_ps(all, a, b), t1 = _mm512_maskz_unpackhi_ps(all, a, b);
+    const V t2 = _mm512_maskz_unpacklo_ps(all, c, d), t3 = _mm512_maskz_unpackhi_ps(all, c, d);
+    a = _mm512_maskz_shuffle_ps(all, t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm512_maskz_shuffle_ps(all, t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm512_maskz_shuffle_ps(all, t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm512_maskz_shuffle_ps(all, t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  // Lanes come out as groups 0 4 8 12 | 1 5 9 13 | ..., StoreAos4 applies the same transpose back
+  static void LoadAos4(const f32 *p, V &a, V &b, V &c, V &d) {
+    a = _mm512_loadu_ps(p);
+    b = _mm512_loadu_ps(p + 16);
+    c = _mm512_loadu_ps(p + 32);
+    d = _mm512_loadu_ps(p + 48);
+    Transpose4(a, b, c, d);
+  }
+  static void StoreAos4(f32 *p, usize stride, V a, V b, V c, V d) {
+    Transpose4(a, b, c, d);
+    const V groups[4] = {a, b, c, d};
+    for (usize k = 0; k < 4; k++) {
+      f32 *row = p + 4 * k * stride;
+      _mm_storeu_ps(row, _mm512_maskz_extractf32x4_ps(0xf, groups[k], 0));
+      _mm_storeu_ps(row + stride, _mm512_maskz_extractf32x4_ps(0xf, groups[k], 1));
+      _mm_storeu_ps(row + 2 * stride, _mm512_maskz_extractf32x4_ps(0xf, groups[k], 2));
+      _mm_storeu_ps(row + 3 * stride, _mm512_maskz_extractf32x4_ps(0xf, groups[k], 3));
+    }
+  }
+};
+
+// --------------------------------------------------------------------------------
+/// The AVX-512F conversion rounds to nearest even like Sono::FloatToHalf, only NaN payloads can
+/// differ
+void FloatsToHalvesHw(const f32 *in, usize count, u16 *out) {
+  usize i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i h =
+      _mm512_maskz_cvtps_ph(0xffff, _mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), h);
+  }
+  FloatsToHalvesBlock<F1>(in, count, out, i);
+}
+// --------------------------------------------------------------------------------
+void HalvesToFloatsHw(const u16 *in, usize count, f32 *out) {
+  usize i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    _mm512_storeu_ps(out + i, _mm512_maskz_cvtph_ps(0xffff, h));
+  }
+  HalvesToFloatsBlock<F1>(in, count, out, i);
+}
+// --------------------------------------------------------------------------------
+constexpr Kernels MakeAvx512Kernels() {
+  Kernels k = MakeKernels<F16>();
+  k.floatsToHalves = &FloatsToHalvesHw;
+  k.halvesToFloats = &HalvesToFloatsHw;
+  return k;
+}
+
+constexpr Kernels s_Kernels = MakeAvx512Kernels();
+
+} // namespace
+
+const Kernels *Sono::BatchImpl::GetKernelsAvx512() { return &s_Kernels; }
+
+#else
+
+const Kernels *Sono::BatchImpl::GetKernelsAvx512() { return nullptr; }
+
+#endif
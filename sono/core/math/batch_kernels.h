@@ -0,0 +1,1062 @@
+#ifndef SN_BATCH_KERNELS_H
+#define SN_BATCH_KERNELS_H
+
+// Internal to batch.cpp and the per instruction set translation units (batch_avx2.cpp,
+// batch_avx512.cpp). Do not include elsewhere.
+//
+// Those translation units are compiled with different -m flags, so nothing here may be an inline
+// function with external linkage: the linker would keep one copy at random and could hand AVX
+// code to a CPU without it. The lane types live in an unnamed namespace and every kernel is a
+// template over them, which gives each instantiation internal linkage.
+
+#include <core/common/types.h>
+#include <core/math/ease.h>
+#include <math.h>
+#include <string.h>
+#include <array>
+#include <utility>
+
+namespace Sono::BatchImpl {
+
+/// One entry per batch operation, filled by each instruction set backend
+struct Kernels {
+  void (*transformPoints)(
+    const f32 *m, const f32 *x, const f32 *y, const f32 *z, usize count, f32 *ox, f32 *oy, f32 *oz
+  );
+  void (*transformDirections)(
+    const f32 *m, const f32 *x, const f32 *y, const f32 *z, usize count, f32 *ox, f32 *oy, f32 *oz
+  );
+  void (*normalize)(f32 *x, f32 *y, f32 *z, usize count);
+  void (*dot)(
+    const f32 *ax, const f32 *ay, const f32 *az, const f32 *bx, const f32 *by, const f32 *bz,
+    usize count, f32 *out
+  );
+  void (*cross)(
+    const f32 *ax, const f32 *ay, const f32 *az, const f32 *bx, const f32 *by, const f32 *bz,
+    usize count, f32 *ox, f32 *oy, f32 *oz
+  );
+  void (*transformAABBs)(
+    const f32 *m, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *ex, const f32 *ey,
+    const f32 *ez, usize count, f32 *ocx, f32 *ocy, f32 *ocz, f32 *oex, f32 *oey, f32 *oez
+  );
+  void (*quaternionsToMat4)(const f32 *q, usize count, f32 *out);
+  usize (*cullSpheres)(
+    const f32 *planes, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *radii, usize count,
+    u32 *outIndices
+  );
+  usize (*cullAABBs)(
+    const f32 *planes, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *ex, const f32 *ey,
+    const f32 *ez, usize count, u32 *outIndices
+  );
+  void (*packQuaternions)(const f32 *q, usize count, u32 bits, u32 *out);
+  void (*unpackQuaternions)(const u32 *packed, usize count, u32 bits, f32 *out);
+  void (*quantizePositions)(
+    const f32 *cell, const f32 *x, const f32 *y, const f32 *z, usize count, u32 bits, u16 *ox,
+    u16 *oy, u16 *oz
+  );
+  void (*dequantizePositions)(
+    const f32 *cell, const u16 *x, const u16 *y, const u16 *z, usize count, u32 bits, f32 *ox,
+    f32 *oy, f32 *oz
+  );
+  void (*floatsToHalves)(const f32 *in, usize count, u16 *out);
+  void (*halvesToFloats)(const u16 *in, usize count, f32 *out);
+  void (*evaluateEase)(Ease ease, const f32 *t, usize count, f32 *out);
+  void (*floatsToNorm8)(const f32 *in, usize count, f32 lo, f32 scale, u8 *out);
+  void (*floatsToNorm16)(const f32 *in, usize count, f32 lo, f32 scale, u16 *out);
+  void (*encodeOctahedral)(const f32 *x, const f32 *y, const f32 *z, usize count, u16 *ox, u16 *oy);
+  f32 (*intersectRayTriangles)(
+    const f32 *ray, const f32 *v0x, const f32 *v0y, const f32 *v0z, const f32 *e1x,
+    const f32 *e1y, const f32 *e1z, const f32 *e2x, const f32 *e2y, const f32 *e2z, usize count,
+    f32 maxT, u32 *outIndex
+  );
+};
+
+const Kernels *GetKernelsAvx2();
+const Kernels *GetKernelsAvx512();
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// Every lane stores its index and only the visible ones advance the cursor, which avoids a
+/// mispredicted branch per element when visibility is random. n <= base + k always holds, so
+/// the stores stay inside a buffer sized for one index per input.
+template <usize WIDTH>
+usize AppendIndicesBranchless(u32 mask, usize base, u32 *out, usize n) {
+  for (usize k = 0; k < WIDTH; k++) {
+    out[n] = (u32)(base + k);
+    n += (mask >> k) & 1u;
+  }
+  return n;
+}
+
+/// Single lane, used for the tails of every wider backend and as the scalar backend. V holds
+/// floats, I the same lanes as 32 bit integers and M a per lane comparison result.
+struct F1 {
+  using V = f32;
+  using I = u32;
+  using M = b8;
+  static constexpr usize WIDTH = 1;
+
+  static V Load(const f32 *p) { return *p; }
+  static void Store(f32 *p, V v) { *p = v; }
+  static V Set1(f32 v) { return v; }
+  static V Add(V a, V b) { return a + b; }
+  static V Sub(V a, V b) { return a - b; }
+  static V Mul(V a, V b) { return a * b; }
+  static V Div(V a, V b) { return a / b; }
+  /// Fused when the translation unit targets FMA, so the tails of the wide backends round
+  /// exactly like their full vectors
+  static V MulAdd(V a, V b, V c) {
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+    return fmaf(a, b, c);
+#else
+    return a * b + c;
+#endif
+  }
+  static V Min(V a, V b) { return a < b ? a : b; }
+  static V Max(V a, V b) { return a > b ? a : b; }
+  static V Sqrt(V v) { return sqrtf(v); }
+  static V Abs(V a) {
+    u32 bits;
+    memcpy(&bits, &a, sizeof(bits));
+    bits &= 0x7fffffffu;
+    memcpy(&a, &bits, sizeof(bits));
+    return a;
+  }
+  /// 1 / sqrt(v), or 0 where v is not positive
+  static V InvSqrtOrZero(V v) { return v > 0.0f ? 1.0f / sqrtf(v) : 0.0f; }
+  /// Bit k set where lane k is >= 0
+  static u32 NonNegativeMask(V v) { return v >= 0.0f ? 1u : 0u; }
+  /// Round to nearest even, the lanes must fit an i32
+  static I Round(V v) { return (u32)(i32)nearbyintf(v); }
+  /// Lanes read as i32
+  static V ToFloat(I v) { return (f32)(i32)v; }
+  static I AsInt(V v) {
+    u32 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+  }
+  static V AsFloat(I v) {
+    f32 f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+  }
+  /// a where m is set, b elsewhere
+  static V Select(M m, V a, V b) { return m ? a : b; }
+  /// Ordered, false for NaN lanes
+  static M Less(V a, V b) { return a < b; }
+
+  static I LoadU32(const u32 *p) { return *p; }
+  static void StoreU32(u32 *p, I v) { *p = v; }
+  /// Zero extended
+  static I LoadU16(const u16 *p) { return *p; }
+  /// Lanes must be in [0, 65535]
+  static void StoreU16(u16 *p, I v) { *p = (u16)v; }
+  /// Lanes must be in [0, 255]
+  static void StoreU8(u8 *p, I v) { *p = (u8)v; }
+  /// One u32 per group of four floats, in the lane order LoadAos4 and StoreAos4 use
+  static I LoadU32Aos4(const u32 *p) { return *p; }
+  static void StoreU32Aos4(u32 *p, I v) { *p = v; }
+  static I Set1I(u32 v) { return v; }
+  static I AddI(I a, I b) { return a + b; }
+  static I SubI(I a, I b) { return a - b; }
+  static I AndI(I a, I b) { return a & b; }
+  static I OrI(I a, I b) { return a | b; }
+  static I XorI(I a, I b) { return a ^ b; }
+  static I ShiftLeft(I v, u32 n) { return v << n; }
+  /// Logical shift
+  static I ShiftRight(I v, u32 n) { return v >> n; }
+  /// Signed comparison
+  static M GreaterI(I a, I b) { return (i32)a > (i32)b; }
+  static I SelectI(M m, I a, I b) { return m ? a : b; }
+  /// Write base + k for every set bit k of mask to out[n...], returns the new n. out must have
+  /// room up to index base + WIDTH - 1.
+  static usize AppendIndices(u32 mask, usize base, u32 *out, usize n) {
+    return AppendIndicesBranchless<WIDTH>(mask, base, out, n);
+  }
+
+  /// Split WIDTH consecutive groups of four floats into one vector per member. Wider backends
+  /// may order the lanes differently, StoreAos4 restores the group order.
+  static void LoadAos4(const f32 *p, V &a, V &b, V &c, V &d) {
+    a = p[0];
+    b = p[1];
+    c = p[2];
+    d = p[3];
+  }
+  /// Write WIDTH groups of four floats, group k at p + k * stride
+  static void StoreAos4(f32 *p, usize, V a, V b, V c, V d) {
+    p[0] = a;
+    p[1] = b;
+    p[2] = c;
+    p[3] = d;
+  }
+};
+
+// --------------------------------------------------------------------------------
+template <typename P>
+usize TransformPointsBlock(
+  const f32 *m, const f32 *x, const f32 *y, const f32 *z, usize count, f32 *ox, f32 *oy, f32 *oz,
+  usize i
+) {
+  using V = typename P::V;
+  const V m00 = P::Set1(m[0]), m01 = P::Set1(m[1]), m02 = P::Set1(m[2]);
+  const V m10 = P::Set1(m[4]), m11 = P::Set1(m[5]), m12 = P::Set1(m[6]);
+  const V m20 = P::Set1(m[8]), m21 = P::Set1(m[9]), m22 = P::Set1(m[10]);
+  const V m30 = P::Set1(m[12]), m31 = P::Set1(m[13]), m32 = P::Set1(m[14]);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V vx = P::Load(x + i), vy = P::Load(y + i), vz = P::Load(z + i);
+    P::Store(ox + i, P::MulAdd(vx, m00, P::MulAdd(vy, m10, P::MulAdd(vz, m20, m30))));
+    P::Store(oy + i, P::MulAdd(vx, m01, P::MulAdd(vy, m11, P::MulAdd(vz, m21, m31))));
+    P::Store(oz + i, P::MulAdd(vx, m02, P::MulAdd(vy, m12, P::MulAdd(vz, m22, m32))));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize TransformDirectionsBlock(
+  const f32 *m, const f32 *x, const f32 *y, const f32 *z, usize count, f32 *ox, f32 *oy, f32 *oz,
+  usize i
+) {
+  using V = typename P::V;
+  const V m00 = P::Set1(m[0]), m01 = P::Set1(m[1]), m02 = P::Set1(m[2]);
+  const V m10 = P::Set1(m[4]), m11 = P::Set1(m[5]), m12 = P::Set1(m[6]);
+  const V m20 = P::Set1(m[8]), m21 = P::Set1(m[9]), m22 = P::Set1(m[10]);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V vx = P::Load(x + i), vy = P::Load(y + i), vz = P::Load(z + i);
+    P::Store(ox + i, P::MulAdd(vx, m00, P::MulAdd(vy, m10, P::Mul(vz, m20))));
+    P::Store(oy + i, P::MulAdd(vx, m01, P::MulAdd(vy, m11, P::Mul(vz, m21))));
+    P::Store(oz + i, P::MulAdd(vx, m02, P::MulAdd(vy, m12, P::Mul(vz, m22))));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize NormalizeBlock(f32 *x, f32 *y, f32 *z, usize count, usize i) {
+  using V = typename P::V;
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V vx = P::Load(x + i), vy = P::Load(y + i), vz = P::Load(z + i);
+    const V inv = P::InvSqrtOrZero(P::MulAdd(vx, vx, P::MulAdd(vy, vy, P::Mul(vz, vz))));
+    P::Store(x + i, P::Mul(vx, inv));
+    P::Store(y + i, P::Mul(vy, inv));
+    P::Store(z + i, P::Mul(vz, inv));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize DotBlock(
+  const f32 *ax, const f32 *ay, const f32 *az, const f32 *bx, const f32 *by, const f32 *bz,
+  usize count, f32 *out, usize i
+) {
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    P::Store(
+      out + i,
+      P::MulAdd(
+        P::Load(ax + i), P::Load(bx + i),
+        P::MulAdd(P::Load(ay + i), P::Load(by + i), P::Mul(P::Load(az + i), P::Load(bz + i)))
+      )
+    );
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize CrossBlock(
+  const f32 *ax, const f32 *ay, const f32 *az, const f32 *bx, const f32 *by, const f32 *bz,
+  usize count, f32 *ox, f32 *oy, f32 *oz, usize i
+) {
+  using V = typename P::V;
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V vax = P::Load(ax + i), vay = P::Load(ay + i), vaz = P::Load(az + i);
+    const V vbx = P::Load(bx + i), vby = P::Load(by + i), vbz = P::Load(bz + i);
+    P::Store(ox + i, P::Sub(P::Mul(vay, vbz), P::Mul(vaz, vby)));
+    P::Store(oy + i, P::Sub(P::Mul(vaz, vbx), P::Mul(vax, vbz)));
+    P::Store(oz + i, P::Sub(P::Mul(vax, vby), P::Mul(vay, vbx)));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize TransformAABBsBlock(
+  const f32 *m, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *ex, const f32 *ey,
+  const f32 *ez, usize count, f32 *ocx, f32 *ocy, f32 *ocz, f32 *oex, f32 *oey, f32 *oez, usize i
+) {
+  using V = typename P::V;
+  const V m00 = P::Set1(m[0]), m01 = P::Set1(m[1]), m02 = P::Set1(m[2]);
+  const V m10 = P::Set1(m[4]), m11 = P::Set1(m[5]), m12 = P::Set1(m[6]);
+  const V m20 = P::Set1(m[8]), m21 = P::Set1(m[9]), m22 = P::Set1(m[10]);
+  const V m30 = P::Set1(m[12]), m31 = P::Set1(m[13]), m32 = P::Set1(m[14]);
+  const V a00 = P::Abs(m00), a01 = P::Abs(m01), a02 = P::Abs(m02);
+  const V a10 = P::Abs(m10), a11 = P::Abs(m11), a12 = P::Abs(m12);
+  const V a20 = P::Abs(m20), a21 = P::Abs(m21), a22 = P::Abs(m22);
+
+  // Arvo: the center moves like a point, the extents through the absolute upper 3x3
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V vx = P::Load(cx + i), vy = P::Load(cy + i), vz = P::Load(cz + i);
+    const V wx = P::Load(ex + i), wy = P::Load(ey + i), wz = P::Load(ez + i);
+    P::Store(ocx + i, P::MulAdd(vx, m00, P::MulAdd(vy, m10, P::MulAdd(vz, m20, m30))));
+    P::Store(ocy + i, P::MulAdd(vx, m01, P::MulAdd(vy, m11, P::MulAdd(vz, m21, m31))));
+    P::Store(ocz + i, P::MulAdd(vx, m02, P::MulAdd(vy, m12, P::MulAdd(vz, m22, m32))));
+    P::Store(oex + i, P::MulAdd(wx, a00, P::MulAdd(wy, a10, P::Mul(wz, a20))));
+    P::Store(oey + i, P::MulAdd(wx, a01, P::MulAdd(wy, a11, P::Mul(wz, a21))));
+    P::Store(oez + i, P::MulAdd(wx, a02, P::MulAdd(wy, a12, P::Mul(wz, a22))));
+  }
+  return i;
+}
+
+// --------------------------------------------------------------------------------
+template <typename P>
+usize QuaternionsToMat4Block(const f32 *q, usize count, f32 *out, usize i) {
+  using V = typename P::V;
+  const V zero = P::Set1(0.0f), one = P::Set1(1.0f), two = P::Set1(2.0f);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    // Quaternions are stored w, x, y, z
+    V w, x, y, z;
+    P::LoadAos4(q + i * 4, w, x, y, z);
+    const V x2 = P::Mul(x, two), y2 = P::Mul(y, two), z2 = P::Mul(z, two);
+    const V xx = P::Mul(x, x2), yy = P::Mul(y, y2), zz = P::Mul(z, z2);
+    const V xy = P::Mul(x, y2), xz = P::Mul(x, z2), yz = P::Mul(y, z2);
+    const V wx = P::Mul(w, x2), wy = P::Mul(w, y2), wz = P::Mul(w, z2);
+
+    // Same rows as Quaternion::ToMat4, the factor 2 moved into the products is exact
+    f32 *m = out + i * 16;
+    P::StoreAos4(m, 16, P::Sub(one, P::Add(yy, zz)), P::Add(xy, wz), P::Sub(xz, wy), zero);
+    P::StoreAos4(m + 4, 16, P::Sub(xy, wz), P::Sub(one, P::Add(xx, zz)), P::Add(yz, wx), zero);
+    P::StoreAos4(m + 8, 16, P::Add(xz, wy), P::Sub(yz, wx), P::Sub(one, P::Add(xx, yy)), zero);
+    P::StoreAos4(m + 12, 16, zero, zero, zero, one);
+  }
+  return i;
+}
+
+// --------------------------------------------------------------------------------
+template <typename P>
+usize CullSpheresBlock(
+  const f32 *planes, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *radii, usize count,
+  u32 *out, usize &visible, usize i
+) {
+  using V = typename P::V;
+  V nx[6], ny[6], nz[6], nd[6];
+  for (usize p = 0; p < 6; p++) {
+    nx[p] = P::Set1(planes[p * 4 + 0]);
+    ny[p] = P::Set1(planes[p * 4 + 1]);
+    nz[p] = P::Set1(planes[p * 4 + 2]);
+    nd[p] = P::Set1(planes[p * 4 + 3]);
+  }
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V x = P::Load(cx + i), y = P::Load(cy + i), z = P::Load(cz + i), r = P::Load(radii + i);
+    // Smallest signed distance over the planes, pushed out by the radius
+    V dist = P::MulAdd(x, nx[0], P::MulAdd(y, ny[0], P::MulAdd(z, nz[0], P::Add(nd[0], r))));
+    for (usize p = 1; p < 6; p++) {
+      dist = P::Min(
+        dist, P::MulAdd(x, nx[p], P::MulAdd(y, ny[p], P::MulAdd(z, nz[p], P::Add(nd[p], r))))
+      );
+    }
+    visible = P::AppendIndices(P::NonNegativeMask(dist), i, out, visible);
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize CullAABBsBlock(
+  const f32 *planes, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *ex, const f32 *ey,
+  const f32 *ez, usize count, u32 *out, usize &visible, usize i
+) {
+  using V = typename P::V;
+  V nx[6], ny[6], nz[6], nd[6], ax[6], ay[6], az[6];
+  for (usize p = 0; p < 6; p++) {
+    nx[p] = P::Set1(planes[p * 4 + 0]);
+    ny[p] = P::Set1(planes[p * 4 + 1]);
+    nz[p] = P::Set1(planes[p * 4 + 2]);
+    nd[p] = P::Set1(planes[p * 4 + 3]);
+    ax[p] = P::Abs(nx[p]);
+    ay[p] = P::Abs(ny[p]);
+    az[p] = P::Abs(nz[p]);
+  }
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V x = P::Load(cx + i), y = P::Load(cy + i), z = P::Load(cz + i);
+    const V wx = P::Load(ex + i), wy = P::Load(ey + i), wz = P::Load(ez + i);
+    // Center distance plus the box radius projected on the normal, smallest over the planes
+    auto distance = [&](usize p) {
+      const V radius = P::MulAdd(wx, ax[p], P::MulAdd(wy, ay[p], P::Mul(wz, az[p])));
+      return P::MulAdd(x, nx[p], P::MulAdd(y, ny[p], P::MulAdd(z, nz[p], P::Add(nd[p], radius))));
+    };
+    V dist = distance(0);
+    for (usize p = 1; p < 6; p++) dist = P::Min(dist, distance(p));
+    visible = P::AppendIndices(P::NonNegativeMask(dist), i, out, visible);
+  }
+  return i;
+}
+
+// --------------------------------------------------------------------------------
+/// Lane wise Sono::PackQuaternion, bits <= 10 so the code fits a u32
+template <typename P>
+usize PackQuaternionsBlock(const f32 *q, usize count, u32 bits, u32 *out, usize i) {
+  using V = typename P::V;
+  using I = typename P::I;
+  using M = typename P::M;
+  const f32 range = 0.70710678118654752f; // Sono::SMALLEST_THREE_RANGE
+  const f32 maxQ = (f32)((1u << bits) - 1);
+  const V offset = P::Set1(range), scale = P::Set1(maxQ * range);
+  const V zero = P::Set1(0.0f), top = P::Set1(maxQ);
+  const I i0 = P::Set1I(0), i1 = P::Set1I(1), i2 = P::Set1I(2), i3 = P::Set1I(3);
+  const I signBit = P::Set1I(0x80000000u);
+
+  auto quantize = [&](V v) {
+    return P::Round(P::Min(P::Max(P::Mul(P::Add(v, offset), scale), zero), top));
+  };
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    V w, x, y, z;
+    P::LoadAos4(q + i * 4, w, x, y, z);
+
+    // Largest magnitude, the first one wins ties. Non negative floats order like their bits.
+    const I aw = P::AsInt(P::Abs(w)), ax = P::AsInt(P::Abs(x));
+    const I ay = P::AsInt(P::Abs(y)), az = P::AsInt(P::Abs(z));
+    M m = P::GreaterI(ax, aw);
+    I best = P::SelectI(m, ax, aw), index = P::SelectI(m, i1, i0);
+    V largest = P::Select(m, x, w);
+    m = P::GreaterI(ay, best);
+    best = P::SelectI(m, ay, best);
+    index = P::SelectI(m, i2, index);
+    largest = P::Select(m, y, largest);
+    m = P::GreaterI(az, best);
+    index = P::SelectI(m, i3, index);
+    largest = P::Select(m, z, largest);
+
+    // Negate the whole quaternion where the dropped component is negative
+    const I flip = P::AndI(P::AsInt(largest), signBit);
+    w = P::AsFloat(P::XorI(P::AsInt(w), flip));
+    x = P::AsFloat(P::XorI(P::AsInt(x), flip));
+    y = P::AsFloat(P::XorI(P::AsInt(y), flip));
+    z = P::AsFloat(P::XorI(P::AsInt(z), flip));
+
+    // The three kept components in w, x, y, z order
+    const I a = quantize(P::Select(P::GreaterI(index, i0), w, x));
+    const I b = quantize(P::Select(P::GreaterI(index, i1), x, y));
+    const I c = quantize(P::Select(P::GreaterI(index, i2), y, z));
+    I packed = P::OrI(P::ShiftLeft(index, 3 * bits), P::ShiftLeft(a, 2 * bits));
+    packed = P::OrI(packed, P::OrI(P::ShiftLeft(b, bits), c));
+    P::StoreU32Aos4(out + i, packed);
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize UnpackQuaternionsBlock(const u32 *packed, usize count, u32 bits, f32 *out, usize i) {
+  using V = typename P::V;
+  using I = typename P::I;
+  using M = typename P::M;
+  const u32 maxQ = (1u << bits) - 1;
+  const V step = P::Set1(2.0f * 0.70710678118654752f / (f32)maxQ);
+  const V center = P::Set1(0.5f * (f32)maxQ), zero = P::Set1(0.0f), one = P::Set1(1.0f);
+  const I mask = P::Set1I(maxQ), i0 = P::Set1I(0), i1 = P::Set1I(1), i2 = P::Set1I(2);
+
+  auto dequantize = [&](I v) {
+    return P::Mul(P::Sub(P::ToFloat(P::AndI(v, mask)), center), step);
+  };
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const I p = P::LoadU32Aos4(packed + i);
+    const I index = P::ShiftRight(p, 3 * bits);
+    const V a = dequantize(P::ShiftRight(p, 2 * bits));
+    const V b = dequantize(P::ShiftRight(p, bits));
+    const V c = dequantize(p);
+    const V sum = P::Add(P::Add(P::Mul(a, a), P::Mul(b, b)), P::Mul(c, c));
+    const V dropped = P::Sqrt(P::Max(zero, P::Sub(one, sum)));
+
+    // Put the dropped component back in slot index
+    const M g0 = P::GreaterI(index, i0), g1 = P::GreaterI(index, i1);
+    const M g2 = P::GreaterI(index, i2);
+    const V w = P::Select(g0, a, dropped);
+    const V x = P::Select(g1, b, P::Select(g0, dropped, a));
+    const V y = P::Select(g2, c, P::Select(g1, dropped, b));
+    const V z = P::Select(g2, dropped, c);
+    P::StoreAos4(out + i * 4, 4, w, x, y, z);
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+/// Lane wise Sono::PackPosition for one axis at a time, bits <= 16
+template <typename P>
+usize QuantizePositionsBlock(
+  const f32 *cell, const f32 *x, const f32 *y, const f32 *z, usize count, u32 bits, u16 *ox,
+  u16 *oy, u16 *oz, usize i
+) {
+  using V = typename P::V;
+  const f32 maxQ = (f32)((1u << bits) - 1);
+  const V zero = P::Set1(0.0f), top = P::Set1(maxQ);
+  V offset[3], scale[3];
+  for (usize axis = 0; axis < 3; axis++) {
+    const f32 extent = cell[3 + axis] - cell[axis];
+    offset[axis] = P::Set1(-cell[axis]);
+    scale[axis] = P::Set1(extent > 0.0f ? maxQ / extent : 0.0f);
+  }
+
+  auto quantize = [&](V v, usize axis) {
+    return P::Round(P::Min(P::Max(P::Mul(P::Add(v, offset[axis]), scale[axis]), zero), top));
+  };
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    P::StoreU16(ox + i, quantize(P::Load(x + i), 0));
+    P::StoreU16(oy + i, quantize(P::Load(y + i), 1));
+    P::StoreU16(oz + i, quantize(P::Load(z + i), 2));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize DequantizePositionsBlock(
+  const f32 *cell, const u16 *x, const u16 *y, const u16 *z, usize count, u32 bits, f32 *ox,
+  f32 *oy, f32 *oz, usize i
+) {
+  using V = typename P::V;
+  const f32 maxQ = (f32)((1u << bits) - 1);
+  V origin[3], step[3];
+  for (usize axis = 0; axis < 3; axis++) {
+    origin[axis] = P::Set1(cell[axis]);
+    step[axis] = P::Set1((cell[3 + axis] - cell[axis]) / maxQ);
+  }
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    P::Store(ox + i, P::MulAdd(P::ToFloat(P::LoadU16(x + i)), step[0], origin[0]));
+    P::Store(oy + i, P::MulAdd(P::ToFloat(P::LoadU16(y + i)), step[1], origin[1]));
+    P::Store(oz + i, P::MulAdd(P::ToFloat(P::LoadU16(z + i)), step[2], origin[2]));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+/// Lane wise Sono::FloatToHalf, every case computed and the right one selected
+template <typename P>
+usize FloatsToHalvesBlock(const f32 *in, usize count, u16 *out, usize i) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const I signMask = P::Set1I(0x80000000u);
+  const I lastFinite = P::Set1I(((127 + 16) << 23) - 1), infinity = P::Set1I(0x7f800000u);
+  const I minNormal = P::Set1I((127 - 14) << 23);
+  const I halfInf = P::Set1I(0x7c00u), halfNan = P::Set1I(0x7e00u);
+  const V denormMagic = P::Set1(0.5f);
+  const I denormMagicBits = P::Set1I(126u << 23);
+  const I rebias = P::Set1I(((u32)(15 - 127) << 23) + 0xfffu), one = P::Set1I(1);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    I bits = P::AsInt(P::Load(in + i));
+    const I sign = P::AndI(bits, signMask);
+    bits = P::XorI(bits, sign);
+
+    const I overflow = P::SelectI(P::GreaterI(bits, infinity), halfNan, halfInf);
+    const I denormal = P::SubI(P::AsInt(P::Add(P::AsFloat(bits), denormMagic)), denormMagicBits);
+    const I mantissaOdd = P::AndI(P::ShiftRight(bits, 13), one);
+    const I normal = P::ShiftRight(P::AddI(P::AddI(bits, rebias), mantissaOdd), 13);
+
+    I h = P::SelectI(P::GreaterI(minNormal, bits), denormal, normal);
+    h = P::SelectI(P::GreaterI(bits, lastFinite), overflow, h);
+    P::StoreU16(out + i, P::OrI(h, P::ShiftRight(sign, 16)));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize HalvesToFloatsBlock(const u16 *in, usize count, f32 *out, usize i) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const V rebias = P::Set1(5.192296858534828e33f); // 2^112
+  const I magnitude = P::Set1I(0x7fffu), signBit = P::Set1I(0x8000u);
+  const I lastFinite = P::Set1I(((127 + 16) << 23) - 1), infNan = P::Set1I(0xffu << 23);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const I h = P::LoadU16(in + i);
+    I bits = P::AsInt(P::Mul(P::AsFloat(P::ShiftLeft(P::AndI(h, magnitude), 13)), rebias));
+    bits = P::SelectI(P::GreaterI(bits, lastFinite), P::OrI(bits, infNan), bits);
+    P::Store(out + i, P::AsFloat(P::OrI(bits, P::ShiftLeft(P::AndI(h, signBit), 16))));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+/// Lane wise Sono::FloatToNorm, each code stored as its low 8 or 16 bits so the snorm formats
+/// get their two's complement pattern
+template <typename P, typename T>
+usize FloatsToNormBlock(const f32 *in, usize count, f32 lo, f32 scale, T *out, usize i) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const V low = P::Set1(lo), one = P::Set1(1.0f), s = P::Set1(scale);
+  const I mask = P::Set1I(sizeof(T) == 1 ? 0xffu : 0xffffu);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V v = P::Min(P::Max(P::Load(in + i), low), one);
+    const I c = P::AndI(P::Round(P::Mul(v, s)), mask);
+    if constexpr (sizeof(T) == 1) {
+      P::StoreU8(out + i, c);
+    } else {
+      P::StoreU16(out + i, c);
+    }
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+/// Lane wise Sono::EncodeOctahedral, the same steps without FMA so the codes match bit for bit
+template <typename P>
+usize EncodeOctahedralBlock(
+  const f32 *x, const f32 *y, const f32 *z, usize count, u16 *ox, u16 *oy, usize i
+) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const V zero = P::Set1(0.0f), one = P::Set1(1.0f), minusOne = P::Set1(-1.0f);
+  const V tiny = P::Set1(1e-30f), scale = P::Set1(32767.0f);
+  const I mask = P::Set1I(0xffffu);
+
+  auto quantize = [&](V v) {
+    return P::AndI(P::Round(P::Mul(P::Min(P::Max(v, minusOne), one), scale)), mask);
+  };
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V vx = P::Load(x + i), vy = P::Load(y + i), vz = P::Load(z + i);
+    const V l1 = P::Max(P::Add(P::Add(P::Abs(vx), P::Abs(vy)), P::Abs(vz)), tiny);
+    const V px = P::Div(vx, l1), py = P::Div(vy, l1);
+
+    // Fold the lower half over the diagonals
+    const V sx = P::Select(P::Less(px, zero), minusOne, one);
+    const V sy = P::Select(P::Less(py, zero), minusOne, one);
+    const V fx = P::Mul(P::Sub(one, P::Abs(py)), sx), fy = P::Mul(P::Sub(one, P::Abs(px)), sy);
+    const auto lower = P::Less(vz, zero);
+    P::StoreU16(ox + i, quantize(P::Select(lower, fx, px)));
+    P::StoreU16(oy + i, quantize(P::Select(lower, fy, py)));
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+/// sin(x) for |x| up to a few thousand: x less the nearest multiple k of PI (split in two so
+/// k * the high part is exact), a degree 11 Taylor polynomial on [-PI/2, PI/2], within 1e-7 of
+/// sinf, and the sign of (-1)^k
+template <typename P>
+typename P::V SinLanes(typename P::V x) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const I k = P::Round(P::Mul(x, P::Set1(0.318309886f)));
+  const V kf = P::ToFloat(k);
+  V r = P::Sub(x, P::Mul(kf, P::Set1(3.140625f)));
+  r = P::Sub(r, P::Mul(kf, P::Set1(9.67653589793e-4f)));
+
+  const V r2 = P::Mul(r, r);
+  V p = P::Set1(-2.50521084e-8f);
+  p = P::MulAdd(p, r2, P::Set1(2.75573192e-6f));
+  p = P::MulAdd(p, r2, P::Set1(-1.98412698e-4f));
+  p = P::MulAdd(p, r2, P::Set1(8.33333333e-3f));
+  p = P::MulAdd(p, r2, P::Set1(-1.66666667e-1f));
+  const V s = P::MulAdd(P::Mul(p, r2), r, r);
+  return P::AsFloat(P::XorI(P::AsInt(s), P::ShiftLeft(k, 31)));
+}
+// --------------------------------------------------------------------------------
+/// 2^x for x in [-126, 127]: 2^round(x) built in the exponent bits times a degree 6 Taylor
+/// polynomial of e^(f ln 2) for the fraction f in [-1/2, 1/2], within 2e-7 relative
+template <typename P>
+typename P::V Exp2Lanes(typename P::V x) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const I k = P::Round(x);
+  const V g = P::Mul(P::Sub(x, P::ToFloat(k)), P::Set1(0.693147181f));
+  V p = P::Set1(1.0f / 720.0f);
+  p = P::MulAdd(p, g, P::Set1(1.0f / 120.0f));
+  p = P::MulAdd(p, g, P::Set1(1.0f / 24.0f));
+  p = P::MulAdd(p, g, P::Set1(1.0f / 6.0f));
+  p = P::MulAdd(p, g, P::Set1(0.5f));
+  p = P::MulAdd(p, g, P::Set1(1.0f));
+  p = P::MulAdd(p, g, P::Set1(1.0f));
+  return P::Mul(p, P::AsFloat(P::ShiftLeft(P::AddI(k, P::Set1I(127)), 23)));
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+typename P::V OutBounceLanes(typename P::V t) {
+  using V = typename P::V;
+  const V n = P::Set1(7.5625f);
+  auto hop = [&](f32 center, f32 base) {
+    const V d = P::Sub(t, P::Set1(center / 2.75f));
+    return P::MulAdd(P::Mul(n, d), d, P::Set1(base));
+  };
+  V v = hop(2.625f, 0.984375f);
+  v = P::Select(P::Less(t, P::Set1(2.5f / 2.75f)), hop(2.25f, 0.9375f), v);
+  v = P::Select(P::Less(t, P::Set1(2.0f / 2.75f)), hop(1.5f, 0.75f), v);
+  return P::Select(P::Less(t, P::Set1(1.0f / 2.75f)), P::Mul(P::Mul(n, t), t), v);
+}
+// --------------------------------------------------------------------------------
+/// Lane wise Sono::Ease* from math.h for t in [0, 1]. Piecewise curves compute both halves
+/// and select, sin and exp2 are the approximations above, so the results are within about 1e-6
+/// of the scalar functions.
+template <typename P, Ease EASE>
+typename P::V EaseLanes(typename P::V t) {
+  using V = typename P::V;
+  const V zero = P::Set1(0.0f), one = P::Set1(1.0f), half = P::Set1(0.5f);
+  const V u = P::Sub(one, t);
+  const auto lowerHalf = P::Less(t, half);
+  // Curves that are special cased to land exactly on 0 and 1
+  auto pinEnds = [&](V v) {
+    return P::Select(P::Less(zero, t), P::Select(P::Less(t, one), v, one), zero);
+  };
+  auto power = [](V v, i32 n) {
+    V r = v;
+    for (i32 k = 1; k < n; k++) r = P::Mul(r, v);
+    return r;
+  };
+  auto inOutPow = [&](i32 n, f32 scale) {
+    const V s = P::Set1(scale);
+    return P::Select(lowerHalf, P::Mul(s, power(t, n)), P::Sub(one, P::Mul(s, power(u, n))));
+  };
+  auto sqrt0 = [&](V v) { return P::Sqrt(P::Max(zero, v)); };
+
+  if constexpr (EASE == Ease::IN_SINE) {
+    return P::Sub(one, SinLanes<P>(P::MulAdd(t, P::Set1(1.57079633f), P::Set1(1.57079633f))));
+  } else if constexpr (EASE == Ease::OUT_SINE) {
+    return SinLanes<P>(P::Mul(t, P::Set1(1.57079633f)));
+  } else if constexpr (EASE == Ease::IN_OUT_SINE) {
+    const V c = SinLanes<P>(P::MulAdd(t, P::Set1(3.14159265f), P::Set1(1.57079633f)));
+    return P::Sub(half, P::Mul(half, c));
+  } else if constexpr (EASE == Ease::IN_QUAD) {
+    return power(t, 2);
+  } else if constexpr (EASE == Ease::OUT_QUAD) {
+    return P::Sub(one, power(u, 2));
+  } else if constexpr (EASE == Ease::IN_OUT_QUAD) {
+    return inOutPow(2, 2.0f);
+  } else if constexpr (EASE == Ease::IN_CUBIC) {
+    return power(t, 3);
+  } else if constexpr (EASE == Ease::OUT_CUBIC) {
+    return P::Sub(one, power(u, 3));
+  } else if constexpr (EASE == Ease::IN_OUT_CUBIC) {
+    return inOutPow(3, 4.0f);
+  } else if constexpr (EASE == Ease::IN_QUART) {
+    return power(t, 4);
+  } else if constexpr (EASE == Ease::OUT_QUART) {
+    return P::Sub(one, power(u, 4));
+  } else if constexpr (EASE == Ease::IN_OUT_QUART) {
+    return inOutPow(4, 8.0f);
+  } else if constexpr (EASE == Ease::IN_QUINT) {
+    return power(t, 5);
+  } else if constexpr (EASE == Ease::OUT_QUINT) {
+    return P::Sub(one, power(u, 5));
+  } else if constexpr (EASE == Ease::IN_OUT_QUINT) {
+    return inOutPow(5, 16.0f);
+  } else if constexpr (EASE == Ease::IN_EXPO) {
+    return pinEnds(Exp2Lanes<P>(P::MulAdd(t, P::Set1(10.0f), P::Set1(-10.0f))));
+  } else if constexpr (EASE == Ease::OUT_EXPO) {
+    return pinEnds(P::Sub(one, Exp2Lanes<P>(P::Mul(t, P::Set1(-10.0f)))));
+  } else if constexpr (EASE == Ease::IN_OUT_EXPO) {
+    const V e = Exp2Lanes<P>(P::MulAdd(P::Min(t, u), P::Set1(20.0f), P::Set1(-10.0f)));
+    return pinEnds(P::Select(lowerHalf, P::Mul(half, e), P::Sub(one, P::Mul(half, e))));
+  } else if constexpr (EASE == Ease::IN_CIRC) {
+    return P::Sub(one, sqrt0(P::Sub(one, power(t, 2))));
+  } else if constexpr (EASE == Ease::OUT_CIRC) {
+    return sqrt0(P::Sub(one, power(u, 2)));
+  } else if constexpr (EASE == Ease::IN_OUT_CIRC) {
+    // 1 - sqrt(1 - 4 min(t, u)^2) mirrored for the upper half
+    const V m = P::Min(t, u);
+    const V s = P::Mul(half, sqrt0(P::Sub(one, P::Mul(P::Set1(4.0f), power(m, 2)))));
+    return P::Select(lowerHalf, P::Sub(half, s), P::Add(half, s));
+  } else if constexpr (EASE == Ease::IN_BACK) {
+    const V c = P::Set1(1.70158f);
+    return P::Mul(power(t, 2), P::Sub(P::Mul(P::Add(c, one), t), c));
+  } else if constexpr (EASE == Ease::OUT_BACK) {
+    const V c = P::Set1(1.70158f);
+    return P::MulAdd(power(u, 2), P::Sub(c, P::Mul(P::Add(c, one), u)), one);
+  } else if constexpr (EASE == Ease::IN_OUT_BACK) {
+    const V c = P::Set1(1.70158f * 1.525f), c1 = P::Set1(1.70158f * 1.525f + 1.0f);
+    const V a = P::Add(t, t), b = P::Sub(a, P::Set1(2.0f));
+    const V lo = P::Mul(P::Mul(half, power(a, 2)), P::Sub(P::Mul(c1, a), c));
+    const V hi = P::MulAdd(P::Mul(half, power(b, 2)), P::MulAdd(c1, b, c), one);
+    return P::Select(lowerHalf, lo, hi);
+  } else if constexpr (EASE == Ease::IN_ELASTIC) {
+    const V e = Exp2Lanes<P>(P::MulAdd(t, P::Set1(10.0f), P::Set1(-10.0f)));
+    const V s = SinLanes<P>(P::Mul(P::MulAdd(t, P::Set1(10.0f), P::Set1(-10.75f)),
+                                   P::Set1(2.09439510f)));
+    return pinEnds(P::Sub(zero, P::Mul(e, s)));
+  } else if constexpr (EASE == Ease::OUT_ELASTIC) {
+    const V e = Exp2Lanes<P>(P::Mul(t, P::Set1(-10.0f)));
+    const V s = SinLanes<P>(P::Mul(P::MulAdd(t, P::Set1(10.0f), P::Set1(-0.75f)),
+                                   P::Set1(2.09439510f)));
+    return pinEnds(P::MulAdd(e, s, one));
+  } else if constexpr (EASE == Ease::IN_OUT_ELASTIC) {
+    const V e = Exp2Lanes<P>(P::MulAdd(P::Min(t, u), P::Set1(20.0f), P::Set1(-10.0f)));
+    const V s = SinLanes<P>(P::Mul(P::MulAdd(t, P::Set1(20.0f), P::Set1(-11.125f)),
+                                   P::Set1(1.39626340f)));
+    const V es = P::Mul(P::Mul(half, e), s);
+    return pinEnds(P::Select(lowerHalf, P::Sub(zero, es), P::Add(es, one)));
+  } else if constexpr (EASE == Ease::IN_BOUNCE) {
+    return P::Sub(one, OutBounceLanes<P>(u));
+  } else if constexpr (EASE == Ease::OUT_BOUNCE) {
+    return OutBounceLanes<P>(t);
+  } else if constexpr (EASE == Ease::IN_OUT_BOUNCE) {
+    const V b = P::Mul(half, OutBounceLanes<P>(P::Sub(P::Add(P::Max(t, u), P::Max(t, u)), one)));
+    return P::Select(lowerHalf, P::Sub(half, b), P::Add(half, b));
+  } else {
+    return t;
+  }
+}
+// --------------------------------------------------------------------------------
+template <typename P, Ease EASE>
+usize EvaluateEaseBlock(const f32 *t, usize count, f32 *out, usize i) {
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    P::Store(out + i, EaseLanes<P, EASE>(P::Load(t + i)));
+  }
+  return i;
+}
+
+// ================================================================================
+// Full range entry points: P for the bulk, F1 for the tail
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+template <typename P>
+void TransformPoints(
+  const f32 *m, const f32 *x, const f32 *y, const f32 *z, usize count, f32 *ox, f32 *oy, f32 *oz
+) {
+  usize i = TransformPointsBlock<P>(m, x, y, z, count, ox, oy, oz, 0);
+  TransformPointsBlock<F1>(m, x, y, z, count, ox, oy, oz, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void TransformDirections(
+  const f32 *m, const f32 *x, const f32 *y, const f32 *z, usize count, f32 *ox, f32 *oy, f32 *oz
+) {
+  usize i = TransformDirectionsBlock<P>(m, x, y, z, count, ox, oy, oz, 0);
+  TransformDirectionsBlock<F1>(m, x, y, z, count, ox, oy, oz, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void Normalize(f32 *x, f32 *y, f32 *z, usize count) {
+  usize i = NormalizeBlock<P>(x, y, z, count, 0);
+  NormalizeBlock<F1>(x, y, z, count, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void Dot(
+  const f32 *ax, const f32 *ay, const f32 *az, const f32 *bx, const f32 *by, const f32 *bz,
+  usize count, f32 *out
+) {
+  usize i = DotBlock<P>(ax, ay, az, bx, by, bz, count, out, 0);
+  DotBlock<F1>(ax, ay, az, bx, by, bz, count, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void Cross(
+  const f32 *ax, const f32 *ay, const f32 *az, const f32 *bx, const f32 *by, const f32 *bz,
+  usize count, f32 *ox, f32 *oy, f32 *oz
+) {
+  usize i = CrossBlock<P>(ax, ay, az, bx, by, bz, count, ox, oy, oz, 0);
+  CrossBlock<F1>(ax, ay, az, bx, by, bz, count, ox, oy, oz, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void TransformAABBs(
+  const f32 *m, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *ex, const f32 *ey,
+  const f32 *ez, usize count, f32 *ocx, f32 *ocy, f32 *ocz, f32 *oex, f32 *oey, f32 *oez
+) {
+  usize i = TransformAABBsBlock<P>(
+    m, cx, cy, cz, ex, ey, ez, count, ocx, ocy, ocz, oex, oey, oez, 0
+  );
+  TransformAABBsBlock<F1>(m, cx, cy, cz, ex, ey, ez, count, ocx, ocy, ocz, oex, oey, oez, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void QuaternionsToMat4(const f32 *q, usize count, f32 *out) {
+  usize i = QuaternionsToMat4Block<P>(q, count, out, 0);
+  QuaternionsToMat4Block<F1>(q, count, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize CullSpheres(
+  const f32 *planes, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *radii, usize count,
+  u32 *outIndices
+) {
+  usize visible = 0;
+  usize i = CullSpheresBlock<P>(planes, cx, cy, cz, radii, count, outIndices, visible, 0);
+  CullSpheresBlock<F1>(planes, cx, cy, cz, radii, count, outIndices, visible, i);
+  return visible;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+usize CullAABBs(
+  const f32 *planes, const f32 *cx, const f32 *cy, const f32 *cz, const f32 *ex, const f32 *ey,
+  const f32 *ez, usize count, u32 *outIndices
+) {
+  usize visible = 0;
+  usize i = CullAABBsBlock<P>(planes, cx, cy, cz, ex, ey, ez, count, outIndices, visible, 0);
+  CullAABBsBlock<F1>(planes, cx, cy, cz, ex, ey, ez, count, outIndices, visible, i);
+  return visible;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void PackQuaternions(const f32 *q, usize count, u32 bits, u32 *out) {
+  usize i = PackQuaternionsBlock<P>(q, count, bits, out, 0);
+  PackQuaternionsBlock<F1>(q, count, bits, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void UnpackQuaternions(const u32 *packed, usize count, u32 bits, f32 *out) {
+  usize i = UnpackQuaternionsBlock<P>(packed, count, bits, out, 0);
+  UnpackQuaternionsBlock<F1>(packed, count, bits, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void QuantizePositions(
+  const f32 *cell, const f32 *x, const f32 *y, const f32 *z, usize count, u32 bits, u16 *ox,
+  u16 *oy, u16 *oz
+) {
+  usize i = QuantizePositionsBlock<P>(cell, x, y, z, count, bits, ox, oy, oz, 0);
+  QuantizePositionsBlock<F1>(cell, x, y, z, count, bits, ox, oy, oz, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void DequantizePositions(
+  const f32 *cell, const u16 *x, const u16 *y, const u16 *z, usize count, u32 bits, f32 *ox,
+  f32 *oy, f32 *oz
+) {
+  usize i = DequantizePositionsBlock<P>(cell, x, y, z, count, bits, ox, oy, oz, 0);
+  DequantizePositionsBlock<F1>(cell, x, y, z, count, bits, ox, oy, oz, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void FloatsToHalves(const f32 *in, usize count, u16 *out) {
+  usize i = FloatsToHalvesBlock<P>(in, count, out, 0);
+  FloatsToHalvesBlock<F1>(in, count, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void HalvesToFloats(const u16 *in, usize count, f32 *out) {
+  usize i = HalvesToFloatsBlock<P>(in, count, out, 0);
+  HalvesToFloatsBlock<F1>(in, count, out, i);
+}
+// --------------------------------------------------------------------------------
+/// The tail goes through F1, whose MulAdd is fused exactly when P's is, so a given t eases to
+/// the same bits wherever it falls in the range
+template <typename P, Ease EASE>
+void EvaluateEaseRange(const f32 *t, usize count, f32 *out) {
+  usize i = EvaluateEaseBlock<P, EASE>(t, count, out, 0);
+  EvaluateEaseBlock<F1, EASE>(t, count, out, i);
+}
+// --------------------------------------------------------------------------------
+/// One loop per curve, picked once per call rather than per element
+template <typename P>
+void EvaluateEase(Ease ease, const f32 *t, usize count, f32 *out) {
+  using Range = void (*)(const f32 *, usize, f32 *);
+  static constexpr auto ranges = []<u8... E>(std::integer_sequence<u8, E...>) {
+    return std::array<Range, sizeof...(E)>{&EvaluateEaseRange<P, (Ease)E>...};
+  }(std::make_integer_sequence<u8, (u8)Ease::COUNT>{});
+  ranges[(usize)ease](t, count, out);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void FloatsToNorm8(const f32 *in, usize count, f32 lo, f32 scale, u8 *out) {
+  usize i = FloatsToNormBlock<P>(in, count, lo, scale, out, 0);
+  FloatsToNormBlock<F1>(in, count, lo, scale, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void FloatsToNorm16(const f32 *in, usize count, f32 lo, f32 scale, u16 *out) {
+  usize i = FloatsToNormBlock<P>(in, count, lo, scale, out, 0);
+  FloatsToNormBlock<F1>(in, count, lo, scale, out, i);
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+void EncodeOctahedral(const f32 *x, const f32 *y, const f32 *z, usize count, u16 *ox, u16 *oy) {
+  usize i = EncodeOctahedralBlock<P>(x, y, z, count, ox, oy, 0);
+  EncodeOctahedralBlock<F1>(x, y, z, count, ox, oy, i);
+}
+// --------------------------------------------------------------------------------
+/// Moller-Trumbore per lane. A lane that misses gets t = infinity rather than a mask, the
+/// backends have no mask logic, then each lane keeps its closest t and the base of the block it
+/// came from, the lane number completes the index.
+template <typename P>
+usize IntersectRayTrianglesBlock(
+  const f32 *ray, const f32 *v0x, const f32 *v0y, const f32 *v0z, const f32 *e1x, const f32 *e1y,
+  const f32 *e1z, const f32 *e2x, const f32 *e2y, const f32 *e2z, usize count, f32 &best,
+  u32 &bestIndex, usize i
+) {
+  using V = typename P::V;
+  using I = typename P::I;
+  const V ox = P::Set1(ray[0]), oy = P::Set1(ray[1]), oz = P::Set1(ray[2]);
+  const V dx = P::Set1(ray[3]), dy = P::Set1(ray[4]), dz = P::Set1(ray[5]);
+  const V zero = P::Set1(0.0f), one = P::Set1(1.0f), miss = P::Set1(INFINITY);
+  // Only rejects (near) zero determinants, the padding of degenerate triangles among them. Rays
+  // grazing a real triangle fail the barycentric bounds instead.
+  const V minDet = P::Set1(1e-20f);
+  V tBest = P::Set1(best);
+  I base = P::Set1I(0);
+
+  for (; i + P::WIDTH <= count; i += P::WIDTH) {
+    const V ax = P::Load(e1x + i), ay = P::Load(e1y + i), az = P::Load(e1z + i);
+    const V bx = P::Load(e2x + i), by = P::Load(e2y + i), bz = P::Load(e2z + i);
+    const V px = P::Sub(P::Mul(dy, bz), P::Mul(dz, by));
+    const V py = P::Sub(P::Mul(dz, bx), P::Mul(dx, bz));
+    const V pz = P::Sub(P::Mul(dx, by), P::Mul(dy, bx));
+    const V det = P::MulAdd(ax, px, P::MulAdd(ay, py, P::Mul(az, pz)));
+    const V inv = P::Div(one, det);
+
+    const V sx = P::Sub(ox, P::Load(v0x + i));
+    const V sy = P::Sub(oy, P::Load(v0y + i));
+    const V sz = P::Sub(oz, P::Load(v0z + i));
+    const V u = P::Mul(P::MulAdd(sx, px, P::MulAdd(sy, py, P::Mul(sz, pz))), inv);
+    const V qx = P::Sub(P::Mul(sy, az), P::Mul(sz, ay));
+    const V qy = P::Sub(P::Mul(sz, ax), P::Mul(sx, az));
+    const V qz = P::Sub(P::Mul(sx, ay), P::Mul(sy, ax));
+    const V v = P::Mul(P::MulAdd(dx, qx, P::MulAdd(dy, qy, P::Mul(dz, qz))), inv);
+    V t = P::Mul(P::MulAdd(bx, qx, P::MulAdd(by, qy, P::Mul(bz, qz))), inv);
+
+    t = P::Select(P::Less(P::Abs(det), minDet), miss, t);
+    t = P::Select(P::Less(u, zero), miss, t);
+    t = P::Select(P::Less(v, zero), miss, t);
+    t = P::Select(P::Less(one, P::Add(u, v)), miss, t);
+    t = P::Select(P::Less(t, zero), miss, t);
+    // NaN never compares less, such lanes are never taken
+    const auto closer = P::Less(t, tBest);
+    tBest = P::Select(closer, t, tBest);
+    base = P::SelectI(closer, P::Set1I((u32)i), base);
+  }
+
+  f32 lanes[P::WIDTH];
+  u32 bases[P::WIDTH];
+  P::Store(lanes, tBest);
+  P::StoreU32(bases, base);
+  for (usize k = 0; k < P::WIDTH; k++) {
+    if (lanes[k] < best) {
+      best = lanes[k];
+      bestIndex = bases[k] + (u32)k;
+    }
+  }
+  return i;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+f32 IntersectRayTriangles(
+  const f32 *ray, const f32 *v0x, const f32 *v0y, const f32 *v0z, const f32 *e1x, const f32 *e1y,
+  const f32 *e1z, const f32 *e2x, const f32 *e2y, const f32 *e2z, usize count, f32 maxT,
+  u32 *outIndex
+) {
+  usize i = IntersectRayTrianglesBlock<P>(
+    ray, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, count, maxT, *outIndex, 0
+  );
+  IntersectRayTrianglesBlock<F1>(
+    ray, v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z, count, maxT, *outIndex, i
+  );
+  return maxT;
+}
+// --------------------------------------------------------------------------------
+template <typename P>
+constexpr Kernels MakeKernels() {
+  return Kernels{
+    &TransformPoints<P>,     &TransformDirections<P>, &Normalize<P>,
+    &Dot<P>,                 &Cross<P>,               &TransformAABBs<P>,
+    &QuaternionsToMat4<P>,   &CullSpheres<P>,         &CullAABBs<P>,
+    &PackQuaternions<P>,     &UnpackQuaternions<P>,   &QuantizePositions<P>,
+    &DequantizePositions<P>, &FloatsToHalves<P>,      &HalvesToFloats<P>,
+    &EvaluateEase<P>,        &FloatsToNorm8<P>,       &FloatsToNorm16<P>,
+    &EncodeOctahedral<P>,    &IntersectRayTriangles<P>,
+  };
+}
+
+} // namespace
+
+} // namespace Sono::BatchImpl
+
+#endif // !SN_BATCH_KERNELS_H
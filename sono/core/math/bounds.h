@@ -0,0 +1,87 @@
+#ifndef SN_BOUNDS_H
+#define SN_BOUNDS_H
+
+#include "affine3x4.h"
+#include "core/common/types.h"
+#include "vec3.h"
+#include <algorithm>
+#include <cmath>
+
+/// @brief Axis aligned bounding box stored as its two corners
+struct AABB {
+  Vec3 min;
+  Vec3 max;
+
+  AABB() = default;
+
+  constexpr AABB(const Vec3 &min, const Vec3 &max)
+    : min(min)
+    , max(max) {}
+
+  static constexpr AABB FromCenterExtents(const Vec3 &center, const Vec3 &extents) {
+    return AABB(center - extents, center + extents);
+  }
+
+  constexpr Vec3 GetCenter() const { return (min + max) * 0.5f; }
+
+  /// @brief Half size on each axis
+  constexpr Vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+  constexpr b8 Contains(const Vec3 &p) const {
+    return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z &&
+      p.z <= max.z;
+  }
+
+  constexpr void Merge(const AABB &other) {
+    for (i32 i = 0; i < 3; i++) {
+      min[i] = std::min(min[i], other.min[i]);
+      max[i] = std::max(max[i], other.max[i]);
+    }
+  }
+
+  /// @brief The axis aligned box enclosing this box moved by m, see Sono::TransformAABBs
+  inline AABB Transformed(const Affine3x4 &m) const {
+    const Vec3 c = m.TransformPoint(GetCenter());
+    const Vec3 e = GetExtents();
+    Vec3 r;
+    for (i32 i = 0; i < 3; i++) {
+      r[i] = std::fabs(m.n[i][0]) * e.x + std::fabs(m.n[i][1]) * e.y + std::fabs(m.n[i][2]) * e.z;
+    }
+    return FromCenterExtents(c, r);
+  }
+};
+
+/// @brief Sphere bounds, the cheapest volume to move and to test against a frustum
+struct BoundingSphere {
+  Vec3 center;
+  f32 radius;
+
+  BoundingSphere() = default;
+
+  constexpr BoundingSphere(const Vec3 &center, f32 radius)
+    : center(center)
+    , radius(radius) {}
+
+  /// @brief The sphere enclosing box
+  static inline BoundingSphere FromAABB(const AABB &box) {
+    return BoundingSphere(box.GetCenter(), box.GetExtents().Length());
+  }
+
+  /// @brief Moves the center and grows the radius by the largest axis scale of m, so the result
+  /// still encloses the transformed sphere under non uniform scale. An infinite radius (no
+  /// bounds) stays infinite, even under a zero scale.
+  inline BoundingSphere Transformed(const Affine3x4 &m) const {
+    if (std::isinf(radius)) return BoundingSphere(m.TransformPoint(center), radius);
+    f32 maxScaleSq = 0.0f;
+    for (i32 axis = 0; axis < 3; axis++) {
+      const f32 x = m.n[0][axis], y = m.n[1][axis], z = m.n[2][axis];
+      maxScaleSq = std::max(maxScaleSq, x * x + y * y + z * z);
+    }
+    return BoundingSphere(m.TransformPoint(center), radius * std::sqrt(maxScaleSq));
+  }
+};
+
+static_assert(sizeof(AABB) == 6 * sizeof(f32));
+static_assert(sizeof(BoundingSphere) == 4 * sizeof(f32));
+
+#endif // !SN_BOUNDS_H
@@ -0,0 +1,408 @@
+#include "bvh.h"
+#include "bvh_build.h"
+#include <core/common/snassert.h>
+
+namespace {
+
+constexpr u32 SAH_BINS = 16;
+constexpr u32 SAH_MIN_PRIMS = 8;
+
+struct BuildTask {
+  i32 node;
+  i32 parent;
+  u32 begin;
+  u32 end;
+};
+
+} // namespace
+
+namespace Sono::BvhImpl {
+
+// --------------------------------------------------------------------------------
+u32 SplitMedian(BuildPrim *prims, u32 count, const AABB &centerBox) {
+  const Vec3 extent = centerBox.max - centerBox.min;
+  const i32 axis =
+    extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+  std::nth_element(
+    prims, prims + count / 2, prims + count,
+    [&](const BuildPrim &a, const BuildPrim &b) { return a.center[axis] < b.center[axis]; }
+  );
+  return count / 2;
+}
+// --------------------------------------------------------------------------------
+/// All three axes are binned in one pass over the prims
+u32 SplitSah(BuildPrim *prims, u32 count, const AABB &centerBox) {
+  struct Bin {
+    AABB box;
+    u32 count;
+  };
+
+  // A few prims are split at the middle of their widest center axis, binning them would cost
+  // more than the split saves
+  if (count <= SAH_MIN_PRIMS) return SplitMedian(prims, count, centerBox);
+
+  const f32 lo[3] = {centerBox.min.x, centerBox.min.y, centerBox.min.z};
+  const f32 extent[3] = {
+    centerBox.max.x - lo[0], centerBox.max.y - lo[1], centerBox.max.z - lo[2]
+  };
+  f32 scale[3];
+  for (i32 axis = 0; axis < 3; axis++) {
+    scale[axis] = extent[axis] > 0.0f ? (f32)SAH_BINS / extent[axis] : 0.0f;
+  }
+  auto binOf = [&](f32 v, i32 axis) {
+    return std::min(SAH_BINS - 1, (u32)((v - lo[axis]) * scale[axis]));
+  };
+
+  // Bins start empty (inverted boxes) so adding a prim is a plain union
+  constexpr f32 INF = std::numeric_limits<f32>::infinity();
+  const AABB empty(Vec3(INF), Vec3(-INF));
+  Bin bins[3][SAH_BINS];
+  for (auto &axisBins : bins) {
+    for (Bin &bin : axisBins) bin = {empty, 0};
+  }
+  for (u32 i = 0; i < count; i++) {
+    const BuildPrim &p = prims[i];
+    Bin &x = bins[0][binOf(p.center.x, 0)];
+    Bin &y = bins[1][binOf(p.center.y, 1)];
+    Bin &z = bins[2][binOf(p.center.z, 2)];
+    x.box = Bvh::Union(x.box, p.box);
+    y.box = Bvh::Union(y.box, p.box);
+    z.box = Bvh::Union(z.box, p.box);
+    x.count++;
+    y.count++;
+    z.count++;
+  }
+
+  f32 bestCost = std::numeric_limits<f32>::infinity();
+  i32 bestAxis = -1;
+  u32 bestBin = 0;
+  for (i32 axis = 0; axis < 3; axis++) {
+    if (!(extent[axis] > 0.0f)) continue;
+
+    // Area times count of the bins right of each split, then sweep the left side against it
+    f32 rightCost[SAH_BINS];
+    AABB acc;
+    u32 n = 0;
+    for (u32 b = SAH_BINS - 1; b > 0; b--) {
+      const Bin &bin = bins[axis][b];
+      if (bin.count > 0) {
+        acc = n == 0 ? bin.box : Bvh::Union(acc, bin.box);
+        n += bin.count;
+      }
+      rightCost[b] = n > 0 ? Bvh::SurfaceArea(acc) * (f32)n : 0.0f;
+    }
+    n = 0;
+    for (u32 b = 0; b + 1 < SAH_BINS; b++) {
+      const Bin &bin = bins[axis][b];
+      if (bin.count > 0) {
+        acc = n == 0 ? bin.box : Bvh::Union(acc, bin.box);
+        n += bin.count;
+      }
+      if (n == 0 || n == count) continue;
+      const f32 cost = Bvh::SurfaceArea(acc) * (f32)n + rightCost[b + 1];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin = b;
+      }
+    }
+  }
+
+  // All centers in one spot, any halves are as good
+  if (bestAxis < 0) return count / 2;
+
+  BuildPrim *mid = std::partition(prims, prims + count, [&](const BuildPrim &p) {
+    return binOf(p.center[bestAxis], bestAxis) <= bestBin;
+  });
+  return (u32)(mid - prims);
+}
+
+} // namespace Sono::BvhImpl
+
+using namespace Sono::BvhImpl;
+
+// --------------------------------------------------------------------------------
+void Bvh::Build(const u32 *items, const AABB *boxes, usize count, i32 *outLeaves) {
+  Clear();
+  if (count == 0) return;
+  SN_ASSERT(count <= (usize)I32_MAX / 2, "Bvh: too many items");
+
+  const usize nodeCount = 2 * count - 1;
+  m_Nodes.resize(nodeCount);
+  m_Parents.resize(nodeCount);
+  m_Dirty.assign(nodeCount, 0);
+  m_LeafCount = count;
+
+  std::vector<BuildPrim> prims(count);
+  for (usize i = 0; i < count; i++) prims[i] = {boxes[i], boxes[i].GetCenter(), (u32)i};
+
+  // Depth first: a subtree of k leaves takes 2k - 1 nodes, so the right child of a node comes
+  // right after its left subtree
+  std::vector<BuildTask> tasks;
+  tasks.push_back({0, NULL_NODE, 0, (u32)count});
+  while (!tasks.empty()) {
+    const BuildTask task = tasks.back();
+    tasks.pop_back();
+    Node &node = m_Nodes[task.node];
+    m_Parents[task.node] = task.parent;
+
+    if (task.end - task.begin == 1) {
+      const BuildPrim &prim = prims[task.begin];
+      node.box = prim.box;
+      node.left = NULL_NODE;
+      node.item = items[prim.index];
+      if (outLeaves) outLeaves[prim.index] = task.node;
+      continue;
+    }
+
+    AABB box = prims[task.begin].box;
+    AABB centerBox(prims[task.begin].center, prims[task.begin].center);
+    for (u32 i = task.begin + 1; i < task.end; i++) {
+      box = Union(box, prims[i].box);
+      centerBox = Union(centerBox, AABB(prims[i].center, prims[i].center));
+    }
+    node.box = box;
+
+    const u32 leftCount = SplitSah(prims.data() + task.begin, task.end - task.begin, centerBox);
+    const u32 mid = task.begin + leftCount;
+    node.left = task.node + 1;
+    node.right = task.node + 2 * (i32)leftCount;
+    tasks.push_back({node.right, task.node, mid, task.end});
+    tasks.push_back({node.left, task.node, task.begin, mid});
+  }
+  m_Root = 0;
+}
+// --------------------------------------------------------------------------------
+void Bvh::Clear() {
+  m_Nodes.clear();
+  m_Parents.clear();
+  m_Dirty.clear();
+  m_Root = NULL_NODE;
+  m_FreeList = NULL_NODE;
+  m_LeafCount = 0;
+}
+// --------------------------------------------------------------------------------
+i32 Bvh::Insert(u32 item, const AABB &box) {
+  const i32 leaf = AllocNode();
+  m_Nodes[leaf].box = box;
+  m_Nodes[leaf].left = NULL_NODE;
+  m_Nodes[leaf].item = item;
+  m_LeafCount++;
+  if (m_Root == NULL_NODE) {
+    m_Root = leaf;
+    return leaf;
+  }
+
+  // Walk down while pairing the leaf with a child is cheaper than with the current node. Going
+  // down grows the current node either way, which every deeper choice pays too.
+  i32 sibling = m_Root;
+  while (!m_Nodes[sibling].IsLeaf()) {
+    const Node &node = m_Nodes[sibling];
+    const f32 combined = SurfaceArea(Union(node.box, box));
+    const f32 pairCost = 2.0f * combined;
+    const f32 inherited = 2.0f * (combined - SurfaceArea(node.box));
+    auto descendCost = [&](i32 child) {
+      const Node &c = m_Nodes[child];
+      const f32 grown = SurfaceArea(Union(c.box, box));
+      return (c.IsLeaf() ? grown : grown - SurfaceArea(c.box)) + inherited;
+    };
+    const f32 leftCost = descendCost(node.left), rightCost = descendCost(node.right);
+    if (pairCost < leftCost && pairCost < rightCost) break;
+    sibling = leftCost < rightCost ? node.left : node.right;
+  }
+
+  const i32 oldParent = m_Parents[sibling];
+  const i32 parent = AllocNode();
+  m_Nodes[parent].box = Union(m_Nodes[sibling].box, box);
+  m_Nodes[parent].left = sibling;
+  m_Nodes[parent].right = leaf;
+  m_Parents[parent] = oldParent;
+  m_Parents[sibling] = parent;
+  m_Parents[leaf] = parent;
+  m_Dirty[parent] = m_Dirty[sibling];
+  if (oldParent == NULL_NODE) {
+    m_Root = parent;
+  } else {
+    ReplaceChild(oldParent, sibling, parent);
+  }
+  RefitUpwards(parent);
+  return leaf;
+}
+// --------------------------------------------------------------------------------
+void Bvh::Remove(i32 leaf) {
+  ASSERT(leaf >= 0 && (usize)leaf < m_Nodes.size() && m_Nodes[leaf].IsLeaf());
+  m_LeafCount--;
+  const i32 parent = m_Parents[leaf];
+  FreeNode(leaf);
+  if (parent == NULL_NODE) {
+    m_Root = NULL_NODE;
+    return;
+  }
+
+  const i32 sibling = m_Nodes[parent].left == leaf ? m_Nodes[parent].right : m_Nodes[parent].left;
+  const i32 grand = m_Parents[parent];
+  m_Parents[sibling] = grand;
+  FreeNode(parent);
+  if (grand == NULL_NODE) {
+    m_Root = sibling;
+    return;
+  }
+  ReplaceChild(grand, parent, sibling);
+  RefitUpwards(grand);
+}
+// --------------------------------------------------------------------------------
+void Bvh::SetLeafBounds(i32 leaf, const AABB &box) {
+  ASSERT(leaf >= 0 && (usize)leaf < m_Nodes.size() && m_Nodes[leaf].IsLeaf());
+  m_Nodes[leaf].box = box;
+  for (i32 i = leaf; i != NULL_NODE && !m_Dirty[i]; i = m_Parents[i]) m_Dirty[i] = 1;
+}
+// --------------------------------------------------------------------------------
+void Bvh::Refit() {
+  if (m_Root == NULL_NODE || !m_Dirty[m_Root]) return;
+
+  // Post order over the dirty nodes, 2 marks one whose dirty children are on the stack
+  Stack stack;
+  stack.Push(m_Root);
+  while (!stack.IsEmpty()) {
+    const i32 i = stack.Top();
+    Node &node = m_Nodes[i];
+    if (!node.IsLeaf() && m_Dirty[i] == 1) {
+      m_Dirty[i] = 2;
+      if (m_Dirty[node.left]) stack.Push(node.left);
+      if (m_Dirty[node.right]) stack.Push(node.right);
+      continue;
+    }
+    stack.Pop();
+    m_Dirty[i] = 0;
+    if (node.IsLeaf()) continue;
+    node.box = Union(m_Nodes[node.left].box, m_Nodes[node.right].box);
+    Rotate(i);
+  }
+}
+// --------------------------------------------------------------------------------
+u32 Bvh::GetHeight() const {
+  if (m_Root == NULL_NODE) return 0;
+  u32 height = 0;
+  std::vector<std::pair<i32, u32>> stack = {{m_Root, 1}};
+  while (!stack.empty()) {
+    const auto [i, depth] = stack.back();
+    stack.pop_back();
+    height = std::max(height, depth);
+    if (m_Nodes[i].IsLeaf()) continue;
+    stack.push_back({m_Nodes[i].left, depth + 1});
+    stack.push_back({m_Nodes[i].right, depth + 1});
+  }
+  return height;
+}
+// --------------------------------------------------------------------------------
+f32 Bvh::GetSahCost() const {
+  if (m_Root == NULL_NODE) return 0.0f;
+  f32 area = 0.0f;
+  Stack stack;
+  stack.Push(m_Root);
+  while (!stack.IsEmpty()) {
+    const Node &node = m_Nodes[stack.Pop()];
+    if (node.IsLeaf()) continue;
+    area += SurfaceArea(node.box);
+    stack.Push(node.left);
+    stack.Push(node.right);
+  }
+  const f32 rootArea = SurfaceArea(m_Nodes[m_Root].box);
+  return rootArea > 0.0f ? area / rootArea : 0.0f;
+}
+// --------------------------------------------------------------------------------
+i32 Bvh::AllocNode() {
+  i32 node;
+  if (m_FreeList != NULL_NODE) {
+    node = m_FreeList;
+    m_FreeList = m_Nodes[node].left;
+  } else {
+    node = (i32)m_Nodes.size();
+    m_Nodes.emplace_back();
+    m_Parents.push_back(NULL_NODE);
+    m_Dirty.push_back(0);
+  }
+  m_Parents[node] = NULL_NODE;
+  m_Dirty[node] = 0;
+  return node;
+}
+// --------------------------------------------------------------------------------
+void Bvh::FreeNode(i32 node) {
+  m_Nodes[node].left = m_FreeList;
+  m_Parents[node] = NULL_NODE;
+  m_Dirty[node] = 0;
+  m_FreeList = node;
+}
+// --------------------------------------------------------------------------------
+void Bvh::ReplaceChild(i32 parent, i32 oldChild, i32 newChild) {
+  Node &node = m_Nodes[parent];
+  if (node.left == oldChild) {
+    node.left = newChild;
+  } else {
+    ASSERT(node.right == oldChild);
+    node.right = newChild;
+  }
+}
+// --------------------------------------------------------------------------------
+void Bvh::Rotate(i32 node) {
+  const i32 l = m_Nodes[node].left, r = m_Nodes[node].right;
+  const b8 leftInternal = !m_Nodes[l].IsLeaf(), rightInternal = !m_Nodes[r].IsLeaf();
+  if (!leftInternal && !rightInternal) return;
+
+  // Swapping two subtrees under different children of node changes the boxes of their parents
+  // below node, node's own box stays. Candidates are a child with a grandchild on the other
+  // side, or two grandchildren.
+  auto parentGain = [&](i32 moved, i32 incoming) {
+    const i32 parent = m_Parents[moved];
+    if (parent == node) return 0.0f;
+    const Node &p = m_Nodes[parent];
+    const i32 stays = p.left == moved ? p.right : p.left;
+    return SurfaceArea(p.box) - SurfaceArea(Union(m_Nodes[incoming].box, m_Nodes[stays].box));
+  };
+  f32 bestGain = 0.0f;
+  i32 bestA = NULL_NODE, bestB = NULL_NODE;
+  auto consider = [&](i32 a, i32 b) {
+    const f32 gain = parentGain(a, b) + parentGain(b, a);
+    if (gain > bestGain) {
+      bestGain = gain;
+      bestA = a;
+      bestB = b;
+    }
+  };
+  const Node &left = m_Nodes[l], &right = m_Nodes[r];
+  if (rightInternal) {
+    consider(l, right.left);
+    consider(l, right.right);
+  }
+  if (leftInternal) {
+    consider(r, left.left);
+    consider(r, left.right);
+  }
+  if (leftInternal && rightInternal) {
+    consider(left.left, right.left);
+    consider(left.left, right.right);
+  }
+  if (bestA == NULL_NODE) return;
+
+  const i32 parentA = m_Parents[bestA], parentB = m_Parents[bestB];
+  ReplaceChild(parentA, bestA, bestB);
+  ReplaceChild(parentB, bestB, bestA);
+  m_Parents[bestA] = parentB;
+  m_Parents[bestB] = parentA;
+  for (const i32 p : {parentA, parentB}) {
+    if (p == node) continue;
+    Node &n = m_Nodes[p];
+    n.box = Union(m_Nodes[n.left].box, m_Nodes[n.right].box);
+  }
+  // A stale subtree that moved keeps the path to it marked for Refit
+  if (m_Dirty[bestA] && parentB != node) m_Dirty[parentB] = 1;
+  if (m_Dirty[bestB] && parentA != node) m_Dirty[parentA] = 1;
+}
+// --------------------------------------------------------------------------------
+void Bvh::RefitUpwards(i32 node) {
+  for (i32 i = node; i != NULL_NODE; i = m_Parents[i]) {
+    Node &n = m_Nodes[i];
+    n.box = Union(m_Nodes[n.left].box, m_Nodes[n.right].box);
+    Rotate(i);
+  }
+}
@@ -0,0 +1,279 @@
+#ifndef SN_BVH_H
+#define SN_BVH_H
+
+#include "bounds.h"
+#include "core/common/types.h"
+#include "frustum.h"
+#include "vec3.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/// @brief Dynamic bounding volume hierarchy of AABBs, one item per leaf. Items are u32s the
+/// caller picks (e.g. entities), a leaf's node index is its handle for Remove and SetLeafBounds.
+///
+/// Build makes a binned SAH tree from scratch. Insert and Remove change it in place, placing a
+/// new leaf where it grows the tree's surface area the least. Moving items set their leaf bounds
+/// and call Refit, which only walks the paths above the moved leaves. Refits and inserts rotate
+/// subtrees where that shrinks a node (Kopta et al.), so the tree keeps its quality as items
+/// drift. Nodes live in one flat array, a built tree in depth first order so queries read it
+/// mostly forward.
+class Bvh {
+public:
+  static constexpr i32 NULL_NODE = -1;
+
+  struct Node {
+    AABB box;
+    i32 left; // NULL_NODE for leaves
+    union {
+      i32 right;
+      u32 item; // Leaves
+    };
+
+    b8 IsLeaf() const { return left == NULL_NODE; }
+  };
+
+  /// @brief Replace the tree with one leaf per item. outLeaves, when given, receives the leaf of
+  /// each item.
+  void Build(const u32 *items, const AABB *boxes, usize count, i32 *outLeaves = nullptr);
+
+  void Clear();
+
+  /// @return the leaf of the new item
+  i32 Insert(u32 item, const AABB &box);
+
+  void Remove(i32 leaf);
+
+  /// @brief Move a leaf, the tree above it is stale until Refit
+  void SetLeafBounds(i32 leaf, const AABB &box);
+
+  /// @brief Recompute the nodes above the leaves moved since the last Refit, rotating where it
+  /// helps. Cost follows the number of moved leaves and the depth, not the tree size.
+  void Refit();
+
+  /// @brief fn(u32 item) for every leaf whose box overlaps box
+  template <typename Fn>
+  void QueryAABB(const AABB &box, Fn &&fn) const;
+
+  /// @brief fn(u32 item) for every leaf whose box touches the sphere
+  template <typename Fn>
+  void QuerySphere(const BoundingSphere &sphere, Fn &&fn) const;
+
+  /// @brief fn(u32 item) for every leaf box the frustum test of Frustum::Intersects(AABB)
+  /// accepts. Subtrees entirely inside are reported without testing their leaves.
+  template <typename Fn>
+  void QueryFrustum(const Frustum &frustum, Fn &&fn) const;
+
+  /// @brief Leaves whose box the ray origin + t * dir hits for t in [0, maxT], nearer subtrees
+  /// first. fn(u32 item, f32 tEnter) returns the new maxT: the distance of an exact hit to only
+  /// look for closer ones, or maxT unchanged to see every box hit.
+  template <typename Fn>
+  void Raycast(const Vec3 &origin, const Vec3 &dir, f32 maxT, Fn &&fn) const;
+
+  i32 GetRoot() const { return m_Root; }
+  const Node &GetNode(i32 index) const { return m_Nodes[index]; }
+  i32 GetParent(i32 index) const { return m_Parents[index]; }
+  usize GetLeafCount() const { return m_LeafCount; }
+
+  /// @brief Longest root to leaf path, 1 for a single leaf
+  u32 GetHeight() const;
+
+  /// @brief Sum of the internal nodes' surface areas over the root's, the SAH cost of a traversal
+  /// up to constants. Lower is better.
+  f32 GetSahCost() const;
+
+  static f32 SurfaceArea(const AABB &box) {
+    const Vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+  }
+
+  static AABB Union(const AABB &a, const AABB &b) {
+    return AABB(
+      Vec3(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)),
+      Vec3(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z))
+    );
+  }
+
+private:
+  /// Node indices of a traversal, on the C stack until a deep tree outgrows it
+  class Stack {
+  public:
+    void Push(i32 node) {
+      if (m_Size == m_Capacity) Grow();
+      m_Data[m_Size++] = node;
+    }
+    i32 Pop() { return m_Data[--m_Size]; }
+    i32 Top() const { return m_Data[m_Size - 1]; }
+    b8 IsEmpty() const { return m_Size == 0; }
+
+  private:
+    void Grow() {
+      m_Heap.resize(m_Capacity * 2);
+      if (m_Data == m_Local) std::copy(m_Local, m_Local + m_Size, m_Heap.begin());
+      m_Data = m_Heap.data();
+      m_Capacity *= 2;
+    }
+
+    i32 m_Local[64];
+    i32 *m_Data = m_Local;
+    usize m_Size = 0;
+    usize m_Capacity = 64;
+    std::vector<i32> m_Heap;
+  };
+
+  enum class Overlap : u8 { OUTSIDE, PARTIAL, INSIDE };
+
+  /// Depth first over the tree, test(box) decides per node whether to go on
+  template <typename Test, typename Fn>
+  void Traverse(Test &&test, Fn &fn) const;
+
+  i32 AllocNode();
+  void FreeNode(i32 node);
+
+  /// Make newChild take oldChild's place under parent
+  void ReplaceChild(i32 parent, i32 oldChild, i32 newChild);
+
+  /// Swap two subtrees under different children of node when that shrinks the children
+  void Rotate(i32 node);
+
+  /// Recompute boxes from node up to the root, rotating on the way
+  void RefitUpwards(i32 node);
+
+private:
+  std::vector<Node> m_Nodes;
+  std::vector<i32> m_Parents;
+  std::vector<u8> m_Dirty; // Above a leaf moved since the last Refit, so are all its ancestors
+  i32 m_Root = NULL_NODE;
+  i32 m_FreeList = NULL_NODE; // Chained through Node::left
+  usize m_LeafCount = 0;
+};
+
+// --------------------------------------------------------------------------------
+template <typename Test, typename Fn>
+void Bvh::Traverse(Test &&test, Fn &fn) const {
+  if (m_Root == NULL_NODE) return;
+  Stack stack;
+  stack.Push(m_Root);
+  while (!stack.IsEmpty()) {
+    const Node &node = m_Nodes[stack.Pop()];
+    const Overlap overlap = test(node.box);
+    if (overlap == Overlap::OUTSIDE) continue;
+    if (node.IsLeaf()) {
+      fn(node.item);
+      continue;
+    }
+    if (overlap == Overlap::PARTIAL) {
+      stack.Push(node.right);
+      stack.Push(node.left);
+      continue;
+    }
+
+    // Inside, every leaf below is in
+    Stack inner;
+    inner.Push(node.left);
+    inner.Push(node.right);
+    while (!inner.IsEmpty()) {
+      const Node &below = m_Nodes[inner.Pop()];
+      if (below.IsLeaf()) {
+        fn(below.item);
+      } else {
+        inner.Push(below.right);
+        inner.Push(below.left);
+      }
+    }
+  }
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+void Bvh::QueryAABB(const AABB &box, Fn &&fn) const {
+  Traverse(
+    [&](const AABB &b) {
+      const b8 overlaps = b.min.x <= box.max.x && b.max.x >= box.min.x && b.min.y <= box.max.y &&
+        b.max.y >= box.min.y && b.min.z <= box.max.z && b.max.z >= box.min.z;
+      return overlaps ? Overlap::PARTIAL : Overlap::OUTSIDE;
+    },
+    fn
+  );
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+void Bvh::QuerySphere(const BoundingSphere &sphere, Fn &&fn) const {
+  const f32 radiusSq = sphere.radius * sphere.radius;
+  Traverse(
+    [&](const AABB &b) {
+      f32 distSq = 0.0f;
+      for (i32 i = 0; i < 3; i++) {
+        const f32 c = sphere.center[i];
+        const f32 d = c < b.min[i] ? b.min[i] - c : (c > b.max[i] ? c - b.max[i] : 0.0f);
+        distSq += d * d;
+      }
+      return distSq <= radiusSq ? Overlap::PARTIAL : Overlap::OUTSIDE;
+    },
+    fn
+  );
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+void Bvh::QueryFrustum(const Frustum &frustum, Fn &&fn) const {
+  Traverse(
+    [&](const AABB &b) {
+      // Per plane the corner furthest along the normal decides outside, the nearest inside
+      const f32 cx = (b.min.x + b.max.x) * 0.5f, ex = (b.max.x - b.min.x) * 0.5f;
+      const f32 cy = (b.min.y + b.max.y) * 0.5f, ey = (b.max.y - b.min.y) * 0.5f;
+      const f32 cz = (b.min.z + b.max.z) * 0.5f, ez = (b.max.z - b.min.z) * 0.5f;
+      Overlap overlap = Overlap::INSIDE;
+      for (const Plane &plane : frustum.planes) {
+        const Vec3 &n = plane.normal;
+        const f32 dist = n.x * cx + n.y * cy + n.z * cz + plane.d;
+        const f32 reach = std::fabs(n.x) * ex + std::fabs(n.y) * ey + std::fabs(n.z) * ez;
+        if (dist < -reach) return Overlap::OUTSIDE;
+        if (dist < reach) overlap = Overlap::PARTIAL;
+      }
+      return overlap;
+    },
+    fn
+  );
+}
+// --------------------------------------------------------------------------------
+template <typename Fn>
+void Bvh::Raycast(const Vec3 &origin, const Vec3 &dir, f32 maxT, Fn &&fn) const {
+  if (m_Root == NULL_NODE) return;
+  const Vec3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+
+  // Slab test, the entry distance or infinity on a miss
+  constexpr f32 MISS = std::numeric_limits<f32>::infinity();
+  auto enter = [&](const AABB &b) {
+    f32 tMin = 0.0f, tMax = maxT;
+    for (i32 i = 0; i < 3; i++) {
+      f32 t0 = (b.min[i] - origin[i]) * invDir[i];
+      f32 t1 = (b.max[i] - origin[i]) * invDir[i];
+      if (t0 > t1) std::swap(t0, t1);
+      // NaN from 0 * inf (origin on a slab plane of a parallel ray) keeps the old bounds
+      tMin = t0 > tMin ? t0 : tMin;
+      tMax = t1 < tMax ? t1 : tMax;
+    }
+    return tMin <= tMax ? tMin : MISS;
+  };
+
+  Stack stack;
+  if (enter(m_Nodes[m_Root].box) == MISS) return;
+  stack.Push(m_Root);
+  while (!stack.IsEmpty()) {
+    const Node &node = m_Nodes[stack.Pop()];
+    if (node.IsLeaf()) {
+      const f32 t = enter(node.box);
+      if (t != MISS) maxT = fn(node.item, t);
+      continue;
+    }
+    const f32 tLeft = enter(m_Nodes[node.left].box);
+    const f32 tRight = enter(m_Nodes[node.right].box);
+    // The nearer child is popped first
+    const b8 leftFirst = tLeft <= tRight;
+    const i32 near = leftFirst ? node.left : node.right, far = leftFirst ? node.right : node.left;
+    if ((leftFirst ? tRight : tLeft) != MISS) stack.Push(far);
+    if ((leftFirst ? tLeft : tRight) != MISS) stack.Push(near);
+  }
+}
+
+#endif // !SN_BVH_H
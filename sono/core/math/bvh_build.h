@@ -0,0 +1,30 @@
+#ifndef SN_BVH_BUILD_H
+#define SN_BVH_BUILD_H
+
+// Internal to the hierarchy builders (bvh.cpp, triangle_bvh.cpp). Do not include elsewhere.
+
+#include "bounds.h"
+#include "core/common/types.h"
+#include "vec3.h"
+
+namespace Sono::BvhImpl {
+
+/// An item while building, its box and center kept next to each other so the passes over a
+/// node's range read memory in order
+struct BuildPrim {
+  AABB box;
+  Vec3 center;
+  u32 index;
+};
+
+/// Binned SAH split of prims by their centers, reordering them so the left side comes first.
+/// centerBox bounds the centers. The number of prims that go left, at least one and fewer than
+/// count for count >= 2.
+u32 SplitSah(BuildPrim *prims, u32 count, const AABB &centerBox);
+
+/// Split at the median center along the widest axis of centerBox, the number that go left
+u32 SplitMedian(BuildPrim *prims, u32 count, const AABB &centerBox);
+
+} // namespace Sono::BvhImpl
+
+#endif // !SN_BVH_BUILD_H
@@ -0,0 +1,46 @@
+#ifndef SN_EASE_H
+#define SN_EASE_H
+
+#include <core/common/types.h>
+
+// Easing curves by value, for code that stores or batches them (TweenSystem, Sono::EvaluateEase
+// in batch.h). The curves themselves are the Sono::Ease* functions in math.h, in the same order.
+// Kept apart from math.h so the batch kernels can name them without pulling in its inline
+// functions.
+
+enum class Ease : u8 {
+  LINEAR,
+  IN_SINE,
+  OUT_SINE,
+  IN_OUT_SINE,
+  IN_QUAD,
+  OUT_QUAD,
+  IN_OUT_QUAD,
+  IN_CUBIC,
+  OUT_CUBIC,
+  IN_OUT_CUBIC,
+  IN_QUART,
+  OUT_QUART,
+  IN_OUT_QUART,
+  IN_QUINT,
+  OUT_QUINT,
+  IN_OUT_QUINT,
+  IN_EXPO,
+  OUT_EXPO,
+  IN_OUT_EXPO,
+  IN_CIRC,
+  OUT_CIRC,
+  IN_OUT_CIRC,
+  IN_BACK,
+  OUT_BACK,
+  IN_OUT_BACK,
+  IN_ELASTIC,
+  OUT_ELASTIC,
+  IN_OUT_ELASTIC,
+  IN_BOUNCE,
+  OUT_BOUNCE,
+  IN_OUT_BOUNCE,
+  COUNT
+};
+
+#endif // !SN_EASE_H
@@ -0,0 +1,38 @@
+#include "frustum.h"
+#include <cmath>
+
+// --------------------------------------------------------------------------------
+Frustum Frustum::FromViewProjection(const Mat4 &m) {
+  // Clip coordinate j of a point is its dot product with column j, so every plane is column 3
+  // plus or minus one of the other columns
+  auto column = [&](i32 j) { return Vec4(m.n[0][j], m.n[1][j], m.n[2][j], m.n[3][j]); };
+  const Vec4 c0 = column(0), c1 = column(1), c2 = column(2), c3 = column(3);
+  const Vec4 raw[PLANE_COUNT] = {c3 + c0, c3 - c0, c3 + c1, c3 - c1, c3 + c2, c3 - c2};
+
+  Frustum f;
+  for (u32 i = 0; i < PLANE_COUNT; i++) {
+    const Vec3 n(raw[i].x, raw[i].y, raw[i].z);
+    const f32 invLen = 1.0f / n.Length();
+    f.planes[i] = Plane{n * invLen, raw[i].w * invLen};
+  }
+  return f;
+}
+// --------------------------------------------------------------------------------
+b8 Frustum::Intersects(const BoundingSphere &sphere) const {
+  for (const Plane &p : planes) {
+    if (p.Distance(sphere.center) < -sphere.radius) return false;
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 Frustum::Intersects(const AABB &box) const {
+  const Vec3 c = box.GetCenter();
+  const Vec3 e = box.GetExtents();
+  for (const Plane &p : planes) {
+    // Projected radius of the box onto the plane normal
+    const f32 r = std::fabs(p.normal.x) * e.x + std::fabs(p.normal.y) * e.y +
+      std::fabs(p.normal.z) * e.z;
+    if (p.Distance(c) < -r) return false;
+  }
+  return true;
+}
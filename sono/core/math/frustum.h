@@ -0,0 +1,51 @@
+#ifndef SN_FRUSTUM_H
+#define SN_FRUSTUM_H
+
+#include "bounds.h"
+#include "core/common/types.h"
+#include "mat4.h"
+#include "vec3.h"
+
+/// @brief Plane through the points p with normal . p + d = 0. Points on the normal side have a
+/// positive distance.
+struct Plane {
+  Vec3 normal;
+  f32 d;
+
+  constexpr f32 Distance(const Vec3 &p) const { return normal.Dot(p) + d; }
+};
+
+/// @brief The six planes bounding a view volume, normals pointing inwards
+struct Frustum {
+  enum Side : u32 {
+    PLANE_LEFT,
+    PLANE_RIGHT,
+    PLANE_BOTTOM,
+    PLANE_TOP,
+    PLANE_NEAR,
+    PLANE_FAR,
+    PLANE_COUNT
+  };
+
+  Plane planes[PLANE_COUNT];
+
+  /// @brief Gribb/Hartmann extraction from a view * projection matrix (Sono row vectors, clip
+  /// = v * viewProj with -w <= z <= w). The planes are normalized so distances are in world
+  /// units.
+  static Frustum FromViewProjection(const Mat4 &viewProj);
+
+  /// @brief Whether the sphere is at least partly inside
+  b8 Intersects(const BoundingSphere &sphere) const;
+
+  /// @brief Conservative box test: true for every box that touches the frustum, and for a few
+  /// boxes near its corners that do not
+  b8 Intersects(const AABB &box) const;
+
+  /// @brief Planes as 6 consecutive (nx, ny, nz, d), the layout the batch culling kernels take
+  inline const f32 *ValuePtr() const { return &planes[0].normal.x; }
+};
+
+static_assert(sizeof(Plane) == 4 * sizeof(f32));
+static_assert(sizeof(Frustum) == 24 * sizeof(f32));
+
+#endif // !SN_FRUSTUM_H
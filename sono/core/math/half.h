@@ -0,0 +1,78 @@
+#ifndef SN_HALF_H
+#define SN_HALF_H
+
+#include "core/common/types.h"
+#include <bit>
+#include <type_traits>
+
+// IEEE 754 binary16 conversions, the storage of the VAT_HALF2 / VAT_HALF4 vertex formats and of
+// PackedTransform scales. Float to half rounds to nearest even, so for |x| within the normal
+// half range [2^-14, 65504] the relative error is at most 2^-11, below it the absolute error is
+// at most 2^-25. Larger values become infinity and NaN stays NaN. Half to float is exact.
+// Sono::FloatsToHalves / HalvesToFloats are the batch versions and give the same bits.
+
+namespace Sono {
+
+// --------------------------------------------------------------------------------
+/// Branch light integer form of the round to nearest even conversion, the batch kernels use the
+/// same steps lane wise
+constexpr u16 FloatToHalf(f32 value) {
+  constexpr u32 f16Max = (127 + 16) << 23;       // 2^16, first float that overflows
+  constexpr u32 f16MinNormal = (127 - 14) << 23; // 2^-14
+  constexpr f32 denormMagic = 0.5f;              // exponent 126, ulp 2^-24 = the half denormal ulp
+
+  u32 bits = std::bit_cast<u32>(value);
+  const u32 sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  u32 h;
+  if (bits >= f16Max) {
+    h = bits > 0x7f800000u ? 0x7e00u : 0x7c00u; // NaN stays a quiet NaN, the rest is infinity
+  } else if (bits < f16MinNormal) {
+    // Adding 0.5 lines the half denormal ulp up with the float ulp, the FPU does the rounding
+    const f32 shifted = std::bit_cast<f32>(bits) + denormMagic;
+    h = std::bit_cast<u32>(shifted) - std::bit_cast<u32>(denormMagic);
+  } else {
+    const u32 mantissaOdd = (bits >> 13) & 1u;
+    bits += ((u32)(15 - 127) << 23) + 0xfffu + mantissaOdd;
+    h = bits >> 13;
+  }
+  return (u16)(h | (sign >> 16));
+}
+// --------------------------------------------------------------------------------
+/// Exact, every half is a float
+constexpr f32 HalfToFloat(u16 half) {
+  constexpr f32 rebias = std::bit_cast<f32>((u32)(254 - 15) << 23); // 2^112
+  constexpr f32 wasInfNan = std::bit_cast<f32>((u32)(127 + 16) << 23);
+
+  // Exponent and mantissa in float position, scaling by 2^112 fixes the bias and normalizes
+  // denormals in one exact multiply
+  f32 f = std::bit_cast<f32>((u32)(half & 0x7fffu) << 13) * rebias;
+  u32 bits = std::bit_cast<u32>(f);
+  if (f >= wasInfNan) bits |= 0xffu << 23;
+  return std::bit_cast<f32>(bits | (u32)(half & 0x8000u) << 16);
+}
+
+} // namespace Sono
+
+/// @brief A binary16 value in memory. Converts explicitly from f32 and implicitly to f32.
+struct Half {
+  u16 bits;
+
+  Half() = default;
+
+  constexpr explicit Half(f32 value)
+    : bits(Sono::FloatToHalf(value)) {}
+
+  constexpr operator f32() const { return Sono::HalfToFloat(bits); }
+
+  static constexpr Half FromBits(u16 bits) {
+    Half h;
+    h.bits = bits;
+    return h;
+  }
+};
+
+static_assert(sizeof(Half) == 2 && std::is_trivially_copyable_v<Half>);
+
+#endif // !SN_HALF_H
@@ -1,60 +1,48 @@
 #ifndef SN_MATH_LERP_H
 #define SN_MATH_LERP_H
 
+#include "core/animation/tween_system.h"
 #include "core/common/types.h"
-#include "core/common/time.h"
-#include "core/math/math.h"
+#include "core/math/ease.h"
 
+/// @brief A value that eases towards the last end it was given. It is a TweenSystem tween, so it
+/// moves once per frame when the system updates and reading it is a lookup. Needs a live
+/// TweenSystem for its whole lifetime.
 template <typename T>
 class Interpolated {
 public:
-  explicit Interpolated(
-    const T &initial = {}, Sono::TransitionFn fn = Sono::Linear, f32 durationInSec = 1.0f
-  )
-    : m_TransitionFn(fn)
-    , m_StartTime(Time::Now())
-    , m_Speed(1.0f / durationInSec)
-    , m_Start(initial)
-    , m_End(m_Start) {}
-
-  f32 GetElapsedSecs() const { return Time::Now() - m_StartTime; }
-
-  T GetValue() const {
-    // clang-format off
-    f32 t = GetElapsedSecs() * m_Speed;
-    if (t >= 1.0f) {
-      return m_End;
-    }
-    return Sono::Lerp<T>(m_Start, m_End, m_TransitionFn(t));
-    // clang-format on
+  explicit Interpolated(const T &initial = {}, Ease ease = Ease::LINEAR, f32 durationInSec = 1.0f)
+    : m_Handle(TweenSystem::Get().Start(initial, initial, durationInSec, ease)) {}
+
+  ~Interpolated() {
+    if (TweenSystem *ts = TweenSystem::GetPtr()) ts->Release(m_Handle);
   }
 
-  void SetDuration(f32 durationInSec) { m_Speed = 1.0f / durationInSec; }
+  Interpolated(const Interpolated &) = delete;
+  Interpolated &operator=(const Interpolated &) = delete;
+
+  f32 GetElapsedSecs() const { return TweenSystem::Get().GetElapsed(m_Handle); }
+
+  T GetValue() const { return TweenSystem::Get().GetValue<T>(m_Handle); }
+
+  void SetDuration(f32 durationInSec) { TweenSystem::Get().SetDuration(m_Handle, durationInSec); }
 
   void SetStart(T const &startVal) {
-    m_Start = startVal;
-    m_StartTime = Time::Now();
+    TweenSystem &ts = TweenSystem::Get();
+    ts.Restart(m_Handle, startVal, ts.GetTarget<T>(m_Handle));
   }
 
-  void SetEnd(T const &endVal) {
-    m_Start = GetValue();
-    m_End = endVal;
-    m_StartTime = Time::Now();
-  }
+  void SetEnd(T const &endVal) { TweenSystem::Get().Retarget(m_Handle, endVal); }
 
   operator T() const { return GetValue(); };
 
-  T &operator=(const T &endVal) {
+  Interpolated &operator=(const T &endVal) {
     SetEnd(endVal);
-    return m_End;
+    return *this;
   }
 
 private:
-  Sono::TransitionFn m_TransitionFn;
-  f32 m_StartTime;
-  f32 m_Speed;
-  T m_Start;
-  T m_End;
+  TweenHandle m_Handle;
 };
 
 #endif // !SN_MATH_LERP_H
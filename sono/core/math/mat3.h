@@ -5,18 +5,20 @@
 #include "mat_base.h"
 #include "vec3.h"
 
+#include <utility>
+
 struct Mat3 : public MatBase<3, 3, f32> {
   Mat3() = default;
 
   template <typename U>
-  explicit Mat3(const U *ptr)
+  constexpr explicit Mat3(const U *ptr)
     : MatBase(ptr) {}
 
-  Mat3(f32 v)
+  constexpr Mat3(f32 v)
     : MatBase(v) {}
 
   // clang-format off
-  Mat3(
+  constexpr Mat3(
     f32 n00, f32 n01, f32 n02,
     f32 n10, f32 n11, f32 n12,
     f32 n20, f32 n21, f32 n22
@@ -26,15 +28,15 @@ struct Mat3 : public MatBase<3, 3, f32> {
     n[2][0] = n20; n[2][1] = n21; n[2][2] = n22;
   }
 
-  Mat3(const Vec3 &a, const Vec3 &b, const Vec3 &c) {
+  constexpr Mat3(const Vec3 &a, const Vec3 &b, const Vec3 &c) {
     n[0][0] = a.x; n[0][1] = a.y; n[0][2] = a.z;
     n[1][0] = b.x; n[1][1] = b.y; n[1][2] = b.z;
     n[2][0] = c.x; n[2][1] = c.y; n[2][2] = c.z;
   }
   // clang-format on
 
-  Mat3 operator+(const Mat3 &rhs) {
-    Mat3 r;
+  constexpr Mat3 operator+(const Mat3 &rhs) const {
+    Mat3 r{};
 
     r[0][0] = n[0][0] + rhs[0][0];
     r[0][1] = n[0][1] + rhs[0][1];
@@ -51,8 +53,8 @@ struct Mat3 : public MatBase<3, 3, f32> {
     return r;
   }
 
-  Mat3 operator-(const Mat3 &rhs) {
-    Mat3 r;
+  constexpr Mat3 operator-(const Mat3 &rhs) const {
+    Mat3 r{};
 
     r[0][0] = n[0][0] - rhs[0][0];
     r[0][1] = n[0][1] - rhs[0][1];
@@ -69,8 +71,8 @@ struct Mat3 : public MatBase<3, 3, f32> {
     return r;
   }
 
-  Mat3 operator*(const Mat3 &rhs) {
-    Mat3 r;
+  constexpr Mat3 operator*(const Mat3 &rhs) const {
+    Mat3 r{};
 
     r[0][0] = n[0][0] * rhs[0][0] + n[0][1] * rhs[1][0] + n[0][2] * rhs[2][0];
     r[0][1] = n[0][0] * rhs[0][1] + n[0][1] * rhs[1][1] + n[0][2] * rhs[2][1];
@@ -87,23 +89,30 @@ struct Mat3 : public MatBase<3, 3, f32> {
     return r;
   }
 
-  Mat3 &Transpose() {
+  constexpr Mat3 &Transpose() {
     std::swap(n[0][1], n[1][0]);
     std::swap(n[1][2], n[2][1]);
     std::swap(n[0][2], n[2][0]);
     return *this;
   }
 
-  Mat3 Transposed() const {
+  constexpr Mat3 Transposed() const {
     Mat3 ret = *this;
     ret.Transpose();
     return ret;
   }
 
   static const Mat3 Zero;
+  static const Mat3 Identity;
 };
 
-inline Vec3 operator*(const Mat3 &lhs, const Vec3 &rhs) {
+inline constexpr Mat3 Mat3::Zero(0.0f);
+inline constexpr Mat3 Mat3::Identity(1.0f);
+
+static_assert(std::is_trivially_copyable_v<Mat3> && std::is_standard_layout_v<Mat3>);
+static_assert(sizeof(Mat3) == 9 * sizeof(f32));
+
+inline constexpr Vec3 operator*(const Mat3 &lhs, const Vec3 &rhs) {
   return Vec3(
     lhs[0][0] * rhs.x + lhs[0][1] * rhs.y + lhs[0][2] * rhs.z,
     lhs[1][0] * rhs.x + lhs[1][1] * rhs.y + lhs[1][2] * rhs.z,
@@ -111,7 +120,7 @@ inline Vec3 operator*(const Mat3 &lhs, const Vec3 &rhs) {
   );
 }
 
-inline Vec3 operator*(const Vec3 &lhs, const Mat3 &rhs) {
+inline constexpr Vec3 operator*(const Vec3 &lhs, const Mat3 &rhs) {
   return Vec3(
     rhs[0][0] * lhs.x + rhs[0][1] * lhs.y + rhs[0][2] * lhs.z,
     rhs[1][0] * lhs.x + rhs[1][1] * lhs.y + rhs[1][2] * lhs.z,
@@ -1,24 +1,8 @@
 #include "mat4.h"
 #include <cmath>
 
-// TODO: Implement custom matrix manipulation
-
 // clang-format off
 
-const Mat4 Mat4::Zero {
-  0.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 0.0f,
-};
-// --------------------------------------------------------------------------------
-const Mat4 Mat4::Identity {
-  1.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 1.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 1.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 1.0f,
-};
-// --------------------------------------------------------------------------------
 Mat4 Mat4::Rotation(Radian angleRad, const Vec3 &axis) {
   Vec3 a = axis.Normalized();
   float c = std::cos(angleRad);
@@ -58,30 +42,6 @@ Mat4 Mat4::FromEuler(const Vec3 &eulerAngle) {
   };
 }
 // --------------------------------------------------------------------------------
-Mat4 Mat4::Scale(const Vec3 &sv) {
-  Mat4 scale(1.0f);
-  scale[0][0] = sv.x;
-  scale[1][1] = sv.y;
-  scale[2][2] = sv.z;
-  return scale;
-}
-// --------------------------------------------------------------------------------
-Mat4 Mat4::Translation(f32 tx, f32 ty, f32 tz) {
-  Mat4 trans(1.0f);
-  trans[3][0] = tx;
-  trans[3][1] = ty;
-  trans[3][2] = tz;
-  return trans;
-}
-// --------------------------------------------------------------------------------
-Mat4 Mat4::Translation(const Vec3 &tv) {
-  Mat4 trans(1.0f);
-  trans[3][0] = tv.x;
-  trans[3][1] = tv.y;
-  trans[3][2] = tv.z;
-  return trans;
-}
-// --------------------------------------------------------------------------------
 Mat4 Mat4::LookAt(const Vec3 &P, const Vec3 &T, const Vec3 &U) {
   Vec3 _D = (P - T).Normalized();
   Vec3 _R = (U.Cross(_D)).Normalized();
@@ -119,13 +79,13 @@ Mat4 Mat4::Ortho(f32 left, f32 right, f32 bottom, f32 top, f32 zNear, f32 zFar)
   //              0                 0    -2/(far-near)        -far-near/far-near
   //              0                 0                0                         1
 
-  // Column major order matrix
+  // Row vectors take the transpose, the translation goes in row 3
   Mat4 m = Mat4::Identity;
   m[0][0] = 2/(right-left);
-  m[0][3] = (-right-left)/(right-left);
+  m[3][0] = (-right-left)/(right-left);
   m[1][1] = 2/(top-bottom);
-  m[1][3] = (-top-bottom)/(top-bottom);
+  m[3][1] = (-top-bottom)/(top-bottom);
   m[2][2] = -2/(zFar-zNear);
-  m[2][3] = (-zFar-zNear)/(zFar-zNear);
-  return Mat4();
+  m[3][2] = (-zFar-zNear)/(zFar-zNear);
+  return m;
 }
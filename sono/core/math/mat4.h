@@ -3,6 +3,7 @@
 
 #include "core/common/types.h"
 #include "mat3.h"
+#include "mat4_kernels.h"
 #include "mat_base.h"
 #include "vec3.h"
 #include "vec4.h"
@@ -12,10 +13,10 @@ struct Mat4 : public MatBase<4, 4, f32> {
   Mat4() = default;
 
   template <typename U>
-  explicit Mat4(const U *ptr)
+  constexpr explicit Mat4(const U *ptr)
     : MatBase(ptr) {}
 
-  Mat4(f32 v)
+  constexpr Mat4(f32 v)
     : MatBase(v) {}
 
   /// @brief Construct a lookAt matrix
@@ -32,8 +33,8 @@ struct Mat4 : public MatBase<4, 4, f32> {
   static Mat4 Perspective(Radian fov, f32 aspect, f32 zNear, f32 zFar);
 
   /// @brief Construct a orthogonal projection matrix
-  /// @param fov The field of view in float
-  /// @param aspec The aspect ratio in float
+  /// @param left, right The x range of the view volume
+  /// @param bottom, top The y range of the view volume
   /// @param near The distance from the origin to the near plane in float
   /// @param far The distance from the origin to the far plane in float
   static Mat4 Ortho(f32 left, f32 right, f32 bottom, f32 top, f32 zNear, f32 zFar);
@@ -50,15 +51,26 @@ struct Mat4 : public MatBase<4, 4, f32> {
 
   /// @brief create a translation matrix
   /// @brief tv a translation vector
-  static Mat4 Translation(const Vec3 &tv);
-  static Mat4 Translation(f32 tx, f32 ty, f32 tz);
+  static constexpr Mat4 Translation(const Vec3 &tv) { return Translation(tv.x, tv.y, tv.z); }
 
-  /// @brief create a translation matrix
-  /// @brief tv a translation vector
-  static Mat4 Scale(const Vec3 &sv);
+  static constexpr Mat4 Translation(f32 tx, f32 ty, f32 tz) {
+    Mat4 trans(1.0f);
+    trans.SetTranslation(tx, ty, tz);
+    return trans;
+  }
+
+  /// @brief create a scale matrix
+  /// @brief sv the scale on each axis
+  static constexpr Mat4 Scale(const Vec3 &sv) {
+    Mat4 scale(1.0f);
+    scale.n[0][0] = sv.x;
+    scale.n[1][1] = sv.y;
+    scale.n[2][2] = sv.z;
+    return scale;
+  }
 
   // clang-format off
-  Mat4(
+  constexpr Mat4(
     f32 n00, f32 n01, f32 n02, f32 n03,
     f32 n10, f32 n11, f32 n12, f32 n13,
     f32 n20, f32 n21, f32 n22, f32 n23,
@@ -70,7 +82,7 @@ struct Mat4 : public MatBase<4, 4, f32> {
     n[3][0] = n30; n[3][1] = n31; n[3][2] = n32; n[3][3] = n33;
   }
 
-  Mat4(const Vec4 &a, const Vec4 &b, const Vec4 &c, const Vec4 &d) {
+  constexpr Mat4(const Vec4 &a, const Vec4 &b, const Vec4 &c, const Vec4 &d) {
     n[0][0] = a.x; n[0][1] = a.y; n[0][2] = a.z; n[0][3] = a.w;
     n[1][0] = b.x; n[1][1] = b.y; n[1][2] = b.z; n[1][3] = b.w;
     n[2][0] = c.x; n[2][1] = c.y; n[2][2] = c.z; n[2][3] = c.w;
@@ -78,7 +90,7 @@ struct Mat4 : public MatBase<4, 4, f32> {
   }
   // clang-format on
 
-  Mat4 &operator+=(const Mat4 &rhs) {
+  constexpr Mat4 &operator+=(const Mat4 &rhs) {
     n[0][0] += rhs(0, 0);
     n[0][1] += rhs(0, 1);
     n[0][2] += rhs(0, 2);
@@ -102,13 +114,13 @@ struct Mat4 : public MatBase<4, 4, f32> {
     return *this;
   }
 
-  Mat4 operator+(const Mat4 &rhs) const {
+  constexpr Mat4 operator+(const Mat4 &rhs) const {
     Mat4 r = *this;
     r += rhs;
     return r;
   }
 
-  Mat4 &operator-=(const Mat4 &rhs) {
+  constexpr Mat4 &operator-=(const Mat4 &rhs) {
     n[0][0] -= rhs(0, 0);
     n[0][1] -= rhs(0, 1);
     n[0][2] -= rhs(0, 2);
@@ -132,78 +144,109 @@ struct Mat4 : public MatBase<4, 4, f32> {
     return *this;
   }
 
-  Mat4 operator-(const Mat4 &rhs) const {
+  constexpr Mat4 operator-(const Mat4 &rhs) const {
     Mat4 r = *this;
     r -= rhs;
     return r;
   }
 
-  Mat4 &operator*=(const Mat4 &rhs) {
-    Mat4 lhs = *this;
-
-    // clang-format off
-    n[0][0] = lhs(0,0) * rhs(0,0) + lhs(0,1) * rhs(1,0) + lhs(0,2) * rhs(2,0) + lhs(0,3) * rhs(3,0);
-    n[0][1] = lhs(0,0) * rhs(0,1) + lhs(0,1) * rhs(1,1) + lhs(0,2) * rhs(2,1) + lhs(0,3) * rhs(3,1);
-    n[0][2] = lhs(0,0) * rhs(0,2) + lhs(0,1) * rhs(1,2) + lhs(0,2) * rhs(2,2) + lhs(0,3) * rhs(3,2);
-    n[0][3] = lhs(0,0) * rhs(0,3) + lhs(0,1) * rhs(1,3) + lhs(0,2) * rhs(2,3) + lhs(0,3) * rhs(3,3);
-
-    n[1][0] = lhs(1,0) * rhs(0,0) + lhs(1,1) * rhs(1,0) + lhs(1,2) * rhs(2,0) + lhs(1,3) * rhs(3,0);
-    n[1][1] = lhs(1,0) * rhs(0,1) + lhs(1,1) * rhs(1,1) + lhs(1,2) * rhs(2,1) + lhs(1,3) * rhs(3,1);
-    n[1][2] = lhs(1,0) * rhs(0,2) + lhs(1,1) * rhs(1,2) + lhs(1,2) * rhs(2,2) + lhs(1,3) * rhs(3,2);
-    n[1][3] = lhs(1,0) * rhs(0,3) + lhs(1,1) * rhs(1,3) + lhs(1,2) * rhs(2,3) + lhs(1,3) * rhs(3,3);
-
-    n[2][0] = lhs(2,0) * rhs(0,0) + lhs(2,1) * rhs(1,0) + lhs(2,2) * rhs(2,0) + lhs(2,3) * rhs(3,0);
-    n[2][1] = lhs(2,0) * rhs(0,1) + lhs(2,1) * rhs(1,1) + lhs(2,2) * rhs(2,1) + lhs(2,3) * rhs(3,1);
-    n[2][2] = lhs(2,0) * rhs(0,2) + lhs(2,1) * rhs(1,2) + lhs(2,2) * rhs(2,2) + lhs(2,3) * rhs(3,2);
-    n[2][3] = lhs(2,0) * rhs(0,3) + lhs(2,1) * rhs(1,3) + lhs(2,2) * rhs(2,3) + lhs(2,3) * rhs(3,3);
-
-    n[3][0] = lhs(3,0) * rhs(0,0) + lhs(3,1) * rhs(1,0) + lhs(3,2) * rhs(2,0) + lhs(3,3) * rhs(3,0);
-    n[3][1] = lhs(3,0) * rhs(0,1) + lhs(3,1) * rhs(1,1) + lhs(3,2) * rhs(2,1) + lhs(3,3) * rhs(3,1);
-    n[3][2] = lhs(3,0) * rhs(0,2) + lhs(3,1) * rhs(1,2) + lhs(3,2) * rhs(2,2) + lhs(3,3) * rhs(3,2);
-    n[3][3] = lhs(3,0) * rhs(0,3) + lhs(3,1) * rhs(1,3) + lhs(3,2) * rhs(2,3) + lhs(3,3) * rhs(3,3);
-    // clang-format on
-
+  constexpr Mat4 &operator*=(const Mat4 &rhs) {
+    if (std::is_constant_evaluated()) {
+      *this = MultiplyConstexpr(*this, rhs);
+    } else {
+      Sono::Mat4Multiply(ValuePtr(), rhs.ValuePtr(), ValuePtr());
+    }
     return *this;
   }
 
+  /// @brief Each component is a row of lhs dotted with rhs
   friend inline Vec4 operator*(const Mat4 &lhs, const Vec4 &rhs) {
-    return Vec4(
-      lhs(0, 0) * rhs.x + lhs(0, 1) * rhs.y + lhs(0, 2) * rhs.z + lhs(0, 3) * rhs.w,
-      lhs(1, 0) * rhs.x + lhs(1, 1) * rhs.y + lhs(1, 2) * rhs.z + lhs(1, 3) * rhs.w,
-      lhs(2, 0) * rhs.x + lhs(2, 1) * rhs.y + lhs(2, 2) * rhs.z + lhs(2, 3) * rhs.w,
-      lhs(3, 0) * rhs.x + lhs(3, 1) * rhs.y + lhs(3, 2) * rhs.z + lhs(3, 3) * rhs.w
-    );
+    Vec4 r;
+    Sono::Mat4MulVec4(lhs.ValuePtr(), rhs.ValuePtr(), r.ValuePtr());
+    return r;
   }
 
+  /// @brief Row vector transform, points and directions go through the matrix this way
   friend inline Vec4 operator*(const Vec4 &lhs, const Mat4 &rhs) {
-    return Vec4(
-      rhs(0, 0) * lhs.x + rhs(0, 1) * lhs.y + rhs(0, 2) * lhs.z + rhs(0, 3) * lhs.w,
-      rhs(1, 0) * lhs.x + rhs(1, 1) * lhs.y + rhs(1, 2) * lhs.z + rhs(1, 3) * lhs.w,
-      rhs(2, 0) * lhs.x + rhs(2, 1) * lhs.y + rhs(2, 2) * lhs.z + rhs(2, 3) * lhs.w,
-      rhs(3, 0) * lhs.x + rhs(3, 1) * lhs.y + rhs(3, 2) * lhs.z + rhs(3, 3) * lhs.w
-    );
+    Vec4 r;
+    Sono::Vec4MulMat4(lhs.ValuePtr(), rhs.ValuePtr(), r.ValuePtr());
+    return r;
   }
 
-  inline Mat4 operator*(const Mat4 &rhs) const {
-    Mat4 r = *this;
-    r *= rhs;
+  constexpr Mat4 operator*(const Mat4 &rhs) const {
+    if (std::is_constant_evaluated()) return MultiplyConstexpr(*this, rhs);
+    Mat4 r;
+    Sono::Mat4Multiply(ValuePtr(), rhs.ValuePtr(), r.ValuePtr());
     return r;
   }
 
-  inline void SetTranslation(const Vec3 &v) { SetTranslation(v.x, v.y, v.z); }
+  constexpr Mat4 Transposed() const {
+    Mat4 r;
+    if (std::is_constant_evaluated()) {
+      for (i32 i = 0; i < 4; i++) {
+        for (i32 j = 0; j < 4; j++) r.n[j][i] = n[i][j];
+      }
+    } else {
+      Sono::Mat4Transpose(ValuePtr(), r.ValuePtr());
+    }
+    return r;
+  }
+
+  /// @brief General inverse, a singular matrix yields non finite values
+  inline Mat4 Inversed() const {
+    Mat4 r;
+    Sono::Mat4Inverse(ValuePtr(), r.ValuePtr());
+    return r;
+  }
+
+  /// @brief Inverse for matrices without projection (column 3 is 0,0,0,1), e.g. model and
+  /// view matrices. Cheaper than Inversed().
+  inline Mat4 InversedAffine() const {
+    Mat4 r;
+    Sono::Mat4InverseAffine(ValuePtr(), r.ValuePtr());
+    return r;
+  }
 
-  inline void SetTranslation(f32 x, f32 y, f32 z) {
+  constexpr void SetTranslation(const Vec3 &v) { SetTranslation(v.x, v.y, v.z); }
+
+  constexpr void SetTranslation(f32 x, f32 y, f32 z) {
     n[3][0] = x;
     n[3][1] = y;
     n[3][2] = z;
   }
 
-  inline Mat3 ToMat3() const {
+  constexpr Mat3 ToMat3() const {
     return Mat3(n[0][0], n[0][1], n[0][2], n[1][0], n[1][1], n[1][2], n[2][0], n[2][1], n[2][2]);
   }
 
   static const Mat4 Identity;
   static const Mat4 Zero;
+
+private:
+  // The kernels work on raw pointers, which constant evaluation cannot index across rows
+  static constexpr Mat4 MultiplyConstexpr(const Mat4 &a, const Mat4 &b) {
+    Mat4 r(0.0f);
+    for (i32 i = 0; i < 4; i++) {
+      for (i32 j = 0; j < 4; j++) {
+        for (i32 k = 0; k < 4; k++) r.n[i][j] += a.n[i][k] * b.n[k][j];
+      }
+    }
+    return r;
+  }
 };
 
+// clang-format off
+inline constexpr Mat4 Mat4::Zero(0.0f);
+
+inline constexpr Mat4 Mat4::Identity(
+  1.0f, 0.0f, 0.0f, 0.0f,
+  0.0f, 1.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 1.0f, 0.0f,
+  0.0f, 0.0f, 0.0f, 1.0f
+);
+// clang-format on
+
+static_assert(std::is_trivially_copyable_v<Mat4> && std::is_standard_layout_v<Mat4>);
+static_assert(sizeof(Mat4) == 16 * sizeof(f32));
+
 #endif // !SN_MAT4_H
@@ -0,0 +1,443 @@
+#ifndef SN_MAT4_KERNELS_H
+#define SN_MAT4_KERNELS_H
+
+#include "simd.h"
+#include <core/common/types.h>
+
+// 4x4 matrix kernels over 16 row major floats (Mat4::n[row][col]). Sono uses row vectors, so
+// points transform as v * M and the translation lives in row 3. Every kernel reads all of its
+// inputs before writing, so out may alias either operand.
+//
+// The Sono::Scalar versions are always compiled and serve as the reference for the SIMD paths.
+
+namespace Sono {
+
+namespace Scalar {
+
+// --------------------------------------------------------------------------------
+/// out = a * b
+inline void Mat4Multiply(const f32 *a, const f32 *b, f32 *out) {
+  f32 r[16];
+  for (i32 i = 0; i < 4; i++) {
+    const f32 a0 = a[i * 4 + 0], a1 = a[i * 4 + 1], a2 = a[i * 4 + 2], a3 = a[i * 4 + 3];
+    for (i32 j = 0; j < 4; j++) {
+      r[i * 4 + j] = a0 * b[j] + a1 * b[4 + j] + a2 * b[8 + j] + a3 * b[12 + j];
+    }
+  }
+  for (i32 i = 0; i < 16; i++) out[i] = r[i];
+}
+// --------------------------------------------------------------------------------
+inline void Mat4Transpose(const f32 *m, f32 *out) {
+  f32 r[16];
+  for (i32 i = 0; i < 4; i++) {
+    for (i32 j = 0; j < 4; j++) r[j * 4 + i] = m[i * 4 + j];
+  }
+  for (i32 i = 0; i < 16; i++) out[i] = r[i];
+}
+// --------------------------------------------------------------------------------
+/// out = v * m (row vector, the Sono point transform)
+inline void Vec4MulMat4(const f32 *v, const f32 *m, f32 *out) {
+  f32 r[4];
+  for (i32 j = 0; j < 4; j++) {
+    r[j] = v[0] * m[j] + v[1] * m[4 + j] + v[2] * m[8 + j] + v[3] * m[12 + j];
+  }
+  for (i32 j = 0; j < 4; j++) out[j] = r[j];
+}
+// --------------------------------------------------------------------------------
+/// out = m * v (column vector, each output is a row dot v)
+inline void Mat4MulVec4(const f32 *m, const f32 *v, f32 *out) {
+  f32 r[4];
+  for (i32 i = 0; i < 4; i++) {
+    r[i] = m[i * 4 + 0] * v[0] + m[i * 4 + 1] * v[1] + m[i * 4 + 2] * v[2] + m[i * 4 + 3] * v[3];
+  }
+  for (i32 i = 0; i < 4; i++) out[i] = r[i];
+}
+// --------------------------------------------------------------------------------
+/// General inverse by cofactor expansion. A singular input yields non finite values.
+/// @return false if the determinant is zero
+inline b8 Mat4Inverse(const f32 *m, f32 *out) {
+  f32 inv[16];
+  // clang-format off
+  inv[0]  =  m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15]
+           + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+  inv[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15]
+           - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+  inv[8]  =  m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15]
+           + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+  inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14]
+           - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+  inv[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15]
+           - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+  inv[5]  =  m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15]
+           + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+  inv[9]  = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15]
+           - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+  inv[13] =  m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14]
+           + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+  inv[2]  =  m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15]
+           + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+  inv[6]  = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15]
+           - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+  inv[10] =  m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15]
+           + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+  inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14]
+           - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+  inv[3]  = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11]
+           - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+  inv[7]  =  m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11]
+           + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+  inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11]
+           - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+  inv[15] =  m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10]
+           + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+  // clang-format on
+
+  const f32 det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+  const f32 invDet = 1.0f / det;
+  for (i32 i = 0; i < 16; i++) out[i] = inv[i] * invDet;
+  return det != 0.0f;
+}
+// --------------------------------------------------------------------------------
+/// Inverse of an affine matrix (column 3 is 0,0,0,1): the upper 3x3 is inverted through the
+/// cross products of its rows and the translation row becomes -t * inverse(M3).
+/// @return false if the upper 3x3 is singular
+inline b8 Mat4InverseAffine(const f32 *m, f32 *out) {
+  const f32 r0[3] = {m[0], m[1], m[2]};
+  const f32 r1[3] = {m[4], m[5], m[6]};
+  const f32 r2[3] = {m[8], m[9], m[10]};
+  const f32 t[3] = {m[12], m[13], m[14]};
+
+  // Columns of the adjugate
+  const f32 c0[3] = {r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2],
+                     r1[0] * r2[1] - r1[1] * r2[0]};
+  const f32 c1[3] = {r2[1] * r0[2] - r2[2] * r0[1], r2[2] * r0[0] - r2[0] * r0[2],
+                     r2[0] * r0[1] - r2[1] * r0[0]};
+  const f32 c2[3] = {r0[1] * r1[2] - r0[2] * r1[1], r0[2] * r1[0] - r0[0] * r1[2],
+                     r0[0] * r1[1] - r0[1] * r1[0]};
+
+  const f32 det = r0[0] * c0[0] + r0[1] * c0[1] + r0[2] * c0[2];
+  const f32 invDet = 1.0f / det;
+
+  f32 r[16];
+  for (i32 i = 0; i < 3; i++) {
+    r[i * 4 + 0] = c0[i] * invDet;
+    r[i * 4 + 1] = c1[i] * invDet;
+    r[i * 4 + 2] = c2[i] * invDet;
+    r[i * 4 + 3] = 0.0f;
+  }
+  for (i32 j = 0; j < 3; j++) {
+    r[12 + j] = -(t[0] * r[j] + t[1] * r[4 + j] + t[2] * r[8 + j]);
+  }
+  r[15] = 1.0f;
+
+  for (i32 i = 0; i < 16; i++) out[i] = r[i];
+  return det != 0.0f;
+}
+
+} // namespace Scalar
+
+#if defined(SN_SIMD_SSE)
+// ================================================================================
+// SSE / AVX
+// ================================================================================
+
+namespace Simd {
+
+/// 2x2 row major matrix product a * b, matrices packed as (m00, m01, m10, m11)
+SN_FORCE_INLINE __m128 Mat2Mul(__m128 a, __m128 b) {
+  return _mm_add_ps(
+    _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+    _mm_mul_ps(
+      _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))
+    )
+  );
+}
+
+/// adj(a) * b
+SN_FORCE_INLINE __m128 Mat2AdjMul(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+    _mm_mul_ps(
+      _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))
+    )
+  );
+}
+
+/// a * adj(b)
+SN_FORCE_INLINE __m128 Mat2MulAdj(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+    _mm_mul_ps(
+      _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))
+    )
+  );
+}
+
+/// Cross product of the xyz lanes, w is 0 when both inputs have w = 0
+SN_FORCE_INLINE __m128 Cross3(__m128 a, __m128 b) {
+  const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+} // namespace Simd
+
+// --------------------------------------------------------------------------------
+inline void Mat4Multiply(const f32 *a, const f32 *b, f32 *out) {
+  using namespace Simd;
+#if defined(SN_SIMD_AVX)
+  // Two output rows per 256 bit register, b rows duplicated in both lanes
+  const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 0));
+  const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+  const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+  const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+  const __m256 a01 = _mm256_loadu_ps(a);
+  const __m256 a23 = _mm256_loadu_ps(a + 8);
+
+  auto row2 = [&](__m256 ar) {
+    __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(ar, ar, 0x00), b0);
+  #if defined(SN_SIMD_FMA)
+    r = _mm256_fmadd_ps(_mm256_shuffle_ps(ar, ar, 0x55), b1, r);
+    r = _mm256_fmadd_ps(_mm256_shuffle_ps(ar, ar, 0xaa), b2, r);
+    r = _mm256_fmadd_ps(_mm256_shuffle_ps(ar, ar, 0xff), b3, r);
+  #else
+    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(ar, ar, 0x55), b1));
+    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(ar, ar, 0xaa), b2));
+    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(ar, ar, 0xff), b3));
+  #endif
+    return r;
+  };
+  const __m256 r01 = row2(a01);
+  const __m256 r23 = row2(a23);
+  _mm256_storeu_ps(out, r01);
+  _mm256_storeu_ps(out + 8, r23);
+#else
+  const __m128 b0 = _mm_loadu_ps(b + 0);
+  const __m128 b1 = _mm_loadu_ps(b + 4);
+  const __m128 b2 = _mm_loadu_ps(b + 8);
+  const __m128 b3 = _mm_loadu_ps(b + 12);
+  for (i32 i = 0; i < 4; i++) {
+    const __m128 ar = _mm_loadu_ps(a + i * 4);
+    __m128 r = _mm_mul_ps(Splat<0>(ar), b0);
+    r = MulAdd(Splat<1>(ar), b1, r);
+    r = MulAdd(Splat<2>(ar), b2, r);
+    r = MulAdd(Splat<3>(ar), b3, r);
+    _mm_storeu_ps(out + i * 4, r);
+  }
+#endif
+}
+// --------------------------------------------------------------------------------
+inline void Mat4Transpose(const f32 *m, f32 *out) {
+  __m128 r0 = _mm_loadu_ps(m + 0);
+  __m128 r1 = _mm_loadu_ps(m + 4);
+  __m128 r2 = _mm_loadu_ps(m + 8);
+  __m128 r3 = _mm_loadu_ps(m + 12);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(out + 0, r0);
+  _mm_storeu_ps(out + 4, r1);
+  _mm_storeu_ps(out + 8, r2);
+  _mm_storeu_ps(out + 12, r3);
+}
+// --------------------------------------------------------------------------------
+inline void Vec4MulMat4(const f32 *v, const f32 *m, f32 *out) {
+  using namespace Simd;
+  const __m128 vv = _mm_loadu_ps(v);
+  __m128 r = _mm_mul_ps(Splat<0>(vv), _mm_loadu_ps(m + 0));
+  r = MulAdd(Splat<1>(vv), _mm_loadu_ps(m + 4), r);
+  r = MulAdd(Splat<2>(vv), _mm_loadu_ps(m + 8), r);
+  r = MulAdd(Splat<3>(vv), _mm_loadu_ps(m + 12), r);
+  _mm_storeu_ps(out, r);
+}
+// --------------------------------------------------------------------------------
+inline void Mat4MulVec4(const f32 *m, const f32 *v, f32 *out) {
+  using namespace Simd;
+  // Transposing turns the four row dots into a column combination
+  __m128 c0 = _mm_loadu_ps(m + 0);
+  __m128 c1 = _mm_loadu_ps(m + 4);
+  __m128 c2 = _mm_loadu_ps(m + 8);
+  __m128 c3 = _mm_loadu_ps(m + 12);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  const __m128 vv = _mm_loadu_ps(v);
+  __m128 r = _mm_mul_ps(Splat<0>(vv), c0);
+  r = MulAdd(Splat<1>(vv), c1, r);
+  r = MulAdd(Splat<2>(vv), c2, r);
+  r = MulAdd(Splat<3>(vv), c3, r);
+  _mm_storeu_ps(out, r);
+}
+// --------------------------------------------------------------------------------
+/// General inverse through 2x2 blocks:
+///   M = | A B |  inverse(M) = 1/|M| * | X Y |
+///       | C D |                       | Z W |
+/// A singular input yields non finite values.
+/// @return false if the determinant is zero
+inline b8 Mat4Inverse(const f32 *m, f32 *out) {
+  using namespace Simd;
+  const __m128 r0 = _mm_loadu_ps(m + 0);
+  const __m128 r1 = _mm_loadu_ps(m + 4);
+  const __m128 r2 = _mm_loadu_ps(m + 8);
+  const __m128 r3 = _mm_loadu_ps(m + 12);
+
+  const __m128 A = _mm_movelh_ps(r0, r1);
+  const __m128 B = _mm_movehl_ps(r1, r0);
+  const __m128 C = _mm_movelh_ps(r2, r3);
+  const __m128 D = _mm_movehl_ps(r3, r2);
+
+  // (|A|, |B|, |C|, |D|)
+  const __m128 detSub = _mm_sub_ps(
+    _mm_mul_ps(
+      _mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)),
+      _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))
+    ),
+    _mm_mul_ps(
+      _mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)),
+      _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))
+    )
+  );
+  const __m128 detA = Splat<0>(detSub);
+  const __m128 detB = Splat<1>(detSub);
+  const __m128 detC = Splat<2>(detSub);
+  const __m128 detD = Splat<3>(detSub);
+
+  const __m128 dc = Mat2AdjMul(D, C);
+  const __m128 ab = Mat2AdjMul(A, B);
+
+  __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, dc));
+  __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, ab));
+  __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, ab));
+  __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, dc));
+
+  // |M| = |A||D| + |B||C| - tr(adj(A)B * adj(D)C)
+  __m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+  tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+  tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+  const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+  const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+  X = _mm_mul_ps(X, rDetM);
+  Y = _mm_mul_ps(Y, rDetM);
+  Z = _mm_mul_ps(Z, rDetM);
+  W = _mm_mul_ps(W, rDetM);
+
+  // Apply the final adjugate while scattering the blocks back into rows
+  _mm_storeu_ps(out + 0, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+  _mm_storeu_ps(out + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+  _mm_storeu_ps(out + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+  _mm_storeu_ps(out + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+
+  return _mm_cvtss_f32(detM) != 0.0f;
+}
+// --------------------------------------------------------------------------------
+/// Inverse of an affine matrix (column 3 is 0,0,0,1), see Scalar::Mat4InverseAffine.
+/// @return false if the upper 3x3 is singular
+inline b8 Mat4InverseAffine(const f32 *m, f32 *out) {
+  using namespace Simd;
+  const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+  const __m128 r0 = _mm_and_ps(_mm_loadu_ps(m + 0), xyzMask);
+  const __m128 r1 = _mm_and_ps(_mm_loadu_ps(m + 4), xyzMask);
+  const __m128 r2 = _mm_and_ps(_mm_loadu_ps(m + 8), xyzMask);
+  const __m128 t = _mm_loadu_ps(m + 12);
+
+  // Columns of the adjugate, transposed into the rows of the inverse
+  __m128 c0 = Cross3(r1, r2);
+  __m128 c1 = Cross3(r2, r0);
+  __m128 c2 = Cross3(r0, r1);
+
+  __m128 det = _mm_mul_ps(r0, c0);
+  det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+  det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+  const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+  __m128 c3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  c0 = _mm_mul_ps(c0, invDet);
+  c1 = _mm_mul_ps(c1, invDet);
+  c2 = _mm_mul_ps(c2, invDet);
+
+  __m128 nt = _mm_mul_ps(Splat<0>(t), c0);
+  nt = MulAdd(Splat<1>(t), c1, nt);
+  nt = MulAdd(Splat<2>(t), c2, nt);
+  nt = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), nt);
+
+  _mm_storeu_ps(out + 0, c0);
+  _mm_storeu_ps(out + 4, c1);
+  _mm_storeu_ps(out + 8, c2);
+  _mm_storeu_ps(out + 12, nt);
+
+  return _mm_cvtss_f32(det) != 0.0f;
+}
+
+#elif defined(SN_SIMD_NEON)
+// ================================================================================
+// NEON
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+inline void Mat4Multiply(const f32 *a, const f32 *b, f32 *out) {
+  const float32x4_t b0 = vld1q_f32(b + 0);
+  const float32x4_t b1 = vld1q_f32(b + 4);
+  const float32x4_t b2 = vld1q_f32(b + 8);
+  const float32x4_t b3 = vld1q_f32(b + 12);
+  float32x4_t a0 = vld1q_f32(a + 0);
+  float32x4_t a1 = vld1q_f32(a + 4);
+  float32x4_t a2 = vld1q_f32(a + 8);
+  float32x4_t a3 = vld1q_f32(a + 12);
+
+  auto row = [&](float32x4_t ar) {
+    float32x4_t r = vmulq_laneq_f32(b0, ar, 0);
+    r = vfmaq_laneq_f32(r, b1, ar, 1);
+    r = vfmaq_laneq_f32(r, b2, ar, 2);
+    r = vfmaq_laneq_f32(r, b3, ar, 3);
+    return r;
+  };
+  vst1q_f32(out + 0, row(a0));
+  vst1q_f32(out + 4, row(a1));
+  vst1q_f32(out + 8, row(a2));
+  vst1q_f32(out + 12, row(a3));
+}
+// --------------------------------------------------------------------------------
+inline void Mat4Transpose(const f32 *m, f32 *out) {
+  const float32x4x4_t t = vld4q_f32(m);
+  vst1q_f32(out + 0, t.val[0]);
+  vst1q_f32(out + 4, t.val[1]);
+  vst1q_f32(out + 8, t.val[2]);
+  vst1q_f32(out + 12, t.val[3]);
+}
+// --------------------------------------------------------------------------------
+inline void Vec4MulMat4(const f32 *v, const f32 *m, f32 *out) {
+  const float32x4_t vv = vld1q_f32(v);
+  float32x4_t r = vmulq_laneq_f32(vld1q_f32(m + 0), vv, 0);
+  r = vfmaq_laneq_f32(r, vld1q_f32(m + 4), vv, 1);
+  r = vfmaq_laneq_f32(r, vld1q_f32(m + 8), vv, 2);
+  r = vfmaq_laneq_f32(r, vld1q_f32(m + 12), vv, 3);
+  vst1q_f32(out, r);
+}
+// --------------------------------------------------------------------------------
+inline void Mat4MulVec4(const f32 *m, const f32 *v, f32 *out) {
+  const float32x4x4_t c = vld4q_f32(m);
+  const float32x4_t vv = vld1q_f32(v);
+  float32x4_t r = vmulq_laneq_f32(c.val[0], vv, 0);
+  r = vfmaq_laneq_f32(r, c.val[1], vv, 1);
+  r = vfmaq_laneq_f32(r, c.val[2], vv, 2);
+  r = vfmaq_laneq_f32(r, c.val[3], vv, 3);
+  vst1q_f32(out, r);
+}
+// --------------------------------------------------------------------------------
+inline b8 Mat4Inverse(const f32 *m, f32 *out) { return Scalar::Mat4Inverse(m, out); }
+// --------------------------------------------------------------------------------
+inline b8 Mat4InverseAffine(const f32 *m, f32 *out) { return Scalar::Mat4InverseAffine(m, out); }
+
+#else
+
+using Scalar::Mat4Inverse;
+using Scalar::Mat4InverseAffine;
+using Scalar::Mat4Multiply;
+using Scalar::Mat4MulVec4;
+using Scalar::Mat4Transpose;
+using Scalar::Vec4MulMat4;
+
+#endif
+
+} // namespace Sono
+
+#endif // !SN_MAT4_KERNELS_H
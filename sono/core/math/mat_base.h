@@ -29,50 +29,59 @@
 //   0>::eval(m); }
 // };
 
+// Matrix storage, row major. Kept trivially copyable and standard layout so matrices can be
+// memcpy'd into GPU buffers, and constexpr so constant matrices need no dynamic initialization.
 template <int R, int C, typename T>
 struct MatBase {
+  static_assert(R > 1 && C > 1, "Matrix must have at least 2 rows and columns");
+
   T n[R][C];
 
   T *ValuePtr() { return &n[0][0]; }
   const T *ValuePtr() const { return &n[0][0]; }
 
-  MatBase() {}
+  MatBase() = default;
 
   template <typename U>
-  explicit MatBase(const U *ptr) {
-    SN_ASSERT(R > 1 || C > 1, "Matrix must have at least 2 row and column");
+  constexpr explicit MatBase(const U *ptr)
+    : n{} {
     for (int i = 0; i < R; i++) {
       for (int j = 0; j < C; j++) {
-        n[i][j] = T(ptr[i * 4 + j]);
+        n[i][j] = T(ptr[i * C + j]);
       }
     }
   }
 
   template <typename U>
-  explicit MatBase(const MatBase<R, C, U> &o)
-    : MatBase(o.ValuePtr()) {}
+  constexpr explicit MatBase(const MatBase<R, C, U> &o)
+    : n{} {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        n[i][j] = T(o.n[i][j]);
+      }
+    }
+  }
 
   /// @brief setup an identity matrix with the value of v in the diagonal cells
-  explicit MatBase(T v) {
-    SN_ASSERT(R == C, "Must be a square matrix");
-    SN_ASSERT(R > 1 || C > 1, "Matrix must have at least 2 row and column");
-    memset(n, 0, R * C * sizeof(T));
+  constexpr explicit MatBase(T v)
+    : n{} {
+    static_assert(R == C, "Must be a square matrix");
     for (int i = 0; i < R; i++) {
       n[i][i] = v;
     }
   }
 
-  T *operator[](usize row) {
+  constexpr T *operator[](usize row) {
     SN_ASSERT(row < R, "Index out of bound");
     return n[row];
   }
 
-  const T *operator[](usize row) const {
+  constexpr const T *operator[](usize row) const {
     SN_ASSERT(row < R, "Index out of bound");
     return n[row];
   }
 
-  const T &operator()(usize row, usize col) const {
+  constexpr const T &operator()(usize row, usize col) const {
     SN_ASSERT(row < R && col < C, "Index out of bound");
     return n[row][col];
   }
@@ -2,6 +2,7 @@
 #define SN_MATH_H
 
 #include <core/common/types.h>
+#include <core/math/ease.h>
 #include <cmath>
 
 typedef f32 Radian;
@@ -41,70 +42,143 @@ constexpr inline f32 EaseInCubic(f32 t) { return t * t * t; }
 /// 1 - (1 - t) * (1 - t) * (1 - t)
 constexpr inline f32 EaseOutCubic(f32 t) { return 3.0f * t - 3.0f * t * t + t * t * t; }
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutCubic(f32 t) { return t; }
+constexpr inline f32 EaseInOutCubic(f32 t) {
+  const f32 u = 1.0f - t;
+  return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInQuart(f32 t) { return t; }
+constexpr inline f32 EaseInQuart(f32 t) { return t * t * t * t; }
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseOutQuart(f32 t) { return t; }
+/// 1 - (1 - t)^4
+constexpr inline f32 EaseOutQuart(f32 t) {
+  const f32 u = 1.0f - t;
+  return 1.0f - u * u * u * u;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutQuart(f32 t) { return t; }
+constexpr inline f32 EaseInOutQuart(f32 t) {
+  const f32 u = 1.0f - t;
+  return t < 0.5f ? 8.0f * t * t * t * t : 1.0f - 8.0f * u * u * u * u;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInQuint(f32 t) { return t; }
+constexpr inline f32 EaseInQuint(f32 t) { return t * t * t * t * t; }
 // --------------------------------------------------------------------------------
 /// 1 - (1 - t)^5
-inline f32 EaseOutQuint(f32 t) { return 1.0f - std::powf(1.0f - t, 5.0f); }
+constexpr inline f32 EaseOutQuint(f32 t) {
+  const f32 u = 1.0f - t;
+  return 1.0f - u * u * u * u * u;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutQuint(f32 t) { return t; }
+constexpr inline f32 EaseInOutQuint(f32 t) {
+  const f32 u = 1.0f - t;
+  return t < 0.5f ? 16.0f * t * t * t * t * t : 1.0f - 16.0f * u * u * u * u * u;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInExpo(f32 t) { return t; }
+/// 2^(10t - 10), exactly 0 at t = 0
+inline f32 EaseInExpo(f32 t) { return t == 0.0f ? 0.0f : std::exp2(10.0f * t - 10.0f); }
 // --------------------------------------------------------------------------------
-inline f32 EaseOutExpo(f32 t) { return t == 1.0f ? 1.0f : 1.0f - std::powf(2.0f, -10.0f * t); }
+/// 1 - 2^(-10t), exactly 1 at t = 1
+inline f32 EaseOutExpo(f32 t) { return t == 1.0f ? 1.0f : 1.0f - std::exp2(-10.0f * t); }
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutExpo(f32 t) { return t; }
+inline f32 EaseInOutExpo(f32 t) {
+  if (t == 0.0f || t == 1.0f) return t;
+  return t < 0.5f ? std::exp2(20.0f * t - 10.0f) / 2.0f
+                  : 1.0f - std::exp2(10.0f - 20.0f * t) / 2.0f;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInCirc(f32 t) { return t; }
+/// 1 - sqrt(1 - t^2)
+inline f32 EaseInCirc(f32 t) { return 1.0f - std::sqrt(std::fmax(0.0f, 1.0f - t * t)); }
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseOutCirc(f32 t) { return t; }
+/// sqrt(1 - (1 - t)^2)
+inline f32 EaseOutCirc(f32 t) {
+  const f32 u = 1.0f - t;
+  return std::sqrt(std::fmax(0.0f, 1.0f - u * u));
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutCirc(f32 t) { return t; }
+inline f32 EaseInOutCirc(f32 t) {
+  const f32 u = 1.0f - t;
+  return t < 0.5f ? (1.0f - std::sqrt(std::fmax(0.0f, 1.0f - 4.0f * t * t))) / 2.0f
+                  : (1.0f + std::sqrt(std::fmax(0.0f, 1.0f - 4.0f * u * u))) / 2.0f;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInBack(f32 t) { return t; }
+/// Overshoot of the Back easings, about 10% past the end
+constexpr f32 EASE_BACK_OVERSHOOT = 1.70158f;
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseOutBack(f32 t) { return t; }
+/// t^2 * ((c + 1) t - c), dips below 0 before leaving
+constexpr inline f32 EaseInBack(f32 t) {
+  constexpr f32 c = EASE_BACK_OVERSHOOT;
+  return t * t * ((c + 1.0f) * t - c);
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutBack(f32 t) { return t; }
+/// 1 + (1 - t)^2 * (c - (c + 1)(1 - t)), overshoots 1 before settling
+constexpr inline f32 EaseOutBack(f32 t) {
+  constexpr f32 c = EASE_BACK_OVERSHOOT;
+  const f32 u = 1.0f - t;
+  return 1.0f + u * u * (c - (c + 1.0f) * u);
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInElastic(f32 t) { return t; }
+constexpr inline f32 EaseInOutBack(f32 t) {
+  constexpr f32 c = EASE_BACK_OVERSHOOT * 1.525f;
+  const f32 a = 2.0f * t, b = 2.0f * t - 2.0f;
+  return t < 0.5f ? a * a * ((c + 1.0f) * a - c) / 2.0f
+                  : (b * b * ((c + 1.0f) * b + c) + 2.0f) / 2.0f;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseOutElastic(f32 t) { return t; }
+/// -2^(10t - 10) sin((10t - 10.75) 2PI / 3)
+inline f32 EaseInElastic(f32 t) {
+  if (t == 0.0f || t == 1.0f) return t;
+  return -std::exp2(10.0f * t - 10.0f) * std::sin((10.0f * t - 10.75f) * (2.0f * PI / 3.0f));
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutElastic(f32 t) { return t; }
+/// 2^(-10t) sin((10t - 0.75) 2PI / 3) + 1
+inline f32 EaseOutElastic(f32 t) {
+  if (t == 0.0f || t == 1.0f) return t;
+  return std::exp2(-10.0f * t) * std::sin((10.0f * t - 0.75f) * (2.0f * PI / 3.0f)) + 1.0f;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInBounce(f32 t) { return t; }
+inline f32 EaseInOutElastic(f32 t) {
+  if (t == 0.0f || t == 1.0f) return t;
+  const f32 s = std::sin((20.0f * t - 11.125f) * (2.0f * PI / 4.5f));
+  return t < 0.5f ? -std::exp2(20.0f * t - 10.0f) * s / 2.0f
+                  : std::exp2(10.0f - 20.0f * t) * s / 2.0f + 1.0f;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseOutBounce(f32 t) { return t; }
+/// Four parabolic hops of shrinking height, the last one lands on 1
+constexpr inline f32 EaseOutBounce(f32 t) {
+  constexpr f32 n = 7.5625f, d = 2.75f;
+  if (t < 1.0f / d) return n * t * t;
+  if (t < 2.0f / d) {
+    t -= 1.5f / d;
+    return n * t * t + 0.75f;
+  }
+  if (t < 2.5f / d) {
+    t -= 2.25f / d;
+    return n * t * t + 0.9375f;
+  }
+  t -= 2.625f / d;
+  return n * t * t + 0.984375f;
+}
 // --------------------------------------------------------------------------------
-// TODO:
-constexpr inline f32 EaseInOutBounce(f32 t) { return t; }
+constexpr inline f32 EaseInBounce(f32 t) { return 1.0f - EaseOutBounce(1.0f - t); }
+// --------------------------------------------------------------------------------
+constexpr inline f32 EaseInOutBounce(f32 t) {
+  return t < 0.5f ? (1.0f - EaseOutBounce(1.0f - 2.0f * t)) / 2.0f
+                  : (1.0f + EaseOutBounce(2.0f * t - 1.0f)) / 2.0f;
+}
+// --------------------------------------------------------------------------------
+/// The function behind an Ease value, Linear for Ease::COUNT
+inline TransitionFn GetEaseFunction(Ease ease) {
+  constexpr TransitionFn functions[] = {
+    Linear,          EaseInSine,     EaseOutSine,      EaseInOutSine,   EaseInQuad,
+    EaseOutQuad,     EaseInOutQuad,  EaseInCubic,      EaseOutCubic,    EaseInOutCubic,
+    EaseInQuart,     EaseOutQuart,   EaseInOutQuart,   EaseInQuint,     EaseOutQuint,
+    EaseInOutQuint,  EaseInExpo,     EaseOutExpo,      EaseInOutExpo,   EaseInCirc,
+    EaseOutCirc,     EaseInOutCirc,  EaseInBack,       EaseOutBack,     EaseInOutBack,
+    EaseInElastic,   EaseOutElastic, EaseInOutElastic, EaseInBounce,    EaseOutBounce,
+    EaseInOutBounce,
+  };
+  static_assert(sizeof(functions) / sizeof(functions[0]) == (usize)Ease::COUNT);
+  return ease < Ease::COUNT ? functions[(usize)ease] : Linear;
+}
 // --------------------------------------------------------------------------------
 template <typename T>
 constexpr inline T Lerp(T a, T b, f32 t) {
@@ -0,0 +1,164 @@
+#include "quantize.h"
+#include "core/common/snassert.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// (v + offset) * scale clamped to [0, top] and rounded to nearest even, step for step what the
+/// batch kernels do so both give the same integers
+u32 Quantize(f32 v, f32 offset, f32 scale, f32 top) {
+  f32 t = (v + offset) * scale;
+  t = t > 0.0f ? t : 0.0f;
+  t = t < top ? t : top;
+  return (u32)std::nearbyint(t);
+}
+
+} // namespace
+
+namespace Sono {
+
+// --------------------------------------------------------------------------------
+u64 PackQuaternion(const Quaternion &q, u32 bits) {
+  SN_ASSERT(
+    bits >= QUATERNION_PACK_MIN_BITS && bits <= QUATERNION_PACK_MAX_BITS,
+    "Quaternion component bits out of range"
+  );
+  const f32 c[4] = {q.w, q.x, q.y, q.z};
+  u32 largest = 0;
+  for (u32 i = 1; i < 4; i++) {
+    if (std::fabs(c[i]) > std::fabs(c[largest])) largest = i;
+  }
+  // q and -q are the same rotation, flip so the dropped component is positive
+  const f32 sign = std::signbit(c[largest]) ? -1.0f : 1.0f;
+
+  const f32 top = (f32)((1u << bits) - 1);
+  const f32 scale = top * SMALLEST_THREE_RANGE; // top / (2 * range)
+  u64 packed = largest;
+  for (u32 i = 0; i < 4; i++) {
+    if (i == largest) continue;
+    packed = (packed << bits) | Quantize(c[i] * sign, SMALLEST_THREE_RANGE, scale, top);
+  }
+  return packed;
+}
+// --------------------------------------------------------------------------------
+Quaternion UnpackQuaternion(u64 packed, u32 bits) {
+  const u32 mask = (1u << bits) - 1;
+  const f32 step = 2.0f * SMALLEST_THREE_RANGE / (f32)mask;
+  const f32 center = 0.5f * (f32)mask;
+
+  f32 v[3];
+  for (i32 k = 2; k >= 0; k--) {
+    v[k] = ((f32)(u32)(packed & mask) - center) * step;
+    packed >>= bits;
+  }
+  const u32 largest = (u32)packed & 3u;
+  const f32 dropped = std::sqrt(std::max(0.0f, 1.0f - (v[0] * v[0] + v[1] * v[1] + v[2] * v[2])));
+
+  f32 c[4];
+  for (u32 i = 0, k = 0; i < 4; i++) c[i] = i == largest ? dropped : v[k++];
+  return Quaternion(c[0], c[1], c[2], c[3]);
+}
+// --------------------------------------------------------------------------------
+f32 PackedQuaternionMaxAngle(u32 bits) {
+  // Each sent component is off by at most half a step e. The dropped one is the largest, so it
+  // is at least 1/2 and its slope |v| / w against the others at most sqrt(3), which keeps the
+  // whole quaternion within 2 * sqrt(3) * e. Unit quaternions d apart are 4 asin(d / 2) apart as
+  // rotations.
+  const f32 e = SMALLEST_THREE_RANGE / (f32)((1u << bits) - 1);
+  return 4.0f * std::asin(std::min(1.0f, std::sqrt(3.0f) * e));
+}
+// --------------------------------------------------------------------------------
+u64 PackPosition(const Vec3 &p, const AABB &cell, u32 bits) {
+  SN_ASSERT(bits >= 1 && bits <= POSITION_PACK_MAX_BITS, "Position bits out of range");
+  const f32 top = (f32)((1u << bits) - 1);
+  u64 packed = 0;
+  for (i32 axis = 2; axis >= 0; axis--) {
+    const f32 extent = cell.max[axis] - cell.min[axis];
+    const f32 scale = extent > 0.0f ? top / extent : 0.0f;
+    packed = (packed << bits) | Quantize(p[axis], -cell.min[axis], scale, top);
+  }
+  return packed;
+}
+// --------------------------------------------------------------------------------
+Vec3 UnpackPosition(u64 packed, const AABB &cell, u32 bits) {
+  const u32 mask = (1u << bits) - 1;
+  Vec3 p;
+  for (i32 axis = 0; axis < 3; axis++) {
+    const f32 step = (cell.max[axis] - cell.min[axis]) / (f32)mask;
+    p[axis] = (f32)(u32)(packed & mask) * step + cell.min[axis];
+    packed >>= bits;
+  }
+  return p;
+}
+// --------------------------------------------------------------------------------
+Vec3 PackedPositionMaxError(const AABB &cell, u32 bits) {
+  // Four roundings of values up to the largest cell coordinate, an ulp of it is below m * 2^-23
+  Vec3 error;
+  for (i32 axis = 0; axis < 3; axis++) {
+    const f32 extent = cell.max[axis] - cell.min[axis];
+    const f32 m = std::max({std::fabs(cell.min[axis]), std::fabs(cell.max[axis]), extent});
+    error[axis] = extent * (0.5f / (f32)((1u << bits) - 1)) + m * 0x1p-22f;
+  }
+  return error;
+}
+
+// --------------------------------------------------------------------------------
+void EncodeOctahedral(const Vec3 &n, i16 *out) {
+  // Step for step what the batch kernel does, so both give the same codes
+  const f32 ax = std::fabs(n.x), ay = std::fabs(n.y), az = std::fabs(n.z);
+  const f32 l1 = std::max(ax + ay + az, 1e-30f);
+  f32 x = n.x / l1, y = n.y / l1;
+  if (n.z < 0.0f) {
+    const f32 fx = (1.0f - std::fabs(y)) * (x < 0.0f ? -1.0f : 1.0f);
+    const f32 fy = (1.0f - std::fabs(x)) * (y < 0.0f ? -1.0f : 1.0f);
+    x = fx;
+    y = fy;
+  }
+  out[0] = FloatToSnorm16(x);
+  out[1] = FloatToSnorm16(y);
+}
+// --------------------------------------------------------------------------------
+Vec3 DecodeOctahedral(const i16 *in) {
+  f32 x = SnormToFloat(in[0], 32767.0f), y = SnormToFloat(in[1], 32767.0f);
+  const f32 z = 1.0f - std::fabs(x) - std::fabs(y);
+  if (z < 0.0f) {
+    const f32 fx = (1.0f - std::fabs(y)) * (x < 0.0f ? -1.0f : 1.0f);
+    const f32 fy = (1.0f - std::fabs(x)) * (y < 0.0f ? -1.0f : 1.0f);
+    x = fx;
+    y = fy;
+  }
+  return Vec3(x, y, z).Normalized();
+}
+
+} // namespace Sono
+
+// ================================================================================
+// PackedTransform
+// ================================================================================
+
+// --------------------------------------------------------------------------------
+PackedTransform PackedTransform::Pack(
+  const Vec3 &position, const Quaternion &rotation, const Vec3 &scale, const AABB &cell
+) {
+  const u64 p = Sono::PackPosition(position, cell, POSITION_BITS);
+  PackedTransform t;
+  t.position[0] = (u16)p;
+  t.position[1] = (u16)(p >> 16);
+  t.position[2] = (u16)(p >> 32);
+  t.scale[0] = Half(scale.x);
+  t.scale[1] = Half(scale.y);
+  t.scale[2] = Half(scale.z);
+  t.rotation = (u32)Sono::PackQuaternion(rotation, ROTATION_BITS);
+  return t;
+}
+// --------------------------------------------------------------------------------
+Vec3 PackedTransform::GetPosition(const AABB &cell) const {
+  const u64 p = (u64)position[0] | (u64)position[1] << 16 | (u64)position[2] << 32;
+  return Sono::UnpackPosition(p, cell, POSITION_BITS);
+}
+// --------------------------------------------------------------------------------
+Quaternion PackedTransform::GetRotation() const {
+  return Sono::UnpackQuaternion(rotation, ROTATION_BITS);
+}
@@ -0,0 +1,117 @@
+#ifndef SN_QUANTIZE_H
+#define SN_QUANTIZE_H
+
+#include "bounds.h"
+#include "core/common/types.h"
+#include "half.h"
+#include "quaternion.h"
+#include "vec3.h"
+#include <cmath>
+#include <type_traits>
+
+// Fixed point codecs for transform state, for snapshots sent over the network and for scenes
+// that keep many transforms resident. Every codec rounds to nearest and states its worst case
+// error, encoding is exact integer work after one float scale so the same input gives the same
+// bits on every backend (Sono::PackQuaternions and friends in batch.h are the batch versions).
+
+namespace Sono {
+
+/// Smallest three: the component with the largest magnitude is dropped and rebuilt from the unit
+/// length, the other three lie in [-1/sqrt(2), 1/sqrt(2)]
+constexpr f32 SMALLEST_THREE_RANGE = 0.70710678118654752f;
+
+constexpr u32 QUATERNION_PACK_MIN_BITS = 2;
+constexpr u32 QUATERNION_PACK_MAX_BITS = 20;
+constexpr u32 POSITION_PACK_MAX_BITS = 21;
+
+/// @brief Smallest three encoding of a unit quaternion in 2 + 3 * bits bits: the index of the
+/// dropped component in the top two bits, then the other three in w, x, y, z order with bits
+/// each. q and -q encode the same, the dropped component is made positive. 9 bits per component
+/// fits 29 bits, 10 bits a u32 and 15 bits 47 bits.
+u64 PackQuaternion(const Quaternion &q, u32 bits);
+
+/// @brief Inverse of PackQuaternion, the result has unit length up to rounding
+Quaternion UnpackQuaternion(u64 packed, u32 bits);
+
+/// @brief Upper bound in radians on the rotation angle between a unit quaternion and its
+/// packed round trip, about 4 * sqrt(3) / (sqrt(2) * (2^bits - 1)): 0.27 degrees at 10 bits,
+/// 0.008 degrees at 15 bits
+f32 PackedQuaternionMaxAngle(u32 bits);
+
+/// @brief Each axis of p mapped to bits bits across cell, x in the lowest bits. Points outside
+/// the cell are clamped to it.
+u64 PackPosition(const Vec3 &p, const AABB &cell, u32 bits);
+
+Vec3 UnpackPosition(u64 packed, const AABB &cell, u32 bits);
+
+/// @brief Largest per axis error of a packed position inside cell: half a quantization step,
+/// plus the float rounding of the cell coordinates that only shows past about 16 bits
+Vec3 PackedPositionMaxError(const AABB &cell, u32 bits);
+
+// --------------------------------------------------------------------------------
+/// v clamped to [lo, 1] (NaN goes to lo) times scale, rounded to nearest even. The normalized
+/// integer vertex formats, the GPU reads back c / scale.
+inline i32 FloatToNorm(f32 v, f32 lo, f32 scale) {
+  v = v > lo ? v : lo;
+  v = v < 1.0f ? v : 1.0f;
+  return (i32)std::nearbyint(v * scale);
+}
+// --------------------------------------------------------------------------------
+/// VAT_BYTE4_SNORM component, [-1, 1] to [-127, 127]
+inline i8 FloatToSnorm8(f32 v) { return (i8)FloatToNorm(v, -1.0f, 127.0f); }
+// --------------------------------------------------------------------------------
+/// VAT_SHORT2_SNORM / VAT_SHORT4_SNORM component, [-1, 1] to [-32767, 32767]
+inline i16 FloatToSnorm16(f32 v) { return (i16)FloatToNorm(v, -1.0f, 32767.0f); }
+// --------------------------------------------------------------------------------
+/// VAT_BYTE4_NORM component, [0, 1] to [0, 255]
+inline u8 FloatToUnorm8(f32 v) { return (u8)FloatToNorm(v, 0.0f, 255.0f); }
+// --------------------------------------------------------------------------------
+/// VAT_USHORT2_NORM / VAT_USHORT4_NORM component, [0, 1] to [0, 65535]
+inline u16 FloatToUnorm16(f32 v) { return (u16)FloatToNorm(v, 0.0f, 65535.0f); }
+// --------------------------------------------------------------------------------
+/// How the GPU decodes a snorm component, -128 and -32768 read as -1
+constexpr f32 SnormToFloat(i32 c, f32 scale) {
+  const f32 v = (f32)c / scale;
+  return v > -1.0f ? v : -1.0f;
+}
+
+/// @brief Octahedral encoding of a unit vector into two snorm16 components, out[0] and out[1]:
+/// the vector is projected onto the octahedron |x| + |y| + |z| = 1 and the lower half folded
+/// over the diagonals. Stored as VAT_SHORT2_SNORM, 4 bytes instead of 12, the round trip stays
+/// within OCTAHEDRAL_MAX_ANGLE. A zero vector encodes as +z.
+void EncodeOctahedral(const Vec3 &n, i16 *out);
+
+/// @brief Inverse of EncodeOctahedral, a unit vector up to rounding
+Vec3 DecodeOctahedral(const i16 *in);
+
+/// Upper bound in radians on the angle between a unit vector and its octahedral round trip, the
+/// worst case measured over millions of directions is about 6.5e-5
+constexpr f32 OCTAHEDRAL_MAX_ANGLE = 7e-5f;
+
+} // namespace Sono
+
+/// @brief Position, rotation and scale in 16 bytes instead of 40. The position is 16 bits per
+/// axis inside a cell the caller picks (a world chunk, the level bounds), the rotation is smallest
+/// three at 10 bits and the scale is half floats.
+struct PackedTransform {
+  u16 position[3];
+  Half scale[3];
+  u32 rotation;
+
+  static constexpr u32 POSITION_BITS = 16;
+  static constexpr u32 ROTATION_BITS = 10;
+
+  static PackedTransform Pack(
+    const Vec3 &position, const Quaternion &rotation, const Vec3 &scale, const AABB &cell
+  );
+
+  Vec3 GetPosition(const AABB &cell) const;
+
+  Quaternion GetRotation() const;
+
+  Vec3 GetScale() const { return Vec3(scale[0], scale[1], scale[2]); }
+};
+
+static_assert(sizeof(PackedTransform) == 16 && std::is_trivially_copyable_v<PackedTransform>);
+
+#endif // !SN_QUANTIZE_H
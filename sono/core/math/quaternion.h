@@ -10,11 +10,9 @@ struct Quaternion {
   f32 w, x, y, z;
 
   // clang-format off
-  Quaternion()
+  constexpr Quaternion()
     : w(1), x(0), y(0), z(0) {}
 
-  ~Quaternion() {}
-
   constexpr Quaternion(f32 s, const Vec3 &v)
     : w(s), x(v.x), y(v.y), z(v.z) {}
 
@@ -31,7 +29,7 @@ struct Quaternion {
     return reinterpret_cast<const Vec3 &>(x);
   }
 
-  inline Quaternion Inversed() const { return Quaternion(w, -x, -y, -z); }
+  constexpr Quaternion Inversed() const { return Quaternion(w, -x, -y, -z); }
 
   inline f32 Length() const { return sqrt(w * w + x * x + y * y + z * z); }
 
@@ -43,7 +41,7 @@ struct Quaternion {
     z *= magInv;
   }
 
-  friend inline Quaternion operator*(const Quaternion &lhs, const Quaternion &rhs) {
+  friend constexpr Quaternion operator*(const Quaternion &lhs, const Quaternion &rhs) {
     // clang-format off
     return Quaternion(
       lhs.w*rhs.w - lhs.x*rhs.x - lhs.y*rhs.y - lhs.z*rhs.z,
@@ -54,14 +52,45 @@ struct Quaternion {
     // clang-format on
   }
 
-  // Vector rotation
-  friend Vec3 operator*(const Quaternion &q, const Vec3 &v) {
-    Quaternion qv(0, v.x, v.y, v.z);
-    Quaternion res = q * qv * q.Inversed();
-    return Vec3(res.x, res.y, res.z);
+  // Vector rotation. Expands q * v * q^-1 for a unit q into v + w t + u x t with t = 2 (u x v)
+  // and u the vector part: two cross products instead of two quaternion products
+  friend constexpr Vec3 operator*(const Quaternion &q, const Vec3 &v) {
+    const f32 tx = 2.0f * (q.y * v.z - q.z * v.y);
+    const f32 ty = 2.0f * (q.z * v.x - q.x * v.z);
+    const f32 tz = 2.0f * (q.x * v.y - q.y * v.x);
+    // clang-format off
+    return Vec3(
+      v.x + q.w * tx + (q.y * tz - q.z * ty),
+      v.y + q.w * ty + (q.z * tx - q.x * tz),
+      v.z + q.w * tz + (q.x * ty - q.y * tx)
+    );
+    // clang-format on
+  }
+
+  /// @brief The local axes after rotation: right is +x, up is +y and forward is -z
+  struct Basis {
+    Vec3 right;
+    Vec3 up;
+    Vec3 forward;
+  };
+
+  /// @brief All three rotated axes at once, sharing the products that ToMat4 needs. Cheaper than
+  /// rotating Vec3::Right, Vec3::Up and Vec3::Forward one by one.
+  constexpr Basis ToBasis() const {
+    const f32 xx = x * x, yy = y * y, zz = z * z;
+    const f32 xy = x * y, xz = x * z, yz = y * z;
+    const f32 wx = w * x, wy = w * y, wz = w * z;
+
+    // clang-format off
+    return Basis{
+      Vec3(1 - 2 * (yy + zz),      2 * (xy + wz),      2 * (xz - wy)),
+      Vec3(    2 * (xy - wz),  1 - 2 * (xx + zz),      2 * (yz + wx)),
+      Vec3(   -2 * (xz + wy),     -2 * (yz - wx), -1 + 2 * (xx + yy))
+    };
+    // clang-format on
   }
 
-  inline Mat4 ToMat4() const {
+  constexpr Mat4 ToMat4() const {
     f32 xx = x * x, yy = y * y, zz = z * z;
     f32 xy = x * y, xz = x * z, yz = y * z;
     f32 wx = w * x, wy = w * y, wz = w * z;
@@ -188,7 +217,9 @@ struct Quaternion {
     return oss.str();
   }
 
-  static inline Quaternion Identity() { return Quaternion(0, 0, 0, 1); }
+  static constexpr Quaternion Identity() { return Quaternion(1, 0, 0, 0); }
 };
 
+static_assert(std::is_trivially_copyable_v<Quaternion> && sizeof(Quaternion) == 4 * sizeof(f32));
+
 #endif // !SN_QUATERION_H
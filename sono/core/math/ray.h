@@ -0,0 +1,35 @@
+#ifndef SN_RAY_H
+#define SN_RAY_H
+
+#include "affine3x4.h"
+#include "core/common/types.h"
+#include "vec3.h"
+
+/// @brief The half line origin + t * dir, t >= 0. dir need not be unit length, distances along
+/// the ray are then in multiples of it.
+struct Ray {
+  Vec3 origin;
+  Vec3 dir;
+
+  Ray() = default;
+
+  constexpr Ray(const Vec3 &origin, const Vec3 &dir)
+    : origin(origin)
+    , dir(dir) {}
+
+  constexpr Vec3 At(f32 t) const { return origin + dir * t; }
+
+  /// @brief The ray moved by m, dir is not renormalized so every point keeps its t. A ray moved
+  /// into a mesh's local space reports hits at the t of the world ray.
+  constexpr Ray Transformed(const Affine3x4 &m) const {
+    return Ray(m.TransformPoint(origin), m.TransformDirection(dir));
+  }
+};
+
+/// @brief Closest triangle hit by a ray
+struct RayHit {
+  f32 t;
+  u32 triangle; // Index of its first index / 3
+};
+
+#endif // !SN_RAY_H
@@ -0,0 +1,69 @@
+#ifndef SN_SIMD_H
+#define SN_SIMD_H
+
+// Compile time instruction set selection for the math kernels. Exactly one backend is active:
+//   SN_SIMD_AVX  : AVX (+FMA when SN_SIMD_FMA) on x86-64, implies the SSE kernels
+//   SN_SIMD_SSE  : SSE2 baseline on x86-64
+//   SN_SIMD_NEON : AArch64 NEON
+//   none         : portable scalar code
+// Define SN_SIMD_DISABLE to force the scalar path.
+
+#if !defined(SN_SIMD_DISABLE)
+  #if defined(__AVX__)
+    #define SN_SIMD_AVX 1
+    #define SN_SIMD_SSE 1
+  #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SN_SIMD_SSE 1
+  #elif defined(__ARM_NEON) && defined(__aarch64__)
+    #define SN_SIMD_NEON 1
+  #endif
+
+  #if defined(SN_SIMD_AVX) && defined(__FMA__)
+    #define SN_SIMD_FMA 1
+  #endif
+#endif
+
+#if defined(SN_SIMD_SSE)
+  #include <immintrin.h>
+#elif defined(SN_SIMD_NEON)
+  #include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+  #define SN_FORCE_INLINE __forceinline
+#else
+  #define SN_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace Sono::Simd {
+
+#if defined(SN_SIMD_AVX)
+constexpr const char *BACKEND_NAME = "avx";
+#elif defined(SN_SIMD_SSE)
+constexpr const char *BACKEND_NAME = "sse2";
+#elif defined(SN_SIMD_NEON)
+constexpr const char *BACKEND_NAME = "neon";
+#else
+constexpr const char *BACKEND_NAME = "scalar";
+#endif
+
+#if defined(SN_SIMD_SSE)
+/// a * b + c, fused when the target has FMA
+SN_FORCE_INLINE __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+  #if defined(SN_SIMD_FMA)
+  return _mm_fmadd_ps(a, b, c);
+  #else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+  #endif
+}
+
+/// Broadcast lane i of v to all four lanes
+template <int I>
+SN_FORCE_INLINE __m128 Splat(__m128 v) {
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+}
+#endif
+
+} // namespace Sono::Simd
+
+#endif // !SN_SIMD_H
@@ -4,13 +4,15 @@
 // --------------------------------------------------------------------------------
 void Transform::Move(const Vec3 &translation, CoordSpace relSpace) {
   if (relSpace == CoordSpace::LOCAL) {
+    const Quaternion::Basis basis = m_Rotation.ToBasis();
     m_Position +=
-      GetRight() * translation.x + GetUp() * translation.y + GetForward() * translation.z;
+      basis.right * translation.x + basis.up * translation.y + basis.forward * translation.z;
   } else {
     m_Position += translation;
   }
 
   m_ModelMatrix.SetTranslation(m_Position);
+  m_IsDirty = true;
 }
 // --------------------------------------------------------------------------------
 const Vec3 &Transform::GetPosition() const { return m_Position; }
@@ -18,20 +20,23 @@ const Vec3 &Transform::GetPosition() const { return m_Position; }
 void Transform::SetPosition(const Vec3 &newPos) {
   m_Position = newPos;
   m_ModelMatrix.SetTranslation(m_Position);
+  m_IsDirty = true;
 }
 // --------------------------------------------------------------------------------
 Vec3 Transform::GetForward() const {
-  return m_Rotation * Vec3::Forward; // forward is the local -z axis
+  return m_Rotation.ToBasis().forward; // forward is the local -z axis
 }
 // --------------------------------------------------------------------------------
 Vec3 Transform::GetRight() const {
-  return m_Rotation * Vec3::Right; // right is the local +x axis
+  return m_Rotation.ToBasis().right; // right is the local +x axis
 }
 // --------------------------------------------------------------------------------
 Vec3 Transform::GetUp() const {
-  return m_Rotation * Vec3::Up; // up is the local +y axis
+  return m_Rotation.ToBasis().up; // up is the local +y axis
 }
 // --------------------------------------------------------------------------------
+Quaternion::Basis Transform::GetBasis() const { return m_Rotation.ToBasis(); }
+// --------------------------------------------------------------------------------
 const Quaternion &Transform::GetRotation() const { return m_Rotation; }
 // --------------------------------------------------------------------------------
 void Transform::SetRotation(const Quaternion &q) {
@@ -92,18 +97,19 @@ void Transform::Scale(const Vec3 &scale) {
 b8 Transform::IsDirty() const { return m_IsDirty; }
 // --------------------------------------------------------------------------------
 Mat4 Transform::GetLocalModelMatrix() const {
-  return Mat4::Scale(m_Scale) * m_Rotation.ToMat4() * Mat4::Translation(m_Position);
+  return Affine3x4::FromTRS(m_Position, m_Rotation, m_Scale).ToMat4();
 }
 // --------------------------------------------------------------------------------
-const Mat4 &Transform::GetModelMatrix() const { return m_ModelMatrix; }
+const Affine3x4 &Transform::GetModelMatrix() const { return m_ModelMatrix; }
 // --------------------------------------------------------------------------------
 void Transform::UpdateModelMatrix() {
-  m_ModelMatrix = GetLocalModelMatrix();
+  m_ModelMatrix = Affine3x4::FromTRS(m_Position, m_Rotation, m_Scale);
   m_IsDirty = false;
 }
 // --------------------------------------------------------------------------------
-void Transform::UpdateModelMatrix(const Mat4 &parentModelMat) {
-  m_ModelMatrix = parentModelMat * GetLocalModelMatrix();
+void Transform::UpdateModelMatrix(const Affine3x4 &parentModelMat) {
+  // Row vectors: the local transform applies first
+  m_ModelMatrix = Affine3x4::FromTRS(m_Position, m_Rotation, m_Scale) * parentModelMat;
   m_IsDirty = false;
 }
 // --------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #ifndef SN_TRANSFORM_H
 #define SN_TRANSFORM_H
 
+#include "affine3x4.h"
 #include "core/math/quaternion.h"
 #include "mat4.h"
 #include "vec3.h"
@@ -13,7 +14,9 @@ public:
   Transform()
     : m_Position{0.0f, 0.0f, 0.0f}
     , m_Scale(1.0f, 1.0f, 1.0f)
-    , m_ModelMatrix(1.0f) {}
+    , m_EditorEuler(Vec3::Zero)
+    , m_ModelMatrix(Affine3x4::Identity)
+    , m_IsDirty(true) {}
 
   explicit Transform(const Vec3 &pos, const Vec3 &rot = Vec3::Zero, const Vec3 &scl = Vec3(1.0f)) {
     m_Position = pos;
@@ -23,6 +26,16 @@ public:
     UpdateModelMatrix();
   }
 
+  /// @brief Position, rotation, scale and the inspector's euler angles (degrees) as they are,
+  /// e.g. read from a file. Starts dirty, the model matrix is computed by the next update.
+  Transform(const Vec3 &pos, const Quaternion &rot, const Vec3 &scl, const Vec3 &eulerDeg)
+    : m_Position(pos)
+    , m_Scale(scl)
+    , m_EditorEuler(eulerDeg)
+    , m_Rotation(rot)
+    , m_ModelMatrix(Affine3x4::Identity)
+    , m_IsDirty(true) {}
+
   // --------------------------------------------------------------------------------
   // Positions
   // --------------------------------------------------------------------------------
@@ -47,6 +60,9 @@ public:
 
   Vec3 GetUp() const;
 
+  /// @brief Right, up and forward in one go, cheaper than the three getters
+  Quaternion::Basis GetBasis() const;
+
   const Quaternion &GetRotation() const;
 
   void SetRotation(const Quaternion &q);
@@ -73,15 +89,20 @@ public:
   // Others ...
   // --------------------------------------------------------------------------------
 
+  /// @brief Whether the local position, rotation or scale changed since the model matrix was
+  /// last computed
   b8 IsDirty() const;
 
   Mat4 GetLocalModelMatrix() const;
 
   void UpdateModelMatrix();
 
-  void UpdateModelMatrix(const Mat4 &parentModelMat);
+  /// @brief Model matrix of a child node, local * parentModelMat
+  void UpdateModelMatrix(const Affine3x4 &parentModelMat);
 
-  const Mat4 &GetModelMatrix() const;
+  /// @brief The 3x4 affine model matrix, expand it with ToMat4() for a shader upload. World space
+  /// for nodes of a Scene, computed by Scene::UpdateTransforms.
+  const Affine3x4 &GetModelMatrix() const;
 
   std::string ToString() const;
 
@@ -94,10 +115,8 @@ private:
 
   Quaternion m_Rotation;
 
-  Mat4 m_RotationMatrix;
-  Mat4 m_ModelMatrix;
+  Affine3x4 m_ModelMatrix;
 
-  // TODO: Make use of this flags after scene graph implementation
   b8 m_IsDirty;
 };
 
@@ -0,0 +1,190 @@
+#include "triangle_bvh.h"
+#include "batch.h"
+#include "bvh.h"
+#include "bvh_build.h"
+#include <core/common/logger.h>
+#include <core/common/snassert.h>
+#include <limits>
+
+using namespace Sono::BvhImpl;
+
+namespace {
+
+struct BuildTask {
+  u32 node;
+  u32 begin;
+  u32 end;
+  u32 depth;
+};
+
+} // namespace
+
+// --------------------------------------------------------------------------------
+void TriangleBvh::Build(
+  const Vec3 *positions, usize vertexCount, const u32 *indices, usize indexCount
+) {
+  BuildFrom(positions, vertexCount, indices, indexCount);
+}
+// --------------------------------------------------------------------------------
+void TriangleBvh::Build(
+  const Vec3 *positions, usize vertexCount, const u16 *indices, usize indexCount
+) {
+  BuildFrom(positions, vertexCount, indices, indexCount);
+}
+// --------------------------------------------------------------------------------
+template <typename Index>
+void TriangleBvh::BuildFrom(
+  const Vec3 *positions, usize vertexCount, const Index *indices, usize indexCount
+) {
+  Clear();
+  const usize triangleCount = indexCount / 3;
+  SN_ASSERT(triangleCount < NO_TRIANGLE, "TriangleBvh: too many triangles");
+
+  std::vector<BuildPrim> prims;
+  prims.reserve(triangleCount);
+  usize skipped = 0;
+  for (usize i = 0; i < triangleCount; i++) {
+    const Index *corner = indices + 3 * i;
+    if (corner[0] >= vertexCount || corner[1] >= vertexCount || corner[2] >= vertexCount) {
+      skipped++;
+      continue;
+    }
+    const Vec3 &a = positions[corner[0]], &b = positions[corner[1]], &c = positions[corner[2]];
+    const AABB box = Bvh::Union(Bvh::Union(AABB(a, a), AABB(b, b)), AABB(c, c));
+    prims.push_back({box, box.GetCenter(), (u32)i});
+  }
+  if (skipped > 0) {
+    LOG_ERROR_F("TriangleBvh: skipped %zu triangles with out of range indices", skipped);
+  }
+  m_TriangleCount = prims.size();
+  if (prims.empty()) return;
+
+  // Leaves take up to LEAF_SIZE triangles, so about 2n / LEAF_SIZE nodes at the usual fill
+  m_Nodes.reserve(4 * prims.size() / LEAF_SIZE + 1);
+  m_Packets.reserve(2 * prims.size() / LEAF_SIZE + 1);
+  m_Nodes.push_back({});
+  std::vector<BuildTask> tasks = {{0, 0, (u32)prims.size(), 1}};
+  while (!tasks.empty()) {
+    const BuildTask task = tasks.back();
+    tasks.pop_back();
+    m_Height = std::max(m_Height, task.depth);
+
+    AABB box = prims[task.begin].box;
+    AABB centerBox(prims[task.begin].center, prims[task.begin].center);
+    for (u32 i = task.begin + 1; i < task.end; i++) {
+      box = Bvh::Union(box, prims[i].box);
+      centerBox = Bvh::Union(centerBox, AABB(prims[i].center, prims[i].center));
+    }
+    m_Nodes[task.node].box = box;
+
+    const u32 count = task.end - task.begin;
+    if (count <= LEAF_SIZE) {
+      m_Nodes[task.node].first = (u32)m_Packets.size();
+      m_Nodes[task.node].count = count;
+      // Unused lanes stay zero, a triangle with zero edges
+      Packet &packet = m_Packets.emplace_back();
+      for (u32 lane = 0; lane < LEAF_SIZE; lane++) packet.triangles[lane] = NO_TRIANGLE;
+      for (u32 lane = 0; lane < count; lane++) {
+        const u32 triangle = prims[task.begin + lane].index;
+        const Index *corner = indices + 3 * (usize)triangle;
+        const Vec3 &v0 = positions[corner[0]];
+        const Vec3 e1 = positions[corner[1]] - v0, e2 = positions[corner[2]] - v0;
+        for (i32 axis = 0; axis < 3; axis++) {
+          packet.v0[axis][lane] = v0[axis];
+          packet.edge1[axis][lane] = e1[axis];
+          packet.edge2[axis][lane] = e2[axis];
+        }
+        packet.triangles[lane] = triangle;
+      }
+      continue;
+    }
+
+    BuildPrim *first = prims.data() + task.begin;
+    const u32 leftCount = task.depth < SAH_MAX_DEPTH ? SplitSah(first, count, centerBox)
+                                                     : SplitMedian(first, count, centerBox);
+    const u32 left = (u32)m_Nodes.size();
+    m_Nodes[task.node].first = left;
+    m_Nodes[task.node].count = 0;
+    m_Nodes.push_back({});
+    m_Nodes.push_back({});
+    const u32 mid = task.begin + leftCount;
+    tasks.push_back({left + 1, mid, task.end, task.depth + 1});
+    tasks.push_back({left, task.begin, mid, task.depth + 1});
+  }
+  SN_ASSERT(m_Height <= MAX_HEIGHT, "TriangleBvh: tree too deep");
+}
+// --------------------------------------------------------------------------------
+void TriangleBvh::Clear() {
+  m_Nodes.clear();
+  m_Packets.clear();
+  m_TriangleCount = 0;
+  m_Height = 0;
+}
+// --------------------------------------------------------------------------------
+AABB TriangleBvh::GetBounds() const {
+  constexpr f32 INF = std::numeric_limits<f32>::infinity();
+  return m_Nodes.empty() ? AABB(Vec3(INF), Vec3(-INF)) : m_Nodes[0].box;
+}
+// --------------------------------------------------------------------------------
+b8 TriangleBvh::Raycast(const Ray &ray, f32 maxT, RayHit &hit) const {
+  if (m_Nodes.empty()) return false;
+  const Vec3 &origin = ray.origin;
+  const Vec3 invDir(1.0f / ray.dir.x, 1.0f / ray.dir.y, 1.0f / ray.dir.z);
+
+  // Slab test against the closest hit so far, the entry distance or infinity on a miss
+  constexpr f32 MISS = std::numeric_limits<f32>::infinity();
+  f32 best = maxT;
+  auto enter = [&](const AABB &b) {
+    f32 tMin = 0.0f, tMax = best;
+    for (i32 i = 0; i < 3; i++) {
+      f32 t0 = (b.min[i] - origin[i]) * invDir[i];
+      f32 t1 = (b.max[i] - origin[i]) * invDir[i];
+      if (t0 > t1) std::swap(t0, t1);
+      // NaN from 0 * inf (origin on a slab plane of a parallel ray) keeps the old bounds
+      tMin = t0 > tMin ? t0 : tMin;
+      tMax = t1 < tMax ? t1 : tMax;
+    }
+    return tMin <= tMax ? tMin : MISS;
+  };
+
+  // Far children wait with their entry distance, skipped once a closer hit is found
+  struct Entry {
+    u32 node;
+    f32 t;
+  };
+  Entry stack[MAX_HEIGHT + 1];
+  usize size = 0;
+  u32 bestTriangle = NO_TRIANGLE;
+
+  if (enter(m_Nodes[0].box) == MISS) return false;
+  stack[size++] = {0, 0.0f};
+  while (size > 0) {
+    const Entry entry = stack[--size];
+    if (entry.t >= best) continue;
+    const Node &node = m_Nodes[entry.node];
+
+    if (node.IsLeaf()) {
+      const Packet &p = m_Packets[node.first];
+      u32 lane = NO_TRIANGLE;
+      best = Sono::IntersectRayTriangles(
+        ray.origin, ray.dir, {p.v0[0], p.v0[1], p.v0[2]},
+        {p.edge1[0], p.edge1[1], p.edge1[2]}, {p.edge2[0], p.edge2[1], p.edge2[2]}, LEAF_SIZE,
+        best, &lane
+      );
+      if (lane != NO_TRIANGLE) bestTriangle = p.triangles[lane];
+      continue;
+    }
+
+    const f32 tLeft = enter(m_Nodes[node.first].box);
+    const f32 tRight = enter(m_Nodes[node.first + 1].box);
+    // The nearer child is popped first
+    const b8 leftFirst = tLeft <= tRight;
+    const f32 tNear = leftFirst ? tLeft : tRight, tFar = leftFirst ? tRight : tLeft;
+    if (tFar != MISS) stack[size++] = {node.first + (leftFirst ? 1u : 0u), tFar};
+    if (tNear != MISS) stack[size++] = {node.first + (leftFirst ? 0u : 1u), tNear};
+  }
+
+  if (bestTriangle == NO_TRIANGLE) return false;
+  hit = {best, bestTriangle};
+  return true;
+}
@@ -0,0 +1,79 @@
+#ifndef SN_TRIANGLE_BVH_H
+#define SN_TRIANGLE_BVH_H
+
+#include "bounds.h"
+#include "core/common/types.h"
+#include "ray.h"
+#include "vec3.h"
+#include <vector>
+
+/// @brief Static bounding volume hierarchy over the triangles of one mesh, a CPU side copy of
+/// its geometry for ray picking. Built once from the positions and indices (binned SAH), then
+/// only queried; a mesh that changes shape builds again.
+///
+/// Each leaf holds up to LEAF_SIZE triangles as one Packet of corner and edge streams, which
+/// Sono::IntersectRayTriangles tests in whole SIMD steps at every level (16 is a multiple of
+/// every lane count). Unused lanes hold degenerate triangles that never hit.
+class TriangleBvh {
+public:
+  static constexpr u32 LEAF_SIZE = 16;
+  static constexpr u32 NO_TRIANGLE = ~0u;
+
+  /// Interior nodes have count 0 and their children at first and first + 1, leaves the packet
+  /// index in first and their triangle count
+  struct Node {
+    AABB box;
+    u32 first;
+    u32 count;
+
+    b8 IsLeaf() const { return count > 0; }
+  };
+
+  struct alignas(64) Packet {
+    f32 v0[3][LEAF_SIZE]; // Per axis
+    f32 edge1[3][LEAF_SIZE];
+    f32 edge2[3][LEAF_SIZE];
+    u32 triangles[LEAF_SIZE]; // NO_TRIANGLE in unused lanes
+  };
+
+  /// @brief Replace the tree with one over indexCount / 3 triangles, triangle i is corners
+  /// indices[3i], indices[3i + 1] and indices[3i + 2]. Triangles with an index past vertexCount
+  /// are skipped with an error logged.
+  void Build(const Vec3 *positions, usize vertexCount, const u32 *indices, usize indexCount);
+  void Build(const Vec3 *positions, usize vertexCount, const u16 *indices, usize indexCount);
+
+  void Clear();
+
+  /// @brief Closest triangle the ray hits for t in [0, maxT), either side
+  /// @return false, hit untouched, when there is none
+  b8 Raycast(const Ray &ray, f32 maxT, RayHit &hit) const;
+
+  /// @brief Box of every triangle, empty (inverted) with none
+  AABB GetBounds() const;
+
+  usize GetTriangleCount() const { return m_TriangleCount; }
+  usize GetNodeCount() const { return m_Nodes.size(); }
+  usize GetPacketCount() const { return m_Packets.size(); }
+  const Node &GetNode(u32 index) const { return m_Nodes[index]; }
+  const Packet &GetPacket(u32 index) const { return m_Packets[index]; }
+
+  /// @brief Longest root to leaf path, 1 for a single leaf
+  u32 GetHeight() const { return m_Height; }
+
+private:
+  /// Past this depth splits go to the median, so no path gets longer than MAX_HEIGHT and a
+  /// traversal fits a fixed stack
+  static constexpr u32 SAH_MAX_DEPTH = 48;
+  static constexpr u32 MAX_HEIGHT = SAH_MAX_DEPTH + 32;
+
+  template <typename Index>
+  void BuildFrom(const Vec3 *positions, usize vertexCount, const Index *indices, usize indexCount);
+
+private:
+  std::vector<Node> m_Nodes; // Root first
+  std::vector<Packet> m_Packets;
+  usize m_TriangleCount = 0;
+  u32 m_Height = 0;
+};
+
+#endif // !SN_TRIANGLE_BVH_H
@@ -3,6 +3,7 @@
 
 #include "vec_base.h"
 #include <ostream>
+#include <type_traits>
 
 template <int N, typename T>
 struct Vec : public VecBase<N, T> {
@@ -11,7 +12,7 @@ struct Vec : public VecBase<N, T> {
   // =========================================================================================
   // Ctors
   // =========================================================================================
-  Vec() {}
+  Vec() = default;
 
   constexpr Vec(T x, T y, T z, T w)
     : VecBase<N, T>(x, y, z, w) {}
@@ -22,62 +23,70 @@ struct Vec : public VecBase<N, T> {
   constexpr Vec(T x, T y)
     : VecBase<N, T>(x, y) {}
 
-  explicit Vec(T v) {
+  constexpr explicit Vec(T v)
+    : VecBase<N, T>() {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] = v;
+      (*this)[i] = v;
     }
   }
   // =========================================================================================
   // Array subscripts
   // =========================================================================================
 
-  T &operator[](i32 i) { return ValuePtr()[i]; }
+  // Constant evaluation cannot index past a named member, it goes through the named components
+  constexpr T &operator[](i32 i) {
+    if (std::is_constant_evaluated()) return this->Component(i);
+    return ValuePtr()[i];
+  }
   // -----------------------------------------------------------------------------------------
-  const T &operator[](i32 i) const { return ValuePtr()[i]; }
+  constexpr const T &operator[](i32 i) const {
+    if (std::is_constant_evaluated()) return this->Component(i);
+    return ValuePtr()[i];
+  }
 
   // =========================================================================================
   // Unary Exprs
   // =========================================================================================
 
-  Vec operator-() const { return (*this) * -1; }
+  constexpr Vec operator-() const { return (*this) * -1; }
   // -----------------------------------------------------------------------------------------
-  const Vec &operator+() const { return *this; }
+  constexpr const Vec &operator+() const { return *this; }
 
   // =========================================================================================
   // Vector arithmetics
   // =========================================================================================
 
-  Vec &operator+=(f32 rhs) {
+  constexpr Vec &operator+=(f32 rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] += rhs;
+      (*this)[i] += rhs;
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec &operator-=(f32 rhs) {
+  constexpr Vec &operator-=(f32 rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] -= rhs;
+      (*this)[i] -= rhs;
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec &operator*=(f32 rhs) {
+  constexpr Vec &operator*=(f32 rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] *= rhs;
+      (*this)[i] *= rhs;
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec &operator/=(f32 rhs) {
+  constexpr Vec &operator/=(f32 rhs) {
     rhs = 1.0f / rhs; // Inverse
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] *= rhs;
+      (*this)[i] *= rhs;
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
   friend constexpr Vec operator+(const Vec &lhs, f32 rhs) {
-    Vec result;
+    Vec result{};
     for (int i = 0; i < N; i++) {
       result[i] = lhs[i] + rhs;
     }
@@ -85,7 +94,7 @@ struct Vec : public VecBase<N, T> {
   }
   // -----------------------------------------------------------------------------------------
   friend constexpr Vec operator-(const Vec &lhs, f32 rhs) {
-    Vec result;
+    Vec result{};
     for (int i = 0; i < N; i++) {
       result[i] = lhs[i] - rhs;
     }
@@ -93,7 +102,7 @@ struct Vec : public VecBase<N, T> {
   }
   // -----------------------------------------------------------------------------------------
   friend constexpr Vec operator*(const Vec &lhs, f32 rhs) {
-    Vec result;
+    Vec result{};
     for (int i = 0; i < N; i++) {
       result[i] = lhs[i] * rhs;
     }
@@ -101,7 +110,7 @@ struct Vec : public VecBase<N, T> {
   }
   // -----------------------------------------------------------------------------------------
   friend constexpr Vec operator/(const Vec &lhs, f32 rhs) {
-    Vec result;
+    Vec result{};
     rhs = 1.0f / rhs;
     for (int i = 0; i < N; i++) {
       result[i] = lhs[i] * rhs;
@@ -113,62 +122,61 @@ struct Vec : public VecBase<N, T> {
   // Vector, vector operations
   // =========================================================================================
 
-  Vec &operator+=(const Vec<N, T> &rhs) {
+  constexpr Vec &operator+=(const Vec<N, T> &rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] += rhs[i];
+      (*this)[i] += rhs[i];
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec &operator-=(const Vec<N, T> &rhs) {
+  constexpr Vec &operator-=(const Vec<N, T> &rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] -= rhs[i];
+      (*this)[i] -= rhs[i];
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec &operator*=(const Vec<N, T> &rhs) {
+  constexpr Vec &operator*=(const Vec<N, T> &rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] *= rhs[i];
+      (*this)[i] *= rhs[i];
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec &operator/=(const Vec<N, T> &rhs) {
+  constexpr Vec &operator/=(const Vec<N, T> &rhs) {
     for (int i = 0; i < N; i++) {
-      ValuePtr()[i] /= rhs[i];
+      (*this)[i] /= rhs[i];
     }
     return *this;
   }
   // -----------------------------------------------------------------------------------------
-  Vec operator+(const Vec<N, T> &rhs) const {
+  constexpr Vec operator+(const Vec<N, T> &rhs) const {
     Vec result = *this;
     result += rhs;
     return result;
   }
   // -----------------------------------------------------------------------------------------
-  Vec operator-(const Vec<N, T> &rhs) const {
+  constexpr Vec operator-(const Vec<N, T> &rhs) const {
     Vec result = *this;
     result -= rhs;
     return result;
   }
   // -----------------------------------------------------------------------------------------
-  Vec operator*(const Vec<N, T> &rhs) const {
+  constexpr Vec operator*(const Vec<N, T> &rhs) const {
     Vec result = *this;
     result *= rhs;
     return result;
   }
   // -----------------------------------------------------------------------------------------
-  Vec operator/(const Vec<N, T> &rhs) const {
+  constexpr Vec operator/(const Vec<N, T> &rhs) const {
     Vec result = *this;
     result /= rhs;
     return result;
   }
   // -----------------------------------------------------------------------------------------
-  bool operator==(const Vec<N, T> &other) const {
-    T *data = ValuePtr();
+  constexpr bool operator==(const Vec<N, T> &other) const {
     for (int i = 0; i < N; i++) {
-      if (other[i] != data[i]) return false;
+      if (other[i] != (*this)[i]) return false;
     }
     return true;
   }
@@ -176,7 +184,7 @@ struct Vec : public VecBase<N, T> {
   constexpr T Dot(const Vec<N, T> &rhs) const {
     T result = T{};
     for (int i = 0; i < N; ++i) {
-      result += ValuePtr()[i] * rhs[i];
+      result += (*this)[i] * rhs[i];
     }
     return result;
   }
@@ -195,7 +203,7 @@ struct Vec : public VecBase<N, T> {
   // -----------------------------------------------------------------------------------------
   f32 Dist(const Vec &rhs) const { return (*this - rhs).Length(); }
   // -----------------------------------------------------------------------------------------
-  f32 DistSquared(const Vec &rhs) const { return (*this - rhs).LengthSquared(); }
+  constexpr f32 DistSquared(const Vec &rhs) const { return (*this - rhs).LengthSquared(); }
   // -----------------------------------------------------------------------------------------
   constexpr T LengthSquared() const { return Dot(*this); }
   // -----------------------------------------------------------------------------------------
@@ -10,7 +10,7 @@ template <>
 struct VecBase<2, f32> {
   f32 x, y;
 
-  VecBase() {}
+  VecBase() = default;
 
   constexpr VecBase(f32 x, f32 y)
     : x(x)
@@ -19,7 +19,24 @@ struct VecBase<2, f32> {
   f32 *ValuePtr() { return &x; }
   const f32 *ValuePtr() const { return &x; }
 
-  constexpr f32 Cross(const Vec<2, f32> &rhs) { return x * rhs.y - y * rhs.x; }
+  constexpr f32 &Component(int i) {
+    switch (i) {
+      case 0:
+        return x;
+      default:
+        return y;
+    }
+  }
+  constexpr const f32 &Component(int i) const {
+    switch (i) {
+      case 0:
+        return x;
+      default:
+        return y;
+    }
+  }
+
+  constexpr f32 Cross(const Vec<2, f32> &rhs) const { return x * rhs.y - y * rhs.x; }
 
   static const Vec2 &Up;
   static const Vec2 &Down;
@@ -28,4 +45,7 @@ struct VecBase<2, f32> {
   static const Vec2 &Zero;
 };
 
+static_assert(std::is_trivially_copyable_v<Vec2> && std::is_standard_layout_v<Vec2>);
+static_assert(sizeof(Vec2) == 2 * sizeof(f32));
+
 #endif // !SN_VEC2_H
@@ -19,7 +19,7 @@ struct VecBase<3, f32> {
     f32 z, b, p, roll;
   };
 
-  VecBase() {}
+  VecBase() = default;
 
   constexpr VecBase(f32 x, f32 y, f32 z)
     : x(x)
@@ -29,7 +29,28 @@ struct VecBase<3, f32> {
   f32 *ValuePtr() { return &x; }
   const f32 *ValuePtr() const { return &x; }
 
-  Vec3 Cross(const Vec3 &rhs) const {
+  constexpr f32 &Component(int i) {
+    switch (i) {
+      case 0:
+        return x;
+      case 1:
+        return y;
+      default:
+        return z;
+    }
+  }
+  constexpr const f32 &Component(int i) const {
+    switch (i) {
+      case 0:
+        return x;
+      case 1:
+        return y;
+      default:
+        return z;
+    }
+  }
+
+  constexpr Vec3 Cross(const Vec3 &rhs) const {
     // clang-format off
     return Vec3(
       y * rhs.z - z * rhs.y,
@@ -48,6 +69,9 @@ struct VecBase<3, f32> {
   static const Vec3 &Zero;
 };
 
+static_assert(std::is_trivially_copyable_v<Vec3> && std::is_standard_layout_v<Vec3>);
+static_assert(sizeof(Vec3) == 3 * sizeof(f32));
+
 namespace Sono {
 // --------------------------------------------------------------------------------
 constexpr inline Vec3 Radians(const Vec3 &euler) {
@@ -21,7 +21,7 @@ struct VecBase<4, f32> {
     f32 w, a, q;
   };
 
-  VecBase() {}
+  VecBase() = default;
 
   constexpr VecBase(f32 x, f32 y, f32 z, f32 w)
     : x(x)
@@ -32,7 +32,35 @@ struct VecBase<4, f32> {
   f32 *ValuePtr() { return &x; }
   const f32 *ValuePtr() const { return &x; }
 
+  constexpr f32 &Component(int i) {
+    switch (i) {
+      case 0:
+        return x;
+      case 1:
+        return y;
+      case 2:
+        return z;
+      default:
+        return w;
+    }
+  }
+  constexpr const f32 &Component(int i) const {
+    switch (i) {
+      case 0:
+        return x;
+      case 1:
+        return y;
+      case 2:
+        return z;
+      default:
+        return w;
+    }
+  }
+
   static const Vec4 &Zero;
 };
 
+static_assert(std::is_trivially_copyable_v<Vec4> && std::is_standard_layout_v<Vec4>);
+static_assert(sizeof(Vec4) == 4 * sizeof(f32));
+
 #endif // !SN_VEC4_H
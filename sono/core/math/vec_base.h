@@ -4,47 +4,34 @@
 #include <cmath>
 #include <core/common/snassert.h>
 
+// Vector storage. Every specialization must stay trivially copyable and standard layout so
+// vectors can be memcpy'd into GPU buffers, and must provide a constexpr Component(i) used by
+// Vec::operator[] during constant evaluation.
 template <int N, typename T>
 struct VecBase {
   T data[N];
   T *ValuePtr() { return &data[0]; }
   const T *ValuePtr() const { return &data[0]; }
 
-  // Default constructor for Vec struct
-  VecBase() {}
+  VecBase() = default;
 
-  VecBase(const VecBase<N, T> &other) {
-    for (int i = 0; i < N; i++) {
-      data[i] = other.data[i];
-    }
+  constexpr VecBase(T x, T y, T z, T w)
+    : data{x, y, z, w} {
+    static_assert(N >= 4, "expected at least 4 dimensions");
   }
 
-  VecBase &operator=(const VecBase<N, T> &other) {
-    for (int i = 0; i < N; i++) {
-      data[i] = other.data[i];
-    }
+  constexpr VecBase(T x, T y, T z)
+    : data{x, y, z} {
+    static_assert(N >= 3, "expected at least 3 dimensions");
   }
 
-  constexpr VecBase(T x, T y, T z, T w) {
-    SN_ASSERT_F(N > 2, "expected at least 4 dimensions (current: %d)", N);
-    data[0] = x;
-    data[1] = y;
-    data[2] = z;
-    data[3] = w;
+  constexpr VecBase(T x, T y)
+    : data{x, y} {
+    static_assert(N >= 2, "expected at least 2 dimensions");
   }
 
-  constexpr VecBase(T x, T y, T z) {
-    SN_ASSERT_F(N > 2, "expected at least 3 dimensions (current: %d)", N);
-    data[0] = x;
-    data[1] = y;
-    data[2] = z;
-  }
-
-  constexpr VecBase(T x, T y) {
-    SN_ASSERT_F(N > 2, "expected at least 2 dimensions (current: %d)", N);
-    data[0] = x;
-    data[1] = y;
-  }
+  constexpr T &Component(int i) { return data[i]; }
+  constexpr const T &Component(int i) const { return data[i]; }
 };
 
 #endif // !SN_VEC_BASE_H
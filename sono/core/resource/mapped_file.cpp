@@ -0,0 +1,98 @@
+#include "mapped_file.h"
+#include "core/common/logger.h"
+
+#ifdef SONO_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { Close(); }
+// --------------------------------------------------------------------------------
+#ifdef SONO_PLATFORM_WINDOWS
+
+b8 MappedFile::Open(const char *path) {
+  Close();
+  HANDLE file = CreateFileA(
+    path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+  );
+  if (file == INVALID_HANDLE_VALUE) {
+    LOG_ERROR_F("MappedFile: failed to open %s", path);
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    LOG_ERROR_F("MappedFile: %s is empty or its size can't be read", path);
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void *data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!data) {
+    LOG_ERROR_F("MappedFile: failed to map %s", path);
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  m_File = file;
+  m_Mapping = mapping;
+  m_Data = static_cast<const u8 *>(data);
+  m_Size = (usize)size.QuadPart;
+  return true;
+}
+// --------------------------------------------------------------------------------
+void MappedFile::Close() {
+  if (m_Data) UnmapViewOfFile(m_Data);
+  if (m_Mapping) CloseHandle(m_Mapping);
+  if (m_File) CloseHandle(m_File);
+  m_Data = nullptr;
+  m_Mapping = nullptr;
+  m_File = nullptr;
+  m_Size = 0;
+}
+
+#else
+
+b8 MappedFile::Open(const char *path) {
+  Close();
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    LOG_ERROR_F("MappedFile: failed to open %s", path);
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    LOG_ERROR_F("MappedFile: %s is empty or its size can't be read", path);
+    close(fd);
+    return false;
+  }
+
+  // The mapping keeps the file referenced, the descriptor is not needed past this
+  void *data = mmap(nullptr, (usize)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_ERROR_F("MappedFile: failed to map %s", path);
+    return false;
+  }
+
+  m_Data = static_cast<const u8 *>(data);
+  m_Size = (usize)info.st_size;
+  return true;
+}
+// --------------------------------------------------------------------------------
+void MappedFile::Close() {
+  if (m_Data) munmap(const_cast<u8 *>(m_Data), m_Size);
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SN_MAPPED_FILE_H
+#define SN_MAPPED_FILE_H
+
+#include "core/common/types.h"
+
+/// @brief A whole file mapped read only into memory. Pages are read in by the OS on first touch,
+/// so opening costs the same whatever the size and only the parts read are loaded.
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /// @return false, with an error logged, when the file can't be opened or is empty
+  b8 Open(const char *path);
+
+  void Close();
+
+  b8 IsOpen() const { return m_Data != nullptr; }
+
+  /// @brief Page aligned start of the file
+  const u8 *GetData() const { return m_Data; }
+
+  usize GetSize() const { return m_Size; }
+
+private:
+  const u8 *m_Data = nullptr;
+  usize m_Size = 0;
+#ifdef SONO_PLATFORM_WINDOWS
+  void *m_File = nullptr;
+  void *m_Mapping = nullptr;
+#endif
+};
+
+#endif // !SN_MAPPED_FILE_H
@@ -0,0 +1,96 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace {
+
+// Set on the pool threads while they run chunks, nested loops run serially
+thread_local b8 t_InsideLoop = false;
+
+} // namespace
+
+// --------------------------------------------------------------------------------
+u32 ThreadPool::GetDefaultWorkerCount() {
+  const u32 hardware = std::thread::hardware_concurrency();
+  return hardware > 1 ? hardware - 1 : 0;
+}
+// --------------------------------------------------------------------------------
+ThreadPool::ThreadPool(u32 workerCount) {
+  m_Workers.reserve(workerCount);
+  for (u32 i = 0; i < workerCount; i++) m_Workers.emplace_back([this] { WorkerLoop(); });
+}
+// --------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() { StopWorkers(); }
+// --------------------------------------------------------------------------------
+void ThreadPool::Shutdown() {
+  System::Shutdown();
+  StopWorkers();
+}
+// --------------------------------------------------------------------------------
+void ThreadPool::StopWorkers() {
+  if (m_Workers.empty()) return;
+  {
+    std::lock_guard lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_WakeCv.notify_all();
+  for (std::thread &worker : m_Workers) worker.join();
+  m_Workers.clear();
+}
+// --------------------------------------------------------------------------------
+void ThreadPool::Run(usize count, usize chunkSize, ChunkFn fn, void *ctx) {
+  if (count == 0) return;
+  chunkSize = std::max<usize>(chunkSize, 1);
+  if (m_Workers.empty() || count <= chunkSize || t_InsideLoop) {
+    fn(ctx, 0, count);
+    return;
+  }
+
+  std::lock_guard submit(m_SubmitMutex);
+  {
+    // Workers still leaving the previous loop read its fields, wait for them first
+    std::unique_lock lock(m_Mutex);
+    m_DoneCv.wait(lock, [&] { return m_Active == 0; });
+    m_Fn = fn;
+    m_Ctx = ctx;
+    m_Count = count;
+    m_ChunkSize = chunkSize;
+    m_Next.store(0, std::memory_order_relaxed);
+    m_Generation++;
+  }
+  m_WakeCv.notify_all();
+
+  t_InsideLoop = true;
+  RunChunks();
+  t_InsideLoop = false;
+
+  // Every chunk is taken, wait for the workers still running one
+  std::unique_lock lock(m_Mutex);
+  m_DoneCv.wait(lock, [&] { return m_Active == 0; });
+}
+// --------------------------------------------------------------------------------
+void ThreadPool::RunChunks() {
+  for (;;) {
+    const usize begin = m_Next.fetch_add(m_ChunkSize, std::memory_order_relaxed);
+    if (begin >= m_Count) return;
+    m_Fn(m_Ctx, begin, std::min(begin + m_ChunkSize, m_Count));
+  }
+}
+// --------------------------------------------------------------------------------
+void ThreadPool::WorkerLoop() {
+  t_InsideLoop = true;
+  u64 seen = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(m_Mutex);
+      m_WakeCv.wait(lock, [&] { return m_Stop || m_Generation != seen; });
+      if (m_Stop) return;
+      seen = m_Generation;
+      m_Active++;
+    }
+
+    RunChunks();
+
+    std::lock_guard lock(m_Mutex);
+    if (--m_Active == 0) m_DoneCv.notify_all();
+  }
+}
@@ -0,0 +1,79 @@
+#ifndef SN_THREAD_POOL_H
+#define SN_THREAD_POOL_H
+
+#include <core/common/singleton.h>
+#include <core/common/types.h>
+#include <core/system.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// @brief Fixed set of worker threads for data parallel loops. ParallelFor splits [0, count)
+/// into chunks that the workers and the calling thread take from a shared counter, and returns
+/// once every chunk ran. Workers sleep between loops.
+///
+/// One loop runs at a time, calls from several threads queue up. A ParallelFor issued from inside
+/// a chunk runs serially on that thread.
+class ThreadPool
+  : public Singleton<ThreadPool>
+  , public System {
+public:
+  /// @param workerCount threads besides the caller, by default one less than the hardware threads
+  explicit ThreadPool(u32 workerCount = GetDefaultWorkerCount());
+
+  ~ThreadPool();
+
+  const char *GetName() const override { return "ThreadPool"; }
+
+  /// @brief Join the workers, ParallelFor runs serially afterwards
+  void Shutdown() override;
+
+  /// @brief Threads that run chunks, the workers plus the caller
+  u32 GetThreadCount() const { return (u32)m_Workers.size() + 1; }
+
+  /// @brief fn(begin, end) over [0, count) in chunks of chunkSize elements (the last one may be
+  /// shorter), in no particular order and across threads. Blocks until all of them returned.
+  template <typename Fn>
+  void ParallelFor(usize count, usize chunkSize, Fn &&fn) {
+    using F = std::remove_reference_t<Fn>;
+    auto call = [](void *ctx, usize begin, usize end) { (*static_cast<F *>(ctx))(begin, end); };
+    Run(count, chunkSize, call, (void *)&fn);
+  }
+
+  static u32 GetDefaultWorkerCount();
+
+private:
+  using ChunkFn = void (*)(void *ctx, usize begin, usize end);
+
+  void Run(usize count, usize chunkSize, ChunkFn fn, void *ctx);
+
+  void StopWorkers();
+
+  /// Take chunks of the current loop until none is left
+  void RunChunks();
+
+  void WorkerLoop();
+
+private:
+  std::vector<std::thread> m_Workers;
+  std::mutex m_SubmitMutex; // Held by the caller for a whole loop
+
+  std::mutex m_Mutex; // Guards the loop fields below while workers may read them
+  std::condition_variable m_WakeCv;
+  std::condition_variable m_DoneCv;
+  u64 m_Generation = 0; // Bumped for every loop, workers wake when it moves
+  u32 m_Active = 0;     // Workers between picking up the loop and leaving it
+  b8 m_Stop = false;
+
+  ChunkFn m_Fn = nullptr;
+  void *m_Ctx = nullptr;
+  usize m_Count = 0;
+  usize m_ChunkSize = 1;
+  alignas(64) std::atomic<usize> m_Next{0}; // First element of the next free chunk
+};
+
+#endif // !SN_THREAD_POOL_H
@@ -0,0 +1,55 @@
+#ifndef SN_TRIPLE_BUFFER_H
+#define SN_TRIPLE_BUFFER_H
+
+#include <core/common/types.h>
+
+#include <atomic>
+
+/// @brief Hands values of T from one producer thread to one consumer thread without locks, and
+/// neither side ever waits for the other. Of the three Ts the producer owns one (the back), the
+/// consumer one (the front) and the third is the latest published. Publish swaps the back with
+/// the latest, Acquire swaps the front with the latest when something new was published.
+///
+/// Ownership: only the producer calls GetWriteBuffer and Publish, only the consumer calls
+/// Acquire and HasNew. A T is never touched by both threads at once, the swaps order its writes
+/// before the other side's reads. The consumer skips values published faster than it acquires.
+template <typename T>
+class TripleBuffer {
+public:
+  /// @brief Producer: the T to fill for the next Publish. It holds an older published value, not
+  /// necessarily the last one, so writing only changes needs to know which value that was.
+  T &GetWriteBuffer() { return m_Buffers[m_Back]; }
+
+  /// @brief Producer: make the write buffer the latest value, the previous latest (or the front
+  /// the consumer gave back) becomes the write buffer
+  void Publish() {
+    const u8 previous = m_Latest.exchange(m_Back | FRESH, std::memory_order_acq_rel);
+    m_Back = previous & INDEX_MASK;
+  }
+
+  /// @brief Consumer: the latest published value, or the one acquired before when nothing was
+  /// published since. Read only, stays unchanged until the next Acquire. A default constructed
+  /// T before the first Publish.
+  const T &Acquire() {
+    if (m_Latest.load(std::memory_order_relaxed) & FRESH) {
+      const u8 previous = m_Latest.exchange(m_Front, std::memory_order_acq_rel);
+      m_Front = previous & INDEX_MASK;
+    }
+    return m_Buffers[m_Front];
+  }
+
+  /// @brief Consumer: whether Acquire would return a newer value
+  b8 HasNew() const { return (m_Latest.load(std::memory_order_relaxed) & FRESH) != 0; }
+
+private:
+  static constexpr u8 INDEX_MASK = 3;
+  static constexpr u8 FRESH = 4; // Set on the latest index by Publish, cleared by Acquire
+
+  T m_Buffers[3] = {};
+  // Each side's index on its own cache line, next to nothing the other side writes
+  alignas(64) u8 m_Back = 0;
+  alignas(64) u8 m_Front = 1;
+  alignas(64) std::atomic<u8> m_Latest{2};
+};
+
+#endif // !SN_TRIPLE_BUFFER_H
@@ -17,11 +17,21 @@ GLBuffer::GLBuffer(const BufferDesc &desc)
   // if (desc.usage & BufferUsage::Storage) m_Target = GL_SHADER_STORAGE_BUFFER;
   // if (desc.usage & BufferUsage::Indirect) m_Target = GL_SHADER_STORAGE_BUFFER;
 
-  m_GlUsage = (desc.usage & BufferUsage::MapWrite) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+  if (desc.usage & BufferUsage::Storage) m_Target = GL_TEXTURE_BUFFER;
+
+  const b8 dynamic = (desc.usage & BufferUsage::MapWrite) || (desc.usage & BufferUsage::CopyDest);
+  m_GlUsage = dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
 
   GL_CALL(glGenBuffers, 1, &m_BufferID);
   GL_CALL(glBindBuffer, m_Target, m_BufferID);
   GL_CALL(glBufferData, m_Target, GetSize(), desc.data, m_GlUsage);
+
+  if (m_Target == GL_TEXTURE_BUFFER) {
+    SN_ASSERT(desc.stride % 16 == 0, "Storage buffer stride must be whole RGBA32F texels");
+    GL_CALL(glGenTextures, 1, &m_StorageTexID);
+    GL_CALL(glBindTexture, GL_TEXTURE_BUFFER, m_StorageTexID);
+    GL_CALL(glTexBuffer, GL_TEXTURE_BUFFER, GL_RGBA32F, m_BufferID);
+  }
 }
 // ------------------------------------------------------------------------------------------
 void *GLBuffer::Map() {
@@ -58,12 +68,22 @@ void GLBuffer::Update(const void *data, usize size, usize offset) {
   }
 }
 // ------------------------------------------------------------------------------------------
-void GLBuffer::Release() { GL_CALL(glDeleteBuffers, 1, &m_BufferID); }
+void GLBuffer::Release() {
+  if (m_StorageTexID) GL_CALL(glDeleteTextures, 1, &m_StorageTexID);
+  m_StorageTexID = 0;
+  GL_CALL(glDeleteBuffers, 1, &m_BufferID);
+}
 // ------------------------------------------------------------------------------------------
 void GLBuffer::Bind() const { GL_CALL(glBindBuffer, m_Target, m_BufferID); }
 // ------------------------------------------------------------------------------------------
 void GLBuffer::Unbind() const { GL_CALL(glBindBuffer, m_Target, 0); }
 // ------------------------------------------------------------------------------------------
+void GLBuffer::BindStorage(u32 slot) const {
+  SN_ASSERT(m_StorageTexID, "Binding a buffer without BufferUsage::Storage as storage");
+  GL_CALL(glActiveTexture, GL_TEXTURE0 + STORAGE_UNIT_BASE + slot);
+  GL_CALL(glBindTexture, GL_TEXTURE_BUFFER, m_StorageTexID);
+}
+// ------------------------------------------------------------------------------------------
 GLuint GLBuffer::GetID() const { return m_BufferID; }
 // ------------------------------------------------------------------------------------------
 GLBuffer::operator u32() const { return m_BufferID; }
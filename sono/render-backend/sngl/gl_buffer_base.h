@@ -6,6 +6,10 @@
 
 class GLBuffer : public Buffer {
 public:
+  /// Storage slots bind past the units a Material's textures use
+  static constexpr u32 STORAGE_UNIT_BASE = 8;
+  static constexpr u32 MAX_STORAGE_SLOTS = 4;
+
   GLBuffer(const BufferDesc &desc);
 
   virtual ~GLBuffer();
@@ -22,6 +26,9 @@ public:
 
   virtual void Unbind() const override;
 
+  /// Bind the buffer texture of a Storage buffer at the texture unit of slot
+  void BindStorage(u32 slot) const;
+
   GLuint GetID() const;
 
   operator u32() const;
@@ -30,6 +37,8 @@ private:
   GLuint m_BufferID;
   GLenum m_Target;
   GLenum m_GlUsage;
+  // Storage buffers are read through a buffer texture, GL 3.3 has no shader storage
+  GLuint m_StorageTexID = 0;
 };
 
 #endif // !SN_GL_BUFFER_BASE_H
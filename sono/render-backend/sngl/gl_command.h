@@ -3,11 +3,16 @@
 
 #include <render-backend/sngl/gl_buffer_base.h>
 #include <render-backend/sngl/gl_render_pipeline.h>
+#include <render-backend/sngl/gl_texture.h>
+#include <render-backend/sngl/gl_vertex_array.h>
 
 enum class CmdType {
   BindPipeline,
+  BindVertexArray,
   BindVertexBuffer,
   BindIndexBuffer,
+  BindTexture,
+  BindStorageBuffer,
   Draw,
   DrawIndexed,
 };
@@ -16,10 +21,24 @@ struct CmdBindPipeline {
   GLRenderPipeline *pipeline;
 };
 
+struct CmdBindVertexArray {
+  GLVertexArray *vertexArray;
+};
+
 struct CmdBindBuffer {
   GLBuffer *buffer;
 };
 
+struct CmdBindTexture {
+  GLTexture *texture;
+  u32 unit;
+};
+
+struct CmdBindStorageBuffer {
+  GLBuffer *buffer;
+  u32 slot;
+};
+
 struct CmdDraw {
   u32 vertexCount, instanceCount, firstVertex, firstInstance;
 };
@@ -32,7 +51,10 @@ struct GLCommand {
   CmdType type;
   union {
     CmdBindPipeline cmdBindPipeline;
+    CmdBindVertexArray cmdBindVertexArray;
     CmdBindBuffer cmdBindBuffer;
+    CmdBindTexture cmdBindTexture;
+    CmdBindStorageBuffer cmdBindStorageBuffer;
     CmdDraw cmdDraw;
     CmdDrawIndexed cmdDrawIndexed;
   };
@@ -1,16 +1,22 @@
 #include <render-backend/sngl/gl_command_list.h>
 #include <render-backend/sngl/gl_render_pass.h>
 
+GLCommandList::~GLCommandList() {
+  // The passes live in the list's allocator, which only reclaims the memory
+  EndRenderPass();
+  for (GLRenderPass *pass : passes) pass->~GLRenderPass();
+}
+
 RenderPass *GLCommandList::BeginRenderPass(const RenderPassDesc &desc) {
   if (!renderPass) {
-    renderPass = m_Allocator->New<GLRenderPass>(desc);
+    renderPass = m_Allocator->New<GLRenderPass>(desc, m_Allocator);
   }
   return renderPass;
 }
 
 void GLCommandList::EndRenderPass() {
   if (renderPass) {
-    m_Allocator->Free(renderPass);
+    passes.push_back(static_cast<GLRenderPass *>(renderPass));
     renderPass = nullptr;
   }
 }
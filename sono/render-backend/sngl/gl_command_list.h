@@ -3,14 +3,23 @@
 
 #include <core/memory/allocators/arena.h>
 #include <render/command_list.h>
+#include <render-backend/sngl/gl_render_pass.h>
+#include <vector>
 
 class GLCommandList : public CommandList {
 public:
   explicit GLCommandList(Allocator *allocator)
     : CommandList(allocator) {}
 
+  ~GLCommandList() override;
+
   RenderPass *BeginRenderPass(const RenderPassDesc &) override;
+
+  /// Close the current pass, it stays recorded for the queue to execute
   void EndRenderPass() override;
+
+public:
+  std::vector<GLRenderPass *> passes; // Ended passes in recording order
 };
 
 #endif // !SN_GL_COMMAND_LIST_H
@@ -5,21 +5,35 @@
 void GLCommandQueue::ExecuteGLCommand(GLCommand *cmd) {
   switch (cmd->type) {
     case CmdType::BindPipeline:
-      cmd->cmdBindPipeline.pipeline->Bind();
+      m_PSO = cmd->cmdBindPipeline.pipeline;
+      m_PSO->Bind();
+      break;
+    case CmdType::BindVertexArray:
+      cmd->cmdBindVertexArray.vertexArray->Bind();
       break;
     case CmdType::BindIndexBuffer: {
-      m_VertexBuffer = cmd->cmdBindBuffer.buffer;
+      m_IndexBuffer = cmd->cmdBindBuffer.buffer;
       cmd->cmdBindBuffer.buffer->Bind();
       break;
     }
     case CmdType::BindVertexBuffer: {
-      m_IndexBuffer = cmd->cmdBindBuffer.buffer;
+      m_VertexBuffer = cmd->cmdBindBuffer.buffer;
       cmd->cmdBindBuffer.buffer->Bind();
       break;
     }
+    case CmdType::BindTexture:
+      cmd->cmdBindTexture.texture->Bind(cmd->cmdBindTexture.unit);
+      break;
+    case CmdType::BindStorageBuffer:
+      cmd->cmdBindStorageBuffer.buffer->BindStorage(cmd->cmdBindStorageBuffer.slot);
+      break;
     case CmdType::Draw: {
       const CmdDraw &draw = cmd->cmdDraw;
-      GL_CALL(glDrawArrays, GL_TRIANGLES, draw.firstVertex, draw.vertexCount);
+      m_PSO->SetBaseInstance(draw.firstInstance);
+      GL_CALL(
+        glDrawArraysInstanced, GL_TRIANGLES, draw.firstVertex, draw.vertexCount,
+        draw.instanceCount
+      );
       break;
     }
     case CmdType::DrawIndexed: {
@@ -29,8 +43,12 @@ void GLCommandQueue::ExecuteGLCommand(GLCommand *cmd) {
         type = GL_UNSIGNED_SHORT;
       else if (m_IndexBuffer->GetStride() == sizeof(u8))
         type = GL_UNSIGNED_BYTE;
+      // firstIdx counts indices, GL takes a byte offset into the index buffer
+      const usize offset = (usize)draw.firstIdx * m_IndexBuffer->GetStride();
+      m_PSO->SetBaseInstance(draw.firstInstance);
       GL_CALL(
-        glDrawElements, GL_TRIANGLES, draw.idxCount, type, reinterpret_cast<void *>(draw.firstIdx)
+        glDrawElementsInstanced, GL_TRIANGLES, draw.idxCount, type,
+        reinterpret_cast<void *>(offset), draw.instanceCount
       );
       break;
     }
@@ -39,10 +57,12 @@ void GLCommandQueue::ExecuteGLCommand(GLCommand *cmd) {
 // --------------------------------------------------------------------------------
 void GLCommandQueue::Submit(const SubmitInfo &info) {
   for (CommandList *cmdList : info.cmdLists) {
-    GLRenderPass *pass =
-      reinterpret_cast<GLRenderPass *>(reinterpret_cast<GLCommandList *>(cmdList)->renderPass);
-    for (GLCommand *cmd : pass->cmds) {
-      this->ExecuteGLCommand(cmd);
+    GLCommandList *glCmdList = static_cast<GLCommandList *>(cmdList);
+    SN_ASSERT(!glCmdList->renderPass, "Submitting a command list with an open render pass");
+    for (GLRenderPass *pass : glCmdList->passes) {
+      for (GLCommand *cmd : pass->cmds) {
+        this->ExecuteGLCommand(cmd);
+      }
       m_ActivePass.push_back(pass);
     }
   }
@@ -11,17 +11,18 @@ public:
   GLCommandQueue() = default;
   ~GLCommandQueue() = default;
 
-  void Submit(const SubmitInfo &info) = 0;
-  void WaitIdle() = 0;
-  void Reset() = 0;
+  /// Execute the ended passes of every list, in order
+  void Submit(const SubmitInfo &info) override;
+  void WaitIdle() override;
+  void Reset() override;
 
 private:
   void ExecuteGLCommand(GLCommand *cmd);
 
 private:
-  GLBuffer *m_VertexBuffer;
-  GLBuffer *m_IndexBuffer;
-  GLRenderPipeline *m_PSO;
+  GLBuffer *m_VertexBuffer = nullptr;
+  GLBuffer *m_IndexBuffer = nullptr;
+  GLRenderPipeline *m_PSO = nullptr;
 };
 
 #endif // !SN_GL_COMMAND_QUEUE_H
@@ -4,6 +4,7 @@
 #include <render-backend/sngl/gl_render_pipeline.h>
 #include <render-backend/sngl/gl_render_device.h>
 #include <render-backend/sngl/gl_buffer_base.h>
+#include <render-backend/sngl/gl_command_queue.h>
 #include <render-backend/sngl/gl_texture.h>
 #include <render-backend/sngl/gl_shader.h>
 
@@ -25,7 +26,7 @@ const std::string kDefaultFragmentShader = // force clang-format
   "}";
 
 // --------------------------------------------------------------------------------
-void GLRenderDevice::Init() {}
+void GLRenderDevice::Init() { queue = m_pResourceAllocator->New<GLCommandQueue>(); }
 // --------------------------------------------------------------------------------
 void GLRenderDevice::Shutdown() {
   m_FrameAllocator.FreeInternalBuffer();
@@ -69,7 +70,11 @@ VertexArray *GLRenderDevice::CreateVertexArray() {
   return m_pResourceAllocator->New<GLVertexArray>();
 }
 // --------------------------------------------------------------------------------
-CommandList *GLRenderDevice::CreateCommandList() { return nullptr; }
+CommandList *GLRenderDevice::CreateCommandList() {
+  CommandList *cmdList = m_FrameAllocator.New<GLCommandList>(&m_FrameAllocator);
+  m_FrameCommandLists.push_back(cmdList);
+  return cmdList;
+}
 // --------------------------------------------------------------------------------
 Buffer *GLRenderDevice::CreateBuffer(const BufferDesc &desc) {
   Buffer *buffer = SN_NEW(ALLOC_TYPE_RENDER_SYSTEM) GLBuffer(desc);
@@ -1,6 +1,7 @@
 #include "core/common/logger.h"
 #include "render-backend/sngl/gl_buffer_base.h"
 #include "render-backend/sngl/gl_render_pipeline.h"
+#include "render-backend/sngl/gl_texture.h"
 #include <render-backend/sngl/gl_render_pass.h>
 
 void GLRenderPass::BindPipeline(RenderPipeline *pso) {
@@ -10,6 +11,13 @@ void GLRenderPass::BindPipeline(RenderPipeline *pso) {
   this->cmds.push_back(cmd);
 }
 
+void GLRenderPass::BindVertexArray(VertexArray *va) {
+  GLCommand *cmd = m_Allocator->New<GLCommand>();
+  cmd->type = CmdType::BindVertexArray;
+  cmd->cmdBindVertexArray.vertexArray = reinterpret_cast<GLVertexArray *>(va);
+  this->cmds.push_back(cmd);
+}
+
 void GLRenderPass::BindVertexBuffer(Buffer *vb) {
   GLCommand *cmd = m_Allocator->New<GLCommand>();
   GLBuffer *buffer = reinterpret_cast<GLBuffer *>(vb);
@@ -28,6 +36,25 @@ void GLRenderPass::BindIndexBuffer(Buffer *vb) {
   this->cmds.push_back(cmd);
 }
 
+void GLRenderPass::BindTexture(Texture *texture, u32 unit) {
+  GLCommand *cmd = m_Allocator->New<GLCommand>();
+  cmd->type = CmdType::BindTexture;
+  cmd->cmdBindTexture.texture = reinterpret_cast<GLTexture *>(texture);
+  cmd->cmdBindTexture.unit = unit;
+  this->cmds.push_back(cmd);
+}
+
+void GLRenderPass::BindStorageBuffer(Buffer *buffer, u32 slot) {
+  GLCommand *cmd = m_Allocator->New<GLCommand>();
+  GLBuffer *glBuffer = reinterpret_cast<GLBuffer *>(buffer);
+  ASSERT(glBuffer->GetUsage() & BufferUsage::Storage);
+  ASSERT(slot < GLBuffer::MAX_STORAGE_SLOTS);
+  cmd->type = CmdType::BindStorageBuffer;
+  cmd->cmdBindStorageBuffer.buffer = glBuffer;
+  cmd->cmdBindStorageBuffer.slot = slot;
+  this->cmds.push_back(cmd);
+}
+
 void GLRenderPass::Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) {
   GLCommand *cmd = m_Allocator->New<GLCommand>();
   cmd->type = CmdType::Draw;
@@ -5,6 +5,9 @@
 #include <render/render_pass.h>
 #include <vector>
 
+/// A Storage buffer bound at slot reads in the shaders as samplerBuffer uStorage<slot>, one
+/// RGBA32F texel per 16 bytes. GL 3.3 has no base instance, a draw sets its firstInstance to
+/// the int uniform uBaseInstance for the shaders to add to gl_InstanceID.
 class GLRenderPass : public RenderPass {
 public:
   explicit GLRenderPass(const RenderPassDesc &desc, Allocator *allocator = nullptr)
@@ -12,8 +15,11 @@ public:
 
   // clang-format off
   void BindPipeline(RenderPipeline *pso) override;
+  void BindVertexArray(VertexArray *va) override;
   void BindVertexBuffer(Buffer *vb) override;
   void BindIndexBuffer(Buffer *vb) override;
+  void BindTexture(Texture *texture, u32 unit) override;
+  void BindStorageBuffer(Buffer *buffer, u32 slot) override;
   void Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) override;
   void DrawIndexed(u32 idxCount, u32 instanceCount, u32 firstIdx, u32 firstInstance) override;
   // clang-format on
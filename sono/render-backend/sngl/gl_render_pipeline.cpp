@@ -39,6 +39,18 @@ GLRenderPipeline::GLRenderPipeline(const PipelineDesc &desc)
     ASSERT(false);
   }
 
+  // Storage slots never move, their samplers are set once for the program
+  GLint previous = 0;
+  glGetIntegerv(GL_CURRENT_PROGRAM, &previous);
+  GL_CALL(glUseProgram, m_ID);
+  for (u32 slot = 0; slot < GLBuffer::MAX_STORAGE_SLOTS; slot++) {
+    const std::string name = std::format("uStorage{}", slot);
+    const GLint loc = glGetUniformLocation(m_ID, name.c_str());
+    if (loc != -1) GL_CALL(glUniform1i, loc, GLBuffer::STORAGE_UNIT_BASE + slot);
+  }
+  GL_CALL(glUseProgram, previous);
+  m_BaseInstanceLoc = glGetUniformLocation(m_ID, "uBaseInstance");
+
   if (m_Desc.label.empty()) {
     m_Desc.label = std::format("OpenGL_Pipeline_{}", m_ID);
   }
@@ -215,6 +227,11 @@ void GLRenderPipeline::SetMat2x3(const char *uniform, const MatBase<2, 3, f32> &
   );
 }
 // --------------------------------------------------------------------------------
+void GLRenderPipeline::SetBaseInstance(i32 base) const {
+  ASSERT_CURRENT_PROGRAM(this);
+  if (m_BaseInstanceLoc != -1) GL_CALL(glUniform1i, m_BaseInstanceLoc, base);
+}
+// --------------------------------------------------------------------------------
 void GLRenderPipeline::Bind() const { GL_CALL(glUseProgram, m_ID); }
 // --------------------------------------------------------------------------------
 void GLRenderPipeline::Unbind() const { GL_CALL(glUseProgram, 0); }
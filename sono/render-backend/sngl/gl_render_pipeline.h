@@ -2,6 +2,7 @@
 #define SN_GL_RENDER_PIPELINE_H
 
 #include <render/render_pipeline.h>
+#include <render-backend/sngl/gl_buffer_base.h>
 #include <core/common/types.h>
 #include <glad/glad.h>
 
@@ -58,6 +59,9 @@ public:
 
   // void SetUniform(UniformType type, const char *uniform, const void *data) const override;
 
+  /// Set uBaseInstance, the firstInstance of the next draw, when the shaders declare it
+  void SetBaseInstance(i32 base) const;
+
   void Bind() const override;
   void Unbind() const override;
   GLuint GetID() const;
@@ -65,6 +69,7 @@ public:
 
 private:
   GLuint m_ID;
+  GLint m_BaseInstanceLoc = -1;
   u8 m_AttachedShaders;
 };
 
@@ -1,5 +1,6 @@
 #include "core/common/logger.h"
 #include "core/common/snassert.h"
+#include "core/common/time.h"
 #include <render-backend/sngl/gl_buffer_base.h>
 #include <render-backend/sngl/gl_render_system.h>
 #include <render-backend/sngl/gl_render_device.h>
@@ -62,9 +63,14 @@ void GLRenderSystem::EndFrame() {
   /* Swap front and back buffers */
   Flush();
   Present();
+  // GL executes command lists on Submit, nothing of this frame's lists is still needed
+  m_pDevice->ResetFrame();
 }
 // --------------------------------------------------------------------------------
-void GLRenderSystem::Present() { m_pActiveCtx->SwapBuffers(); }
+void GLRenderSystem::Present() {
+  m_pActiveCtx->SwapBuffers();
+  m_LastPresentTicks = Time::Ticks();
+}
 // --------------------------------------------------------------------------------
 void GLRenderSystem::SetViewport(i32 posX, i32 posY, i32 width, i32 height) {
   glViewport(posX, posY, width, height);
@@ -23,14 +23,18 @@ static GLenum ConvertToGLType(VertexAttribType type) {
     case VAT_UINT4:
       return GL_UNSIGNED_INT;
     case VAT_BYTE4_NORM:
+      return GL_UNSIGNED_BYTE;
     case VAT_BYTE4_SNORM:
       return GL_BYTE;
     case VAT_USHORT2_NORM:
     case VAT_USHORT4_NORM:
       return GL_UNSIGNED_SHORT;
+    case VAT_SHORT2_SNORM:
+    case VAT_SHORT4_SNORM:
+      return GL_SHORT;
     case VAT_HALF2:
     case VAT_HALF4:
-      return GL_UNSIGNED_SHORT;
+      return GL_HALF_FLOAT;
   }
 
   SN_ASSERT(false, "Unsupported VertexAttribType");
@@ -45,7 +45,7 @@ void GLWindow::Create(i32 width, i32 height, const char *title, WindowMode mode)
   glfwSetFramebufferSizeCallback(m_Context, [](GLFWwindow *window, int width, int height) {
     (void)window;
     Event e;
-    e.time = Time::Now() * 1000;
+    e.time = (i64)Time::Ticks();
     e.type = EventType::WINDOW_RESIZE;
     e.payload = WindowResizeEvent{width, height};
     SN_QUEUE_EVENT(e)
@@ -53,7 +53,7 @@ void GLWindow::Create(i32 width, i32 height, const char *title, WindowMode mode)
 
   glfwSetCursorPosCallback(m_Context, [](GLFWwindow *window, double xpos, double ypos) {
     Event e;
-    e.time = Time::Now() * 1000;
+    e.time = (i64)Time::Ticks();
     e.type = EventType::MOUSE_MOVE;
     e.payload = MouseMoveEvent{xpos, ypos};
     SN_QUEUE_EVENT(e)
@@ -62,7 +62,7 @@ void GLWindow::Create(i32 width, i32 height, const char *title, WindowMode mode)
   glfwSetMouseButtonCallback(m_Context, [](GLFWwindow *window, int button, int action, int mods) {
     (void)window;
     Event e;
-    e.time = Time::Now() * 1000;
+    e.time = (i64)Time::Ticks();
     e.type = EventType::MOUSE_BUTTON;
     e.payload = MouseButtonEvent{button, (b8)action};
     SN_QUEUE_EVENT(e)
@@ -71,6 +71,7 @@ void Camera::SetPerspective(Radian fov, f32 aspect, f32 zNear, f32 zFar) {
   m_zNear = zNear;
   m_zFar = zFar;
   m_ProjectionMatrix = Mat4::Perspective(fov, aspect, zNear, zFar);
+  UpdateFrustum();
 }
 // --------------------------------------------------------------------------------
 void Camera::SetOrthogonal() {
@@ -78,6 +79,18 @@ void Camera::SetOrthogonal() {
   // m_ProjectionMatrix = Mat4::Ortho();
 }
 // --------------------------------------------------------------------------------
+Ray Camera::ScreenPointToRay(const Vec2 &point, const Vec2 &viewportSize) const {
+  // Pixels to NDC, y grows up in NDC and down on screen
+  const f32 x = 2.0f * point.x / viewportSize.x - 1.0f;
+  const f32 y = 1.0f - 2.0f * point.y / viewportSize.y;
+  const Mat4 inverse = GetViewProjectionMatrix().Inversed();
+  const Vec4 nearPoint = Vec4(x, y, -1.0f, 1.0f) * inverse;
+  const Vec4 farPoint = Vec4(x, y, 1.0f, 1.0f) * inverse;
+  const Vec3 from = Vec3(nearPoint.x, nearPoint.y, nearPoint.z) / nearPoint.w;
+  const Vec3 to = Vec3(farPoint.x, farPoint.y, farPoint.z) / farPoint.w;
+  return Ray(from, (to - from).Normalized());
+}
+// --------------------------------------------------------------------------------
 void Camera::UpdateView() {
   Vec3 forward(
     cos(Sono::Radians(m_Rotations.yaw)) * cos(Sono::Radians(m_Rotations.pitch)),
@@ -89,4 +102,9 @@ void Camera::UpdateView() {
   m_Up = m_Right.Cross(m_Forward);
 
   m_ViewMatrix = Mat4::LookAt(m_Position, m_Position + m_Forward, m_Up);
+  UpdateFrustum();
+}
+// --------------------------------------------------------------------------------
+void Camera::UpdateFrustum() {
+  m_Frustum = Frustum::FromViewProjection(GetViewProjectionMatrix());
 }
@@ -1,7 +1,10 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+#include "core/math/frustum.h"
 #include "core/math/mat4.h"
+#include "core/math/ray.h"
+#include "core/math/vec2.h"
 #include "core/math/vec3.h"
 #include "render/render_context.h"
 
@@ -37,14 +40,25 @@ public:
   inline Vec3 &GetPosition() { return m_Position; }
   inline const Mat4 &GetViewMatrix() const { return m_ViewMatrix; }
   inline const Mat4 &GetProjectionMatrix() const { return m_ProjectionMatrix; }
+  inline f32 GetNear() const { return m_zNear; }
+  inline f32 GetFar() const { return m_zFar; }
+  inline Mat4 GetViewProjectionMatrix() const { return m_ViewMatrix * m_ProjectionMatrix; }
+
+  /// @brief World ray through a point of the viewport, in pixels from its top left corner
+  /// (e.g. Mouse::GetPosition() for a full window viewport). Starts on the near plane, dir is
+  /// unit length so t is the distance from there.
+  Ray ScreenPointToRay(const Vec2 &point, const Vec2 &viewportSize) const;
+  /// World space view volume, kept in sync with the view and projection matrices
+  inline const Frustum &GetFrustum() const { return m_Frustum; }
 
 private:
   void UpdateView();
+  void UpdateFrustum();
 
 private:
   Mat4 m_ViewMatrix;
-  Mat4 m_Frustum;
   Mat4 m_ProjectionMatrix;
+  Frustum m_Frustum;
 
   Vec3 m_Position;
   Vec3 m_Forward;
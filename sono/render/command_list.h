@@ -7,7 +7,9 @@
 
 class CommandList {
 public:
-  explicit CommandList(Allocator *allocator);
+  explicit CommandList(Allocator *allocator)
+    : renderPass(nullptr)
+    , m_Allocator(allocator) {}
   virtual ~CommandList() = default;
 
   virtual RenderPass *BeginRenderPass(const RenderPassDesc &) = 0;
@@ -0,0 +1,78 @@
+#include <render/draw_list.h>
+#include <algorithm>
+#include <cstdint>
+
+u64 DrawKey::Make(RenderLayer layer, u32 pipeline, u32 material, u32 depth, u32 mesh) {
+  auto field = [](u32 value, u32 bits) { return (u64)value & ((1ull << bits) - 1); };
+  const u64 l = field((u32)layer, LAYER_BITS), p = field(pipeline, PIPELINE_BITS);
+  const u64 m = field(material, MATERIAL_BITS);
+  u64 d = field(depth, DEPTH_BITS);
+  const u64 mesh64 = field(mesh, MESH_BITS);
+
+  u64 key = l << (64 - LAYER_BITS);
+  if (layer == RenderLayer::Transparent) {
+    const u64 farToNear = field(~depth, DEPTH_BITS);
+    key |= farToNear << (PIPELINE_BITS + MATERIAL_BITS + MESH_BITS);
+    key |= p << (MATERIAL_BITS + MESH_BITS);
+    key |= m << MESH_BITS;
+  } else {
+    // Coarse slabs are enough for early depth rejection, and keep a mesh's draws together
+    d &= ~((1ull << (DEPTH_BITS - OPAQUE_DEPTH_BITS)) - 1);
+    key |= p << (MATERIAL_BITS + DEPTH_BITS + MESH_BITS);
+    key |= m << (DEPTH_BITS + MESH_BITS);
+    key |= d << MESH_BITS;
+  }
+  return key | mesh64;
+}
+// --------------------------------------------------------------------------------
+u32 DrawKey::DepthBucket(f32 distance, f32 far) {
+  constexpr u32 maxBucket = (1u << DEPTH_BITS) - 1;
+  const f32 t = distance / far;
+  // Written so NaN lands in bucket 0
+  if (!(t > 0.0f)) return 0;
+  return t >= 1.0f ? maxBucket : (u32)(t * (f32)maxBucket);
+}
+// --------------------------------------------------------------------------------
+u32 DrawKey::ResourceBits(const void *resource, u32 bits) {
+  if (!resource) return 0;
+  // Fibonacci hashing, the top bits of the product mix every address bit
+  const u64 address = (u64)reinterpret_cast<uintptr_t>(resource);
+  return (u32)((address * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+// --------------------------------------------------------------------------------
+void DrawList::Sort() {
+  const usize count = m_Packets.size();
+  if (count < RADIX_MIN_COUNT) {
+    std::stable_sort(m_Packets.begin(), m_Packets.end(), [](const auto &a, const auto &b) {
+      return a.key < b.key;
+    });
+    return;
+  }
+
+  u32 histograms[8][256] = {};
+  for (const DrawPacket &packet : m_Packets) {
+    const u64 key = packet.key;
+    for (u32 b = 0; b < 8; b++) histograms[b][(key >> (b * 8)) & 0xFF]++;
+  }
+
+  m_Scratch.resize(count);
+  DrawPacket *src = m_Packets.data(), *dst = m_Scratch.data();
+  for (u32 b = 0; b < 8; b++) {
+    u32 *histogram = histograms[b];
+    // Every key has the same byte here, the pass would copy the order unchanged
+    if (histogram[(src[0].key >> (b * 8)) & 0xFF] == count) continue;
+
+    u32 offset = 0;
+    for (u32 i = 0; i < 256; i++) {
+      const u32 size = histogram[i];
+      histogram[i] = offset;
+      offset += size;
+    }
+    for (usize i = 0; i < count; i++) {
+      dst[histogram[(src[i].key >> (b * 8)) & 0xFF]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != m_Packets.data()) m_Packets.swap(m_Scratch);
+}
@@ -0,0 +1,79 @@
+#ifndef SN_DRAW_LIST_H
+#define SN_DRAW_LIST_H
+
+#include <core/common/types.h>
+#include <render/resource/material.h>
+#include <vector>
+
+/// @brief 64 bit sort key of a draw, high fields first:
+///   opaque      : layer 4 | pipeline 12 | material 16 | depth 12 | mesh 20
+///   transparent : layer 4 | far to near depth 12 | pipeline 12 | material 16 | mesh 20
+/// Sorted opaque draws change pipeline and material as rarely as possible and go front to back
+/// within a material for early depth rejection, by OPAQUE_DEPTH_BITS slabs so draws of one mesh
+/// in a slab still share their buffer binds. Transparent draws must blend back to front, state
+/// only breaks ties. Resources enter a key by a hash of their address, so two may share bits and
+/// interleave: that costs binds, never correctness, the recorder compares the pointers.
+struct DrawKey {
+  static constexpr u32 LAYER_BITS = 4;
+  static constexpr u32 PIPELINE_BITS = 12;
+  static constexpr u32 MATERIAL_BITS = 16;
+  static constexpr u32 DEPTH_BITS = 12;
+  static constexpr u32 MESH_BITS = 20;
+  /// Opaque draws only keep the top bits of their depth
+  static constexpr u32 OPAQUE_DEPTH_BITS = 4;
+
+  /// @brief Fields wider than their bits are masked
+  static u64 Make(RenderLayer layer, u32 pipeline, u32 material, u32 depth, u32 mesh);
+
+  /// @brief Depth field of a distance along the view direction, [0, far] maps to the whole
+  /// range and anything outside is clamped
+  static u32 DepthBucket(f32 distance, f32 far);
+
+  /// @brief The bits of a resource for its field, the same address always gives the same bits
+  static u32 ResourceBits(const void *resource, u32 bits);
+
+  static RenderLayer GetLayer(u64 key) { return (RenderLayer)(key >> (64 - LAYER_BITS)); }
+};
+
+/// @brief One draw as extracted from a scene, what the recorder needs to find the rest
+struct DrawPacket {
+  u64 key;
+  u32 ref;  // Dense index of the node's MeshRef in its pool
+  u32 slot; // Transform slot of the node
+};
+
+static_assert(sizeof(DrawPacket) == 16);
+
+/// @brief What recording a DrawList issued
+struct DrawStats {
+  u32 draws = 0;
+  u32 pipelineBinds = 0;
+  u32 bufferBinds = 0; // Vertex array, vertex and index
+  u32 textureBinds = 0;
+};
+
+/// @brief The draws of a frame, sorted by key before they are recorded
+class DrawList {
+public:
+  void Clear() { m_Packets.clear(); }
+  void Reserve(usize count) { m_Packets.reserve(count); }
+
+  void Add(u64 key, u32 ref, u32 slot) { m_Packets.push_back({key, ref, slot}); }
+
+  /// @brief Stable sort of the packets by key. LSD radix sort on the key bytes: one read builds
+  /// all eight histograms and a byte equal in every key costs no pass, so the fields a frame
+  /// does not use (one layer, few pipelines) are skipped. Short lists use std::stable_sort.
+  void Sort();
+
+  /// Below this many packets the comparison sort wins
+  static constexpr usize RADIX_MIN_COUNT = 256;
+
+  const std::vector<DrawPacket> &GetPackets() const { return m_Packets; }
+  usize GetSize() const { return m_Packets.size(); }
+
+private:
+  std::vector<DrawPacket> m_Packets;
+  std::vector<DrawPacket> m_Scratch;
+};
+
+#endif // !SN_DRAW_LIST_H
@@ -45,7 +45,8 @@ void SetViewportCommand::Execute(RenderSystem &renderSys) const {
 }
 // --------------------------------------------------------------------------------
 DrawCommand::DrawCommand(
-  const VertexArray *va, u32 offset, u32 vertCount, PrimitiveType topology, const Mat4 &model
+  const VertexArray *va, u32 offset, u32 vertCount, PrimitiveType topology,
+  const Affine3x4 &model
 )
   : m_VAO(va)
   , m_Transform(model)
@@ -54,12 +55,13 @@ DrawCommand::DrawCommand(
   , m_Topology(topology) {}
 // --------------------------------------------------------------------------------
 void DrawCommand::Execute(RenderSystem &renderSys) const {
-  renderSys.GetCurrentPipeline()->SetUniform("uModel", m_Transform);
+  renderSys.GetCurrentPipeline()->SetUniform("uModel", m_Transform.ToMat4());
   renderSys.Draw(m_Topology, m_VAO, m_VertOffset, m_NumVertices);
 }
 // --------------------------------------------------------------------------------
 DrawIndexedCommand::DrawIndexedCommand(
-  const VertexArray *va, u32 idxOffset, u32 idxCount, const Mat4 &model, PrimitiveType topology
+  const VertexArray *va, u32 idxOffset, u32 idxCount, const Affine3x4 &model,
+  PrimitiveType topology
 )
   : m_VAO(va)
   , m_Transform(model)
@@ -68,7 +70,7 @@ DrawIndexedCommand::DrawIndexedCommand(
   , m_Topology(topology) {}
 // --------------------------------------------------------------------------------
 void DrawIndexedCommand::Execute(RenderSystem &renderSys) const {
-  renderSys.GetCurrentPipeline()->SetUniform("uModel", m_Transform);
+  renderSys.GetCurrentPipeline()->SetUniform("uModel", m_Transform.ToMat4());
   renderSys.DrawIndexed(m_Topology, m_VAO, m_IndexOffset, m_NumIndex);
 }
 // --------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #include <render/colors.h>
 #include <render/render_pipeline.h>
 #include <render/vertex_array.h>
+#include <core/math/affine3x4.h>
 #include <core/math/mat4.h>
 
 class RenderSystem;
@@ -71,13 +72,13 @@ class DrawCommand : public RenderCommand {
 public:
   DrawCommand(
     const VertexArray *va, u32 offset, u32 vertCount,
-    PrimitiveType topology = PrimitiveType::TRIANGLES, const Mat4 &model = Mat4::Identity
+    PrimitiveType topology = PrimitiveType::TRIANGLES, const Affine3x4 &model = Affine3x4::Identity
   );
   void Execute(RenderSystem &renderSys) const override;
 
 private:
   const VertexArray *m_VAO;
-  const Mat4 &m_Transform;
+  Affine3x4 m_Transform; // expanded to a Mat4 at upload
   u32 m_VertOffset;
   u32 m_NumVertices;
   PrimitiveType m_Topology;
@@ -86,14 +87,15 @@ private:
 class DrawIndexedCommand : public RenderCommand {
 public:
   DrawIndexedCommand(
-    const VertexArray *va, u32 idxOffset, u32 idxCount, const Mat4 &model = Mat4::Identity,
+    const VertexArray *va, u32 idxOffset, u32 idxCount,
+    const Affine3x4 &model = Affine3x4::Identity,
     PrimitiveType topology = PrimitiveType::TRIANGLES
   );
   void Execute(RenderSystem &renderSys) const override;
 
 private:
   const VertexArray *m_VAO;
-  const Mat4 &m_Transform;
+  Affine3x4 m_Transform; // expanded to a Mat4 at upload
   u32 m_IndexOffset;
   u32 m_NumIndex;
   PrimitiveType m_Topology;
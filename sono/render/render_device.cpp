@@ -20,3 +20,10 @@ void RenderDevice::DeleteAllBuffers() {
     }
   }
 }
+// --------------------------------------------------------------------------------
+void RenderDevice::ResetFrame() {
+  if (queue) queue->Reset();
+  for (CommandList *cmdList : m_FrameCommandLists) cmdList->~CommandList();
+  m_FrameCommandLists.clear();
+  m_FrameAllocator.Clear();
+}
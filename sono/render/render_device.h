@@ -16,6 +16,7 @@
 #include <core/memory/allocator.h>
 
 #include <set>
+#include <vector>
 
 using PipelineHandle = u32;
 
@@ -45,11 +46,16 @@ public:
 
   virtual void DeleteAllBuffers();
 
+  /// @brief Destroy the command lists created this frame and reclaim their memory. Call once the
+  /// queue has executed them.
+  void ResetFrame();
+
 public:
   CommandQueue *queue;
 
 protected:
   std::set<Buffer *> m_Buffers;
+  std::vector<CommandList *> m_FrameCommandLists; // Allocated from m_FrameAllocator
 
   // std::array<RenderPipeline *, 64> m_Pipelines;
   // std::queue<PipelineHandle> m_FreePipeline;
@@ -5,6 +5,8 @@
 #include <render/colors.h>
 #include <render/render_pipeline.h>
 #include <render/buffer_base.h>
+#include <render/vertex_array.h>
+#include <render/resource/texture.h>
 
 struct RenderPassDesc {
   Color3 clearCol;
@@ -18,8 +20,13 @@ public:
 
   // clang-format off
   virtual void BindPipeline(RenderPipeline *pso) = 0;
+  virtual void BindVertexArray(VertexArray *va) = 0;
   virtual void BindVertexBuffer(Buffer *vb) = 0;
   virtual void BindIndexBuffer(Buffer *vb) = 0;
+  virtual void BindTexture(Texture *texture, u32 unit) = 0;
+  /// Bind a Storage buffer the pipeline's shaders read from at slot. A draw's firstInstance
+  /// offsets the instance index the shaders see, so it can select an element of the buffer.
+  virtual void BindStorageBuffer(Buffer *buffer, u32 slot) = 0;
   virtual void Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) = 0;
   virtual void DrawIndexed(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) = 0;
   // clang-format on
@@ -12,7 +12,8 @@ RenderSystem::RenderSystem()
   : m_pActiveCtx(nullptr)
   , m_pDevice(nullptr)
   , m_pActivePipeline(nullptr)
-  , m_Arena(RENDER_FRAME_ALLOC_SIZE) {
+  , m_Arena(RENDER_FRAME_ALLOC_SIZE)
+  , m_LastPresentTicks(0) {
   /* Initialize the library */
   if (!glfwInit()) exit(EXIT_FAILURE);
   m_DebugDraw = m_Arena.New<DebugDraw>(this);
@@ -100,6 +100,9 @@ public:
 
   inline RenderDevice *GetRenderDevice() const { return m_pDevice; };
 
+  /// Time::Ticks() taken right after the last Present() returned
+  inline u64 GetLastPresentTicks() const { return m_LastPresentTicks; }
+
 protected:
   RenderContext *m_pActiveCtx;
   RenderDevice *m_pDevice;
@@ -109,6 +112,7 @@ protected:
   RenderQueue m_RenderQueue;
   ArenaAllocator m_Arena;
   ArenaAllocator::Marker m_FrameBeginMark;
+  u64 m_LastPresentTicks;
 };
 
 #endif // !SN_RENDER_SYSTEM_H
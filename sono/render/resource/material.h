@@ -0,0 +1,25 @@
+#ifndef SN_MATERIAL_H
+#define SN_MATERIAL_H
+
+#include <core/common/types.h>
+
+class RenderPipeline;
+class Texture;
+
+/// @brief Draw order group, every draw of a layer comes before the next layer's
+enum class RenderLayer : u8 {
+  Opaque,
+  Transparent, // Blended, drawn back to front
+};
+
+/// @brief The pipeline and textures a mesh is drawn with. textures[i] is bound to unit i, units
+/// left null keep whatever was bound.
+struct Material {
+  static constexpr u32 MAX_TEXTURES = 4;
+
+  RenderPipeline *pipeline = nullptr;
+  Texture *textures[MAX_TEXTURES] = {};
+  RenderLayer layer = RenderLayer::Opaque;
+};
+
+#endif // !SN_MATERIAL_H
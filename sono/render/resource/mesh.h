@@ -6,17 +6,20 @@
 #include <render/vertex_layout.h>
 #include <render/buffer_base.h>
 
+class TriangleBvh;
+
 struct SubMesh {
   u32 idxOffset;
   u32 idxCount;
 };
 
 struct Mesh {
-  Buffer *pVertexBuffer;
-  Buffer *pIndexBuffer;
-  VertexArray *pVertexArray; // NOTE: this will be removed
+  Buffer *pVertexBuffer = nullptr;
+  Buffer *pIndexBuffer = nullptr;
+  VertexArray *pVertexArray = nullptr; // The layout applied to pVertexBuffer
   std::vector<SubMesh> subMeshes;
   VertexLayout layout;
+  const TriangleBvh *pTriangles = nullptr; // CPU copy of the geometry for picking, optional
 };
 
 class MeshFactory {
@@ -1,11 +1,74 @@
 #include <render/scene.h>
+#include <render/scene_snapshot.h>
+#include <render/render_system.h>
+#include <render/camera.h>
+#include <render/resource/material.h>
+#include <render/resource/mesh.h>
+#include <core/common/snassert.h>
+#include <core/math/batch.h>
+#include <core/math/triangle_bvh.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
-u32 Scene::AddNode(i32 parent, i32 level) {
-  i32 node = (i32)m_Hierachy.size();
-  m_Hierachy.push_back(
-    {.parent = parent, .firstChild = -1, .lastChild = -1, .nextSibling = -1, .level = level}
-  );
-  m_Transforms.emplace_back();
+Entity Scene::AddNode(Entity parentEntity) {
+  SN_ASSERT(parentEntity == NULL_ENTITY || IsAlive(parentEntity), "Parent node does not exist");
+  const i32 parent = parentEntity == NULL_ENTITY ? -1 : (i32)EntityHandle::GetIndex(parentEntity);
+
+  i32 node;
+  if (m_FreeIndices.size() >= MIN_FREE_INDICES) {
+    node = (i32)m_FreeIndices.front();
+    m_FreeIndices.pop_front();
+  } else {
+    node = (i32)m_Hierachy.size();
+    SN_ASSERT(node < (i32)EntityHandle::MAX_INDEX, "Too many entities");
+    m_Hierachy.emplace_back();
+    m_Generations.push_back(0);
+    m_Names.emplace_back();
+    m_SlotOf.push_back(0);
+    m_BvhLeaf.push_back(Bvh::NULL_NODE);
+    m_RenderStamp.push_back(0);
+  }
+  const Entity entity = EntityHandle::Make(node, m_Generations[node]);
+  const i32 level = parent > -1 ? m_Hierachy[parent].level + 1 : 0;
+  m_Hierachy[node] =
+    {.parent = parent, .firstChild = -1, .lastChild = -1, .nextSibling = -1, .level = level};
+  m_NodeCount++;
+  MarkRenderChanged((u32)node);
+
+  // Fill a hole of the level, or append when the node belongs to the last level. Otherwise it
+  // is out of level order and the next UpdateTransforms sorts it in.
+  const i32 parentSlot = parent > -1 ? (i32)m_SlotOf[parent] : -1;
+  const BoundingSphere noBounds(Vec3::Zero, std::numeric_limits<f32>::infinity());
+  if (!m_OrderDirty && level < (i32)m_LevelFree.size() && !m_LevelFree[level].empty()) {
+    const u32 slot = m_LevelFree[level].back();
+    m_LevelFree[level].pop_back();
+    m_HoleCount--;
+    m_SlotOf[node] = slot;
+    m_EntityOf[slot] = entity;
+    m_SlotParent[slot] = parentSlot;
+    m_Transforms[slot] = Transform(); // starts dirty
+    m_Bounds[slot] = noBounds;
+    m_WorldChanged[slot] = 0;
+  } else {
+    m_SlotOf[node] = (u32)m_Transforms.size();
+    m_EntityOf.push_back(entity);
+    m_SlotParent.push_back(parentSlot);
+    m_Transforms.emplace_back();
+    m_Bounds.push_back(noBounds);
+    m_WorldChanged.push_back(0);
+
+    if (m_LevelStart.empty()) m_LevelStart.push_back(0);
+    const i32 levelCount = (i32)m_LevelStart.size() - 1;
+    if (m_OrderDirty || level + 1 < levelCount) {
+      m_OrderDirty = true;
+    } else {
+      if (level == levelCount) m_LevelStart.push_back(m_LevelStart.back());
+      m_LevelStart.back()++;
+    }
+  }
 
   // update parent node if valid index provided
   if (parent > -1) {
@@ -29,18 +92,447 @@ u32 Scene::AddNode(i32 parent, i32 level) {
     }
   }
 
-  return node;
+  return entity;
+}
+
+Entity Scene::CreateEntity() { return AddNode(NULL_ENTITY); }
+
+void Scene::DestroyEntity(Entity e) {
+  if (!IsAlive(e)) return;
+  const i32 node = (i32)EntityHandle::GetIndex(e);
+
+  // Unlink from the parent's children, the subtree goes with it
+  const i32 parent = m_Hierachy[node].parent;
+  if (parent > -1) {
+    Hierachy &p = m_Hierachy[parent];
+    i32 prev = -1;
+    for (i32 c = p.firstChild; c != node; c = m_Hierachy[c].nextSibling) prev = c;
+    if (prev > -1) {
+      m_Hierachy[prev].nextSibling = m_Hierachy[node].nextSibling;
+    } else {
+      p.firstChild = m_Hierachy[node].nextSibling;
+    }
+    if (p.lastChild == node) p.lastChild = prev;
+  }
+
+  std::vector<i32> stack = {node};
+  while (!stack.empty()) {
+    const i32 i = stack.back();
+    stack.pop_back();
+    for (i32 c = m_Hierachy[i].firstChild; c > -1; c = m_Hierachy[c].nextSibling) {
+      stack.push_back(c);
+    }
+
+    const Entity dead = EntityHandle::Make(i, m_Generations[i]);
+    for (const std::unique_ptr<ComponentPoolBase> &pool : m_Pools) {
+      if (pool) pool->Remove(dead);
+    }
+
+    // The slot becomes a hole that a new node of the level can take, or that the next rebuild
+    // compacts away
+    const u32 slot = m_SlotOf[i];
+    m_EntityOf[slot] = NULL_ENTITY;
+    m_SlotParent[slot] = -1;
+    if (!m_OrderDirty) {
+      const usize level = (usize)m_Hierachy[i].level;
+      if (level >= m_LevelFree.size()) m_LevelFree.resize(level + 1);
+      m_LevelFree[level].push_back(slot);
+      m_HoleCount++;
+    }
+
+    if (m_BvhLeaf[i] != Bvh::NULL_NODE) {
+      m_Bvh.Remove(m_BvhLeaf[i]);
+      m_BvhLeaf[i] = Bvh::NULL_NODE;
+    }
+    m_Names[i] = std::string();
+    m_Generations[i] = (u16)((m_Generations[i] + 1) & EntityHandle::MAX_GENERATION);
+    m_Hierachy[i] =
+      {.parent = -1, .firstChild = -1, .lastChild = -1, .nextSibling = -1, .level = -1};
+    m_FreeIndices.push_back((u32)i);
+    m_NodeCount--;
+    MarkRenderChanged((u32)i);
+  }
+  // Too many holes make the update walk dead slots
+  if (m_HoleCount > m_Transforms.size() / 4) m_OrderDirty = true;
+}
+
+void Scene::SetBounds(Entity e, const BoundingSphere &localBounds) {
+  m_Bounds[m_SlotOf[EntityHandle::GetIndex(e)]] = localBounds;
+  if (m_BvhBuilt) m_BvhPending.push_back(e);
+  MarkRenderChanged(EntityHandle::GetIndex(e));
+}
+
+void Scene::UpdateTransforms() {
+  if (m_OrderDirty) RebuildLevelOrder();
+  m_UpdateCount++;
+
+  // A node only reads its parent, so a level can be split across threads once the levels above
+  // it are done
+  ThreadPool *pool = ThreadPool::GetPtr();
+  for (usize l = 0; l + 1 < m_LevelStart.size(); l++) {
+    const usize begin = m_LevelStart[l], end = m_LevelStart[l + 1];
+    if (!pool || end - begin < PARALLEL_MIN_LEVEL_SIZE) {
+      UpdateTransformRange(begin, end);
+      continue;
+    }
+    pool->ParallelFor(end - begin, PARALLEL_CHUNK_SIZE, [&](usize first, usize last) {
+      UpdateTransformRange(begin + first, begin + last);
+    });
+  }
+
+  // Gather the flags, eight at a time where none is set
+  m_ChangedTransforms.clear();
+  const u8 *changed = m_WorldChanged.data();
+  const usize count = m_WorldChanged.size();
+  for (usize k = 0; k < count; k += 8) {
+    u64 word = 0;
+    if (k + 8 <= count) std::memcpy(&word, changed + k, sizeof(word));
+    if (k + 8 <= count && word == 0) continue;
+    for (usize j = k; j < std::min(k + 8, count); j++) {
+      if (changed[j] && m_EntityOf[j] != NULL_ENTITY) m_ChangedTransforms.push_back(m_EntityOf[j]);
+    }
+  }
+}
+
+void Scene::UpdateTransformRange(usize begin, usize end) {
+  Transform *transforms = m_Transforms.data();
+  const i32 *slotParent = m_SlotParent.data();
+  u8 *changed = m_WorldChanged.data();
+  for (usize k = begin; k < end; k++) {
+    const i32 parent = slotParent[k];
+    changed[k] = transforms[k].IsDirty() || (parent > -1 && changed[parent]);
+    if (!changed[k]) continue;
+
+    if (parent > -1) {
+      transforms[k].UpdateModelMatrix(transforms[parent].GetModelMatrix());
+    } else {
+      transforms[k].UpdateModelMatrix();
+    }
+  }
+}
+
+void Scene::RebuildLevelOrder() {
+  const usize count = m_NodeCount;
+
+  // Breadth first from the roots in creation order, which is level order. Destroyed nodes are
+  // not reached, which compacts their slots away.
+  std::vector<u32> order;
+  order.reserve(count);
+  for (u32 i = 0; i < m_Hierachy.size(); i++) {
+    if (m_Hierachy[i].level == 0) order.push_back(i);
+  }
+  for (usize k = 0; k < order.size(); k++) {
+    for (i32 c = m_Hierachy[order[k]].firstChild; c > -1; c = m_Hierachy[c].nextSibling) {
+      order.push_back((u32)c);
+    }
+  }
+  SN_ASSERT(order.size() == count, "Scene hierarchy has a cycle or a detached node");
+
+  std::vector<Transform> transforms(count);
+  std::vector<BoundingSphere> bounds(count);
+  std::vector<u32> slotOf(m_Hierachy.size(), U32_MAX);
+  std::vector<Entity> entityOf(count);
+  m_LevelStart.clear();
+  for (usize k = 0; k < count; k++) {
+    const u32 i = order[k];
+    transforms[k] = m_Transforms[m_SlotOf[i]];
+    bounds[k] = m_Bounds[m_SlotOf[i]];
+    slotOf[i] = (u32)k;
+    entityOf[k] = EntityHandle::Make(i, m_Generations[i]);
+    while ((i32)m_LevelStart.size() <= m_Hierachy[i].level) m_LevelStart.push_back((u32)k);
+  }
+  m_LevelStart.push_back((u32)count);
+
+  m_SlotParent.resize(count);
+  for (usize k = 0; k < count; k++) {
+    const i32 parent = m_Hierachy[order[k]].parent;
+    m_SlotParent[k] = parent > -1 ? (i32)slotOf[parent] : -1;
+  }
+  m_Transforms = std::move(transforms);
+  m_Bounds = std::move(bounds);
+  m_SlotOf = std::move(slotOf);
+  m_EntityOf = std::move(entityOf);
+  m_WorldChanged.assign(count, 0);
+  m_LevelFree.clear();
+  m_HoleCount = 0;
+  m_OrderDirty = false;
+}
+
+const std::vector<Entity> &Scene::CullVisible(const Frustum &frustum) {
+  const usize count = m_Transforms.size();
+  m_CullSpheres.resize(count * 4);
+  f32 *x = m_CullSpheres.data();
+  f32 *y = x + count;
+  f32 *z = y + count;
+  f32 *radius = z + count;
+  for (usize i = 0; i < count; i++) {
+    const BoundingSphere world = m_Bounds[i].Transformed(m_Transforms[i].GetModelMatrix());
+    x[i] = world.center.x;
+    y[i] = world.center.y;
+    z[i] = world.center.z;
+    radius[i] = world.radius;
+  }
+
+  m_VisibleNodes.resize(count);
+  const usize visible = Sono::CullSpheres(frustum, {x, y, z}, radius, count, m_VisibleNodes.data());
+  // Holes left by destroyed nodes are dropped
+  usize kept = 0;
+  for (usize i = 0; i < visible; i++) {
+    const Entity e = m_EntityOf[m_VisibleNodes[i]];
+    if (e != NULL_ENTITY) m_VisibleNodes[kept++] = e;
+  }
+  m_VisibleNodes.resize(kept);
+  return m_VisibleNodes;
+}
+
+const Bvh &Scene::UpdateBvh() {
+  if (!m_BvhBuilt) {
+    std::vector<u32> items;
+    std::vector<AABB> boxes;
+    std::vector<i32> leaves;
+    for (usize k = 0; k < m_Transforms.size(); k++) {
+      if (m_EntityOf[k] == NULL_ENTITY || std::isinf(m_Bounds[k].radius)) continue;
+      const BoundingSphere world = m_Bounds[k].Transformed(m_Transforms[k].GetModelMatrix());
+      items.push_back(m_EntityOf[k]);
+      boxes.push_back(AABB::FromCenterExtents(world.center, Vec3(world.radius)));
+    }
+    leaves.resize(items.size());
+    m_Bvh.Build(items.data(), boxes.data(), items.size(), leaves.data());
+    for (usize i = 0; i < items.size(); i++) {
+      m_BvhLeaf[EntityHandle::GetIndex(items[i])] = leaves[i];
+    }
+    m_BvhPending.clear();
+    m_BvhBuilt = true;
+    m_BvhUpdateCount = m_UpdateCount;
+    return m_Bvh;
+  }
+
+  // The changed flags only cover the last update, after a skipped one every node is synced
+  if (m_UpdateCount != m_BvhUpdateCount) {
+    if (m_UpdateCount - m_BvhUpdateCount > 1) {
+      for (usize k = 0; k < m_Transforms.size(); k++) SyncBvhSlot(k);
+    } else {
+      for (const Entity e : m_ChangedTransforms) {
+        if (IsAlive(e)) SyncBvhSlot(m_SlotOf[EntityHandle::GetIndex(e)]);
+      }
+    }
+    m_BvhUpdateCount = m_UpdateCount;
+  }
+  for (const Entity e : m_BvhPending) {
+    if (IsAlive(e)) SyncBvhSlot(m_SlotOf[EntityHandle::GetIndex(e)]);
+  }
+  m_BvhPending.clear();
+  m_Bvh.Refit();
+  return m_Bvh;
 }
 
-Entity Scene::CreateEntity() {
-  // NOTE: for now the level is not set
-  return AddNode(-1, 0);
+void Scene::SyncBvhSlot(usize slot) {
+  const Entity e = m_EntityOf[slot];
+  if (e == NULL_ENTITY) return;
+  i32 &leaf = m_BvhLeaf[EntityHandle::GetIndex(e)];
+  if (std::isinf(m_Bounds[slot].radius)) {
+    if (leaf != Bvh::NULL_NODE) m_Bvh.Remove(leaf);
+    leaf = Bvh::NULL_NODE;
+    return;
+  }
+
+  const BoundingSphere world = m_Bounds[slot].Transformed(m_Transforms[slot].GetModelMatrix());
+  const AABB box = AABB::FromCenterExtents(world.center, Vec3(world.radius));
+  if (leaf == Bvh::NULL_NODE) {
+    leaf = m_Bvh.Insert(e, box);
+  } else {
+    m_Bvh.SetLeafBounds(leaf, box);
+  }
 }
 
-void Scene::Render(RenderSystem *rs) {
+b8 Scene::Raycast(const Ray &ray, f32 maxT, SceneRayHit &hit) {
+  const Bvh &bvh = UpdateBvh();
+  ComponentPool<MeshRef> &meshes = GetPool<MeshRef>();
+  b8 found = false;
+  bvh.Raycast(ray.origin, ray.dir, maxT, [&](u32 item, f32) {
+    const Entity e = (Entity)item;
+    if (!meshes.Has(e)) return maxT;
+    const Mesh *mesh = meshes.Get(e).mesh;
+    if (!mesh || !mesh->pTriangles) return maxT;
+
+    // The ray in the mesh's space keeps its t, hits compare across nodes as they are
+    RayHit meshHit;
+    const Ray local = ray.Transformed(GetWorldMatrix(e).Inversed());
+    if (mesh->pTriangles->Raycast(local, maxT, meshHit)) {
+      maxT = meshHit.t;
+      hit = {e, meshHit.t, meshHit.triangle};
+      found = true;
+    }
+    return maxT;
+  });
+  return found;
+}
+
+void Scene::ExtractDraws(const Camera &camera, DrawList &out) {
+  out.Clear();
+  const std::vector<Entity> &visible = CullVisible(camera.GetFrustum());
+  ComponentPool<MeshRef> &refs = GetPool<MeshRef>();
+  out.Reserve(std::min(visible.size(), refs.GetSize()));
+
+  const Vec3 &eye = camera.GetPosition(), &forward = camera.GetForward();
+  const f32 far = camera.GetFar();
+  for (const Entity e : visible) {
+    if (!refs.Has(e)) continue;
+    const u32 ref = refs.GetIndex(e);
+    const MeshRef &meshRef = refs.GetData()[ref];
+    const Material *material = meshRef.material;
+    if (!meshRef.mesh || !material) continue;
+
+    const u32 slot = m_SlotOf[EntityHandle::GetIndex(e)];
+    const Vec3 center =
+      m_Bounds[slot].Transformed(m_Transforms[slot].GetModelMatrix()).center - eye;
+    const f32 distance = center.x * forward.x + center.y * forward.y + center.z * forward.z;
+    const u64 key = DrawKey::Make(
+      material->layer, DrawKey::ResourceBits(material->pipeline, DrawKey::PIPELINE_BITS),
+      DrawKey::ResourceBits(material, DrawKey::MATERIAL_BITS), DrawKey::DepthBucket(distance, far),
+      DrawKey::ResourceBits(meshRef.mesh, DrawKey::MESH_BITS)
+    );
+    out.Add(key, ref, slot);
+  }
+  out.Sort();
+}
+
+DrawStats Scene::RecordDraws(const DrawList &list, RenderPass *pass) {
+  DrawStats stats;
+  const MeshRef *refs = GetPool<MeshRef>().GetData();
+
+  RenderPipeline *pipeline = nullptr;
+  VertexArray *vertexArray = nullptr;
+  Buffer *vertexBuffer = nullptr, *indexBuffer = nullptr;
+  Texture *textures[Material::MAX_TEXTURES] = {};
+  for (const DrawPacket &packet : list.GetPackets()) {
+    const MeshRef &ref = refs[packet.ref];
+    const Mesh &mesh = *ref.mesh;
+    const Material &material = *ref.material;
+
+    if (material.pipeline != pipeline) {
+      pipeline = material.pipeline;
+      pass->BindPipeline(pipeline);
+      stats.pipelineBinds++;
+    }
+    for (u32 unit = 0; unit < Material::MAX_TEXTURES; unit++) {
+      Texture *texture = material.textures[unit];
+      if (!texture || texture == textures[unit]) continue;
+      textures[unit] = texture;
+      pass->BindTexture(texture, unit);
+      stats.textureBinds++;
+    }
+    // The vertex array holds the layout and, in GL, the index buffer binding, it goes first
+    if (mesh.pVertexArray != vertexArray) {
+      vertexArray = mesh.pVertexArray;
+      pass->BindVertexArray(vertexArray);
+      stats.bufferBinds++;
+    }
+    if (mesh.pVertexBuffer != vertexBuffer) {
+      vertexBuffer = mesh.pVertexBuffer;
+      pass->BindVertexBuffer(vertexBuffer);
+      stats.bufferBinds++;
+    }
+    if (mesh.pIndexBuffer && mesh.pIndexBuffer != indexBuffer) {
+      indexBuffer = mesh.pIndexBuffer;
+      pass->BindIndexBuffer(indexBuffer);
+      stats.bufferBinds++;
+    }
+
+    stats.draws++;
+    const u32 instance = EntityHandle::GetIndex(m_EntityOf[packet.slot]);
+    if (ref.subMesh < mesh.subMeshes.size()) {
+      const SubMesh &subMesh = mesh.subMeshes[ref.subMesh];
+      pass->DrawIndexed(subMesh.idxCount, 1, subMesh.idxOffset, instance);
+    } else if (mesh.pIndexBuffer) {
+      pass->DrawIndexed(mesh.pIndexBuffer->GetCount(), 1, 0, instance);
+    } else {
+      pass->Draw(mesh.pVertexBuffer->GetCount(), 1, 0, instance);
+    }
+  }
+  return stats;
+}
+
+void Scene::Render(RenderSystem *rs, const Camera &camera) {
   RenderDevice *device = rs->GetRenderDevice();
+  const usize capacity = GetEntityCapacity();
+  if (!m_TransformGpuBuffer || m_TransformGpuBuffer->GetCount() < capacity) {
+    if (m_TransformGpuBuffer) device->DeleteBuffer(m_TransformGpuBuffer);
+    m_TransformGpuBuffer = device->CreateBuffer(
+      {.count = std::bit_ceil(std::max<usize>(capacity, 1024)),
+       .stride = sizeof(Affine3x4),
+       .usage = BufferUsage::Storage | BufferUsage::CopyDest}
+    );
+    // The new buffer may reuse the old one's address
+    m_TransformBuffer.Invalidate();
+  }
+  m_TransformBuffer.Upload(*this, m_TransformGpuBuffer);
+
+  ExtractDraws(camera, m_DrawList);
+
   CommandList *cmdList = device->CreateCommandList();
   RenderPass *pass = cmdList->BeginRenderPass({.clearCol = Color3(0, 0, 0)});
+  pass->BindStorageBuffer(m_TransformGpuBuffer, TRANSFORM_BUFFER_SLOT);
+  RecordDraws(m_DrawList, pass);
+  cmdList->EndRenderPass();
+  device->queue->Submit({.cmdLists = {cmdList}});
+}
+
+void Scene::PublishSnapshot(TripleBuffer<SceneFrame> &snapshot) {
+  // The changed flags only cover the last update, after a skipped one every node is copied
+  const b8 all = m_UpdateCount - m_SnapshotUpdateCount > 1;
+  if (!all && m_UpdateCount != m_SnapshotUpdateCount) {
+    for (const Entity e : m_ChangedTransforms) MarkRenderChanged(EntityHandle::GetIndex(e));
+  }
+  m_SnapshotUpdateCount = m_UpdateCount;
+
+  const u64 publish = ++m_PublishCount;
+  std::vector<u32> &changes = m_SnapshotHistory[publish % SNAPSHOT_HISTORY];
+  changes.swap(m_RenderChanged);
+  m_RenderChanged.clear();
+  m_SnapshotHistoryAll[publish % SNAPSHOT_HISTORY] = all;
+
+  // The write frame is some publishes old, it needs the changes of each since. Past one write
+  // per node, copying every node once is cheaper.
+  SceneFrame &frame = snapshot.GetWriteBuffer();
+  const usize count = m_Hierachy.size();
+  b8 whole = frame.frame == 0 || publish - frame.frame > SNAPSHOT_HISTORY;
+  usize listed = 0;
+  for (u64 p = frame.frame + 1; !whole && p <= publish; p++) {
+    listed += m_SnapshotHistory[p % SNAPSHOT_HISTORY].size();
+    whole = m_SnapshotHistoryAll[p % SNAPSHOT_HISTORY] || listed >= count;
+  }
+
+  frame.entities.resize(count, NULL_ENTITY);
+  frame.world.resize(count, Affine3x4::Identity);
+  frame.bounds.resize(count);
+  frame.meshes.resize(count);
+  ComponentPool<MeshRef> &meshes = GetPool<MeshRef>();
+  if (whole) {
+    for (u32 i = 0; i < count; i++) WriteFrameNode(frame, i, meshes);
+  } else {
+    for (u64 p = frame.frame + 1; p <= publish; p++) {
+      for (const u32 i : m_SnapshotHistory[p % SNAPSHOT_HISTORY]) WriteFrameNode(frame, i, meshes);
+    }
+  }
+  frame.frame = publish;
+  snapshot.Publish();
+}
+
+void Scene::WriteFrameNode(SceneFrame &frame, u32 index, ComponentPool<MeshRef> &meshes) const {
+  if (m_Hierachy[index].level < 0) {
+    frame.entities[index] = NULL_ENTITY;
+    frame.meshes[index] = MeshRef();
+    return;
+  }
+  const Entity e = EntityHandle::Make(index, m_Generations[index]);
+  const u32 slot = m_SlotOf[index];
+  const Affine3x4 &world = m_Transforms[slot].GetModelMatrix();
+  frame.entities[index] = e;
+  frame.world[index] = world;
+  frame.bounds[index] = m_Bounds[slot].Transformed(world);
+  const MeshRef *meshRef = meshes.Find(e);
+  frame.meshes[index] = meshRef ? *meshRef : MeshRef();
 }
 
-void Scene::RenderSceneTree(RenderSystem *rs) {}
+void Scene::RenderSceneTree(RenderSystem *) {}
@@ -1,14 +1,54 @@
 #ifndef SN_SCENE_GRAPH_H
 #define SN_SCENE_GRAPH_H
 
-#include <render/render_system.h>
 #include <core/common/types.h>
+#include <core/ecs/component_pool.h>
+#include <core/math/bounds.h>
+#include <core/math/bvh.h>
+#include <core/math/frustum.h>
+#include <core/math/ray.h>
 #include <core/math/transform.h>
+#include <core/thread/thread_pool.h>
+#include <render/draw_list.h>
+#include <render/transform_buffer.h>
+#include <deque>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-using Entity = u32;
+class Buffer;
+class Camera;
+class RenderPass;
+class RenderSystem;
+struct Material;
+struct Mesh;
 
+struct SceneFrame;
+
+template <typename... Ts>
+class SceneView;
+
+template <typename T>
+class TripleBuffer;
+
+/// @brief What a node draws
+struct MeshRef {
+  const Mesh *mesh = nullptr;
+  u32 subMesh = 0;
+  const Material *material = nullptr;
+};
+
+/// @brief A node hit by Scene::Raycast, triangle indexes its mesh's TriangleBvh triangles
+struct SceneRayHit {
+  Entity entity;
+  f32 t;
+  u32 triangle;
+};
+
+/// Node links by entity index, level is -1 for a destroyed node
 struct Hierachy {
   i32 parent;
   i32 firstChild;
@@ -22,26 +62,364 @@ public:
   Scene() = default;
   ~Scene() = default;
 
+  /// @brief Every node has a Transform, other components live in a ComponentPool per type
   template <typename T>
   T &GetComponent(Entity e);
 
+  template <typename T>
+  b8 HasComponent(Entity e) const;
+
+  /// @brief Give e a T built from args, replacing the one it had
+  template <typename T, typename... Args>
+  T &AddComponent(Entity e, Args &&...args);
+
+  template <typename T>
+  void RemoveComponent(Entity e);
+
+  /// @brief The packed storage of T, created on first use
+  template <typename T>
+  ComponentPool<T> &GetPool();
+
+  /// @brief The nodes that have all of Ts, see SceneView
+  template <typename... Ts>
+  SceneView<Ts...> GetView() {
+    return SceneView<Ts...>(*this);
+  }
+
   Entity CreateEntity();
 
-  u32 AddNode(i32 parent, i32 level);
-  void Render(RenderSystem *rs);
+  /// @brief New node under parent (NULL_ENTITY for a root), its level is one below the
+  /// parent's. Reuses the index of a destroyed node once MIN_FREE_INDICES of them wait, so
+  /// spawning and destroying keeps the per entity arrays at a steady size.
+  Entity AddNode(Entity parent);
+
+  /// @brief Destroy e with its whole subtree and their components, their handles go stale.
+  /// Their transform slots become holes that new nodes of the same level fill, so steady
+  /// spawning and destroying needs no reordering; past a quarter of the slots the next
+  /// UpdateTransforms compacts them. Stale handles are ignored.
+  void DestroyEntity(Entity e);
+
+  b8 IsAlive(Entity e) const {
+    const u32 index = EntityHandle::GetIndex(e);
+    return index < m_Hierachy.size() && m_Hierachy[index].level >= 0 &&
+           m_Generations[index] == EntityHandle::GetGeneration(e);
+  }
+
+  /// @brief Live nodes
+  usize GetNodeCount() const { return m_NodeCount; }
+
+  void SetName(Entity e, std::string name) { m_Names[EntityHandle::GetIndex(e)] = std::move(name); }
+
+  /// @brief Empty for unnamed nodes
+  const std::string &GetName(Entity e) const { return m_Names[EntityHandle::GetIndex(e)]; }
+
+  /// Freed indices wait in a queue until there are this many, so an index is reused at most
+  /// once every MIN_FREE_INDICES destroys and the generation takes long to wrap around
+  static constexpr usize MIN_FREE_INDICES = 1024;
+
+  /// @brief Recompute the world matrix of every node whose Transform is dirty and of all their
+  /// descendants, world = local * parent world. One forward pass over the transforms, which are
+  /// stored in level order: parents come before their children and are read in order, a clean
+  /// subtree costs a flag check per node. Levels of PARALLEL_MIN_LEVEL_SIZE nodes or more are
+  /// split across the ThreadPool when there is one.
+  void UpdateTransforms();
+
+  /// @brief The nodes whose world matrix the last UpdateTransforms changed (moved, or under a
+  /// node that moved), in level order. Replaced by each update: a consumer that last caught up
+  /// at GetTransformVersion() v only needs this list to catch up with v + 1, further behind it
+  /// has to take every node. Entities may have been destroyed since the update.
+  const std::vector<Entity> &GetChangedTransforms() const { return m_ChangedTransforms; }
+
+  /// @brief UpdateTransforms calls so far
+  u64 GetTransformVersion() const { return m_UpdateCount; }
+
+  /// @brief World matrix of a live node as of the last UpdateTransforms
+  const Affine3x4 &GetWorldMatrix(Entity e) const {
+    return m_Transforms[m_SlotOf[EntityHandle::GetIndex(e)]].GetModelMatrix();
+  }
+
+  /// @brief One past the highest entity index handed out, the size of arrays by entity index
+  usize GetEntityCapacity() const { return m_Hierachy.size(); }
+
+  /// Smaller levels are not worth waking the workers for
+  static constexpr usize PARALLEL_MIN_LEVEL_SIZE = 8192;
+  static constexpr usize PARALLEL_CHUNK_SIZE = 2048;
+
+  /// @brief Local space bounds of a node, nodes without bounds are never culled
+  void SetBounds(Entity e, const BoundingSphere &localBounds);
+
+  /// @brief The nodes whose world bounds touch the frustum, in level order. Uses the model
+  /// matrices as of the last transform update. Only these should be drawn.
+  const std::vector<Entity> &CullVisible(const Frustum &frustum);
+
+  /// @brief World space boxes of the nodes with bounds in a Bvh whose items are entities, for
+  /// ray, box, sphere and frustum queries. Call after UpdateTransforms: the first call builds
+  /// the tree, later ones insert, remove and refit only the nodes that moved, were added or
+  /// destroyed, or got new bounds since. A node's box encloses its world bounding sphere.
+  const Bvh &UpdateBvh();
+
+  /// @brief The Bvh as of the last UpdateBvh
+  const Bvh &GetBvh() const { return m_Bvh; }
+
+  /// @brief Closest node whose mesh the ray hits for t in [0, maxT), tested against the mesh's
+  /// CPU triangles (Mesh::pTriangles) in the node's space. Walks UpdateBvh, nearer nodes
+  /// first, so only nodes with bounds are found; nodes without a MeshRef or triangles are
+  /// skipped. A mesh is tested whole whatever its MeshRef's subMesh.
+  /// @return false, hit untouched, when nothing is hit
+  b8 Raycast(const Ray &ray, f32 maxT, SceneRayHit &hit);
+
+  /// @brief Replace out with a packet per visible node whose MeshRef has a mesh and a material,
+  /// sorted by DrawKey. The depth of a draw is its world bounds center along the camera's
+  /// forward axis, the far plane maps to the last bucket. Culls with CullVisible.
+  void ExtractDraws(const Camera &camera, DrawList &out);
+
+  /// @brief Record the draws of a sorted list into pass, binding a pipeline, vertex array,
+  /// buffer or texture only where it differs from what the previous draw bound. A draw's firstInstance is the
+  /// entity index of its node, where the pipeline finds its model matrix in a TransformBuffer.
+  /// The list must come from ExtractDraws with no MeshRef added or removed since.
+  DrawStats RecordDraws(const DrawList &list, RenderPass *pass);
+
+  /// @brief Upload the changed world matrices into the scene's TransformBuffer, then extract,
+  /// sort and record the visible draws seen by camera and submit them. The buffer is bound at
+  /// TRANSFORM_BUFFER_SLOT, see assets/shaders/scene.vs.glsl for a shader reading it.
+  void Render(RenderSystem *rs, const Camera &camera);
+
+  /// Storage slot Render binds the world matrices at
+  static constexpr u32 TRANSFORM_BUFFER_SLOT = 0;
+
+  /// @brief Write the render state of every node (world matrix, world bounds, MeshRef) into the
+  /// snapshot's write frame and publish it, so another thread renders it while this one goes on
+  /// updating. Only nodes changed since that frame was last written are copied: moved by an
+  /// UpdateTransforms, added, destroyed, given bounds, or given or stripped of a MeshRef. A
+  /// MeshRef edited in place through GetComponent is not seen, replace it with AddComponent.
+  /// Call after UpdateTransforms, on the thread that owns the scene, always with one snapshot.
+  void PublishSnapshot(TripleBuffer<SceneFrame> &snapshot);
+
+  /// Publishes whose changes are kept, a frame last written before them is copied whole
+  static constexpr usize SNAPSHOT_HISTORY = 4;
+
   void RenderSceneTree(RenderSystem *rs);
 
+private:
+  void RebuildLevelOrder();
+
+  /// Update the transforms of slots [begin, end), their parents must be up to date
+  void UpdateTransformRange(usize begin, usize end);
+
+  /// Bring the Bvh leaf of the node in slot up to date with its world bounds
+  void SyncBvhSlot(usize slot);
+
+  /// List a node for the next PublishSnapshot
+  void MarkRenderChanged(u32 index) {
+    if (m_RenderStamp[index] == m_PublishCount + 1) return;
+    m_RenderStamp[index] = m_PublishCount + 1;
+    m_RenderChanged.push_back(index);
+  }
+
+  /// Copy the render state of the node at entity index into frame
+  void WriteFrameNode(SceneFrame &frame, u32 index, ComponentPool<MeshRef> &meshes) const;
+
+  template <typename... Ts>
+  friend class SceneView;
+  friend class SceneFile;
+
 private:
   std::unordered_map<usize, usize> m_NodeToName;
 
+  // Per entity index
   std::vector<Hierachy> m_Hierachy;
-  std::vector<Transform> m_Transforms;
   std::vector<std::string> m_Names; // Node names
+  std::vector<u16> m_Generations;
+  std::deque<u32> m_FreeIndices; // Oldest first
+  std::vector<i32> m_BvhLeaf;    // Bvh::NULL_NODE for nodes without bounds
+  usize m_NodeCount = 0;
+
+  // Per slot. Slots are in level order: level l spans slots [m_LevelStart[l], m_LevelStart[l + 1])
+  // and a rebuild sorts each level by parent slot. Destroyed nodes leave holes (m_EntityOf is
+  // NULL_ENTITY, no parent) listed per level in m_LevelFree. While m_OrderDirty new nodes take
+  // the next slot whatever their level.
+  std::vector<Transform> m_Transforms;
+  std::vector<BoundingSphere> m_Bounds; // Local space
+  std::vector<i32> m_SlotParent;        // Slot of the parent, -1 for roots
+  std::vector<Entity> m_EntityOf;
+  std::vector<u8> m_WorldChanged; // Set when the world matrix moved in the last update
+  std::vector<u32> m_SlotOf;      // Per entity index
+  std::vector<u32> m_LevelStart;
+  std::vector<std::vector<u32>> m_LevelFree;
+  usize m_HoleCount = 0;
+  b8 m_OrderDirty = false;
+
+  std::vector<std::unique_ptr<ComponentPoolBase>> m_Pools; // By GetComponentTypeId
+
+  std::vector<f32> m_CullSpheres; // World space x, y, z and radius streams for the batch test
+  std::vector<Entity> m_VisibleNodes;
+
+  DrawList m_DrawList;
+  TransformBuffer m_TransformBuffer;
+  Buffer *m_TransformGpuBuffer = nullptr; // Created by Render, one Affine3x4 per entity index
+  std::vector<Entity> m_ChangedTransforms;
+
+  Bvh m_Bvh;
+  std::vector<Entity> m_BvhPending; // Given new bounds since the last UpdateBvh
+  u64 m_UpdateCount = 0;            // UpdateTransforms calls
+  u64 m_BvhUpdateCount = 0;         // m_UpdateCount as of the last UpdateBvh
+  b8 m_BvhBuilt = false;
+
+  // Snapshot changes by entity index. Publish p's list is m_SnapshotHistory[p % SNAPSHOT_HISTORY],
+  // all set when every node counts as changed.
+  std::vector<u32> m_RenderChanged; // Since the last publish
+  std::vector<u64> m_RenderStamp;   // Per entity index, the publish it was last listed for
+  std::vector<u32> m_SnapshotHistory[SNAPSHOT_HISTORY];
+  b8 m_SnapshotHistoryAll[SNAPSHOT_HISTORY] = {};
+  u64 m_PublishCount = 0;
+  u64 m_SnapshotUpdateCount = 0; // m_UpdateCount as of the last publish
 };
 
 template <>
 inline Transform &Scene::GetComponent<Transform>(Entity e) {
-  return m_Transforms[e];
+  return m_Transforms[m_SlotOf[EntityHandle::GetIndex(e)]];
+}
+
+/// @brief Iterates the nodes that have every component of Ts. The smallest pool among Ts drives
+/// the loop and the other pools are probed per entity, so the cost follows the rarest component.
+/// The driving pool's components are read in their packed order; Transform, which every node has,
+/// never drives unless it is the only type, then the transform slots are walked in level order.
+/// Adding or removing components of Ts while iterating is not allowed, views are cheap to get
+/// again afterwards.
+template <typename... Ts>
+class SceneView {
+public:
+  explicit SceneView(Scene &scene)
+    : m_Scene(&scene)
+    , m_Pools(PoolOf<Ts>(scene)...) {
+    ((m_Driver = PickDriver(std::get<ComponentPool<Ts> *>(m_Pools))), ...);
+  }
+
+  /// @brief Upper bound of the matching nodes, the size of the driving pool or the slot count
+  usize GetCandidateCount() const {
+    return m_Driver ? m_Driver->GetSize() : m_Scene->m_Transforms.size();
+  }
+
+  /// @brief fn(Entity, Ts &...) for every matching node
+  template <typename Fn>
+  void Each(Fn &&fn) {
+    EachRange(0, GetCandidateCount(), fn);
+  }
+
+  /// @brief Each split across the ThreadPool in chunks of chunkSize candidates. fn runs
+  /// concurrently and must only write the components it is handed.
+  template <typename Fn>
+  void ParallelEach(usize chunkSize, Fn &&fn) {
+    ThreadPool *pool = ThreadPool::GetPtr();
+    if (!pool) {
+      EachRange(0, GetCandidateCount(), fn);
+      return;
+    }
+    pool->ParallelFor(GetCandidateCount(), chunkSize, [&](usize begin, usize end) {
+      EachRange(begin, end, fn);
+    });
+  }
+
+private:
+  template <typename T>
+  static ComponentPool<T> *PoolOf(Scene &scene) {
+    if constexpr (std::is_same_v<T, Transform>) {
+      return nullptr;
+    } else {
+      return &scene.GetPool<T>();
+    }
+  }
+
+  const ComponentPoolBase *PickDriver(const ComponentPoolBase *pool) const {
+    if (!pool) return m_Driver;
+    return !m_Driver || pool->GetSize() < m_Driver->GetSize() ? pool : m_Driver;
+  }
+
+  template <typename T>
+  b8 Contains(Entity e) const {
+    if constexpr (std::is_same_v<T, Transform>) {
+      return true;
+    } else {
+      return std::get<ComponentPool<T> *>(m_Pools)->Has(e);
+    }
+  }
+
+  /// The driving pool (or transform slot) is read at the candidate index, the rest looked up
+  template <typename T>
+  T &Fetch(Entity e, usize candidate) {
+    if constexpr (std::is_same_v<T, Transform>) {
+      if (!m_Driver) return m_Scene->m_Transforms[candidate];
+      return m_Scene->GetComponent<Transform>(e);
+    } else {
+      ComponentPool<T> *pool = std::get<ComponentPool<T> *>(m_Pools);
+      return pool == m_Driver ? pool->GetData()[candidate] : pool->Get(e);
+    }
+  }
+
+  template <typename Fn>
+  void EachRange(usize begin, usize end, Fn &fn) {
+    if (!m_Driver) {
+      // Only Transform, skip the holes destroyed nodes left
+      for (usize i = begin; i < end; i++) {
+        const Entity e = m_Scene->m_EntityOf[i];
+        if (e != NULL_ENTITY) fn(e, Fetch<Ts>(e, i)...);
+      }
+      return;
+    }
+
+    const Entity *entities = m_Driver->GetEntities();
+    for (usize i = begin; i < end; i++) {
+      const Entity e = entities[i];
+      if (!(Contains<Ts>(e) && ...)) continue;
+      fn(e, Fetch<Ts>(e, i)...);
+    }
+  }
+
+private:
+  Scene *m_Scene;
+  std::tuple<ComponentPool<Ts> *...> m_Pools; // nullptr for Transform
+  const ComponentPoolBase *m_Driver = nullptr; // nullptr walks the transform slots
+};
+
+template <typename T>
+T &Scene::GetComponent(Entity e) {
+  return GetPool<T>().Get(e);
+}
+
+template <typename T>
+b8 Scene::HasComponent(Entity e) const {
+  if constexpr (std::is_same_v<T, Transform>) {
+    return IsAlive(e);
+  } else {
+    const u32 id = GetComponentTypeId<T>();
+    return id < m_Pools.size() && m_Pools[id] && m_Pools[id]->Has(e);
+  }
+}
+
+template <typename T, typename... Args>
+T &Scene::AddComponent(Entity e, Args &&...args) {
+  static_assert(!std::is_same_v<T, Transform>, "Every node already has a Transform");
+  SN_ASSERT(IsAlive(e), "Entity does not exist");
+  if constexpr (std::is_same_v<T, MeshRef>) MarkRenderChanged(EntityHandle::GetIndex(e));
+  return GetPool<T>().Add(e, std::forward<Args>(args)...);
+}
+
+template <typename T>
+void Scene::RemoveComponent(Entity e) {
+  static_assert(!std::is_same_v<T, Transform>, "Every node has a Transform");
+  if constexpr (std::is_same_v<T, MeshRef>) {
+    if (IsAlive(e)) MarkRenderChanged(EntityHandle::GetIndex(e));
+  }
+  GetPool<T>().Remove(e);
+}
+
+template <typename T>
+ComponentPool<T> &Scene::GetPool() {
+  static_assert(!std::is_same_v<T, Transform>, "Transforms are stored by the hierarchy");
+  const u32 id = GetComponentTypeId<T>();
+  if (id >= m_Pools.size()) m_Pools.resize(id + 1);
+  if (!m_Pools[id]) m_Pools[id] = std::make_unique<ComponentPool<T>>();
+  return static_cast<ComponentPool<T> &>(*m_Pools[id]);
 }
 
 #endif // !SN_SCENE_GRAPH_H
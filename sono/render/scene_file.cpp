@@ -0,0 +1,331 @@
+#include "scene_file.h"
+#include <core/common/logger.h>
+#include <core/resource/mapped_file.h>
+
+#include <fstream>
+
+namespace {
+
+static_assert(EntityHandle::Make(1, 0) == 1, "Loaded node indices are used as entities");
+
+// --------------------------------------------------------------------------------
+u64 AlignUp(u64 offset) { return (offset + SCENE_FILE_ALIGN - 1) & ~(SCENE_FILE_ALIGN - 1); }
+// --------------------------------------------------------------------------------
+b8 Fail(const char *reason) {
+  LOG_ERROR_F("SceneFile: %s", reason);
+  return false;
+}
+
+/// A section with the bytes Write copies into it
+struct PendingSection {
+  SceneFileSection section;
+  const void *data;
+};
+
+} // namespace
+
+// ================================================================================
+// SceneFileView
+// ================================================================================
+
+b8 SceneFileView::Open(const u8 *data, usize size) {
+  *this = SceneFileView();
+  SceneFileHeader header;
+  if (size < sizeof(header)) return Fail("truncated header");
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != SCENE_FILE_MAGIC) return Fail("not a scene file");
+  if (header.version != SCENE_FILE_VERSION) return Fail("unsupported version");
+  if (header.fileSize != size) return Fail("size does not match the header");
+  if (header.sectionCount > (size - sizeof(header)) / sizeof(SceneFileSection)) {
+    return Fail("truncated section table");
+  }
+
+  m_Data = data;
+  m_Sections = reinterpret_cast<const SceneFileSection *>(data + sizeof(header));
+  m_SectionCount = header.sectionCount;
+  m_NodeCount = header.nodeCount;
+  for (u32 s = 0; s < m_SectionCount; s++) {
+    const SceneFileSection &section = m_Sections[s];
+    if (section.type >= SFS_COUNT || section.elementSize == 0) return Fail("bad section");
+    if (section.offset % SCENE_FILE_ALIGN != 0 || section.offset > size
+        || section.count > (size - section.offset) / section.elementSize) {
+      return Fail("section out of the file or misaligned");
+    }
+  }
+
+  // The node arrays, one element per node
+  const u64 n = m_NodeCount;
+  auto nodeArray = [&](u32 type, u32 elementSize, u64 count) -> const void * {
+    const SceneFileSection *section = FindSection(type, 0);
+    if (!section || section->elementSize != elementSize || section->count != count) return nullptr;
+    return data + section->offset;
+  };
+  m_Hierarchy = static_cast<const Hierachy *>(nodeArray(SFS_HIERARCHY, sizeof(Hierachy), n));
+  m_Transforms = static_cast<const SceneFileTransform *>(
+    nodeArray(SFS_TRANSFORMS, sizeof(SceneFileTransform), n)
+  );
+  m_Bounds = static_cast<const BoundingSphere *>(nodeArray(SFS_BOUNDS, sizeof(BoundingSphere), n));
+  m_NameOffsets = static_cast<const u32 *>(nodeArray(SFS_NAME_OFFSETS, sizeof(u32), n + 1));
+  const SceneFileSection *chars = FindSection(SFS_NAME_CHARS, 0);
+  if (!m_Hierarchy || !m_Transforms || !m_Bounds || !m_NameOffsets || !chars
+      || chars->elementSize != 1) {
+    return Fail("missing or mis-sized node array");
+  }
+  m_NameChars = data + chars->offset;
+
+  // Level order with consistent links. Siblings and children come after their node, so every
+  // child list ends, and each node is in its parent's list only.
+  u64 nonRoots = 0;
+  for (u64 i = 0; i < n; i++) {
+    const Hierachy &h = m_Hierarchy[i];
+    if (i > 0 && h.level < m_Hierarchy[i - 1].level) return Fail("nodes not in level order");
+    if (h.parent < 0) {
+      if (h.parent != -1 || h.level != 0) return Fail("bad root");
+    } else {
+      nonRoots++;
+      if ((u64)h.parent >= i || h.level != m_Hierarchy[h.parent].level + 1) {
+        return Fail("parent after its child or at the wrong level");
+      }
+    }
+    if (h.nextSibling != -1 && ((u64)h.nextSibling <= i || (u64)h.nextSibling >= n
+                                || m_Hierarchy[h.nextSibling].parent != h.parent)) {
+      return Fail("bad sibling link");
+    }
+    if (h.firstChild == -1 && h.lastChild == -1) continue;
+    if (h.firstChild < 0 || (u64)h.firstChild <= i || h.lastChild < h.firstChild
+        || (u64)h.lastChild >= n || m_Hierarchy[h.firstChild].parent != (i32)i
+        || m_Hierarchy[h.lastChild].parent != (i32)i
+        || m_Hierarchy[h.lastChild].nextSibling != -1) {
+      return Fail("bad child link");
+    }
+  }
+  u64 reached = 0;
+  for (u64 i = 0; i < n; i++) {
+    for (i32 c = m_Hierarchy[i].firstChild; c != -1; c = m_Hierarchy[c].nextSibling) reached++;
+  }
+  if (reached != nonRoots) return Fail("node missing from its parent's children");
+
+  if (m_NameOffsets[0] != 0 || m_NameOffsets[n] != chars->count) return Fail("bad name offsets");
+  for (u64 i = 0; i < n; i++) {
+    if (m_NameOffsets[i] > m_NameOffsets[i + 1]) return Fail("bad name offsets");
+  }
+
+  // Columns come in node and data pairs, each node at most once per column
+  std::vector<u8> seen;
+  for (u32 s = 0; s < m_SectionCount; s++) {
+    const SceneFileSection &nodes = m_Sections[s];
+    if (nodes.type != SFS_COLUMN_NODES) continue;
+    const SceneFileSection *columnData = FindSection(SFS_COLUMN_DATA, nodes.tag);
+    if (FindSection(SFS_COLUMN_NODES, nodes.tag) != &nodes || nodes.elementSize != sizeof(u32)
+        || !columnData || columnData->count != nodes.count) {
+      return Fail("bad component column");
+    }
+    seen.assign(n, 0);
+    const u32 *indices = reinterpret_cast<const u32 *>(data + nodes.offset);
+    for (u64 k = 0; k < nodes.count; k++) {
+      if (indices[k] >= n || seen[indices[k]]) return Fail("bad component column node");
+      seen[indices[k]] = 1;
+    }
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 SceneFileView::FindColumn(
+  u32 tag, u32 &elementSize, const u32 *&nodes, const void *&data, usize &count
+) const {
+  const SceneFileSection *nodeSection = FindSection(SFS_COLUMN_NODES, tag);
+  const SceneFileSection *dataSection = FindSection(SFS_COLUMN_DATA, tag);
+  if (!nodeSection || !dataSection) return false;
+  elementSize = dataSection->elementSize;
+  nodes = reinterpret_cast<const u32 *>(m_Data + nodeSection->offset);
+  data = m_Data + dataSection->offset;
+  count = (usize)nodeSection->count;
+  return true;
+}
+// --------------------------------------------------------------------------------
+const SceneFileSection *SceneFileView::FindSection(u32 type, u32 tag) const {
+  for (u32 s = 0; s < m_SectionCount; s++) {
+    if (m_Sections[s].type == type && m_Sections[s].tag == tag) return &m_Sections[s];
+  }
+  return nullptr;
+}
+
+// ================================================================================
+// SceneFile
+// ================================================================================
+
+void SceneFile::Write(Scene &scene, std::vector<u8> &out, const std::vector<SceneColumn> &columns) {
+  // Slot k is node k once the slots are in level order without holes
+  if (scene.m_OrderDirty || scene.m_HoleCount > 0) scene.RebuildLevelOrder();
+  const u32 count = (u32)scene.m_NodeCount;
+
+  std::vector<Hierachy> nodes(count);
+  auto slotOf = [&](i32 index) { return index > -1 ? (i32)scene.m_SlotOf[index] : -1; };
+  for (u32 k = 0; k < count; k++) {
+    const Hierachy &h = scene.m_Hierachy[EntityHandle::GetIndex(scene.m_EntityOf[k])];
+    nodes[k] = {
+      .parent = slotOf(h.parent),
+      .firstChild = slotOf(h.firstChild),
+      .lastChild = slotOf(h.lastChild),
+      .nextSibling = slotOf(h.nextSibling),
+      .level = h.level
+    };
+  }
+
+  std::vector<SceneFileTransform> transforms(count);
+  std::vector<u32> nameOffsets(count + 1, 0);
+  std::string nameChars;
+  for (u32 k = 0; k < count; k++) {
+    const Transform &t = scene.m_Transforms[k];
+    const Vec3 &p = t.GetPosition(), &s = t.GetScale();
+    const Vec3 &e = t.GetEuler();
+    const Quaternion &q = t.GetRotation();
+    transforms[k] = {{p.x, p.y, p.z}, {q.w, q.x, q.y, q.z}, {s.x, s.y, s.z}, {e.x, e.y, e.z}};
+    nameChars += scene.m_Names[EntityHandle::GetIndex(scene.m_EntityOf[k])];
+    nameOffsets[k + 1] = (u32)nameChars.size();
+  }
+
+  auto section = [](u32 type, u32 tag, u32 elementSize, u64 count, const void *data) {
+    return PendingSection{{type, tag, elementSize, 0, 0, count}, data};
+  };
+  std::vector<PendingSection> sections = {
+    section(SFS_HIERARCHY, 0, sizeof(Hierachy), count, nodes.data()),
+    section(SFS_TRANSFORMS, 0, sizeof(SceneFileTransform), count, transforms.data()),
+    section(SFS_BOUNDS, 0, sizeof(BoundingSphere), count, scene.m_Bounds.data()),
+    section(SFS_NAME_OFFSETS, 0, sizeof(u32), count + 1, nameOffsets.data()),
+    section(SFS_NAME_CHARS, 0, 1, nameChars.size(), nameChars.data()),
+  };
+
+  // Component columns with the entities as node indices
+  std::vector<std::vector<u32>> columnNodes(columns.size());
+  for (usize c = 0; c < columns.size(); c++) {
+    const void *data = nullptr;
+    const Entity *entities = nullptr;
+    usize size = 0;
+    columns[c].read(scene, data, entities, size);
+    columnNodes[c].resize(size);
+    for (usize i = 0; i < size; i++) {
+      columnNodes[c][i] = scene.m_SlotOf[EntityHandle::GetIndex(entities[i])];
+    }
+    sections.push_back(
+      section(SFS_COLUMN_NODES, columns[c].tag, sizeof(u32), size, columnNodes[c].data())
+    );
+    sections.push_back(
+      section(SFS_COLUMN_DATA, columns[c].tag, columns[c].elementSize, size, data)
+    );
+  }
+
+  u64 offset = sizeof(SceneFileHeader) + sections.size() * sizeof(SceneFileSection);
+  for (PendingSection &pending : sections) {
+    offset = AlignUp(offset);
+    pending.section.offset = offset;
+    offset += pending.section.count * pending.section.elementSize;
+  }
+
+  const SceneFileHeader header = {
+    .magic = SCENE_FILE_MAGIC,
+    .version = SCENE_FILE_VERSION,
+    .reserved = 0,
+    .nodeCount = count,
+    .sectionCount = (u32)sections.size(),
+    .fileSize = offset
+  };
+  out.assign((usize)offset, 0);
+  std::memcpy(out.data(), &header, sizeof(header));
+  u8 *table = out.data() + sizeof(header);
+  for (usize s = 0; s < sections.size(); s++) {
+    const SceneFileSection &described = sections[s].section;
+    std::memcpy(table + s * sizeof(SceneFileSection), &described, sizeof(SceneFileSection));
+    if (described.count == 0) continue;
+    std::memcpy(
+      out.data() + described.offset, sections[s].data, described.count * described.elementSize
+    );
+  }
+}
+// --------------------------------------------------------------------------------
+b8 SceneFile::Save(Scene &scene, const char *path, const std::vector<SceneColumn> &columns) {
+  std::vector<u8> data;
+  Write(scene, data, columns);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(data.data()), (std::streamsize)data.size());
+  if (!file.good()) {
+    LOG_ERROR_F("SceneFile: failed to write %s", path);
+    return false;
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 SceneFile::Load(
+  const SceneFileView &view, Scene &scene, const std::vector<SceneColumn> &columns
+) {
+  SN_ASSERT(scene.m_Hierachy.empty(), "Scenes are loaded into an empty Scene");
+  for (const SceneColumn &column : columns) {
+    u32 elementSize = 0;
+    const u32 *nodes = nullptr;
+    const void *data = nullptr;
+    usize count = 0;
+    if (view.FindColumn(column.tag, elementSize, nodes, data, count)
+        && elementSize != column.elementSize) {
+      LOG_ERROR_F("SceneFile: column %u holds %u byte components", column.tag, elementSize);
+      return false;
+    }
+  }
+
+  // The file is already in level order without holes, entity i sits in slot i
+  const u32 count = view.GetNodeCount();
+  scene.m_Hierachy.assign(view.GetHierarchy(), view.GetHierarchy() + count);
+  scene.m_Generations.assign(count, 0);
+  scene.m_Names.resize(count);
+  scene.m_NodeCount = count;
+  scene.m_Bounds.assign(view.GetBounds(), view.GetBounds() + count);
+  scene.m_Transforms.reserve(count);
+  scene.m_SlotParent.resize(count);
+  scene.m_EntityOf.resize(count);
+  scene.m_SlotOf.resize(count);
+  scene.m_BvhLeaf.assign(count, Bvh::NULL_NODE);
+  scene.m_RenderStamp.assign(count, 0);
+  scene.m_LevelStart.clear();
+  for (u32 i = 0; i < count; i++) {
+    const SceneFileTransform &t = view.GetTransforms()[i];
+    scene.m_Transforms.emplace_back(
+      Vec3(t.position[0], t.position[1], t.position[2]),
+      Quaternion(t.rotation[0], t.rotation[1], t.rotation[2], t.rotation[3]),
+      Vec3(t.scale[0], t.scale[1], t.scale[2]), Vec3(t.euler[0], t.euler[1], t.euler[2])
+    );
+    const std::string_view name = view.GetName(i);
+    if (!name.empty()) scene.m_Names[i].assign(name);
+    scene.m_SlotParent[i] = scene.m_Hierachy[i].parent;
+    scene.m_EntityOf[i] = i;
+    scene.m_SlotOf[i] = i;
+    while ((i32)scene.m_LevelStart.size() <= scene.m_Hierachy[i].level) {
+      scene.m_LevelStart.push_back(i);
+    }
+  }
+  scene.m_LevelStart.push_back(count);
+  scene.m_WorldChanged.assign(count, 0);
+  scene.m_LevelFree.clear();
+  scene.m_HoleCount = 0;
+  scene.m_OrderDirty = false;
+
+  for (const SceneColumn &column : columns) {
+    u32 elementSize = 0;
+    const u32 *nodes = nullptr;
+    const void *data = nullptr;
+    usize size = 0;
+    if (view.FindColumn(column.tag, elementSize, nodes, data, size)) {
+      column.write(scene, reinterpret_cast<const Entity *>(nodes), data, size);
+    }
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 SceneFile::Load(const char *path, Scene &scene, const std::vector<SceneColumn> &columns) {
+  MappedFile file;
+  if (!file.Open(path)) return false;
+  SceneFileView view;
+  if (!view.Open(file.GetData(), file.GetSize())) {
+    LOG_ERROR_F("SceneFile: %s is not a version %d scene file", path, SCENE_FILE_VERSION);
+    return false;
+  }
+  return Load(view, scene, columns);
+}
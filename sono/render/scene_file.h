@@ -0,0 +1,176 @@
+#ifndef SN_SCENE_FILE_H
+#define SN_SCENE_FILE_H
+
+#include <core/common/types.h>
+#include <render/scene.h>
+
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Scene file layout (little endian), nothing in it is a pointer
+//   header   : SceneFileHeader
+//   sections : header.sectionCount * SceneFileSection
+//   data     : one array per section at its offset from the start of the file, aligned to
+//              SCENE_FILE_ALIGN, count elements of elementSize bytes
+//
+// Nodes are stored in level order (the order Scene::UpdateTransforms walks), node i of the file
+// is entity i of the loaded scene.
+//   SFS_HIERARCHY    : Hierachy per node, links are node indices. Parents come before their
+//                      children and each node's children are consecutive.
+//   SFS_TRANSFORMS   : SceneFileTransform per node, local position, rotation and scale, and the
+//                      euler angles the inspector shows (not derived from the rotation on load)
+//   SFS_BOUNDS       : BoundingSphere per node, local space
+//   SFS_NAME_OFFSETS : u32 per node plus one, node i's name is chars [offsets[i], offsets[i + 1])
+//   SFS_NAME_CHARS   : u8, the names back to back without terminators
+//   SFS_COLUMN_NODES : u32 node index per component of the column named by tag
+//   SFS_COLUMN_DATA  : the components of the column named by tag, in the same order
+
+constexpr u32 SCENE_FILE_MAGIC = 0x43534E53; // "SNSC"
+constexpr u16 SCENE_FILE_VERSION = 1;
+constexpr u64 SCENE_FILE_ALIGN = 64;
+
+enum SceneFileSectionType : u32 {
+  SFS_HIERARCHY,
+  SFS_TRANSFORMS,
+  SFS_BOUNDS,
+  SFS_NAME_OFFSETS,
+  SFS_NAME_CHARS,
+  SFS_COLUMN_NODES,
+  SFS_COLUMN_DATA,
+  SFS_COUNT
+};
+
+struct SceneFileHeader {
+  u32 magic;
+  u16 version;
+  u16 reserved;
+  u32 nodeCount;
+  u32 sectionCount;
+  u64 fileSize;
+};
+
+struct SceneFileSection {
+  u32 type;        // SceneFileSectionType
+  u32 tag;         // Column tag, 0 for the other sections
+  u32 elementSize; // Bytes per element
+  u32 reserved;
+  u64 offset; // From the start of the file
+  u64 count;
+};
+
+struct SceneFileTransform {
+  f32 position[3];
+  f32 rotation[4]; // w, x, y, z
+  f32 scale[3];
+  f32 euler[3]; // Degrees
+};
+
+static_assert(sizeof(SceneFileHeader) == 24);
+static_assert(sizeof(SceneFileSection) == 32);
+static_assert(sizeof(SceneFileTransform) == 52);
+static_assert(sizeof(Hierachy) == 20 && std::is_trivially_copyable_v<Hierachy>);
+static_assert(sizeof(BoundingSphere) == 16 && std::is_trivially_copyable_v<BoundingSphere>);
+
+/// @brief A component type stored as a column, by tag. The components are copied as bytes, so
+/// the type must be trivially copyable and hold no pointers that should survive a reload.
+struct SceneColumn {
+  u32 tag;
+  u32 elementSize;
+  /// The packed components of the scene's pool and their entities
+  void (*read)(Scene &scene, const void *&data, const Entity *&entities, usize &count);
+  /// Add count components from data, entities[i] gets the i-th one
+  void (*write)(Scene &scene, const Entity *entities, const void *data, usize count);
+
+  template <typename T>
+  static SceneColumn Of(u32 tag) {
+    static_assert(std::is_trivially_copyable_v<T>, "Columns are stored as raw bytes");
+    SceneColumn column;
+    column.tag = tag;
+    column.elementSize = (u32)sizeof(T);
+    column.read = [](Scene &scene, const void *&data, const Entity *&entities, usize &count) {
+      ComponentPool<T> &pool = scene.GetPool<T>();
+      data = pool.GetData();
+      entities = pool.GetEntities();
+      count = pool.GetSize();
+    };
+    column.write = [](Scene &scene, const Entity *entities, const void *data, usize count) {
+      ComponentPool<T> &pool = scene.GetPool<T>();
+      pool.Reserve(pool.GetSize() + count);
+      for (usize i = 0; i < count; i++) {
+        T value;
+        std::memcpy(&value, static_cast<const u8 *>(data) + i * sizeof(T), sizeof(T));
+        pool.Add(entities[i], value);
+      }
+    };
+    return column;
+  }
+};
+
+/// @brief The arrays of a scene file, used in place (e.g. from a MappedFile) without copying.
+/// Open validates everything the loader relies on, a view that opened can be loaded safely.
+class SceneFileView {
+public:
+  /// @return false, with an error logged, when data is not a valid scene file of this version.
+  /// data must stay alive and unchanged while the view is used.
+  b8 Open(const u8 *data, usize size);
+
+  u32 GetNodeCount() const { return m_NodeCount; }
+
+  const Hierachy *GetHierarchy() const { return m_Hierarchy; }
+  const SceneFileTransform *GetTransforms() const { return m_Transforms; }
+  const BoundingSphere *GetBounds() const { return m_Bounds; }
+
+  std::string_view GetName(u32 node) const {
+    const char *chars = reinterpret_cast<const char *>(m_NameChars);
+    return {chars + m_NameOffsets[node], m_NameOffsets[node + 1] - m_NameOffsets[node]};
+  }
+
+  /// @brief The column named tag, false when the file has none
+  b8 FindColumn(
+    u32 tag, u32 &elementSize, const u32 *&nodes, const void *&data, usize &count
+  ) const;
+
+private:
+  const SceneFileSection *FindSection(u32 type, u32 tag) const;
+
+private:
+  const u8 *m_Data = nullptr;
+  const SceneFileSection *m_Sections = nullptr;
+  u32 m_SectionCount = 0;
+  u32 m_NodeCount = 0;
+
+  const Hierachy *m_Hierarchy = nullptr;
+  const SceneFileTransform *m_Transforms = nullptr;
+  const BoundingSphere *m_Bounds = nullptr;
+  const u32 *m_NameOffsets = nullptr;
+  const u8 *m_NameChars = nullptr;
+};
+
+/// @brief Writes a Scene into the format above and loads it back
+class SceneFile {
+public:
+  /// @brief Serialize scene and the given component columns into out (replaced). Sorts the
+  /// scene into level order first if it isn't, entity handles are not kept: node i of the file
+  /// is the i-th node in level order.
+  static void Write(
+    Scene &scene, std::vector<u8> &out, const std::vector<SceneColumn> &columns = {}
+  );
+
+  /// @return false, with an error logged, when the file can't be written
+  static b8 Save(Scene &scene, const char *path, const std::vector<SceneColumn> &columns = {});
+
+  /// @brief Fill scene, which must be empty, from an opened view. Columns the file lacks are
+  /// skipped. Transforms are dirty, the next UpdateTransforms computes the world matrices.
+  /// @return false, with an error logged and scene untouched, when a column's element size does
+  /// not match the file
+  static b8 Load(
+    const SceneFileView &view, Scene &scene, const std::vector<SceneColumn> &columns = {}
+  );
+
+  /// @brief Map path, validate and Load it
+  static b8 Load(const char *path, Scene &scene, const std::vector<SceneColumn> &columns = {});
+};
+
+#endif // !SN_SCENE_FILE_H
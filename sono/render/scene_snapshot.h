@@ -0,0 +1,29 @@
+#ifndef SN_SCENE_SNAPSHOT_H
+#define SN_SCENE_SNAPSHOT_H
+
+#include <core/common/types.h>
+#include <core/ecs/entity.h>
+#include <core/math/affine3x4.h>
+#include <core/math/bounds.h>
+#include <core/thread/triple_buffer.h>
+#include <render/scene.h>
+#include <vector>
+
+/// @brief What a renderer needs of a Scene as of one Scene::PublishSnapshot, by entity index.
+/// Plain copies, nothing in it points into the scene.
+struct SceneFrame {
+  u64 frame = 0; // Publish count of the scene when written, 0 before the first
+
+  std::vector<Entity> entities;       // NULL_ENTITY for destroyed nodes and free indices
+  std::vector<Affine3x4> world;       // World matrices
+  std::vector<BoundingSphere> bounds; // World space, an infinite radius is never culled
+  std::vector<MeshRef> meshes;        // No mesh for nodes that draw nothing
+
+  usize GetSize() const { return entities.size(); }
+};
+
+/// @brief Frames passed from the thread that updates a scene to the one that renders it, see
+/// TripleBuffer for who may call what. A snapshot is fed by a single Scene.
+using SceneSnapshot = TripleBuffer<SceneFrame>;
+
+#endif // !SN_SCENE_SNAPSHOT_H
@@ -0,0 +1,70 @@
+#include <render/transform_buffer.h>
+#include <render/buffer_base.h>
+#include <render/scene.h>
+#include <core/common/snassert.h>
+#include <algorithm>
+#include <cstring>
+
+TransformUploadStats TransformBuffer::Upload(Scene &scene, Buffer *buffer) {
+  const usize capacity = scene.GetEntityCapacity();
+  const u64 version = scene.GetTransformVersion();
+  SN_ASSERT(buffer && buffer->GetCount() >= capacity, "Transform buffer is too small");
+  SN_ASSERT(buffer->GetStride() == sizeof(Affine3x4), "Transform buffer stride mismatch");
+
+  TransformUploadStats stats{};
+  if (buffer == m_Buffer && version == m_Version) return stats;
+  const b8 full = buffer != m_Buffer || version - m_Version != 1;
+  m_Staging.resize(capacity, Affine3x4::Identity);
+
+  if (full) {
+    scene.GetView<Transform>().Each([&](Entity e, Transform &transform) {
+      m_Staging[EntityHandle::GetIndex(e)] = transform.GetModelMatrix();
+    });
+    buffer->Update(m_Staging.data(), capacity * sizeof(Affine3x4));
+    m_Buffer = buffer;
+    m_Version = version;
+    return {(u32)capacity, 1, true};
+  }
+
+  m_Changed.resize(capacity, 0);
+  usize changedCount = 0;
+  for (const Entity e : scene.GetChangedTransforms()) {
+    if (!scene.IsAlive(e)) continue;
+    const u32 index = EntityHandle::GetIndex(e);
+    m_Staging[index] = scene.GetWorldMatrix(e);
+    m_Changed[index] = 1;
+    changedCount++;
+  }
+  m_Version = version;
+  if (changedCount == 0) return stats;
+
+  // The list is in level order, the flags give the indices sorted. Runs closer than MERGE_GAP
+  // merge, all clear words are skipped eight flags at a time.
+  u8 *changed = m_Changed.data();
+  i64 runBegin = -1, runEnd = -1;
+  auto flush = [&]() {
+    const usize n = (usize)(runEnd - runBegin);
+    buffer->Update(&m_Staging[runBegin], n * sizeof(Affine3x4), runBegin * sizeof(Affine3x4));
+    stats.matrices += (u32)n;
+    stats.updates++;
+  };
+  for (usize k = 0; k < capacity && changedCount > 0; k += 8) {
+    u64 word = 0;
+    if (k + 8 <= capacity) std::memcpy(&word, changed + k, sizeof(word));
+    if (k + 8 <= capacity && word == 0) continue;
+    for (usize j = k; j < std::min(k + 8, capacity); j++) {
+      if (!changed[j]) continue;
+      changed[j] = 0;
+      changedCount--;
+      if (runBegin < 0) {
+        runBegin = (i64)j;
+      } else if ((i64)j - runEnd > (i64)MERGE_GAP) {
+        flush();
+        runBegin = (i64)j;
+      }
+      runEnd = (i64)j + 1;
+    }
+  }
+  flush();
+  return stats;
+}
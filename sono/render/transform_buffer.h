@@ -0,0 +1,47 @@
+#ifndef SN_TRANSFORM_BUFFER_H
+#define SN_TRANSFORM_BUFFER_H
+
+#include <core/common/types.h>
+#include <core/math/affine3x4.h>
+#include <vector>
+
+class Buffer;
+class Scene;
+
+/// @brief What an Upload sent
+struct TransformUploadStats {
+  u32 matrices; // Matrices written, merged gaps included
+  u32 updates;  // Buffer::Update calls
+  b8 full;      // Every matrix was sent
+};
+
+/// @brief Keeps a GPU buffer of world matrices, one Affine3x4 (three vec4 rows) per entity index,
+/// in step with a Scene. Each Upload sends only what the last UpdateTransforms changed, as one
+/// Buffer::Update per run of nearby indices, so a frame where few nodes move costs a few hundred
+/// bytes rather than the whole scene. Falls back to a full upload when it missed an update or is
+/// handed a new buffer.
+class TransformBuffer {
+public:
+  /// Changed indices at most this far apart go out in one update, the matrices between them
+  /// resent, since small writes cost more per call than per byte
+  static constexpr u32 MERGE_GAP = 4;
+
+  /// @brief Bring buffer up to the scene's last UpdateTransforms. The buffer must hold
+  /// scene.GetEntityCapacity() elements of sizeof(Affine3x4). Destroyed nodes' matrices are
+  /// left as they were, nothing draws them.
+  TransformUploadStats Upload(Scene &scene, Buffer *buffer);
+
+  /// @brief The matrices as last sent, by entity index
+  const std::vector<Affine3x4> &GetMatrices() const { return m_Staging; }
+
+  /// @brief Send everything on the next Upload
+  void Invalidate() { m_Buffer = nullptr; }
+
+private:
+  std::vector<Affine3x4> m_Staging;
+  std::vector<u8> m_Changed; // Per entity index, only set during an Upload
+  Buffer *m_Buffer = nullptr; // Buffer of the last upload
+  u64 m_Version = 0;          // Scene::GetTransformVersion() it was synced to
+};
+
+#endif // !SN_TRANSFORM_BUFFER_H
@@ -7,7 +7,7 @@
 // VertexAttribute
 // ================================================================================
 
-inline u32 VertexAttribute::GetTypeCount(VertexAttribType type) {
+u32 VertexAttribute::GetTypeCount(VertexAttribType type) {
   switch (type) {
     case VAT_FLOAT:
     case VAT_INT:
@@ -18,6 +18,7 @@ inline u32 VertexAttribute::GetTypeCount(VertexAttribType type) {
     case VAT_UINT2:
     case VAT_USHORT2_NORM:
     case VAT_HALF2:
+    case VAT_SHORT2_SNORM:
       return 2;
     case VAT_FLOAT3:
     case VAT_INT3:
@@ -30,6 +31,7 @@ inline u32 VertexAttribute::GetTypeCount(VertexAttribType type) {
     case VAT_BYTE4_SNORM:
     case VAT_USHORT4_NORM:
     case VAT_HALF4:
+    case VAT_SHORT4_SNORM:
       return 4;
   }
   SN_ASSERT_F(false, "VertexAttribType of %d is unsupported", type);
@@ -38,7 +40,7 @@ inline u32 VertexAttribute::GetTypeCount(VertexAttribType type) {
 
 // clang-format off
 
-inline u32 VertexAttribute::GetTypeSize(VertexAttribType type) {
+u32 VertexAttribute::GetTypeSize(VertexAttribType type) {
   switch (type) {
   case VAT_FLOAT:        return 4;
   case VAT_FLOAT2:       return 8;
@@ -56,14 +58,31 @@ inline u32 VertexAttribute::GetTypeSize(VertexAttribType type) {
   case VAT_BYTE4_SNORM:  return 4;
   case VAT_USHORT2_NORM: return 4;
   case VAT_USHORT4_NORM: return 8;
-  case VAT_HALF2:        return 2;
-  case VAT_HALF4:        return 4;
+  case VAT_HALF2:        return 4;
+  case VAT_HALF4:        return 8;
+  case VAT_SHORT2_SNORM: return 4;
+  case VAT_SHORT4_SNORM: return 8;
   }
   SN_ASSERT_F(false, "VertexAttribType of %d is unsupported", type);
   return 0;
 }
 
 // clang-format on
+
+b8 VertexAttribute::IsTypeNormalized(VertexAttribType type) {
+  switch (type) {
+    case VAT_BYTE4_NORM:
+    case VAT_BYTE4_SNORM:
+    case VAT_USHORT2_NORM:
+    case VAT_USHORT4_NORM:
+    case VAT_SHORT2_SNORM:
+    case VAT_SHORT4_SNORM:
+      return true;
+    default:
+      return false;
+  }
+}
+
 u32 VertexAttribute::GetSize() const { return VertexAttribute::GetTypeSize(type); }
 
 u32 VertexAttribute::GetElementCount() const { return VertexAttribute::GetTypeCount(type); }
@@ -29,7 +29,9 @@ enum VertexAttribType : u8 {
   VAT_USHORT2_NORM, // 2 ushorts normalized to [0,1]
   VAT_USHORT4_NORM, // 4 ushorts normalized to [0,1]
   VAT_HALF2,        // 2 half floats
-  VAT_HALF4         // 4 half floats
+  VAT_HALF4,        // 4 half floats
+  VAT_SHORT2_SNORM, // 2 shorts normalized to [-1,1], an octahedral normal (Sono::EncodeOctahedral)
+  VAT_SHORT4_SNORM  // 4 shorts normalized to [-1,1]
 };
 
 enum VertexAttributeSemantic : u8 {
@@ -61,7 +63,7 @@ struct VertexAttribute {
     , location(loc)
     , type(t)
     , semantic(sem)
-    , normalized(false) {}
+    , normalized(IsTypeNormalized(t)) {}
 
   u32 GetSize() const;
 
@@ -71,6 +73,9 @@ struct VertexAttribute {
 
   static u32 GetTypeSize(VertexAttribType type);
 
+  /// Whether the shader reads the type as [0,1] / [-1,1] floats, the *_NORM and *_SNORM types
+  static b8 IsTypeNormalized(VertexAttribType type);
+
   b8 operator==(const VertexAttribute &rhs) const;
 
   b8 operator!=(const VertexAttribute &rhs) const { return !(*this == rhs); }
@@ -0,0 +1,166 @@
+#include "vertex_pack.h"
+#include "core/math/batch.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// Vertices converted per pass, the scratch arrays stay in L1
+constexpr usize CHUNK = 256;
+
+enum class Conversion : u8 { COPY, FLOAT, HALF, SNORM8, UNORM8, SNORM16, UNORM16, OCTAHEDRAL };
+
+struct Step {
+  const VertexAttribute *src;
+  const VertexAttribute *dst;
+  Conversion conversion;
+};
+
+// --------------------------------------------------------------------------------
+b8 IsFloatType(VertexAttribType type) {
+  return type == VAT_FLOAT || type == VAT_FLOAT2 || type == VAT_FLOAT3 || type == VAT_FLOAT4;
+}
+// --------------------------------------------------------------------------------
+/// How src turns into dst, false when it can't
+b8 GetConversion(const VertexAttribute &src, const VertexAttribute &dst, Conversion &out) {
+  if (src.type == dst.type) {
+    out = Conversion::COPY;
+    return true;
+  }
+  if (!IsFloatType(src.type)) return false;
+
+  switch (dst.type) {
+    case VAT_FLOAT:
+    case VAT_FLOAT2:
+    case VAT_FLOAT3:
+    case VAT_FLOAT4:
+      out = Conversion::FLOAT;
+      return true;
+    case VAT_HALF2:
+    case VAT_HALF4:
+      out = Conversion::HALF;
+      return true;
+    case VAT_BYTE4_SNORM:
+      out = Conversion::SNORM8;
+      return true;
+    case VAT_BYTE4_NORM:
+      out = Conversion::UNORM8;
+      return true;
+    case VAT_USHORT2_NORM:
+    case VAT_USHORT4_NORM:
+      out = Conversion::UNORM16;
+      return true;
+    case VAT_SHORT2_SNORM:
+      out = dst.semantic == VAS_NORMAL ? Conversion::OCTAHEDRAL : Conversion::SNORM16;
+      return true;
+    case VAT_SHORT4_SNORM:
+      out = Conversion::SNORM16;
+      return true;
+    default:
+      return false;
+  }
+}
+// --------------------------------------------------------------------------------
+/// values[i] into the component at dst + i * stride
+template <typename T>
+void Scatter(const T *values, usize count, u8 *dst, u32 stride) {
+  for (usize i = 0; i < count; i++) std::memcpy(dst + i * stride, &values[i], sizeof(T));
+}
+
+} // namespace
+
+namespace Sono {
+
+// --------------------------------------------------------------------------------
+b8 RepackVertices(
+  const void *src, const VertexLayout &srcLayout, usize count, void *dst,
+  const VertexLayout &dstLayout
+) {
+  std::vector<Step> steps;
+  steps.reserve(dstLayout.GetAttributeCount());
+  for (const VertexAttribute &attr : dstLayout.GetAttributes()) {
+    Step step{srcLayout.Find(attr.semantic), &attr, Conversion::COPY};
+    if (!step.src || !GetConversion(*step.src, attr, step.conversion)) return false;
+    steps.push_back(step);
+  }
+
+  const u32 srcStride = srcLayout.GetStride(), dstStride = dstLayout.GetStride();
+  f32 floats[4][CHUNK];
+  u16 shorts[4][CHUNK];
+  u8 bytes[4][CHUNK];
+
+  for (usize base = 0; base < count; base += CHUNK) {
+    const usize n = count - base < CHUNK ? count - base : CHUNK;
+    const u8 *srcChunk = static_cast<const u8 *>(src) + base * srcStride;
+    u8 *dstChunk = static_cast<u8 *>(dst) + base * dstStride;
+
+    for (const Step &step : steps) {
+      const u8 *in = srcChunk + step.src->offset;
+      u8 *out = dstChunk + step.dst->offset;
+      if (step.conversion == Conversion::COPY) {
+        const u32 size = step.dst->GetSize();
+        for (usize i = 0; i < n; i++) std::memcpy(out + i * dstStride, in + i * srcStride, size);
+        continue;
+      }
+
+      // Gather the float components into one array each, missing ones read as zero
+      const u32 srcCount = step.src->GetElementCount();
+      const u32 dstCount = step.dst->GetElementCount();
+      const u32 gathered = step.conversion == Conversion::OCTAHEDRAL ? 3 : dstCount;
+      for (u32 c = 0; c < gathered; c++) {
+        if (c >= srcCount) {
+          std::memset(floats[c], 0, n * sizeof(f32));
+          continue;
+        }
+        const u8 *component = in + c * sizeof(f32);
+        for (usize i = 0; i < n; i++) {
+          std::memcpy(&floats[c][i], component + i * srcStride, sizeof(f32));
+        }
+      }
+
+      if (step.conversion == Conversion::OCTAHEDRAL) {
+        Sono::EncodeOctahedral(
+          {floats[0], floats[1], floats[2]}, n, reinterpret_cast<i16 *>(shorts[0]),
+          reinterpret_cast<i16 *>(shorts[1])
+        );
+        Scatter(shorts[0], n, out, dstStride);
+        Scatter(shorts[1], n, out + sizeof(u16), dstStride);
+        continue;
+      }
+
+      for (u32 c = 0; c < dstCount; c++) {
+        switch (step.conversion) {
+          case Conversion::FLOAT:
+            Scatter(floats[c], n, out + c * sizeof(f32), dstStride);
+            break;
+          case Conversion::HALF:
+            Sono::FloatsToHalves(floats[c], n, shorts[c]);
+            Scatter(shorts[c], n, out + c * sizeof(u16), dstStride);
+            break;
+          case Conversion::SNORM16:
+            Sono::FloatsToSnorm16(floats[c], n, reinterpret_cast<i16 *>(shorts[c]));
+            Scatter(shorts[c], n, out + c * sizeof(u16), dstStride);
+            break;
+          case Conversion::UNORM16:
+            Sono::FloatsToUnorm16(floats[c], n, shorts[c]);
+            Scatter(shorts[c], n, out + c * sizeof(u16), dstStride);
+            break;
+          case Conversion::SNORM8:
+            Sono::FloatsToSnorm8(floats[c], n, reinterpret_cast<i8 *>(bytes[c]));
+            Scatter(bytes[c], n, out + c, dstStride);
+            break;
+          case Conversion::UNORM8:
+            Sono::FloatsToUnorm8(floats[c], n, bytes[c]);
+            Scatter(bytes[c], n, out + c, dstStride);
+            break;
+          default:
+            break;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace Sono
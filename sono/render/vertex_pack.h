@@ -0,0 +1,27 @@
+#ifndef SN_VERTEX_PACK_H
+#define SN_VERTEX_PACK_H
+
+#include "core/common/types.h"
+#include "vertex_layout.h"
+
+namespace Sono {
+
+/// @brief Rewrite count vertices of srcLayout into dstLayout, e.g. VertexPNT (32 bytes) into
+/// FLOAT3 position, VAT_SHORT2_SNORM normal and VAT_HALF2 texcoord (20 bytes). Attributes are
+/// matched by semantic, every attribute of dstLayout needs one in srcLayout.
+///
+/// Float sources convert to any of the float, half, *_NORM and *_SNORM types through the batch
+/// kernels (batch.h), a VAS_NORMAL stored as VAT_SHORT2_SNORM is octahedral encoded. Components
+/// the source lacks are written as zero, extra ones are dropped. Other source types only copy
+/// into the same type.
+///
+/// @return false, with dst untouched, when an attribute of dstLayout has no source or no
+/// conversion from it. src and dst must not overlap.
+b8 RepackVertices(
+  const void *src, const VertexLayout &srcLayout, usize count, void *dst,
+  const VertexLayout &dstLayout
+);
+
+} // namespace Sono
+
+#endif // !SN_VERTEX_PACK_H
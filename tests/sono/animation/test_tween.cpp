@@ -0,0 +1,148 @@
+#include <doctest.h>
+#include <core/animation/tween_system.h>
+#include <core/math/lerp.h>
+#include <core/math/math.h>
+#include <core/math/vec3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// What a tween should read after elapsed seconds, from the scalar curve
+f32 Expected(f32 from, f32 to, f32 duration, Ease ease, f32 elapsed) {
+  const f32 t = std::min(elapsed / duration, 1.0f);
+  return t >= 1.0f ? to : Sono::Lerp(from, to, Sono::GetEaseFunction(ease)(t));
+}
+
+} // namespace
+
+TEST_SUITE("Animation/Tween") {
+  TEST_CASE("A tween follows its curve and holds the end value once finished") {
+    TweenSystem tweens;
+    const TweenHandle h = tweens.Start(Vec3(0.0f), Vec3(2.0f, -4.0f, 8.0f), 1.0f, Ease::OUT_QUAD);
+    CHECK(tweens.GetValue<Vec3>(h) == Vec3(0.0f));
+    CHECK(tweens.IsRunning(h));
+
+    tweens.Update(0.25f);
+    const f32 e = Sono::EaseOutQuad(0.25f);
+    const Vec3 v = tweens.GetValue<Vec3>(h);
+    CHECK(v.x == doctest::Approx(2.0f * e));
+    CHECK(v.y == doctest::Approx(-4.0f * e));
+    CHECK(v.z == doctest::Approx(8.0f * e));
+    CHECK(tweens.GetElapsed(h) == doctest::Approx(0.25f));
+
+    tweens.Update(0.5f);
+    tweens.Update(0.5f);
+    CHECK_FALSE(tweens.IsRunning(h));
+    CHECK(tweens.GetRunningCount() == 0);
+    CHECK(tweens.GetValue<Vec3>(h) == Vec3(2.0f, -4.0f, 8.0f));
+    tweens.Update(1.0f);
+    CHECK(tweens.GetValue<Vec3>(h) == Vec3(2.0f, -4.0f, 8.0f));
+
+    // Zero duration lands at once
+    const TweenHandle instant = tweens.Start(1.0f, 3.0f, 0.0f);
+    CHECK_FALSE(tweens.IsRunning(instant));
+    CHECK(tweens.GetValue<f32>(instant) == 3.0f);
+  }
+
+  TEST_CASE("Many tweens across pools keep their own values as others finish") {
+    TweenSystem tweens;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<f32> value(-50.0f, 50.0f);
+    std::uniform_real_distribution<f32> duration(0.1f, 2.0f);
+
+    struct Expect {
+      TweenHandle handle;
+      f32 from, to, duration;
+      Ease ease;
+    };
+    std::vector<Expect> expects;
+    for (u32 i = 0; i < 500; i++) {
+      const Ease ease = (Ease)(i % (u32)Ease::COUNT);
+      const Expect x{{}, value(rng), value(rng), duration(rng), ease};
+      expects.push_back(x);
+      expects.back().handle = tweens.Start(x.from, x.to, x.duration, ease);
+    }
+
+    f32 elapsed = 0.0f;
+    for (i32 frame = 0; frame < 150; frame++) {
+      tweens.Update(1.0f / 60.0f);
+      elapsed += 1.0f / 60.0f;
+      usize running = 0;
+      for (const Expect &x : expects) {
+        const f32 expected = Expected(x.from, x.to, x.duration, x.ease, elapsed);
+        CHECK(std::fabs(tweens.GetValue<f32>(x.handle) - expected) <= 1e-3f);
+        running += tweens.IsRunning(x.handle);
+      }
+      CHECK(tweens.GetRunningCount() == running);
+    }
+    CHECK(tweens.GetRunningCount() == 0);
+  }
+
+  TEST_CASE("Released handles go stale and their slots are reused") {
+    TweenSystem tweens;
+    const TweenHandle a = tweens.Start(0.0f, 1.0f, 1.0f);
+    const TweenHandle b = tweens.Start(10.0f, 20.0f, 1.0f);
+    CHECK_FALSE(TweenHandle().IsValid());
+
+    tweens.Release(a);
+    CHECK_FALSE(tweens.IsAlive(a));
+    tweens.Release(a); // stale, nothing happens
+    CHECK(tweens.GetRunningCount() == 1);
+
+    const TweenHandle c = tweens.Start(5.0f, 6.0f, 2.0f);
+    CHECK(c.index == a.index);
+    CHECK(c.generation != a.generation);
+    CHECK_FALSE(tweens.IsAlive(a));
+
+    tweens.Update(0.5f);
+    CHECK(tweens.GetValue<f32>(b) == doctest::Approx(15.0f));
+    CHECK(tweens.GetValue<f32>(c) == doctest::Approx(5.25f));
+  }
+
+  TEST_CASE("Retargeting starts from the current value") {
+    TweenSystem tweens;
+    const TweenHandle h = tweens.Start(0.0f, 10.0f, 2.0f);
+    tweens.Update(1.0f);
+    tweens.Retarget(h, -10.0f);
+    CHECK(tweens.GetValue<f32>(h) == doctest::Approx(5.0f));
+    CHECK(tweens.GetTarget<f32>(h) == -10.0f);
+    tweens.Update(1.0f);
+    CHECK(tweens.GetValue<f32>(h) == doctest::Approx(-2.5f));
+
+    // Shorter duration applies from the next update, the elapsed time is kept
+    tweens.SetDuration(h, 1.5f);
+    tweens.Update(0.25f);
+    CHECK(tweens.GetValue<f32>(h) == doctest::Approx(5.0f - 15.0f * (1.25f / 1.5f)));
+    tweens.SetDuration(h, 0.0f);
+    CHECK(tweens.GetValue<f32>(h) == -10.0f);
+
+    // A finished tween runs again when retargeted
+    tweens.SetDuration(h, 1.0f);
+    tweens.Retarget(h, 0.0f);
+    CHECK(tweens.IsRunning(h));
+    CHECK(tweens.GetValue<f32>(h) == -10.0f);
+  }
+
+  TEST_CASE("Interpolated reads its tween") {
+    TweenSystem tweens;
+    {
+      Interpolated<f32> x(1.0f, Ease::LINEAR, 1.0f);
+      CHECK((f32)x == 1.0f);
+      x = 3.0f;
+      CHECK(tweens.GetRunningCount() == 1);
+      tweens.Update(0.5f);
+      CHECK(x.GetValue() == doctest::Approx(2.0f));
+      CHECK(x.GetElapsedSecs() == doctest::Approx(0.5f));
+
+      x.SetStart(0.0f);
+      tweens.Update(0.25f);
+      CHECK(x.GetValue() == doctest::Approx(0.75f));
+    }
+    CHECK(tweens.GetRunningCount() == 0); // released with the value
+  }
+}
@@ -0,0 +1,77 @@
+#include <doctest.h>
+#include <core/ecs/component_pool.h>
+
+#include <random>
+#include <unordered_map>
+
+TEST_SUITE("Ecs/ComponentPool") {
+  TEST_CASE("Components stay packed as they are added and removed") {
+    ComponentPool<i32> pool;
+    pool.Add(5, 50);
+    pool.Add(2, 20);
+    pool.Add(9, 90);
+    CHECK(pool.GetSize() == 3);
+    CHECK(pool.Has(2));
+    CHECK_FALSE(pool.Has(3));
+    CHECK_FALSE(pool.Has(100));
+    CHECK(pool.Find(3) == nullptr);
+
+    // The last component fills the hole
+    pool.Remove(5);
+    CHECK(pool.GetSize() == 2);
+    CHECK_FALSE(pool.Has(5));
+    CHECK(pool.GetEntities()[0] == 9);
+    CHECK(pool.GetData()[0] == 90);
+    CHECK(pool.GetIndex(9) == 0);
+    CHECK(pool.Get(2) == 20);
+
+    pool.Remove(5); // not there, nothing happens
+    pool.Add(2, 21); // replaces
+    CHECK(pool.GetSize() == 2);
+    CHECK(pool.Get(2) == 21);
+  }
+
+  TEST_CASE("Random adds and removes match a map") {
+    ComponentPool<u64> pool;
+    std::unordered_map<Entity, u64> expected;
+    std::mt19937 rng(11);
+    for (u32 i = 0; i < 20000; i++) {
+      const Entity e = rng() % 512;
+      if (rng() % 3 == 0) {
+        pool.Remove(e);
+        expected.erase(e);
+      } else {
+        pool.Add(e, (u64)i);
+        expected[e] = i;
+      }
+    }
+
+    REQUIRE(pool.GetSize() == expected.size());
+    for (usize i = 0; i < pool.GetSize(); i++) {
+      const Entity e = pool.GetEntities()[i];
+      REQUIRE(expected.count(e) == 1);
+      CHECK(pool.GetData()[i] == expected[e]);
+      CHECK(pool.GetIndex(e) == i);
+    }
+  }
+
+  TEST_CASE("A stale handle does not see the component of its index' new entity") {
+    ComponentPool<i32> pool;
+    const Entity old = EntityHandle::Make(7, 0);
+    const Entity current = EntityHandle::Make(7, 1);
+    pool.Add(old, 1);
+    pool.Remove(old);
+    pool.Add(current, 2);
+    CHECK_FALSE(pool.Has(old));
+    CHECK(pool.Find(old) == nullptr);
+    pool.Remove(old); // stale, nothing happens
+    CHECK(pool.Get(current) == 2);
+  }
+
+  TEST_CASE("Each component type gets its own id") {
+    struct A {};
+    struct B {};
+    CHECK(GetComponentTypeId<A>() == GetComponentTypeId<A>());
+    CHECK(GetComponentTypeId<A>() != GetComponentTypeId<B>());
+  }
+}
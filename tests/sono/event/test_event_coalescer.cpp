@@ -0,0 +1,65 @@
+#include <doctest.h>
+#include <core/event/event_coalescer.h>
+
+static Event MakeEvent(EventType type, EventPayload payload, i64 time = 0) {
+  Event e;
+  e.time = time;
+  e.tick = (u64)time;
+  e.type = type;
+  e.payload = payload;
+  return e;
+}
+
+TEST_SUITE("Event/EventCoalescer") {
+  TEST_CASE("Consecutive mouse moves collapse to the last position") {
+    std::vector<Event> events = {
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{1, 1}, 1),
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{2, 3}, 2),
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{5, 8}, 3),
+    };
+
+    CHECK(EventCoalescer::Coalesce(events) == 2);
+    REQUIRE(events.size() == 1);
+    const auto &mm = std::get<MouseMoveEvent>(events[0].payload);
+    CHECK(mm.xpos == 5);
+    CHECK(mm.ypos == 8);
+    // Keeps the timestamp of the oldest merged input
+    CHECK(events[0].time == 1);
+  }
+
+  TEST_CASE("Moves separated by a button event are not merged") {
+    std::vector<Event> events = {
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{1, 1}),
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{2, 2}),
+      MakeEvent(EventType::MOUSE_BUTTON, MouseButtonEvent{0, true}),
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{3, 3}),
+      MakeEvent(EventType::MOUSE_SCROLL, MouseScrollEvent{0, 1}),
+      MakeEvent(EventType::MOUSE_SCROLL, MouseScrollEvent{0, 2}),
+    };
+
+    CHECK(EventCoalescer::Coalesce(events) == 2);
+    REQUIRE(events.size() == 4);
+    CHECK(std::get<MouseMoveEvent>(events[0].payload).xpos == 2);
+    CHECK(events[1].type == EventType::MOUSE_BUTTON);
+    CHECK(std::get<MouseMoveEvent>(events[2].payload).xpos == 3);
+    CHECK(std::get<MouseScrollEvent>(events[3].payload).scrollY == 2);
+  }
+
+  TEST_CASE("Repeated key states are dropped, transitions are kept") {
+    std::vector<Event> events = {
+      MakeEvent(EventType::KEY, KeyEvent{65, true}),
+      MakeEvent(EventType::KEY, KeyEvent{65, true}),
+      MakeEvent(EventType::KEY, KeyEvent{66, true}),
+      MakeEvent(EventType::KEY, KeyEvent{65, true}),
+      MakeEvent(EventType::KEY, KeyEvent{65, false}),
+      MakeEvent(EventType::KEY, KeyEvent{65, true}),
+    };
+
+    CHECK(EventCoalescer::Coalesce(events) == 2);
+    REQUIRE(events.size() == 4);
+    CHECK(std::get<KeyEvent>(events[0].payload).key == 65);
+    CHECK(std::get<KeyEvent>(events[1].payload).key == 66);
+    CHECK(std::get<KeyEvent>(events[2].payload).down == false);
+    CHECK(std::get<KeyEvent>(events[3].payload).down == true);
+  }
+}
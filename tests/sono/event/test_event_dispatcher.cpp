@@ -0,0 +1,93 @@
+#include <doctest.h>
+#include <core/event/event_dispatcher.h>
+
+#include <utility>
+
+static Event MakeKeyEvent(i32 key) {
+  Event e;
+  e.time = 0;
+  e.tick = 0;
+  e.type = EventType::KEY;
+  e.payload = KeyEvent{key, true};
+  return e;
+}
+
+TEST_SUITE("Event/EventDispatcher") {
+  TEST_CASE("Listeners only receive their payload type") {
+    EventDispatcher::Clear();
+    i32 keys = 0, moves = 0;
+    EventDispatcher::Register<KeyEvent>([&keys](const KeyEvent &e) { keys += e.key; });
+    EventDispatcher::Register<MouseMoveEvent>([&moves](const MouseMoveEvent &) { moves++; });
+
+    EventDispatcher::Dispatch(MakeKeyEvent(3));
+    EventDispatcher::Dispatch(MakeKeyEvent(4));
+
+    CHECK(keys == 7);
+    CHECK(moves == 0);
+    EventDispatcher::Clear();
+  }
+
+  TEST_CASE("Unregister by handle") {
+    EventDispatcher::Clear();
+    i32 a = 0, b = 0;
+    ListenerHandle ha = EventDispatcher::Register<KeyEvent>([&a](const KeyEvent &) { a++; });
+    EventDispatcher::Register<KeyEvent>([&b](const KeyEvent &) { b++; });
+
+    EventDispatcher::Dispatch(MakeKeyEvent(0));
+    EventDispatcher::Unregister(ha);
+    EventDispatcher::Dispatch(MakeKeyEvent(0));
+
+    CHECK(a == 1);
+    CHECK(b == 2);
+    CHECK(EventDispatcher::GetListenerCount(EventPayloadIndex<KeyEvent>) == 1);
+    EventDispatcher::Clear();
+  }
+
+  TEST_CASE("Register and unregister from inside a callback") {
+    EventDispatcher::Clear();
+    i32 calls = 0, late = 0;
+    ListenerHandle self = INVALID_LISTENER;
+    self = EventDispatcher::Register<KeyEvent>([&](const KeyEvent &) {
+      calls++;
+      EventDispatcher::Unregister(self);
+      EventDispatcher::Register<KeyEvent>([&late](const KeyEvent &) { late++; });
+    });
+
+    EventDispatcher::Dispatch(MakeKeyEvent(0));
+    CHECK(calls == 1);
+    CHECK(late == 0);
+
+    EventDispatcher::Dispatch(MakeKeyEvent(0));
+    CHECK(calls == 1);
+    CHECK(late == 1);
+    EventDispatcher::Clear();
+  }
+
+  TEST_CASE("A listener unregistering itself keeps its captures until dispatch returns") {
+    struct Guard {
+      b8 *alive;
+      explicit Guard(b8 *flag) : alive(flag) {}
+      Guard(const Guard &other) : alive(other.alive) {}
+      Guard(Guard &&other) noexcept : alive(std::exchange(other.alive, nullptr)) {}
+      ~Guard() {
+        if (alive) *alive = false;
+      }
+    };
+
+    EventDispatcher::Clear();
+    b8 alive = true, aliveAfterUnregister = false;
+    ListenerHandle self = INVALID_LISTENER;
+    self = EventDispatcher::Register<KeyEvent>(
+      [guard = Guard(&alive), &self, &alive, &aliveAfterUnregister](const KeyEvent &) {
+        EventDispatcher::Unregister(self);
+        aliveAfterUnregister = alive && guard.alive != nullptr;
+      }
+    );
+
+    EventDispatcher::Dispatch(MakeKeyEvent(0));
+    CHECK(aliveAfterUnregister);
+    CHECK_FALSE(alive);
+    CHECK(EventDispatcher::GetListenerCount(EventPayloadIndex<KeyEvent>) == 0);
+    EventDispatcher::Clear();
+  }
+}
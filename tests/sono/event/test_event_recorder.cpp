@@ -0,0 +1,74 @@
+#include <doctest.h>
+#include <core/event/event_recorder.h>
+
+static Event MakeEvent(i64 time, EventType type, EventPayload payload) {
+  Event e;
+  e.time = time;
+  e.tick = 0;
+  e.type = type;
+  e.payload = payload;
+  return e;
+}
+
+TEST_SUITE("Event/EventRecorder") {
+  TEST_CASE("Frames round-trip through the binary encoding") {
+    std::vector<Event> frame0 = {
+      MakeEvent(100, EventType::KEY, KeyEvent{87, true}),
+      MakeEvent(101, EventType::MOUSE_MOVE, MouseMoveEvent{123.25, -4.5}),
+      MakeEvent(99, EventType::MOUSE_BUTTON, MouseButtonEvent{1, true}),
+    };
+    std::vector<Event> frame1 = {};
+    std::vector<Event> frame2 = {
+      MakeEvent(140, EventType::MOUSE_SCROLL, MouseScrollEvent{0.0f, -2.0f}),
+      MakeEvent(141, EventType::WINDOW_RESIZE, WindowResizeEvent{1920, 1080}),
+      MakeEvent(142, EventType::KEY, KeyEvent{87, false}),
+    };
+
+    std::vector<u8> data;
+    i64 prev = 0;
+    prev = EncodeEventFrame(data, frame0.data(), frame0.size(), 0.016f, prev);
+    prev = EncodeEventFrame(data, frame1.data(), frame1.size(), 0.017f, prev);
+    prev = EncodeEventFrame(data, frame2.data(), frame2.size(), 0.018f, prev);
+
+    usize cursor = 0;
+    i64 decodePrev = 0;
+    f32 dt = 0.0f;
+    std::vector<Event> out;
+
+    REQUIRE(DecodeEventFrame(data.data(), data.size(), cursor, out, dt, decodePrev));
+    CHECK(dt == 0.016f);
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].time == 100);
+    CHECK(std::get<KeyEvent>(out[0].payload).key == 87);
+    CHECK(std::get<KeyEvent>(out[0].payload).down);
+    CHECK(std::get<MouseMoveEvent>(out[1].payload).xpos == 123.25);
+    CHECK(std::get<MouseMoveEvent>(out[1].payload).ypos == -4.5);
+    CHECK(out[2].time == 99);
+    CHECK(std::get<MouseButtonEvent>(out[2].payload).button == 1);
+
+    out.clear();
+    REQUIRE(DecodeEventFrame(data.data(), data.size(), cursor, out, dt, decodePrev));
+    CHECK(dt == 0.017f);
+    CHECK(out.empty());
+
+    REQUIRE(DecodeEventFrame(data.data(), data.size(), cursor, out, dt, decodePrev));
+    REQUIRE(out.size() == 3);
+    CHECK(std::get<MouseScrollEvent>(out[0].payload).scrollY == -2.0f);
+    CHECK(std::get<WindowResizeEvent>(out[1].payload).width == 1920);
+    CHECK(std::get<WindowResizeEvent>(out[1].payload).height == 1080);
+    CHECK_FALSE(std::get<KeyEvent>(out[2].payload).down);
+    CHECK(cursor == data.size());
+  }
+
+  TEST_CASE("Truncated data is rejected") {
+    std::vector<Event> frame = {MakeEvent(5, EventType::MOUSE_MOVE, MouseMoveEvent{1.0, 2.0})};
+    std::vector<u8> data;
+    EncodeEventFrame(data, frame.data(), frame.size(), 0.016f, 0);
+
+    usize cursor = 0;
+    i64 prev = 0;
+    f32 dt = 0.0f;
+    std::vector<Event> out;
+    CHECK_FALSE(DecodeEventFrame(data.data(), data.size() - 3, cursor, out, dt, prev));
+  }
+}
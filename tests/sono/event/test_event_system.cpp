@@ -0,0 +1,103 @@
+#include <doctest.h>
+#include <core/event/event_system.h>
+
+#include <thread>
+#include <vector>
+
+TEST_SUITE("Event/EventSystem") {
+  TEST_CASE("Single producer keeps push order") {
+    EventSystem es;
+    constexpr i32 count = 10'000;
+
+    for (i32 i = 0; i < count; i++) {
+      Event e;
+      e.time = i;
+      e.type = EventType::KEY;
+      e.payload = KeyEvent{i, true};
+      es.Push(e);
+    }
+
+    std::vector<Event> events;
+    CHECK(es.Drain(events) == count);
+    REQUIRE(events.size() == count);
+    for (i32 i = 0; i < count; i++) {
+      CHECK(std::get<KeyEvent>(events[i].payload).key == i);
+    }
+    CHECK(events.front().tick <= events.back().tick);
+    CHECK(es.Drain(events) == 0);
+  }
+
+  TEST_CASE("Multiple producers while the main thread drains") {
+    EventSystem es;
+    constexpr i32 producers = 4;
+    constexpr i32 perProducer = 1'000'000;
+
+    std::vector<std::thread> threads;
+    for (i32 p = 0; p < producers; p++) {
+      threads.emplace_back([&es, p]() {
+        Event e;
+        e.time = 0;
+        e.type = EventType::MOUSE_MOVE;
+        for (i32 i = 0; i < perProducer; i++) {
+          e.payload = MouseMoveEvent{(f64)p, (f64)i};
+          es.Push(e);
+        }
+      });
+    }
+
+    // Every event must arrive exactly once and in per-producer order
+    std::vector<i64> nextSeq(producers, 0);
+    std::vector<Event> batch;
+    i64 received = 0;
+    b8 inOrder = true;
+    while (received < (i64)producers * perProducer) {
+      batch.clear();
+      received += es.Drain(batch);
+      for (const Event &e : batch) {
+        const auto &mm = std::get<MouseMoveEvent>(e.payload);
+        i64 &seq = nextSeq[(usize)mm.xpos];
+        inOrder &= (i64)mm.ypos == seq;
+        seq++;
+      }
+    }
+
+    for (auto &t : threads) t.join();
+
+    batch.clear();
+    CHECK(es.Drain(batch) == 0);
+    CHECK(inOrder);
+    for (i32 p = 0; p < producers; p++) {
+      CHECK(nextSeq[p] == perProducer);
+    }
+  }
+
+  TEST_CASE("Chunks grow at the boundary and are recycled after a drain") {
+    EventSystem es;
+    constexpr u32 chunk = EventSystem::CHUNK_SIZE;
+
+    Event e;
+    e.time = 0;
+    e.type = EventType::KEY;
+    e.payload = KeyEvent{0, true};
+
+    CHECK(es.GetChunkCount() == 1);
+    for (u32 i = 0; i < chunk; i++) es.Push(e);
+    CHECK(es.GetChunkCount() == 1);
+
+    // The first event past the boundary links exactly one more chunk
+    es.Push(e);
+    CHECK(es.GetChunkCount() == 2);
+
+    for (u32 i = 0; i < 3 * chunk; i++) es.Push(e);
+    CHECK(es.GetChunkCount() == 5);
+
+    std::vector<Event> events;
+    CHECK(es.Drain(events) == 4 * chunk + 1);
+
+    // The drained chunks are relinked, the same burst again needs no allocation
+    for (u32 i = 0; i < 4 * chunk + 1; i++) es.Push(e);
+    CHECK(es.GetChunkCount() == 5);
+    events.clear();
+    CHECK(es.Drain(events) == 4 * chunk + 1);
+  }
+}
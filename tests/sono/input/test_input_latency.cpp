@@ -0,0 +1,23 @@
+#include <doctest.h>
+#include <core/input/input_latency.h>
+
+TEST_SUITE("Input/InputLatency") {
+  TEST_CASE("Percentiles of a frame's latencies") {
+    std::vector<u64> latencies;
+    for (u64 i = 1; i <= 100; i++) latencies.push_back(i * 1'000'000); // 1..100 ms
+
+    InputLatencyStats stats = InputLatencyTracker::ComputeStats(latencies);
+    CHECK(stats.samples == 100);
+    CHECK(stats.p50Ms == doctest::Approx(50.0));
+    CHECK(stats.p95Ms == doctest::Approx(95.0));
+    CHECK(stats.p99Ms == doctest::Approx(99.0));
+    CHECK(stats.maxMs == doctest::Approx(100.0));
+  }
+
+  TEST_CASE("Empty input keeps zeroed stats") {
+    std::vector<u64> latencies;
+    InputLatencyStats stats = InputLatencyTracker::ComputeStats(latencies);
+    CHECK(stats.samples == 0);
+    CHECK(stats.maxMs == 0.0);
+  }
+}
@@ -0,0 +1,72 @@
+#include <doctest.h>
+#include <core/input/input_system.h>
+#include <core/memory/allocators/arena.h>
+
+static Event MakeEvent(EventType type, EventPayload payload) {
+  Event e;
+  e.type = type;
+  e.payload = payload;
+  return e;
+}
+
+TEST_SUITE("Input/InputSystem") {
+  TEST_CASE("A batch applies the same states as its events one by one") {
+    const Event events[] = {
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{10, 20}),
+      MakeEvent(EventType::KEY, KeyEvent{65, true}),
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{14, 17}),
+      MakeEvent(EventType::MOUSE_BUTTON, MouseButtonEvent{1, true}),
+      MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{20, 25}),
+      MakeEvent(EventType::KEY, KeyEvent{66, true}),
+      MakeEvent(EventType::KEY, KeyEvent{65, false}),
+      MakeEvent(EventType::MOUSE_SCROLL, MouseScrollEvent{0, 3}),
+      MakeEvent(EventType::WINDOW_RESIZE, WindowResizeEvent{800, 600}),
+    };
+    const usize count = sizeof(events) / sizeof(events[0]);
+
+    MouseState single, batched;
+    KeyState singleKeys, batchedKeys;
+    for (const b8 batch : {false, true}) {
+      alignas(16) static u8 backing[4096];
+      ArenaAllocator arena(backing, sizeof(backing));
+      InputSystem input(arena);
+      if (batch) {
+        input.InjectEvents(events, count);
+      } else {
+        for (const Event &e : events) input.InjectEvent(e);
+      }
+      REQUIRE(input.m_MouseState);
+      REQUIRE(input.m_KeyState);
+      (batch ? batched : single) = *input.m_MouseState;
+      (batch ? batchedKeys : singleKeys) = *input.m_KeyState;
+    }
+
+    // The first move only sets the start position
+    CHECK(batched.deltaX == 10.0);
+    CHECK(batched.deltaY == 5.0);
+    CHECK(batched.deltaX == single.deltaX);
+    CHECK(batched.deltaY == single.deltaY);
+    CHECK(batched.scrollY == 3.0f);
+    CHECK(batched.scrollDelta == single.scrollDelta);
+    CHECK(batched.currBtns == single.currBtns);
+    CHECK(batchedKeys.currKeys == singleKeys.currKeys);
+    CHECK(batchedKeys.currKeys.test(66));
+    CHECK_FALSE(batchedKeys.currKeys.test(65));
+  }
+
+  TEST_CASE("Deltas of consecutive batches add up") {
+    alignas(16) static u8 backing[4096];
+    ArenaAllocator arena(backing, sizeof(backing));
+    InputSystem input(arena);
+    const Event first[] = {MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{0, 0})};
+    const Event second[] = {MakeEvent(EventType::MOUSE_MOVE, MouseMoveEvent{3, 4})};
+    input.InjectEvents(first, 1);
+    input.InjectEvents(second, 1);
+    CHECK(input.m_MouseState->deltaX == 3.0);
+    CHECK(input.m_MouseState->deltaY == 4.0);
+    input.EndFrame();
+    CHECK(input.m_MouseState->deltaX == 0.0);
+    input.InjectEvents(nullptr, 0);
+    CHECK(input.m_MouseState->posX == 3.0);
+  }
+}
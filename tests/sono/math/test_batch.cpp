@@ -0,0 +1,221 @@
+#include <doctest.h>
+#include <core/math/batch.h>
+#include <core/math/math.h>
+#include <core/math/quaternion.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Stream {
+  std::vector<f32> x, y, z;
+
+  explicit Stream(usize n)
+    : x(n)
+    , y(n)
+    , z(n) {}
+
+  Sono::Vec3Soa View() { return {x.data(), y.data(), z.data()}; }
+  Sono::ConstVec3Soa View() const { return {x.data(), y.data(), z.data()}; }
+  Vec3 At(usize i) const { return Vec3(x[i], y[i], z[i]); }
+};
+
+// --------------------------------------------------------------------------------
+Stream RandomStream(usize n, u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-10.0f, 10.0f);
+  Stream s(n);
+  for (usize i = 0; i < n; i++) {
+    s.x[i] = dist(rng);
+    s.y[i] = dist(rng);
+    s.z[i] = dist(rng);
+  }
+  return s;
+}
+// --------------------------------------------------------------------------------
+Mat4 TestMatrix() {
+  Mat4 m = Quaternion::FromAxisAngle(Vec3(0.3f, -1.0f, 0.5f), 1.1f).ToMat4();
+  for (i32 i = 0; i < 3; i++) m[0][i] *= 2.0f;
+  m.SetTranslation(4.0f, -3.0f, 12.0f);
+  return m;
+}
+// --------------------------------------------------------------------------------
+b8 Near(f32 a, f32 b) { return std::fabs(a - b) <= 1e-4f * std::max(1.0f, std::fabs(b)); }
+// --------------------------------------------------------------------------------
+b8 Near(const Vec3 &a, const Vec3 &b) { return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z); }
+// --------------------------------------------------------------------------------
+std::vector<Sono::SimdLevel> SupportedLevels() {
+  std::vector<Sono::SimdLevel> levels;
+  for (Sono::SimdLevel level :
+       {Sono::SimdLevel::SCALAR, Sono::SimdLevel::SSE2, Sono::SimdLevel::NEON, Sono::SimdLevel::AVX2,
+        Sono::SimdLevel::AVX512}) {
+    if (Sono::IsSimdLevelSupported(level)) levels.push_back(level);
+  }
+  return levels;
+}
+
+// Counts around every lane width so both the wide loop and the tail run
+constexpr usize kCounts[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 1001};
+
+} // namespace
+
+TEST_SUITE("Math/Batch") {
+  TEST_CASE("Scalar is always supported and a level is active") {
+    CHECK(Sono::IsSimdLevelSupported(Sono::SimdLevel::SCALAR));
+    CHECK(Sono::IsSimdLevelSupported(Sono::GetSimdLevel()));
+  }
+
+  TEST_CASE("Kernels match per vector math on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    const Mat4 m = TestMatrix();
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      for (usize n : kCounts) {
+        CAPTURE(Sono::ToString(level));
+        CAPTURE(n);
+        const Stream a = RandomStream(n, 1);
+        const Stream b = RandomStream(n, 2);
+
+        Stream points(n), dirs(n), cross(n);
+        std::vector<f32> dot(n);
+        Sono::TransformPoints(m, a.View(), n, points.View());
+        Sono::TransformDirections(m, a.View(), n, dirs.View());
+        Sono::Cross(a.View(), b.View(), n, cross.View());
+        Sono::Dot(a.View(), b.View(), n, dot.data());
+
+        Stream normalized = a;
+        Sono::Normalize(normalized.View(), n);
+
+        for (usize i = 0; i < n; i++) {
+          const Vec4 p = Vec4(a.x[i], a.y[i], a.z[i], 1.0f) * m;
+          const Vec4 d = Vec4(a.x[i], a.y[i], a.z[i], 0.0f) * m;
+          CHECK(Near(points.At(i), Vec3(p.x, p.y, p.z)));
+          CHECK(Near(dirs.At(i), Vec3(d.x, d.y, d.z)));
+          CHECK(Near(cross.At(i), a.At(i).Cross(b.At(i))));
+          CHECK(Near(dot[i], a.At(i).Dot(b.At(i))));
+          CHECK(Near(normalized.At(i), a.At(i).Normalized()));
+        }
+      }
+    }
+    Sono::SetSimdLevel(initial);
+  }
+
+  TEST_CASE("Normalize keeps zero vectors and works in place with aliasing outputs") {
+    Stream s(9);
+    s.x[4] = 3.0f;
+    s.y[4] = 4.0f;
+    Sono::Normalize(s.View(), 9);
+    CHECK(s.At(0) == Vec3(0.0f, 0.0f, 0.0f));
+    CHECK(Near(s.At(4), Vec3(0.6f, 0.8f, 0.0f)));
+
+    Stream p = RandomStream(19, 3);
+    const Stream original = p;
+    Sono::TransformPoints(TestMatrix(), p.View(), 19, p.View());
+    const Vec4 expected = Vec4(original.x[18], original.y[18], original.z[18], 1.0f) * TestMatrix();
+    CHECK(Near(p.At(18), Vec3(expected.x, expected.y, expected.z)));
+  }
+
+  TEST_CASE("Transformed boxes enclose the transformed corners") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    const Mat4 m = TestMatrix();
+    const usize n = 37;
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      CAPTURE(Sono::ToString(level));
+
+      const Stream centers = RandomStream(n, 4);
+      Stream extents = RandomStream(n, 5);
+      for (usize i = 0; i < n; i++) {
+        extents.x[i] = std::fabs(extents.x[i]);
+        extents.y[i] = std::fabs(extents.y[i]);
+        extents.z[i] = std::fabs(extents.z[i]);
+      }
+
+      Stream outCenters(n), outExtents(n);
+      Sono::TransformAABBs(
+        m, centers.View(), extents.View(), n, outCenters.View(), outExtents.View()
+      );
+
+      for (usize i = 0; i < n; i++) {
+        Vec3 lo(INFINITY, INFINITY, INFINITY), hi(-INFINITY, -INFINITY, -INFINITY);
+        for (i32 corner = 0; corner < 8; corner++) {
+          const Vec3 c = centers.At(i);
+          const Vec3 e = extents.At(i);
+          const Vec4 p = Vec4(
+                           c.x + (corner & 1 ? e.x : -e.x), c.y + (corner & 2 ? e.y : -e.y),
+                           c.z + (corner & 4 ? e.z : -e.z), 1.0f
+                         ) *
+            m;
+          lo = Vec3(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+          hi = Vec3(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+        }
+        // The box around the transformed corners is exactly the Arvo result
+        CHECK(Near(outCenters.At(i), (lo + hi) * 0.5f));
+        CHECK(Near(outExtents.At(i), (hi - lo) * 0.5f));
+      }
+    }
+    Sono::SetSimdLevel(initial);
+  }
+
+  TEST_CASE("Quaternion to matrix matches ToMat4 on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      for (usize n : kCounts) {
+        CAPTURE(Sono::ToString(level));
+        CAPTURE(n);
+        std::vector<Quaternion> quats(n);
+        for (Quaternion &q : quats) {
+          q = Quaternion(dist(rng), dist(rng), dist(rng), dist(rng));
+          q.Normalize();
+        }
+        std::vector<Mat4> out(n);
+        Sono::QuaternionsToMat4(quats.data(), n, out.data());
+
+        for (usize i = 0; i < n; i++) {
+          const Mat4 expected = quats[i].ToMat4();
+          for (i32 j = 0; j < 16; j++) CHECK(Near(out[i].ValuePtr()[j], expected.ValuePtr()[j]));
+        }
+      }
+    }
+    Sono::SetSimdLevel(initial);
+  }
+
+  TEST_CASE("Batch easing matches the scalar curves on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    constexpr usize kSteps = 1001;
+    std::vector<f32> t(kSteps), out(kSteps);
+    for (usize i = 0; i < kSteps; i++) t[i] = (f32)i / (f32)(kSteps - 1);
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      CAPTURE(Sono::ToString(level));
+      for (u32 e = 0; e < (u32)Ease::COUNT; e++) {
+        CAPTURE(e);
+        const Sono::TransitionFn fn = Sono::GetEaseFunction((Ease)e);
+        Sono::EvaluateEase((Ease)e, t.data(), kSteps, out.data());
+        for (usize i = 0; i < kSteps; i++) CHECK(std::fabs(out[i] - fn(t[i])) <= 2e-6f);
+        CHECK(std::fabs(out.front()) <= 1e-6f);
+        CHECK(std::fabs(out.back() - 1.0f) <= 1e-6f);
+
+        // In place, as the tween system runs it. Every length up to two AVX-512 vectors puts
+        // each of the first elements in the scalar tail at least once, which must round the
+        // same as the full vectors did
+        for (usize n = 1; n <= 33; n++) {
+          CAPTURE(n);
+          std::vector<f32> inPlace(t.begin(), t.begin() + n);
+          Sono::EvaluateEase((Ease)e, inPlace.data(), inPlace.size(), inPlace.data());
+          for (usize i = 0; i < inPlace.size(); i++) CHECK(inPlace[i] == out[i]);
+        }
+      }
+    }
+    Sono::SetSimdLevel(initial);
+  }
+}
@@ -0,0 +1,275 @@
+#include <doctest.h>
+#include <core/math/bvh.h>
+#include <core/math/mat4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+AABB RandomBox(std::mt19937 &rng) {
+  std::uniform_real_distribution<f32> pos(-50.0f, 50.0f);
+  std::uniform_real_distribution<f32> size(0.1f, 3.0f);
+  return AABB::FromCenterExtents(
+    Vec3(pos(rng), pos(rng), pos(rng)), Vec3(size(rng), size(rng), size(rng))
+  );
+}
+// --------------------------------------------------------------------------------
+b8 Encloses(const AABB &outer, const AABB &inner) {
+  return outer.Contains(inner.min) && outer.Contains(inner.max);
+}
+// --------------------------------------------------------------------------------
+/// Links, enclosure and leaf count of the whole tree, each item must be seen once
+void CheckTree(const Bvh &bvh, usize itemCount) {
+  std::vector<u32> seen(itemCount, 0);
+  usize leaves = 0;
+  if (bvh.GetRoot() != Bvh::NULL_NODE) {
+    REQUIRE(bvh.GetParent(bvh.GetRoot()) == Bvh::NULL_NODE);
+    std::vector<i32> stack = {bvh.GetRoot()};
+    while (!stack.empty()) {
+      const i32 i = stack.back();
+      stack.pop_back();
+      const Bvh::Node &node = bvh.GetNode(i);
+      if (node.IsLeaf()) {
+        REQUIRE(node.item < itemCount);
+        seen[node.item]++;
+        leaves++;
+        continue;
+      }
+      for (const i32 child : {node.left, node.right}) {
+        REQUIRE(bvh.GetParent(child) == i);
+        REQUIRE(Encloses(node.box, bvh.GetNode(child).box));
+        stack.push_back(child);
+      }
+    }
+  }
+  CHECK(leaves == bvh.GetLeafCount());
+  for (const u32 s : seen) REQUIRE(s <= 1);
+}
+// --------------------------------------------------------------------------------
+b8 Overlaps(const AABB &a, const AABB &b) {
+  for (i32 i = 0; i < 3; i++) {
+    if (a.min[i] > b.max[i] || a.max[i] < b.min[i]) return false;
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+/// Entry distance of the ray into box, or -1 on a miss
+f32 RayEnter(const Vec3 &origin, const Vec3 &dir, const AABB &box) {
+  f32 tMin = 0.0f, tMax = INFINITY;
+  for (i32 i = 0; i < 3; i++) {
+    if (dir[i] == 0.0f) {
+      if (origin[i] < box.min[i] || origin[i] > box.max[i]) return -1.0f;
+      continue;
+    }
+    f32 t0 = (box.min[i] - origin[i]) / dir[i], t1 = (box.max[i] - origin[i]) / dir[i];
+    if (t0 > t1) std::swap(t0, t1);
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+  }
+  return tMin <= tMax ? tMin : -1.0f;
+}
+// --------------------------------------------------------------------------------
+/// The box, sphere and frustum queries against testing every box
+void CheckQueries(const Bvh &bvh, const std::vector<AABB> &boxes, const std::vector<b8> &live) {
+  std::mt19937 rng(3);
+  std::vector<u32> got, expected;
+  auto collect = [&](u32 item) { got.push_back(item); };
+  auto compare = [&]() {
+    std::sort(got.begin(), got.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(got == expected);
+    got.clear();
+    expected.clear();
+  };
+
+  for (i32 q = 0; q < 50; q++) {
+    AABB query = RandomBox(rng);
+    query = AABB::FromCenterExtents(query.GetCenter(), query.GetExtents() * 4.0f);
+    bvh.QueryAABB(query, collect);
+    for (u32 i = 0; i < boxes.size(); i++) {
+      if (live[i] && Overlaps(boxes[i], query)) expected.push_back(i);
+    }
+    compare();
+
+    const BoundingSphere sphere(query.GetCenter(), query.GetExtents().x * 2.0f);
+    bvh.QuerySphere(sphere, collect);
+    for (u32 i = 0; i < boxes.size(); i++) {
+      const Vec3 c = sphere.center;
+      const Vec3 closest(
+        std::clamp(c.x, boxes[i].min.x, boxes[i].max.x),
+        std::clamp(c.y, boxes[i].min.y, boxes[i].max.y),
+        std::clamp(c.z, boxes[i].min.z, boxes[i].max.z)
+      );
+      if (live[i] && (closest - c).LengthSquared() <= sphere.radius * sphere.radius) {
+        expected.push_back(i);
+      }
+    }
+    compare();
+  }
+
+  for (const Vec3 eye : {Vec3(0.0f, 10.0f, 80.0f), Vec3(-30.0f, 0.0f, 0.0f), Vec3(5.0f)}) {
+    const Mat4 view = Mat4::LookAt(eye, Vec3(0.0f), Vec3::Up);
+    const Mat4 projection = Mat4::Perspective(Sono::Radians(60.0f), 1.5f, 0.5f, 60.0f);
+    const Frustum frustum = Frustum::FromViewProjection(view * projection);
+    bvh.QueryFrustum(frustum, collect);
+    for (u32 i = 0; i < boxes.size(); i++) {
+      if (live[i] && frustum.Intersects(boxes[i])) expected.push_back(i);
+    }
+    CHECK(!expected.empty());
+    compare();
+  }
+}
+// --------------------------------------------------------------------------------
+/// Closest box hit of random rays against testing every box
+void CheckRays(const Bvh &bvh, const std::vector<AABB> &boxes, const std::vector<b8> &live) {
+  std::mt19937 rng(4);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  i32 hits = 0;
+  for (i32 r = 0; r < 200; r++) {
+    const Vec3 origin = Vec3(dist(rng), dist(rng), dist(rng)) * 60.0f;
+    const Vec3 dir = r % 10 == 0 ? Vec3(0.0f, 0.0f, -1.0f) : Vec3(dist(rng), dist(rng), dist(rng));
+
+    f32 expected = INFINITY;
+    for (u32 i = 0; i < boxes.size(); i++) {
+      const f32 t = live[i] ? RayEnter(origin, dir, boxes[i]) : -1.0f;
+      if (t >= 0.0f) expected = std::min(expected, t);
+    }
+
+    f32 best = INFINITY;
+    bvh.Raycast(origin, dir, INFINITY, [&](u32, f32 t) { return best = std::min(best, t); });
+    if (expected == INFINITY) {
+      REQUIRE(best == INFINITY);
+    } else {
+      REQUIRE(best == doctest::Approx(expected));
+    }
+    hits += expected != INFINITY;
+  }
+  CHECK(hits > 20);
+}
+
+} // namespace
+
+TEST_SUITE("Math/Bvh") {
+  TEST_CASE("A built tree encloses every item and answers queries like brute force") {
+    std::mt19937 rng(1);
+    std::vector<AABB> boxes(2000);
+    std::vector<u32> items(boxes.size());
+    for (u32 i = 0; i < boxes.size(); i++) {
+      boxes[i] = RandomBox(rng);
+      items[i] = i;
+    }
+    const std::vector<b8> live(boxes.size(), true);
+
+    Bvh bvh;
+    std::vector<i32> leaves(boxes.size());
+    bvh.Build(items.data(), boxes.data(), boxes.size(), leaves.data());
+    CheckTree(bvh, boxes.size());
+    CHECK(bvh.GetLeafCount() == boxes.size());
+    for (u32 i = 0; i < boxes.size(); i++) REQUIRE(bvh.GetNode(leaves[i]).item == i);
+    // A balanced tree of 2000 leaves is 12 deep, SAH may trade a little depth for less area
+    CHECK(bvh.GetHeight() < 30);
+    CheckQueries(bvh, boxes, live);
+    CheckRays(bvh, boxes, live);
+  }
+
+  TEST_CASE("Empty, single and coincident items") {
+    Bvh bvh;
+    bvh.Build(nullptr, nullptr, 0);
+    i32 calls = 0;
+    bvh.QueryAABB(AABB(Vec3(-1e9f), Vec3(1e9f)), [&](u32) { calls++; });
+    CHECK(calls == 0);
+    CHECK(bvh.GetHeight() == 0);
+
+    const AABB box(Vec3(0.0f), Vec3(1.0f));
+    const u32 one = 7;
+    bvh.Build(&one, &box, 1);
+    bvh.QueryAABB(box, [&](u32 item) { calls += item == 7; });
+    CHECK(calls == 1);
+
+    // Every center in one spot, the split falls back to halves
+    const std::vector<AABB> same(100, box);
+    std::vector<u32> items(same.size());
+    for (u32 i = 0; i < items.size(); i++) items[i] = i;
+    bvh.Build(items.data(), same.data(), same.size());
+    CheckTree(bvh, items.size());
+    CHECK(bvh.GetHeight() == 8);
+  }
+
+  TEST_CASE("Inserts, removes and refits keep the tree exact") {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<f32> step(-2.0f, 2.0f);
+    const u32 count = 1500;
+    std::vector<AABB> boxes(count);
+    std::vector<b8> live(count, false);
+    std::vector<i32> leaves(count, Bvh::NULL_NODE);
+
+    Bvh bvh;
+    for (i32 round = 0; round < 20; round++) {
+      // Some items come and go, some move and are refit at once
+      for (i32 op = 0; op < 200; op++) {
+        const u32 i = rng() % count;
+        if (!live[i]) {
+          boxes[i] = RandomBox(rng);
+          leaves[i] = bvh.Insert(i, boxes[i]);
+          live[i] = true;
+        } else if (rng() % 3 == 0) {
+          bvh.Remove(leaves[i]);
+          live[i] = false;
+        } else {
+          const Vec3 d(step(rng), step(rng), step(rng));
+          boxes[i] = AABB(boxes[i].min + d, boxes[i].max + d);
+          bvh.SetLeafBounds(leaves[i], boxes[i]);
+        }
+      }
+      bvh.Refit();
+      CheckTree(bvh, count);
+      CHECK(bvh.GetLeafCount() == (usize)std::count(live.begin(), live.end(), true));
+    }
+    CheckQueries(bvh, boxes, live);
+    CheckRays(bvh, boxes, live);
+
+    // Removing everything leaves an empty tree that takes new items
+    for (u32 i = 0; i < count; i++) {
+      if (live[i]) bvh.Remove(leaves[i]);
+    }
+    CHECK(bvh.GetRoot() == Bvh::NULL_NODE);
+    leaves[0] = bvh.Insert(0, boxes[0]);
+    CHECK(bvh.GetRoot() == leaves[0]);
+  }
+
+  TEST_CASE("Rotations keep a drifting tree close to a rebuilt one") {
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<f32> dir(-1.0f, 1.0f);
+    const u32 count = 4000;
+    std::vector<AABB> boxes(count);
+    std::vector<Vec3> velocity(count);
+    std::vector<u32> items(count);
+    for (u32 i = 0; i < count; i++) {
+      boxes[i] = RandomBox(rng);
+      velocity[i] = Vec3(dir(rng), dir(rng), dir(rng)) * 0.2f;
+      items[i] = i;
+    }
+    Bvh bvh;
+    std::vector<i32> leaves(count);
+    bvh.Build(items.data(), boxes.data(), count, leaves.data());
+
+    // Every item drifts past its neighbours, the original grouping goes stale
+    for (i32 frame = 0; frame < 60; frame++) {
+      for (u32 i = 0; i < count; i++) {
+        boxes[i] = AABB(boxes[i].min + velocity[i], boxes[i].max + velocity[i]);
+        bvh.SetLeafBounds(leaves[i], boxes[i]);
+      }
+      bvh.Refit();
+    }
+    CheckTree(bvh, count);
+
+    Bvh rebuilt;
+    rebuilt.Build(items.data(), boxes.data(), count);
+    CHECK(bvh.GetSahCost() < 2.5f * rebuilt.GetSahCost());
+    CheckQueries(bvh, boxes, std::vector<b8>(count, true));
+  }
+}
@@ -0,0 +1,172 @@
+#include <doctest.h>
+#include <core/math/batch.h>
+#include <core/math/bounds.h>
+#include <core/math/frustum.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+Mat4 TestViewProjection() {
+  const Mat4 view = Mat4::LookAt(Vec3(2.0f, 3.0f, 10.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3::Up);
+  return view * Mat4::Perspective(Sono::Radians(60.0f), 16.0f / 9.0f, 0.5f, 60.0f);
+}
+// --------------------------------------------------------------------------------
+/// Clip space containment of a point, the ground truth for the extracted planes
+b8 InsideClip(const Mat4 &viewProj, const Vec3 &p) {
+  const Vec4 c = Vec4(p.x, p.y, p.z, 1.0f) * viewProj;
+  return c.x >= -c.w && c.x <= c.w && c.y >= -c.w && c.y <= c.w && c.z >= -c.w && c.z <= c.w;
+}
+// --------------------------------------------------------------------------------
+/// Smallest plane distance pushed out by radius, negative means culled
+f32 Margin(const Frustum &f, const Vec3 &center, const Vec3 &extents, f32 radius) {
+  f32 margin = INFINITY;
+  for (const Plane &p : f.planes) {
+    const f32 boxRadius = std::fabs(p.normal.x) * extents.x + std::fabs(p.normal.y) * extents.y +
+      std::fabs(p.normal.z) * extents.z;
+    margin = std::min(margin, p.Distance(center) + radius + boxRadius);
+  }
+  return margin;
+}
+// --------------------------------------------------------------------------------
+std::vector<Sono::SimdLevel> SupportedLevels() {
+  std::vector<Sono::SimdLevel> levels;
+  for (Sono::SimdLevel level :
+       {Sono::SimdLevel::SCALAR, Sono::SimdLevel::SSE2, Sono::SimdLevel::NEON, Sono::SimdLevel::AVX2,
+        Sono::SimdLevel::AVX512}) {
+    if (Sono::IsSimdLevelSupported(level)) levels.push_back(level);
+  }
+  return levels;
+}
+
+} // namespace
+
+TEST_SUITE("Math/Culling") {
+  TEST_CASE("Extracted planes agree with the clip space test") {
+    const Mat4 viewProj = TestViewProjection();
+    const Frustum frustum = Frustum::FromViewProjection(viewProj);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<f32> dist(-60.0f, 60.0f);
+    for (i32 i = 0; i < 2000; i++) {
+      const Vec3 p(dist(rng), dist(rng), dist(rng));
+      if (std::fabs(Margin(frustum, p, Vec3(0.0f), 0.0f)) < 1e-3f) continue; // on a plane
+      CHECK(frustum.Intersects(BoundingSphere(p, 0.0f)) == InsideClip(viewProj, p));
+    }
+
+    for (const Plane &p : frustum.planes) CHECK(std::fabs(p.normal.Length() - 1.0f) < 1e-5f);
+  }
+
+  TEST_CASE("Spheres and boxes straddling a plane are kept") {
+    const Frustum frustum = Frustum::FromViewProjection(TestViewProjection());
+    const Vec3 eye(2.0f, 3.0f, 10.0f);
+
+    // Behind the camera, then grown until it reaches past the near plane
+    const Vec3 behind = eye + (eye - Vec3(0.0f, 1.0f, 0.0f)).Normalized() * 3.0f;
+    CHECK_FALSE(frustum.Intersects(BoundingSphere(behind, 1.0f)));
+    CHECK(frustum.Intersects(BoundingSphere(behind, 4.0f)));
+    CHECK_FALSE(frustum.Intersects(AABB::FromCenterExtents(behind, Vec3(1.0f))));
+    CHECK(frustum.Intersects(AABB::FromCenterExtents(behind, Vec3(4.0f))));
+    CHECK(frustum.Intersects(AABB(Vec3(-1.0f), Vec3(1.0f))));
+  }
+
+  TEST_CASE("Orthographic projection maps the box to the clip cube") {
+    const Mat4 ortho = Mat4::Ortho(-4.0f, 2.0f, -1.0f, 3.0f, 0.5f, 20.0f);
+    const Vec4 lo = Vec4(-4.0f, -1.0f, -0.5f, 1.0f) * ortho;
+    const Vec4 hi = Vec4(2.0f, 3.0f, -20.0f, 1.0f) * ortho;
+    CHECK(lo.x == doctest::Approx(-1.0f));
+    CHECK(lo.y == doctest::Approx(-1.0f));
+    CHECK(lo.z == doctest::Approx(-1.0f));
+    CHECK(hi.x == doctest::Approx(1.0f));
+    CHECK(hi.y == doctest::Approx(1.0f));
+    CHECK(hi.z == doctest::Approx(1.0f));
+
+    const Frustum frustum = Frustum::FromViewProjection(ortho);
+    CHECK(frustum.Intersects(BoundingSphere(Vec3(1.9f, 2.9f, -19.0f), 0.0f)));
+    CHECK_FALSE(frustum.Intersects(BoundingSphere(Vec3(2.1f, 0.0f, -5.0f), 0.05f)));
+  }
+
+  TEST_CASE("Batch culling matches the per bound test on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    const Frustum frustum = Frustum::FromViewProjection(TestViewProjection());
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<f32> pos(-40.0f, 40.0f);
+    std::uniform_real_distribution<f32> size(0.1f, 3.0f);
+    constexpr usize kCount = 1001;
+    std::vector<f32> cx(kCount), cy(kCount), cz(kCount), ex(kCount), ey(kCount), ez(kCount);
+    std::vector<f32> radii(kCount);
+    for (usize i = 0; i < kCount; i++) {
+      cx[i] = pos(rng);
+      cy[i] = pos(rng);
+      cz[i] = pos(rng);
+      ex[i] = size(rng);
+      ey[i] = size(rng);
+      ez[i] = size(rng);
+      radii[i] = size(rng);
+    }
+    const Sono::ConstVec3Soa centers(cx.data(), cy.data(), cz.data());
+    const Sono::ConstVec3Soa extents(ex.data(), ey.data(), ez.data());
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      for (usize n : {usize(0), usize(1), usize(7), usize(16), usize(33), kCount}) {
+        CAPTURE(Sono::ToString(level));
+        CAPTURE(n);
+        std::vector<u32> spheres(n), boxes(n);
+        spheres.resize(Sono::CullSpheres(frustum, centers, radii.data(), n, spheres.data()));
+        boxes.resize(Sono::CullAABBs(frustum, centers, extents, n, boxes.data()));
+        CHECK(std::is_sorted(spheres.begin(), spheres.end()));
+        CHECK(std::is_sorted(boxes.begin(), boxes.end()));
+
+        for (usize i = 0; i < n; i++) {
+          const Vec3 c(cx[i], cy[i], cz[i]), e(ex[i], ey[i], ez[i]);
+          const b8 sphereKept = std::binary_search(spheres.begin(), spheres.end(), (u32)i);
+          const b8 boxKept = std::binary_search(boxes.begin(), boxes.end(), (u32)i);
+          // Fused and unfused sums may round differently right on a plane
+          if (std::fabs(Margin(frustum, c, Vec3(0.0f), radii[i])) > 1e-4f) {
+            CHECK(sphereKept == frustum.Intersects(BoundingSphere(c, radii[i])));
+          }
+          if (std::fabs(Margin(frustum, c, e, 0.0f)) > 1e-4f) {
+            CHECK(boxKept == frustum.Intersects(AABB::FromCenterExtents(c, e)));
+          }
+        }
+      }
+    }
+    Sono::SetSimdLevel(initial);
+  }
+
+  TEST_CASE("Moved bounds enclose the moved geometry") {
+    const Affine3x4 m = Affine3x4::FromTRS(
+      Vec3(3.0f, -1.0f, 2.0f), Quaternion::FromAxisAngle(Vec3(1.0f, 1.0f, 0.0f), 0.7f),
+      Vec3(2.0f, 0.5f, 1.0f)
+    );
+    const AABB box(Vec3(-1.0f, -2.0f, 0.0f), Vec3(1.0f, 0.5f, 3.0f));
+    const AABB movedBox = box.Transformed(m);
+    const BoundingSphere movedSphere = BoundingSphere::FromAABB(box).Transformed(m);
+
+    for (i32 corner = 0; corner < 8; corner++) {
+      const Vec3 p(
+        corner & 1 ? box.max.x : box.min.x, corner & 2 ? box.max.y : box.min.y,
+        corner & 4 ? box.max.z : box.min.z
+      );
+      const Vec3 q = m.TransformPoint(p);
+      const AABB grown(movedBox.min - Vec3(1e-4f), movedBox.max + Vec3(1e-4f));
+      CHECK(grown.Contains(q));
+      CHECK(q.Dist(movedSphere.center) <= movedSphere.radius + 1e-4f);
+    }
+  }
+
+  TEST_CASE("Unbounded spheres stay unbounded under a zero scale") {
+    const Affine3x4 m =
+      Affine3x4::FromTRS(Vec3(1.0f, 2.0f, 3.0f), Quaternion::Identity(), Vec3(0.0f));
+    const BoundingSphere moved = BoundingSphere(Vec3::Zero, INFINITY).Transformed(m);
+    CHECK(moved.radius == INFINITY);
+    CHECK(moved.center.x == 1.0f);
+    CHECK(BoundingSphere(Vec3::Zero, 2.0f).Transformed(m).radius == 0.0f);
+  }
+}
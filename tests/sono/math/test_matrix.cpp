@@ -1,5 +1,244 @@
 #include <doctest.h>
+#include <core/math/affine3x4.h>
+#include <core/math/mat4.h>
+#include <core/math/quaternion.h>
+#include <core/math/transform.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <cmath>
+#include <random>
+
+// How Sono and glm matrices correspond is explained in sono-bench/src/glm_compat.h
+
+namespace {
+
+// --------------------------------------------------------------------------------
+b8 Near(f32 a, f32 b, f32 eps = 1e-4f) {
+  return std::fabs(a - b) <= eps * std::max(1.0f, std::max(std::fabs(a), std::fabs(b)));
+}
+// --------------------------------------------------------------------------------
+b8 Near(const Mat4 &a, const glm::mat4 &b, f32 eps = 1e-4f) {
+  for (i32 r = 0; r < 4; r++) {
+    for (i32 c = 0; c < 4; c++) {
+      if (!Near(a[r][c], b[r][c], eps)) return false;
+    }
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+b8 Near(const Mat4 &a, const Mat4 &b, f32 eps = 1e-4f) {
+  for (i32 i = 0; i < 16; i++) {
+    if (!Near(a.ValuePtr()[i], b.ValuePtr()[i], eps)) return false;
+  }
+  return true;
+}
+// --------------------------------------------------------------------------------
+glm::mat4 ToGlm(const Mat4 &m) { return glm::make_mat4(m.ValuePtr()); }
+// --------------------------------------------------------------------------------
+Mat4 RandomMat4(std::mt19937 &rng) {
+  std::uniform_real_distribution<f32> dist(-4.0f, 4.0f);
+  Mat4 m;
+  for (i32 i = 0; i < 16; i++) m.ValuePtr()[i] = dist(rng);
+  // Keep the random matrices well conditioned so the inverse tolerance stays meaningful
+  for (i32 i = 0; i < 4; i++) m[i][i] += 10.0f;
+  return m;
+}
+// --------------------------------------------------------------------------------
+Mat4 RandomAffine(std::mt19937 &rng) {
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::uniform_real_distribution<f32> scale(0.25f, 4.0f);
+  Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+  q.Normalize();
+
+  Transform t;
+  t.SetPosition(Vec3(dist(rng) * 50.0f, dist(rng) * 50.0f, dist(rng) * 50.0f));
+  t.SetRotation(q);
+  t.Scale(Vec3(scale(rng), scale(rng), scale(rng)));
+  return t.GetLocalModelMatrix();
+}
+
+// The math types are plain value types that can be built and combined at compile time
+static_assert(std::is_trivially_copyable_v<Vec3> && std::is_trivially_copyable_v<Mat4>);
+static_assert(Vec3(1.0f, 2.0f, 3.0f) + Vec3(1.0f) == Vec3(2.0f, 3.0f, 4.0f));
+static_assert(Vec3(1.0f, 0.0f, 0.0f).Cross(Vec3(0.0f, 1.0f, 0.0f)) == Vec3(0.0f, 0.0f, 1.0f));
+static_assert(Vec4(1.0f, 2.0f, 3.0f, 4.0f).Dot(Vec4(1.0f)) == 10.0f);
+static_assert(Mat4::Identity(0, 0) == 1.0f && Mat4::Identity(3, 2) == 0.0f);
+static_assert((Mat4::Translation(1.0f, 2.0f, 3.0f) * Mat4::Scale(Vec3(2.0f)))(3, 1) == 4.0f);
+static_assert(Mat4::Translation(Vec3(5.0f, 6.0f, 7.0f)).Transposed()(2, 3) == 7.0f);
+static_assert((Mat3::Identity * Vec3(1.0f, 2.0f, 3.0f)) == Vec3(1.0f, 2.0f, 3.0f));
+static_assert(Quaternion::Identity().w == 1.0f);
+static_assert(Affine3x4(Mat4::Translation(4.0f, 5.0f, 6.0f)).GetTranslation().z == 6.0f);
+static_assert(Affine3x4::Identity.TransformPoint(Vec3(1.0f, 2.0f, 3.0f)) == Vec3(1.0f, 2.0f, 3.0f));
+
+} // namespace
 
 TEST_SUITE("Math/Matrix") {
-  TEST_CASE("") {}
+  TEST_CASE("Constant matrices match their runtime products") {
+    constexpr Mat4 compiled = Mat4::Translation(1.0f, 2.0f, 3.0f) * Mat4::Scale(Vec3(2.0f));
+    const Mat4 runtime = Mat4::Translation(1.0f, 2.0f, 3.0f) * Mat4::Scale(Vec3(2.0f));
+    CHECK(Near(compiled, runtime));
+    CHECK(Near(Mat4::Identity * runtime, runtime));
+  }
+
+  TEST_CASE("Multiply matches glm") {
+    std::mt19937 rng(1);
+    for (i32 i = 0; i < 64; i++) {
+      const Mat4 a = RandomMat4(rng);
+      const Mat4 b = RandomMat4(rng);
+
+      INFO("a: " << a.ToString());
+      INFO("b: " << b.ToString());
+      CHECK(Near(a * b, ToGlm(b) * ToGlm(a)));
+    }
+  }
+
+  TEST_CASE("Multiply in place") {
+    std::mt19937 rng(2);
+    const Mat4 a = RandomMat4(rng);
+    const Mat4 b = RandomMat4(rng);
+
+    Mat4 m = a;
+    m *= b;
+    CHECK(Near(m, a * b));
+
+    // The output may alias the right operand too
+    Mat4 r = b;
+    Sono::Mat4Multiply(a.ValuePtr(), r.ValuePtr(), r.ValuePtr());
+    CHECK(Near(r, a * b));
+  }
+
+  TEST_CASE("Transpose matches glm") {
+    std::mt19937 rng(3);
+    const Mat4 m = RandomMat4(rng);
+    CHECK(Near(m.Transposed(), glm::transpose(ToGlm(m)), 0.0f));
+  }
+
+  TEST_CASE("Inverse matches glm") {
+    std::mt19937 rng(4);
+    for (i32 i = 0; i < 64; i++) {
+      const Mat4 m = RandomMat4(rng);
+
+      INFO("m: " << m.ToString());
+      CHECK(Near(m.Inversed(), glm::inverse(ToGlm(m))));
+      CHECK(Near(m * m.Inversed(), Mat4::Identity));
+    }
+  }
+
+  TEST_CASE("Affine inverse matches the general inverse") {
+    std::mt19937 rng(5);
+    for (i32 i = 0; i < 64; i++) {
+      const Mat4 m = RandomAffine(rng);
+
+      INFO("m: " << m.ToString());
+      CHECK(Near(m.InversedAffine(), glm::inverse(ToGlm(m))));
+      CHECK(Near(m.InversedAffine(), m.Inversed()));
+    }
+  }
+
+  TEST_CASE("Singular matrices are reported") {
+    f32 out[16];
+    CHECK_FALSE(Sono::Mat4Inverse(Mat4::Zero.ValuePtr(), out));
+    CHECK_FALSE(Sono::Mat4InverseAffine(Mat4::Zero.ValuePtr(), out));
+    CHECK(Sono::Mat4Inverse(Mat4::Identity.ValuePtr(), out));
+    CHECK(Sono::Mat4InverseAffine(Mat4::Identity.ValuePtr(), out));
+  }
+
+  TEST_CASE("Vector transforms match glm") {
+    std::mt19937 rng(6);
+    const Mat4 m = RandomMat4(rng);
+    const Vec4 v(1.5f, -2.0f, 0.25f, 1.0f);
+    const glm::vec4 gv(v.x, v.y, v.z, v.w);
+
+    const Vec4 rowVec = v * m;
+    const glm::vec4 gRowVec = ToGlm(m) * gv;
+    const Vec4 colVec = m * v;
+    const glm::vec4 gColVec = gv * ToGlm(m);
+
+    for (i32 i = 0; i < 4; i++) {
+      CHECK(Near(rowVec.ValuePtr()[i], gRowVec[i]));
+      CHECK(Near(colVec.ValuePtr()[i], gColVec[i]));
+    }
+  }
+
+  TEST_CASE("Kernels match the scalar reference") {
+    INFO("backend: " << Sono::Simd::BACKEND_NAME);
+
+    std::mt19937 rng(7);
+    for (i32 i = 0; i < 64; i++) {
+      const Mat4 a = RandomMat4(rng);
+      const Mat4 b = RandomAffine(rng);
+      Mat4 simd, scalar;
+
+      Sono::Mat4Multiply(a.ValuePtr(), b.ValuePtr(), simd.ValuePtr());
+      Sono::Scalar::Mat4Multiply(a.ValuePtr(), b.ValuePtr(), scalar.ValuePtr());
+      CHECK(Near(simd, scalar));
+
+      Sono::Mat4Inverse(a.ValuePtr(), simd.ValuePtr());
+      Sono::Scalar::Mat4Inverse(a.ValuePtr(), scalar.ValuePtr());
+      CHECK(Near(simd, scalar));
+
+      Sono::Mat4InverseAffine(b.ValuePtr(), simd.ValuePtr());
+      Sono::Scalar::Mat4InverseAffine(b.ValuePtr(), scalar.ValuePtr());
+      CHECK(Near(simd, scalar));
+
+      Sono::Mat4Transpose(a.ValuePtr(), simd.ValuePtr());
+      Sono::Scalar::Mat4Transpose(a.ValuePtr(), scalar.ValuePtr());
+      CHECK(Near(simd, scalar, 0.0f));
+    }
+  }
+
+  TEST_CASE("Local model matrix matches the composed product") {
+    Transform t;
+    t.SetPosition(Vec3(3.0f, -2.0f, 7.5f));
+    t.SetRotation(Quaternion::FromAxisAngle(Vec3(1.0f, 2.0f, -0.5f), 0.8f));
+    t.Scale(Vec3(2.0f, 0.5f, 3.0f));
+
+    const Mat4 composed =
+      Mat4::Scale(t.GetScale()) * t.GetRotation().ToMat4() * Mat4::Translation(t.GetPosition());
+    CHECK(Near(t.GetLocalModelMatrix(), composed));
+  }
+
+  TEST_CASE("Affine 3x4 matches the equivalent Mat4") {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<f32> dist(-20.0f, 20.0f);
+    for (i32 iter = 0; iter < 200; iter++) {
+      const Mat4 a = RandomAffine(rng);
+      const Mat4 b = RandomAffine(rng);
+      const Affine3x4 aa(a), ab(b);
+      const Vec3 p(dist(rng), dist(rng), dist(rng));
+
+      CHECK(Near(aa.ToMat4(), a, 0.0f));
+      CHECK(Near((aa * ab).ToMat4(), a * b));
+      CHECK(Near(aa.Inversed().ToMat4(), a.InversedAffine(), 1e-3f));
+      CHECK(Near((aa * aa.Inversed()).ToMat4(), Mat4::Identity, 1e-3f));
+
+      const Vec4 expected = Vec4(p.x, p.y, p.z, 1.0f) * a;
+      const Vec3 point = aa.TransformPoint(p);
+      CHECK(Near(point.x, expected.x));
+      CHECK(Near(point.y, expected.y));
+      CHECK(Near(point.z, expected.z));
+
+      Affine3x4 simd, scalar;
+      Sono::Affine3x4Multiply(aa.ValuePtr(), ab.ValuePtr(), simd.ValuePtr());
+      Sono::Scalar::Affine3x4Multiply(aa.ValuePtr(), ab.ValuePtr(), scalar.ValuePtr());
+      CHECK(Near(simd.ToMat4(), scalar.ToMat4()));
+
+      Sono::Affine3x4Inverse(aa.ValuePtr(), simd.ValuePtr());
+      Sono::Scalar::Affine3x4Inverse(aa.ValuePtr(), scalar.ValuePtr());
+      CHECK(Near(simd.ToMat4(), scalar.ToMat4()));
+    }
+  }
+
+  TEST_CASE("Transform model matrix is the local matrix under its parent") {
+    Transform parent(Vec3(1.0f, -4.0f, 2.0f), Vec3(0.4f, -0.2f, 1.1f), Vec3(2.0f));
+    Transform child(Vec3(0.5f, 3.0f, -1.0f), Vec3(-0.3f, 0.9f, 0.1f), Vec3(1.0f, 0.5f, 1.5f));
+    parent.UpdateModelMatrix();
+    CHECK(Near(parent.GetModelMatrix().ToMat4(), parent.GetLocalModelMatrix(), 0.0f));
+
+    child.UpdateModelMatrix(parent.GetModelMatrix());
+    // Row vectors, the child local transform applies first
+    const Mat4 expected = child.GetLocalModelMatrix() * parent.GetLocalModelMatrix();
+    CHECK(Near(child.GetModelMatrix().ToMat4(), expected));
+  }
 }
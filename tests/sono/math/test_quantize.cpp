@@ -0,0 +1,297 @@
+#include <doctest.h>
+#include <core/math/batch.h>
+#include <core/math/quantize.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// Rotation angle between two unit quaternions, through their distance so it stays accurate
+/// for tiny angles
+f64 AngleBetween(const Quaternion &a, const Quaternion &b) {
+  const f64 dot = (f64)a.w * b.w + (f64)a.x * b.x + (f64)a.y * b.y + (f64)a.z * b.z;
+  const f64 s = dot < 0.0 ? -1.0 : 1.0;
+  const f64 dw = a.w - s * b.w, dx = a.x - s * b.x, dy = a.y - s * b.y, dz = a.z - s * b.z;
+  return 4.0 * std::asin(std::min(1.0, std::sqrt(dw * dw + dx * dx + dy * dy + dz * dz) / 2.0));
+}
+// --------------------------------------------------------------------------------
+/// Uniform random rotations, every other one close to (0.5, 0.5, 0.5, 0.5) where the dropped
+/// component is smallest and the error bound is reached
+std::vector<Quaternion> TestQuaternions(usize count) {
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<Quaternion> quats(count);
+  for (usize i = 0; i < count; i++) {
+    Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+    if (i % 2) {
+      q = Quaternion(
+        0.5f + 0.01f * q.w, -0.5f + 0.01f * q.x, 0.5f + 0.01f * q.y, -0.5f + 0.01f * q.z
+      );
+    }
+    q.Normalize();
+    quats[i] = q;
+  }
+  return quats;
+}
+// --------------------------------------------------------------------------------
+std::vector<Sono::SimdLevel> SupportedLevels() {
+  std::vector<Sono::SimdLevel> levels;
+  for (Sono::SimdLevel level :
+       {Sono::SimdLevel::SCALAR, Sono::SimdLevel::SSE2, Sono::SimdLevel::NEON, Sono::SimdLevel::AVX2,
+        Sono::SimdLevel::AVX512}) {
+    if (Sono::IsSimdLevelSupported(level)) levels.push_back(level);
+  }
+  return levels;
+}
+
+} // namespace
+
+TEST_SUITE("Math/Quantize") {
+  TEST_CASE("Half conversions round to nearest even and round trip every half") {
+    CHECK(Sono::FloatToHalf(1.0f) == 0x3c00);
+    CHECK(Sono::FloatToHalf(-2.0f) == 0xc000);
+    CHECK(Sono::FloatToHalf(65504.0f) == 0x7bff);
+    CHECK(Sono::FloatToHalf(65519.0f) == 0x7bff);
+    CHECK(Sono::FloatToHalf(65520.0f) == 0x7c00); // tie, rounds to the even infinity
+    CHECK(Sono::FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001);
+    CHECK(Sono::FloatToHalf(std::ldexp(1.0f, -25)) == 0x0000);     // tie to even zero
+    CHECK(Sono::FloatToHalf(std::ldexp(3.0f, -25)) == 0x0002);     // tie to even two
+    CHECK(Sono::FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00); // tie to even
+    CHECK(Sono::FloatToHalf(-INFINITY) == 0xfc00);
+    CHECK(std::isnan(Sono::HalfToFloat(Sono::FloatToHalf(NAN))));
+    static_assert(Sono::FloatToHalf(0.5f) == 0x3800 && Sono::HalfToFloat(0x3555) < 1.0f / 3.0f);
+
+    for (u32 bits = 0; bits <= 0xffff; bits++) {
+      const f32 f = Sono::HalfToFloat((u16)bits);
+      if ((bits & 0x7c00) == 0x7c00 && (bits & 0x3ff) != 0) {
+        CHECK(std::isnan(f));
+        continue;
+      }
+      REQUIRE(Sono::FloatToHalf(f) == bits);
+    }
+  }
+
+  TEST_CASE("Half conversion error stays inside the stated bounds") {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<f32> exponent(-30.0f, 16.0f);
+    for (i32 i = 0; i < 100000; i++) {
+      const f32 f = std::exp2(exponent(rng)) * (i % 2 ? -1.0f : 1.0f);
+      if (std::fabs(f) > 65504.0f) continue;
+      const f32 h = Half(f);
+      if (std::fabs(f) >= std::ldexp(1.0f, -14)) {
+        CHECK(std::fabs(h - f) <= std::fabs(f) * std::ldexp(1.0f, -11));
+      } else {
+        CHECK(std::fabs(h - f) <= std::ldexp(1.0f, -25));
+      }
+    }
+  }
+
+  TEST_CASE("Packed quaternions stay within the stated angle") {
+    const std::vector<Quaternion> quats = TestQuaternions(20000);
+    for (u32 bits : {9u, 10u, 12u, 15u}) {
+      CAPTURE(bits);
+      const f64 bound = Sono::PackedQuaternionMaxAngle(bits);
+      f64 worst = 0.0;
+      for (const Quaternion &q : quats) {
+        const u64 packed = Sono::PackQuaternion(q, bits);
+        CHECK(packed < (u64)1 << (2 + 3 * bits));
+        CHECK(Sono::PackQuaternion(Quaternion(-q.w, -q.x, -q.y, -q.z), bits) == packed);
+        const Quaternion r = Sono::UnpackQuaternion(packed, bits);
+        CHECK(std::fabs(r.Length() - 1.0f) < 1e-5f);
+        worst = std::max(worst, AngleBetween(q, r));
+      }
+      CHECK(worst <= bound + 1e-6);
+      CHECK(worst > 0.5 * bound); // the bound is tight, not just true
+    }
+    // Zero is not on the grid, it lands half a step off
+    const Quaternion identity = Sono::UnpackQuaternion(Sono::PackQuaternion(Quaternion(), 10), 10);
+    CHECK(AngleBetween(identity, Quaternion()) <= Sono::PackedQuaternionMaxAngle(10));
+  }
+
+  TEST_CASE("Packed positions stay within the stated error") {
+    const AABB cell(Vec3(-100.0f, 0.0f, -8.0f), Vec3(100.0f, 50.0f, 8.0f));
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<f32> t(0.0f, 1.0f);
+    for (u32 bits : {8u, 16u, 21u}) {
+      CAPTURE(bits);
+      const Vec3 maxError = Sono::PackedPositionMaxError(cell, bits);
+      for (i32 i = 0; i < 10000; i++) {
+        const Vec3 p = cell.min + (cell.max - cell.min) * Vec3(t(rng), t(rng), t(rng));
+        const Vec3 r = Sono::UnpackPosition(Sono::PackPosition(p, cell, bits), cell, bits);
+        for (i32 axis = 0; axis < 3; axis++) {
+          CHECK(std::fabs(r[axis] - p[axis]) <= maxError[axis]);
+        }
+      }
+    }
+
+    // Outside points clamp to the cell, a flat axis decodes to its plane
+    const AABB flat(Vec3(0.0f, 2.0f, 0.0f), Vec3(1.0f, 2.0f, 1.0f));
+    const u64 outside = Sono::PackPosition(Vec3(-5.0f, 9.0f, 5.0f), flat, 12);
+    const Vec3 clamped = Sono::UnpackPosition(outside, flat, 12);
+    CHECK(clamped == Vec3(0.0f, 2.0f, 1.0f));
+  }
+
+  TEST_CASE("PackedTransform round trips a transform") {
+    const AABB cell(Vec3(-64.0f), Vec3(64.0f));
+    const Vec3 position(12.5f, -3.25f, 40.0f);
+    const Quaternion rotation = Quaternion::FromAxisAngle(Vec3(0.3f, 1.0f, -0.2f), 2.1f);
+    const Vec3 scale(1.0f, 0.5f, 3.0f);
+
+    const PackedTransform packed = PackedTransform::Pack(position, rotation, scale, cell);
+    const Vec3 maxError = Sono::PackedPositionMaxError(cell, PackedTransform::POSITION_BITS);
+    CHECK(packed.GetPosition(cell).Dist(position) <= maxError.Length());
+    CHECK(
+      AngleBetween(packed.GetRotation(), rotation) <=
+      Sono::PackedQuaternionMaxAngle(PackedTransform::ROTATION_BITS)
+    );
+    CHECK(packed.GetScale() == scale);
+  }
+
+  TEST_CASE("Normalized integers clamp and round to nearest even") {
+    CHECK(Sono::FloatToSnorm8(1.0f) == 127);
+    CHECK(Sono::FloatToSnorm8(-1.0f) == -127);
+    CHECK(Sono::FloatToSnorm8(-3.0f) == -127);
+    CHECK(Sono::FloatToSnorm8(0.5f) == 64); // 63.5 rounds to even
+    CHECK(Sono::FloatToSnorm16(-0.25f) == -8192);
+    CHECK(Sono::FloatToUnorm8(-0.5f) == 0);
+    CHECK(Sono::FloatToUnorm8(2.0f / 255.0f) == 2);
+    CHECK(Sono::FloatToUnorm8(8.0f) == 255);
+    CHECK(Sono::FloatToUnorm16(0.5f) == 32768); // 32767.5 rounds to even
+    CHECK(Sono::FloatToUnorm16(1.0f) == 65535);
+    static_assert(Sono::SnormToFloat(-128, 127.0f) == -1.0f);
+
+    for (i32 c = -127; c <= 127; c++) {
+      REQUIRE(Sono::FloatToSnorm8(Sono::SnormToFloat(c, 127.0f)) == c);
+    }
+    for (i32 c = 0; c <= 255; c++) REQUIRE(Sono::FloatToUnorm8((f32)c / 255.0f) == c);
+  }
+
+  TEST_CASE("Octahedral normals stay within the stated angle") {
+    std::mt19937 rng(5);
+    std::normal_distribution<f32> dist;
+    f64 worst = 0.0;
+    for (i32 i = 0; i < 200000; i++) {
+      Vec3 n(dist(rng), dist(rng), dist(rng));
+      if (i % 4 == 1) n.z *= 1e-3f; // along the fold
+      n.Normalize();
+      i16 code[2];
+      Sono::EncodeOctahedral(n, code);
+      const Vec3 r = Sono::DecodeOctahedral(code);
+      CHECK(std::fabs(r.Length() - 1.0f) < 1e-6f);
+      const f64 d = n.Dist(r);
+      worst = std::max(worst, 2.0 * std::asin(std::min(1.0, d / 2.0)));
+    }
+    CHECK(worst <= Sono::OCTAHEDRAL_MAX_ANGLE);
+    CHECK(worst > 0.5 * Sono::OCTAHEDRAL_MAX_ANGLE);
+
+    // The axes are exact, a zero vector reads as +z
+    for (const Vec3 &axis : {Vec3(1, 0, 0), Vec3(0, -1, 0), Vec3(0, 0, 1), Vec3(0, 0, -1)}) {
+      i16 code[2];
+      Sono::EncodeOctahedral(axis, code);
+      CHECK(Sono::DecodeOctahedral(code) == axis);
+    }
+    i16 zero[2];
+    Sono::EncodeOctahedral(Vec3(0.0f), zero);
+    CHECK(Sono::DecodeOctahedral(zero) == Vec3(0.0f, 0.0f, 1.0f));
+  }
+
+  TEST_CASE("Batch codecs match the scalar ones on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    constexpr usize kCount = 1003;
+    const std::vector<Quaternion> quats = TestQuaternions(kCount);
+
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<f32> pos(-30.0f, 30.0f);
+    std::uniform_real_distribution<f32> exponent(-28.0f, 17.0f);
+    std::vector<f32> px(kCount), py(kCount), pz(kCount), floats(kCount);
+    for (usize i = 0; i < kCount; i++) {
+      px[i] = pos(rng);
+      py[i] = pos(rng);
+      pz[i] = pos(rng);
+      floats[i] = std::exp2(exponent(rng)) * (i % 3 ? 1.0f : -1.0f);
+    }
+    floats[0] = 0.0f;
+    floats[1] = -0.0f;
+    floats[2] = INFINITY;
+    floats[3] = NAN;
+    floats[4] = 65520.0f;
+
+    // Normals and values around the normalized ranges, the halfway points included
+    std::uniform_real_distribution<f32> unit(-1.5f, 1.5f);
+    std::vector<f32> nx(kCount), ny(kCount), nz(kCount), norms(kCount);
+    for (usize i = 0; i < kCount; i++) {
+      Vec3 n(unit(rng), unit(rng), unit(rng));
+      n.Normalize();
+      nx[i] = n.x;
+      ny[i] = n.y;
+      nz[i] = n.z;
+      norms[i] = i % 4 ? unit(rng) : (f32)((i32)i - 500) / 254.0f;
+    }
+    const AABB cell(Vec3(-25.0f), Vec3(25.0f, 10.0f, 25.0f)); // some points fall outside
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      CAPTURE(Sono::ToString(level));
+      for (usize n : {usize(5), usize(16), usize(37), kCount}) {
+        CAPTURE(n);
+        std::vector<u32> packed(n);
+        std::vector<Quaternion> unpacked(n);
+        Sono::PackQuaternions(quats.data(), n, 10, packed.data());
+        Sono::UnpackQuaternions(packed.data(), n, 10, unpacked.data());
+
+        std::vector<u16> qx(n), qy(n), qz(n), halves(n);
+        std::vector<f32> rx(n), ry(n), rz(n), back(n);
+        const Sono::Vec3U16Soa quantized{qx.data(), qy.data(), qz.data()};
+        Sono::QuantizePositions(cell, {px.data(), py.data(), pz.data()}, n, 16, quantized);
+        Sono::DequantizePositions(cell, quantized, n, 16, {rx.data(), ry.data(), rz.data()});
+        Sono::FloatsToHalves(floats.data(), n, halves.data());
+        Sono::HalvesToFloats(halves.data(), n, back.data());
+
+        std::vector<i8> snorm8(n);
+        std::vector<i16> snorm16(n), octX(n), octY(n);
+        std::vector<u8> unorm8(n);
+        std::vector<u16> unorm16(n);
+        Sono::FloatsToSnorm8(norms.data(), n, snorm8.data());
+        Sono::FloatsToSnorm16(norms.data(), n, snorm16.data());
+        Sono::FloatsToUnorm8(norms.data(), n, unorm8.data());
+        Sono::FloatsToUnorm16(norms.data(), n, unorm16.data());
+        Sono::EncodeOctahedral({nx.data(), ny.data(), nz.data()}, n, octX.data(), octY.data());
+
+        for (usize i = 0; i < n; i++) {
+          CHECK(packed[i] == Sono::PackQuaternion(quats[i], 10));
+          const Quaternion r = Sono::UnpackQuaternion(packed[i], 10);
+          CHECK(std::fabs(unpacked[i].w - r.w) < 1e-6f);
+          CHECK(std::fabs(unpacked[i].x - r.x) < 1e-6f);
+          CHECK(std::fabs(unpacked[i].y - r.y) < 1e-6f);
+          CHECK(std::fabs(unpacked[i].z - r.z) < 1e-6f);
+
+          const Vec3 p(px[i], py[i], pz[i]);
+          const u64 fields = Sono::PackPosition(p, cell, 16);
+          CHECK(qx[i] == (u16)fields);
+          CHECK(qy[i] == (u16)(fields >> 16));
+          CHECK(qz[i] == (u16)(fields >> 32));
+          CHECK(Vec3(rx[i], ry[i], rz[i]).Dist(Sono::UnpackPosition(fields, cell, 16)) < 1e-5f);
+
+          CHECK(halves[i] == Sono::FloatToHalf(floats[i]));
+          const f32 expected = Sono::HalfToFloat(halves[i]);
+          CHECK(std::memcmp(&back[i], &expected, sizeof(f32)) == 0);
+
+          CHECK(snorm8[i] == Sono::FloatToSnorm8(norms[i]));
+          CHECK(snorm16[i] == Sono::FloatToSnorm16(norms[i]));
+          CHECK(unorm8[i] == Sono::FloatToUnorm8(norms[i]));
+          CHECK(unorm16[i] == Sono::FloatToUnorm16(norms[i]));
+          i16 oct[2];
+          Sono::EncodeOctahedral(Vec3(nx[i], ny[i], nz[i]), oct);
+          CHECK(octX[i] == oct[0]);
+          CHECK(octY[i] == oct[1]);
+        }
+      }
+    }
+    Sono::SetSimdLevel(initial);
+  }
+}
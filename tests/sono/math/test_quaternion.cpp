@@ -164,4 +164,41 @@ TEST_SUITE("Math/Quaternion") {
     CHECK(ApproxEqual(myB, glmB));
     CHECK(ApproxEqual(myC, glmC));
   }
+
+  TEST_CASE("Vector rotation matches glm and the sandwich product") {
+    const Quaternion q = Quaternion::FromAxisAngle(Vec3(0.3f, -1.0f, 0.6f), 2.1f);
+    const glm::quat glmQ(q.w, q.x, q.y, q.z);
+
+    for (const Vec3 &v : {Vec3(1.0f, 0.0f, 0.0f), Vec3(-3.0f, 4.5f, 2.0f), Vec3(0.0f)}) {
+      const Vec3 rotated = q * v;
+      const glm::vec3 expected = glmQ * glm::vec3(v.x, v.y, v.z);
+      const Quaternion sandwich = q * Quaternion(0.0f, v.x, v.y, v.z) * q.Inversed();
+
+      INFO("sono: " << rotated.ToString());
+      CHECK(ApproxEqual(rotated.x, expected.x));
+      CHECK(ApproxEqual(rotated.y, expected.y));
+      CHECK(ApproxEqual(rotated.z, expected.z));
+      CHECK(rotated.x == doctest::Approx(sandwich.x).epsilon(1e-5));
+      CHECK(rotated.y == doctest::Approx(sandwich.y).epsilon(1e-5));
+      CHECK(rotated.z == doctest::Approx(sandwich.z).epsilon(1e-5));
+    }
+  }
+
+  TEST_CASE("Basis matches the rotated axes and the matrix rows") {
+    const Quaternion q = Quaternion::FromEuler(Vec3(0.4f, -1.2f, 2.5f));
+    const Quaternion::Basis basis = q.ToBasis();
+    const Mat4 m = q.ToMat4();
+
+    const Vec3 right = q * Vec3(1.0f, 0.0f, 0.0f);
+    const Vec3 up = q * Vec3(0.0f, 1.0f, 0.0f);
+    const Vec3 forward = q * Vec3(0.0f, 0.0f, -1.0f);
+    for (i32 i = 0; i < 3; i++) {
+      CHECK(basis.right[i] == doctest::Approx(right[i]).epsilon(1e-5));
+      CHECK(basis.up[i] == doctest::Approx(up[i]).epsilon(1e-5));
+      CHECK(basis.forward[i] == doctest::Approx(forward[i]).epsilon(1e-5));
+      CHECK(basis.right[i] == m[0][i]);
+      CHECK(basis.up[i] == m[1][i]);
+      CHECK(basis.forward[i] == -m[2][i]);
+    }
+  }
 }
@@ -0,0 +1,218 @@
+#include <doctest.h>
+#include <core/math/batch.h>
+#include <core/math/triangle_bvh.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Soup {
+  std::vector<Vec3> positions;
+  std::vector<u32> indices;
+};
+
+// --------------------------------------------------------------------------------
+/// count small triangles scattered through a 100 unit cube, every fifth one sharing corners
+/// with the previous so the index buffer is not trivial
+Soup RandomSoup(usize count, u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> pos(-50.0f, 50.0f), offset(-2.0f, 2.0f);
+  Soup soup;
+  for (usize i = 0; i < count; i++) {
+    const u32 base = (u32)soup.positions.size();
+    if (i % 5 == 4) {
+      soup.positions.push_back(soup.positions.back() + Vec3(offset(rng), offset(rng), 0.0f));
+      soup.indices.insert(soup.indices.end(), {base - 1, base - 2, base});
+      continue;
+    }
+    const Vec3 c(pos(rng), pos(rng), pos(rng));
+    for (i32 k = 0; k < 3; k++) {
+      soup.positions.push_back(c + Vec3(offset(rng), offset(rng), offset(rng)));
+    }
+    soup.indices.insert(soup.indices.end(), {base, base + 1, base + 2});
+  }
+  return soup;
+}
+// --------------------------------------------------------------------------------
+/// Moller-Trumbore in doubles, t of the hit or -1
+f64 ReferenceHit(const Vec3 &o, const Vec3 &d, const Vec3 &a, const Vec3 &b, const Vec3 &c) {
+  const f64 e1[3] = {(f64)b.x - a.x, (f64)b.y - a.y, (f64)b.z - a.z};
+  const f64 e2[3] = {(f64)c.x - a.x, (f64)c.y - a.y, (f64)c.z - a.z};
+  const f64 s[3] = {(f64)o.x - a.x, (f64)o.y - a.y, (f64)o.z - a.z};
+  const f64 p[3] = {
+    d.y * e2[2] - d.z * e2[1], d.z * e2[0] - d.x * e2[2], d.x * e2[1] - d.y * e2[0]
+  };
+  const f64 det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+  if (det == 0.0) return -1.0;
+  const f64 u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+  const f64 q[3] = {
+    s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]
+  };
+  const f64 v = (d.x * q[0] + d.y * q[1] + d.z * q[2]) / det;
+  const f64 t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+  return u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t >= 0.0 ? t : -1.0;
+}
+// --------------------------------------------------------------------------------
+/// Closest hit of every triangle, t and triangle, or t = infinity
+RayHit BruteForce(const Soup &soup, const Vec3 &o, const Vec3 &d) {
+  RayHit best = {INFINITY, TriangleBvh::NO_TRIANGLE};
+  for (u32 i = 0; i < soup.indices.size() / 3; i++) {
+    const f64 t = ReferenceHit(
+      o, d, soup.positions[soup.indices[3 * i]], soup.positions[soup.indices[3 * i + 1]],
+      soup.positions[soup.indices[3 * i + 2]]
+    );
+    if (t >= 0.0 && t < best.t) best = {(f32)t, i};
+  }
+  return best;
+}
+// --------------------------------------------------------------------------------
+std::vector<Sono::SimdLevel> SupportedLevels() {
+  std::vector<Sono::SimdLevel> levels;
+  for (Sono::SimdLevel level :
+       {Sono::SimdLevel::SCALAR, Sono::SimdLevel::SSE2, Sono::SimdLevel::NEON, Sono::SimdLevel::AVX2,
+        Sono::SimdLevel::AVX512}) {
+    if (Sono::IsSimdLevelSupported(level)) levels.push_back(level);
+  }
+  return levels;
+}
+
+} // namespace
+
+TEST_SUITE("Math/TriangleBvh") {
+  TEST_CASE("The batch ray test finds the closest triangle on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    // A stack of unit triangles facing +z at z = 0, -1, ..., each shifted a little
+    constexpr usize kCount = 37;
+    std::vector<f32> v0[3], e1[3], e2[3];
+    for (auto *streams : {v0, e1, e2}) {
+      for (i32 axis = 0; axis < 3; axis++) streams[axis].resize(kCount);
+    }
+    for (usize i = 0; i < kCount; i++) {
+      v0[0][i] = -0.2f + 0.005f * (f32)i;
+      v0[1][i] = -0.2f;
+      v0[2][i] = -(f32)i;
+      e1[0][i] = 1.0f;
+      e2[1][i] = 1.0f;
+    }
+    auto view = [](std::vector<f32> *s) {
+      return Sono::ConstVec3Soa(s[0].data(), s[1].data(), s[2].data());
+    };
+
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      CAPTURE(Sono::ToString(level));
+      // Every count, so each level's wide loop and tail both find the first one
+      for (usize count = 1; count <= kCount; count++) {
+        u32 index = 99;
+        const f32 t = Sono::IntersectRayTriangles(
+          Vec3(0.0f, 0.0f, 5.0f), Vec3(0.0f, 0.0f, -1.0f), view(v0), view(e1), view(e2), count,
+          INFINITY, &index
+        );
+        REQUIRE(index == 0);
+        REQUIRE(t == doctest::Approx(5.0f));
+      }
+
+      // From below, the bottom one is the closest
+      u32 index = 99;
+      f32 t = Sono::IntersectRayTriangles(
+        Vec3(0.0f, 0.0f, -100.0f), Vec3(0.0f, 0.0f, 1.0f), view(v0), view(e1), view(e2), kCount,
+        INFINITY, &index
+      );
+      CHECK(index == kCount - 1);
+      CHECK(t == doctest::Approx(100.0f - (f32)(kCount - 1)));
+
+      // maxT bounds the search, a miss leaves the index alone
+      index = 99;
+      t = Sono::IntersectRayTriangles(
+        Vec3(0.0f, 0.0f, 5.0f), Vec3(0.0f, 0.0f, -1.0f), view(v0), view(e1), view(e2), kCount,
+        4.0f, &index
+      );
+      CHECK(t == 4.0f);
+      CHECK(index == 99);
+      // Outside the triangles, and parallel to them
+      t = Sono::IntersectRayTriangles(
+        Vec3(3.0f, 3.0f, 5.0f), Vec3(0.0f, 0.0f, -1.0f), view(v0), view(e1), view(e2), kCount,
+        INFINITY, &index
+      );
+      CHECK(t == INFINITY);
+      t = Sono::IntersectRayTriangles(
+        Vec3(0.1f, 0.1f, 0.0f), Vec3(1.0f, 0.0f, 0.0f), view(v0), view(e1), view(e2), kCount,
+        INFINITY, &index
+      );
+      CHECK(t == INFINITY);
+      CHECK(index == 99);
+    }
+    Sono::SetSimdLevel(initial);
+  }
+
+  TEST_CASE("Ray casts match testing every triangle on every supported level") {
+    const Sono::SimdLevel initial = Sono::GetSimdLevel();
+    const Soup soup = RandomSoup(5000, 1);
+    TriangleBvh bvh;
+    bvh.Build(
+      soup.positions.data(), soup.positions.size(), soup.indices.data(), soup.indices.size()
+    );
+    CHECK(bvh.GetTriangleCount() == 5000);
+    // Leaves are filled to a good part, not one triangle each
+    CHECK(bvh.GetPacketCount() < 5000 / 4);
+    CHECK(bvh.GetNodeCount() == 2 * bvh.GetPacketCount() - 1);
+    for (u32 p = 0; p < bvh.GetPacketCount(); p++) {
+      for (const u32 triangle : bvh.GetPacket(p).triangles) {
+        REQUIRE((triangle < 5000 || triangle == TriangleBvh::NO_TRIANGLE));
+      }
+    }
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    for (Sono::SimdLevel level : SupportedLevels()) {
+      REQUIRE(Sono::SetSimdLevel(level));
+      CAPTURE(Sono::ToString(level));
+      i32 hits = 0;
+      for (i32 r = 0; r < 300; r++) {
+        const Vec3 origin = Vec3(dist(rng), dist(rng), dist(rng)) * 70.0f;
+        // Aim near the center so most rays cross the soup, some along an axis
+        const Vec3 target = Vec3(dist(rng), dist(rng), dist(rng)) * 40.0f;
+        const Vec3 dir = r % 10 == 0 ? Vec3(0.0f, 0.0f, -1.0f) : target - origin;
+        const RayHit expected = BruteForce(soup, origin, dir);
+
+        RayHit hit = {-1.0f, 0};
+        const b8 found = bvh.Raycast(Ray(origin, dir), INFINITY, hit);
+        REQUIRE(found == (expected.t != INFINITY));
+        if (!found) continue;
+        // Near equal hits may swap under rounding, the distance must agree either way
+        REQUIRE(hit.t == doctest::Approx(expected.t).epsilon(1e-4));
+        hits++;
+      }
+      CHECK(hits > 100);
+    }
+    Sono::SetSimdLevel(initial);
+  }
+
+  TEST_CASE("Empty, 16 bit and out of range index buffers") {
+    TriangleBvh bvh;
+    RayHit hit = {-1.0f, 0};
+    bvh.Build(nullptr, 0, (const u32 *)nullptr, 0);
+    CHECK(!bvh.Raycast(Ray(Vec3(0.0f), Vec3(1.0f, 0.0f, 0.0f)), INFINITY, hit));
+    CHECK(bvh.GetHeight() == 0);
+
+    // A quad of two triangles in the z = 2 plane, a third one names a missing vertex
+    const Vec3 quad[4] = {
+      Vec3(-1.0f, -1.0f, 2.0f), Vec3(1.0f, -1.0f, 2.0f), Vec3(1.0f, 1.0f, 2.0f),
+      Vec3(-1.0f, 1.0f, 2.0f)
+    };
+    const u16 indices[9] = {0, 1, 2, 2, 3, 0, 0, 1, 9};
+    bvh.Build(quad, 4, indices, 9);
+    CHECK(bvh.GetTriangleCount() == 2);
+    CHECK(bvh.GetHeight() == 1);
+    REQUIRE(bvh.Raycast(Ray(Vec3(-0.5f, 0.5f, 0.0f), Vec3(0.0f, 0.0f, 1.0f)), INFINITY, hit));
+    CHECK(hit.t == doctest::Approx(2.0f));
+    CHECK(hit.triangle == 1);
+    // Either side hits, maxT is exclusive
+    REQUIRE(bvh.Raycast(Ray(Vec3(0.5f, -0.5f, 5.0f), Vec3(0.0f, 0.0f, -2.0f)), INFINITY, hit));
+    CHECK(hit.t == doctest::Approx(1.5f));
+    CHECK(hit.triangle == 0);
+    CHECK(!bvh.Raycast(Ray(Vec3(0.5f, -0.5f, 5.0f), Vec3(0.0f, 0.0f, -2.0f)), 1.5f, hit));
+  }
+}
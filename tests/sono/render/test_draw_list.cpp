@@ -0,0 +1,217 @@
+#include <doctest.h>
+#include <render/camera.h>
+#include <render/draw_list.h>
+#include <render/render_pass.h>
+#include <render/resource/material.h>
+#include <render/resource/mesh.h>
+#include <render/scene.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+/// Draw state as the pass saw it at each draw
+struct RecordedDraw {
+  RenderPipeline *pipeline;
+  VertexArray *vertexArray;
+  Buffer *vertexBuffer;
+  Buffer *indexBuffer;
+  Texture *texture;
+  u32 idxCount, firstIdx, firstInstance;
+};
+
+class RecordingPass : public RenderPass {
+public:
+  RecordingPass()
+    : RenderPass(RenderPassDesc{Color3(0u)}) {}
+
+  void BindPipeline(RenderPipeline *pso) override { m_Pipeline = pso; }
+  void BindVertexArray(VertexArray *va) override { m_VertexArray = va; }
+  void BindVertexBuffer(Buffer *vb) override { m_VertexBuffer = vb; }
+  void BindIndexBuffer(Buffer *ib) override { m_IndexBuffer = ib; }
+  void BindTexture(Texture *texture, u32 unit) override {
+    if (unit == 0) m_Texture = texture;
+  }
+  void BindStorageBuffer(Buffer *, u32) override {}
+  void Draw(u32, u32, u32, u32) override { FAIL("Every test mesh is indexed"); }
+  void DrawIndexed(u32 idxCount, u32 instanceCount, u32 firstIdx, u32 firstInstance) override {
+    CHECK(instanceCount == 1);
+    draws.push_back(
+      {m_Pipeline, m_VertexArray, m_VertexBuffer, m_IndexBuffer, m_Texture, idxCount, firstIdx,
+       firstInstance}
+    );
+  }
+
+  std::vector<RecordedDraw> draws;
+
+private:
+  RenderPipeline *m_Pipeline = nullptr;
+  VertexArray *m_VertexArray = nullptr;
+  Buffer *m_VertexBuffer = nullptr, *m_IndexBuffer = nullptr;
+  Texture *m_Texture = nullptr;
+};
+
+// Stand-ins for backend objects, only their addresses are used
+alignas(16) u8 g_Pipelines[3][16];
+alignas(16) u8 g_VertexArrays[5][16];
+alignas(16) u8 g_Buffers[10][16];
+alignas(16) u8 g_Textures[4][16];
+
+template <typename T>
+T *Fake(u8 *storage) {
+  return reinterpret_cast<T *>(storage);
+}
+
+} // namespace
+
+TEST_SUITE("Render/DrawList") {
+  TEST_CASE("Keys order by layer, then state and depth") {
+    using L = RenderLayer;
+    // Opaque before transparent whatever the rest
+    CHECK(
+      DrawKey::Make(L::Opaque, 4095, 65535, 4095, 0) < DrawKey::Make(L::Transparent, 0, 0, 0, 0)
+    );
+    // Pipeline over material over depth over mesh
+    CHECK(DrawKey::Make(L::Opaque, 1, 9, 9, 9) < DrawKey::Make(L::Opaque, 2, 0, 0, 0));
+    CHECK(DrawKey::Make(L::Opaque, 1, 1, 9, 9) < DrawKey::Make(L::Opaque, 1, 2, 0, 0));
+    CHECK(DrawKey::Make(L::Opaque, 1, 1, 100, 9) < DrawKey::Make(L::Opaque, 1, 1, 300, 0));
+    // Opaque depth only counts by slab, the mesh decides within one
+    CHECK(DrawKey::Make(L::Opaque, 1, 1, 200, 0) < DrawKey::Make(L::Opaque, 1, 1, 100, 1));
+    // Transparent: far before near, before any state
+    CHECK(DrawKey::Make(L::Transparent, 9, 9, 20, 9) < DrawKey::Make(L::Transparent, 0, 0, 10, 0));
+    CHECK(DrawKey::Make(L::Transparent, 1, 9, 10, 9) < DrawKey::Make(L::Transparent, 2, 0, 10, 0));
+    // Wide fields are masked, they don't spill into their neighbours
+    CHECK(
+      DrawKey::Make(L::Opaque, 0, 0, 0, 0xFFFFFFFF) == DrawKey::Make(L::Opaque, 0, 0, 0, 0xFFFFF)
+    );
+    CHECK(DrawKey::GetLayer(DrawKey::Make(L::Transparent, 1, 2, 3, 4)) == L::Transparent);
+
+    CHECK(DrawKey::DepthBucket(-5.0f, 100.0f) == 0);
+    CHECK(DrawKey::DepthBucket(50.0f, 100.0f) == 2047);
+    CHECK(DrawKey::DepthBucket(500.0f, 100.0f) == 4095);
+    CHECK(DrawKey::DepthBucket(NAN, 100.0f) == 0);
+    CHECK(DrawKey::ResourceBits(nullptr, 12) == 0);
+    CHECK(DrawKey::ResourceBits(g_Pipelines[1], 12) < 4096);
+  }
+
+  TEST_CASE("The radix sort orders like a stable comparison sort") {
+    std::mt19937_64 rng(1);
+    for (const usize count : {0, 1, 100, 255, 256, 5000, 70000}) {
+      for (const b8 fewFields : {true, false}) {
+        DrawList list;
+        std::vector<DrawPacket> expected;
+        for (usize i = 0; i < count; i++) {
+          // Few pipelines and materials leave most key bytes equal, the passes are skipped
+          const u64 key = fewFields ? DrawKey::Make(RenderLayer::Opaque, rng() % 3, rng() % 5,
+                                                    rng() % 4096, rng() % 20)
+                                    : rng();
+          list.Add(key, (u32)i, (u32)(count - i));
+          expected.push_back({key, (u32)i, (u32)(count - i)});
+        }
+        list.Sort();
+        std::stable_sort(expected.begin(), expected.end(), [](const auto &a, const auto &b) {
+          return a.key < b.key;
+        });
+        REQUIRE(list.GetSize() == count);
+        for (usize i = 0; i < count; i++) {
+          REQUIRE(list.GetPackets()[i].key == expected[i].key);
+          REQUIRE(list.GetPackets()[i].ref == expected[i].ref);
+          REQUIRE(list.GetPackets()[i].slot == expected[i].slot);
+        }
+      }
+    }
+  }
+
+  TEST_CASE("Recorded draws bind each state once and keep the depth order") {
+    Mesh meshes[5];
+    for (u32 i = 0; i < 5; i++) {
+      meshes[i].pVertexArray = Fake<VertexArray>(g_VertexArrays[i]);
+      meshes[i].pVertexBuffer = Fake<Buffer>(g_Buffers[2 * i]);
+      meshes[i].pIndexBuffer = Fake<Buffer>(g_Buffers[2 * i + 1]);
+      meshes[i].subMeshes = {{0, 36}, {36, 12 * (i + 1)}};
+    }
+    Material materials[8];
+    for (u32 i = 0; i < 8; i++) {
+      // The two transparent materials share a pipeline, their textures differ
+      const b8 transparent = i >= 6;
+      materials[i].pipeline = Fake<RenderPipeline>(g_Pipelines[transparent ? 2 : i % 3]);
+      materials[i].textures[0] = Fake<Texture>(g_Textures[i % 4]);
+      materials[i].layer = transparent ? RenderLayer::Transparent : RenderLayer::Opaque;
+    }
+
+    Scene scene;
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<f32> pos(-10.0f, 10.0f);
+    for (u32 i = 0; i < 600; i++) {
+      const Entity e = scene.CreateEntity();
+      scene.GetComponent<Transform>(e).SetPosition(Vec3(pos(rng), pos(rng), pos(rng)));
+      scene.SetBounds(e, BoundingSphere(Vec3::Zero, 0.5f));
+      // Some nodes have nothing to draw
+      if (i % 10 == 0) continue;
+      const Material *material = i % 10 == 1 ? nullptr : &materials[rng() % 8];
+      scene.AddComponent<MeshRef>(e, &meshes[rng() % 5], i % 2, material);
+    }
+    scene.UpdateTransforms();
+
+    Camera camera;
+    camera.SetPosition(Vec3(0.0f, 0.0f, 40.0f));
+    camera.LookAt(Vec3::Zero);
+    DrawList list;
+    scene.ExtractDraws(camera, list);
+    CHECK(list.GetSize() == 480);
+
+    RecordingPass pass;
+    const DrawStats stats = scene.RecordDraws(list, &pass);
+    REQUIRE(stats.draws == list.GetSize());
+    REQUIRE(pass.draws.size() == list.GetSize());
+
+    const ComponentPool<MeshRef> &refs = scene.GetPool<MeshRef>();
+    std::set<const void *> opaquePipelines, opaqueMaterials;
+    u32 opaqueDraws = 0, pipelineChanges = 0, materialChanges = 0;
+    f32 lastDepth = -INFINITY;
+    for (usize i = 0; i < pass.draws.size(); i++) {
+      const RecordedDraw &draw = pass.draws[i];
+      const MeshRef &ref = refs.GetData()[list.GetPackets()[i].ref];
+      const Entity entity = refs.GetEntities()[list.GetPackets()[i].ref];
+      // Every draw sees the state its packet asks for, and its node's matrix by entity index
+      REQUIRE(draw.firstInstance == EntityHandle::GetIndex(entity));
+      REQUIRE(draw.pipeline == ref.material->pipeline);
+      REQUIRE(draw.texture == ref.material->textures[0]);
+      REQUIRE(draw.vertexArray == ref.mesh->pVertexArray);
+      REQUIRE(draw.vertexBuffer == ref.mesh->pVertexBuffer);
+      REQUIRE(draw.indexBuffer == ref.mesh->pIndexBuffer);
+      REQUIRE(draw.firstIdx == ref.mesh->subMeshes[ref.subMesh].idxOffset);
+      REQUIRE(draw.idxCount == ref.mesh->subMeshes[ref.subMesh].idxCount);
+
+      const Vec3 toNode = scene.GetWorldMatrix(entity).GetTranslation() - camera.GetPosition();
+      const f32 depth = toNode.Dot(camera.GetForward());
+      const b8 sameMaterial =
+        i > 0 && ref.material == refs.GetData()[list.GetPackets()[i - 1].ref].material;
+      if (ref.material->layer == RenderLayer::Opaque) {
+        REQUIRE(opaqueDraws == i); // Opaque draws come first
+        opaqueDraws++;
+        opaquePipelines.insert(draw.pipeline);
+        opaqueMaterials.insert(ref.material);
+        pipelineChanges += i == 0 || draw.pipeline != pass.draws[i - 1].pipeline;
+        materialChanges += !sameMaterial;
+        // Front to back within a material, up to the size of the opaque depth slabs
+        const f32 slab = camera.GetFar() / (1 << DrawKey::OPAQUE_DEPTH_BITS);
+        if (sameMaterial) REQUIRE(depth >= lastDepth - slab);
+      } else if (i > opaqueDraws) {
+        // Back to front across materials
+        REQUIRE(depth <= lastDepth + camera.GetFar() / 4095.0f);
+      }
+      lastDepth = depth;
+    }
+    CHECK(opaqueDraws > 0);
+    CHECK(opaqueDraws < pass.draws.size());
+    CHECK(pipelineChanges == opaquePipelines.size());
+    CHECK(materialChanges == opaqueMaterials.size());
+    // The transparent draws follow depth and switch textures, but never pipelines
+    CHECK(stats.pipelineBinds <= opaquePipelines.size() + 1);
+    CHECK(stats.textureBinds < stats.draws / 2);
+  }
+}
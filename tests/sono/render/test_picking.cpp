@@ -0,0 +1,106 @@
+#include <doctest.h>
+#include <core/math/triangle_bvh.h>
+#include <render/camera.h>
+#include <render/resource/mesh.h>
+#include <render/scene.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// Unit cube around the origin, 12 triangles
+TriangleBvh CubeTriangles() {
+  std::vector<Vec3> corners;
+  for (i32 i = 0; i < 8; i++) {
+    corners.emplace_back(i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f);
+  }
+  const u32 indices[36] = {
+    0, 1, 3, 0, 3, 2, 4, 5, 7, 4, 7, 6, // -z, +z
+    0, 2, 6, 0, 6, 4, 1, 3, 7, 1, 7, 5, // -x, +x
+    0, 1, 5, 0, 5, 4, 2, 3, 7, 2, 7, 6, // -y, +y
+  };
+  TriangleBvh bvh;
+  bvh.Build(corners.data(), corners.size(), indices, 36);
+  return bvh;
+}
+
+} // namespace
+
+TEST_SUITE("Render/Picking") {
+  TEST_CASE("Screen points unproject to rays through what they show") {
+    Camera camera;
+    camera.SetPerspective(Sono::Radians(60.0f), 2.0f, 0.5f, 200.0f);
+    camera.SetPosition(Vec3(3.0f, 4.0f, 20.0f));
+    camera.LookAt(Vec3::Zero);
+    const Vec2 viewport(1600.0f, 800.0f);
+
+    // The center looks down the forward axis
+    const Ray center = camera.ScreenPointToRay(Vec2(800.0f, 400.0f), viewport);
+    CHECK(center.dir.Dot(camera.GetForward()) == doctest::Approx(1.0f));
+    CHECK((center.origin - camera.GetPosition()).Length() == doctest::Approx(0.5f).epsilon(1e-3));
+
+    // World points projected to the screen and back lie on their ray
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<f32> dist(-5.0f, 5.0f);
+    const Mat4 viewProjection = camera.GetViewProjectionMatrix();
+    for (i32 i = 0; i < 50; i++) {
+      const Vec3 p(dist(rng), dist(rng), dist(rng));
+      const Vec4 clip = Vec4(p.x, p.y, p.z, 1.0f) * viewProjection;
+      const Vec2 screen(
+        (clip.x / clip.w + 1.0f) * 0.5f * viewport.x, (1.0f - clip.y / clip.w) * 0.5f * viewport.y
+      );
+      const Ray ray = camera.ScreenPointToRay(screen, viewport);
+      CHECK(ray.dir.Length() == doctest::Approx(1.0f));
+      const Vec3 toPoint = p - ray.origin;
+      const f32 along = toPoint.Dot(ray.dir);
+      CHECK(along > 0.0f);
+      CHECK((ray.At(along) - p).Length() < 1e-3f);
+    }
+  }
+
+  TEST_CASE("Scene ray casts pick the closest mesh in node space") {
+    const TriangleBvh cube = CubeTriangles();
+    Mesh mesh;
+    mesh.pTriangles = &cube;
+    Mesh noTriangles;
+
+    // A row of cubes along -z, scaled and turned, one of them has no CPU triangles
+    Scene scene;
+    std::vector<Entity> nodes;
+    for (i32 i = 0; i < 6; i++) {
+      const Entity e = scene.CreateEntity();
+      Transform &t = scene.GetComponent<Transform>(e);
+      t.SetPosition(Vec3(0.0f, 0.0f, -4.0f * (f32)i));
+      t.Scale(Vec3(2.0f, 2.0f, 1.0f + (f32)i));
+      t.SetRotation(Quaternion::FromAxisAngle(Vec3(0.0f, 0.0f, 1.0f), 0.3f * (f32)i));
+      scene.SetBounds(e, BoundingSphere(Vec3::Zero, 0.9f));
+      scene.AddComponent<MeshRef>(e, i == 1 ? &noTriangles : &mesh);
+      nodes.push_back(e);
+    }
+    scene.UpdateTransforms();
+
+    SceneRayHit hit = {NULL_ENTITY, -1.0f, 0};
+    const Ray down(Vec3(0.1f, 0.2f, 10.0f), Vec3(0.0f, 0.0f, -1.0f));
+    REQUIRE(scene.Raycast(down, INFINITY, hit));
+    CHECK(hit.entity == nodes[0]);
+    // The first cube is 1 deep, its front face at z = 0.5
+    CHECK(hit.t == doctest::Approx(9.5f));
+
+    // Past the first, the second has nothing to test, the third is 3 deep around z = -8
+    const Ray behind(Vec3(0.1f, 0.2f, -1.0f), Vec3(0.0f, 0.0f, -1.0f));
+    REQUIRE(scene.Raycast(behind, INFINITY, hit));
+    CHECK(hit.entity == nodes[2]);
+    CHECK(hit.t == doctest::Approx(5.5f));
+    CHECK(!scene.Raycast(behind, 5.0f, hit));
+
+    // Moved away, the picks follow the next update
+    scene.GetComponent<Transform>(nodes[2]).SetPosition(Vec3(50.0f, 0.0f, -8.0f));
+    scene.UpdateTransforms();
+    REQUIRE(scene.Raycast(behind, INFINITY, hit));
+    CHECK(hit.entity == nodes[3]);
+    CHECK(!scene.Raycast(Ray(Vec3(10.0f, 0.0f, 10.0f), Vec3(0.0f, 0.0f, -1.0f)), INFINITY, hit));
+  }
+}
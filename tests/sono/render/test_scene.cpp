@@ -0,0 +1,354 @@
+#include <doctest.h>
+#include <core/thread/thread_pool.h>
+#include <render/scene.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// Where p in the space of node ends up in world space, applying each local transform up the
+/// parent chain
+Vec3 ChainPoint(Scene &scene, const std::vector<i32> &parents, i32 node, Vec3 p) {
+  for (; node > -1; node = parents[node]) {
+    const Transform &t = scene.GetComponent<Transform>(node);
+    p = Affine3x4::FromTRS(t.GetPosition(), t.GetRotation(), t.GetScale()).TransformPoint(p);
+  }
+  return p;
+}
+
+} // namespace
+
+TEST_SUITE("Render/Scene") {
+  TEST_CASE("Children inherit the world transform of their parents") {
+    Scene scene;
+    const u32 root = scene.CreateEntity();
+    const u32 child = scene.AddNode(root);
+    const u32 grandChild = scene.AddNode(child);
+    const u32 other = scene.CreateEntity();
+
+    scene.GetComponent<Transform>(root).SetPosition(Vec3(10.0f, 0.0f, 0.0f));
+    scene.GetComponent<Transform>(root).Scale(2.0f);
+    scene.GetComponent<Transform>(child).SetPosition(Vec3(0.0f, 1.0f, 0.0f));
+    scene.GetComponent<Transform>(grandChild).SetPosition(Vec3(0.0f, 0.0f, 1.0f));
+    scene.GetComponent<Transform>(other).SetPosition(Vec3(-3.0f, 0.0f, 0.0f));
+    scene.UpdateTransforms();
+
+    auto worldOrigin = [&](u32 e) {
+      return scene.GetComponent<Transform>(e).GetModelMatrix().TransformPoint(Vec3::Zero);
+    };
+    CHECK(worldOrigin(root) == Vec3(10.0f, 0.0f, 0.0f));
+    CHECK(worldOrigin(child) == Vec3(10.0f, 2.0f, 0.0f));
+    CHECK(worldOrigin(grandChild) == Vec3(10.0f, 2.0f, 2.0f));
+    CHECK(worldOrigin(other) == Vec3(-3.0f, 0.0f, 0.0f));
+    CHECK_FALSE(scene.GetComponent<Transform>(grandChild).IsDirty());
+
+    // Moving the root carries its subtree along, nodes created later join on the next update
+    scene.GetComponent<Transform>(root).SetPosition(Vec3(0.0f, 5.0f, 0.0f));
+    const u32 late = scene.AddNode(grandChild);
+    scene.GetComponent<Transform>(late).SetPosition(Vec3(1.0f, 0.0f, 0.0f));
+    scene.UpdateTransforms();
+    CHECK(worldOrigin(grandChild) == Vec3(0.0f, 7.0f, 2.0f));
+    CHECK(worldOrigin(late) == Vec3(2.0f, 7.0f, 2.0f));
+    CHECK(worldOrigin(other) == Vec3(-3.0f, 0.0f, 0.0f));
+  }
+
+  TEST_CASE("Culling reports entities whatever order the nodes are stored in") {
+    Scene scene;
+    const u32 inside = scene.CreateEntity();
+    const u32 outside = scene.CreateEntity();
+    const u32 insideChild = scene.AddNode(outside);
+    const u32 outsideChild = scene.AddNode(inside);
+    scene.GetComponent<Transform>(inside).SetPosition(Vec3(0.0f, 0.0f, -5.0f));
+    scene.GetComponent<Transform>(outside).SetPosition(Vec3(10.0f, 0.0f, 0.0f));
+    scene.GetComponent<Transform>(insideChild).SetPosition(Vec3(-10.0f, 0.0f, -5.0f));
+    scene.GetComponent<Transform>(outsideChild).SetPosition(Vec3(0.0f, 0.0f, -30.0f));
+    for (u32 e : {inside, outside, insideChild, outsideChild}) {
+      scene.SetBounds(e, BoundingSphere(Vec3::Zero, 0.1f));
+    }
+    scene.UpdateTransforms();
+
+    const Frustum frustum =
+      Frustum::FromViewProjection(Mat4::Ortho(-4.0f, 2.0f, -1.0f, 3.0f, 0.5f, 20.0f));
+    const std::vector<u32> &visible = scene.CullVisible(frustum);
+    REQUIRE(visible.size() == 2);
+    CHECK(visible[0] == inside);
+    CHECK(visible[1] == insideChild);
+  }
+
+  TEST_CASE("Partial updates match a full recomputation of a random tree") {
+    Scene scene;
+    std::mt19937 rng(41);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    std::vector<i32> parents;
+    for (i32 i = 0; i < 2000; i++) {
+      // A few roots, otherwise any earlier node, so creation order is not level order
+      const i32 parent = i < 4 ? -1 : (i32)(rng() % (u32)i);
+      REQUIRE(scene.AddNode(parent) == (u32)i);
+      parents.push_back(parent);
+      Transform &t = scene.GetComponent<Transform>(i);
+      t.SetPosition(Vec3(dist(rng), dist(rng), dist(rng)) * 3.0f);
+      t.SetRotation(Quaternion::FromAxisAngle(Vec3(dist(rng), 1.0f, dist(rng)), dist(rng)));
+      t.Scale(Vec3(1.0f + 0.1f * dist(rng)));
+    }
+
+    const Vec3 probe(0.5f, -1.0f, 2.0f);
+    for (i32 frame = 0; frame < 5; frame++) {
+      // Touch about 1% of the nodes between updates
+      for (i32 i = 0; i < 20 && frame > 0; i++) {
+        Transform &t = scene.GetComponent<Transform>(rng() % 2000);
+        t.Move(Vec3(dist(rng), dist(rng), dist(rng)));
+        t.Rotate(Quaternion::FromAxisAngle(Vec3(0.0f, 0.0f, 1.0f), dist(rng)));
+      }
+      scene.UpdateTransforms();
+
+      for (i32 i = 0; i < 2000; i++) {
+        const Vec3 expected = ChainPoint(scene, parents, i, probe);
+        const Vec3 actual = scene.GetComponent<Transform>(i).GetModelMatrix().TransformPoint(probe);
+        REQUIRE(actual.Dist(expected) < 1e-3f * (1.0f + expected.Length()));
+      }
+    }
+  }
+
+  TEST_CASE("Levels split across threads give the serial result") {
+    // Wide enough that the lower levels go through the pool
+    auto build = [](Scene &scene) {
+      std::mt19937 rng(42);
+      std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+      for (u32 i = 0; i < 60000; i++) {
+        const i32 parent = i < 64 ? -1 : (i32)(i / 4 - 16);
+        Transform &t = scene.GetComponent<Transform>(scene.AddNode(parent));
+        t.SetPosition(Vec3(dist(rng), dist(rng), dist(rng)));
+        t.SetRotation(Quaternion::FromAxisAngle(Vec3(dist(rng), 1.0f, 0.0f), dist(rng)));
+      }
+    };
+    Scene serial, parallel;
+    build(serial);
+    build(parallel);
+    serial.UpdateTransforms();
+    {
+      ThreadPool pool(3);
+      parallel.UpdateTransforms();
+      for (Entity e = 0; e < 60000; e += 7) {
+        serial.GetComponent<Transform>(e).Scale(1.5f);
+        parallel.GetComponent<Transform>(e).Scale(1.5f);
+      }
+      serial.UpdateTransforms();
+      parallel.UpdateTransforms();
+    }
+
+    for (Entity e = 0; e < 60000; e++) {
+      const Affine3x4 &a = serial.GetComponent<Transform>(e).GetModelMatrix();
+      const Affine3x4 &b = parallel.GetComponent<Transform>(e).GetModelMatrix();
+      REQUIRE(std::memcmp(&a, &b, sizeof(Affine3x4)) == 0);
+    }
+  }
+
+  TEST_CASE("Views visit the nodes that have every component") {
+    struct Velocity {
+      Vec3 v;
+    };
+    Scene scene;
+    for (u32 i = 0; i < 100; i++) scene.AddNode(i < 10 ? -1 : (i32)(i % 10));
+    for (Entity e = 0; e < 100; e += 2) scene.AddComponent<MeshRef>(e, nullptr, e);
+    for (Entity e = 0; e < 100; e += 3) scene.AddComponent<Velocity>(e, Vec3((f32)e, 0.0f, 0.0f));
+    scene.RemoveComponent<MeshRef>(0);
+    CHECK_FALSE(scene.HasComponent<MeshRef>(0));
+    CHECK(scene.HasComponent<MeshRef>(2));
+    CHECK(scene.HasComponent<Transform>(99));
+
+    // Multiples of 6 but 0, driven by the smaller Velocity pool
+    std::vector<Entity> seen;
+    auto view = scene.GetView<Transform, MeshRef, Velocity>();
+    CHECK(view.GetCandidateCount() == 34);
+    view.Each([&](Entity e, Transform &t, MeshRef &mesh, Velocity &velocity) {
+      CHECK(&t == &scene.GetComponent<Transform>(e));
+      CHECK(mesh.subMesh == e);
+      CHECK(velocity.v.x == (f32)e);
+      seen.push_back(e);
+    });
+    std::sort(seen.begin(), seen.end());
+    REQUIRE(seen.size() == 16);
+    for (usize i = 0; i < seen.size(); i++) CHECK(seen[i] == 6 * (i + 1));
+
+    usize transforms = 0;
+    scene.GetView<Transform>().Each([&](Entity, Transform &) { transforms++; });
+    CHECK(transforms == 100);
+  }
+
+  TEST_CASE("A parallel view writes the same components as a serial one") {
+    Scene scene;
+    for (u32 i = 0; i < 50000; i++) {
+      const Entity e = scene.CreateEntity();
+      if (i % 5 != 0) scene.AddComponent<MeshRef>(e, nullptr, 0u);
+    }
+    {
+      ThreadPool pool(3);
+      scene.GetView<MeshRef>().ParallelEach(1024, [](Entity e, MeshRef &mesh) {
+        mesh.subMesh += e;
+      });
+    }
+    const ComponentPool<MeshRef> &meshes = scene.GetPool<MeshRef>();
+    REQUIRE(meshes.GetSize() == 40000);
+    for (usize i = 0; i < meshes.GetSize(); i++) {
+      REQUIRE(meshes.GetData()[i].subMesh == meshes.GetEntities()[i]);
+    }
+  }
+
+  TEST_CASE("Destroying a node takes its subtree and components, handles go stale") {
+    Scene scene;
+    const Entity root = scene.CreateEntity();
+    const Entity child = scene.AddNode(root);
+    const Entity grandChild = scene.AddNode(child);
+    const Entity sibling = scene.AddNode(root);
+    scene.AddComponent<MeshRef>(grandChild);
+    scene.AddComponent<MeshRef>(sibling);
+    scene.GetComponent<Transform>(root).SetPosition(Vec3(1.0f, 0.0f, 0.0f));
+    scene.GetComponent<Transform>(sibling).SetPosition(Vec3(0.0f, 1.0f, 0.0f));
+
+    scene.DestroyEntity(child);
+    CHECK_FALSE(scene.IsAlive(child));
+    CHECK_FALSE(scene.IsAlive(grandChild));
+    CHECK(scene.IsAlive(sibling));
+    CHECK(scene.GetNodeCount() == 2);
+    CHECK_FALSE(scene.HasComponent<MeshRef>(grandChild));
+    CHECK(scene.GetPool<MeshRef>().GetSize() == 1);
+    scene.DestroyEntity(child); // stale, nothing happens
+
+    scene.UpdateTransforms();
+    CHECK(scene.GetView<Transform>().GetCandidateCount() == 2);
+    const Affine3x4 &world = scene.GetComponent<Transform>(sibling).GetModelMatrix();
+    CHECK(world.TransformPoint(Vec3::Zero) == Vec3(1.0f, 1.0f, 0.0f));
+
+    // Once enough indices wait, the oldest is reused with a new generation. Two already do.
+    for (usize i = 2; i < Scene::MIN_FREE_INDICES; i++) scene.DestroyEntity(scene.CreateEntity());
+    const Entity reused = scene.CreateEntity();
+    CHECK(EntityHandle::GetIndex(reused) == EntityHandle::GetIndex(child));
+    CHECK(EntityHandle::GetGeneration(reused) != EntityHandle::GetGeneration(child));
+    CHECK(scene.IsAlive(reused));
+    CHECK_FALSE(scene.IsAlive(child));
+    CHECK_FALSE(scene.HasComponent<MeshRef>(reused));
+  }
+
+  TEST_CASE("Spawning and destroying keeps the storage bounded and the transforms right") {
+    Scene scene;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    std::vector<Entity> live;
+    std::vector<Entity> parentOf(EntityHandle::MAX_INDEX + 1, NULL_ENTITY); // By index
+    u32 maxIndex = 0;
+
+    for (i32 frame = 0; frame < 200; frame++) {
+      for (i32 i = 0; i < 50; i++) {
+        const Entity parent = !live.empty() && rng() % 2 ? live[rng() % live.size()] : NULL_ENTITY;
+        const Entity e = scene.AddNode(parent);
+        parentOf[EntityHandle::GetIndex(e)] = parent;
+        maxIndex = std::max(maxIndex, EntityHandle::GetIndex(e));
+        scene.GetComponent<Transform>(e).SetPosition(Vec3(dist(rng), dist(rng), dist(rng)));
+        live.push_back(e);
+      }
+      for (i32 i = 0; i < 50 && !live.empty(); i++) {
+        scene.DestroyEntity(live[rng() % live.size()]);
+        live.erase(
+          std::remove_if(live.begin(), live.end(), [&](Entity e) { return !scene.IsAlive(e); }),
+          live.end()
+        );
+      }
+      scene.UpdateTransforms();
+    }
+
+    CHECK(scene.GetNodeCount() == live.size());
+    usize visited = 0;
+    scene.GetView<Transform>().Each([&](Entity e, Transform &) { visited += scene.IsAlive(e); });
+    CHECK(visited == live.size());
+    CHECK(maxIndex < 2 * Scene::MIN_FREE_INDICES + 500);
+    const Vec3 probe(0.5f, -1.0f, 2.0f);
+    for (const Entity e : live) {
+      Vec3 expected = probe;
+      for (Entity n = e; n != NULL_ENTITY; n = parentOf[EntityHandle::GetIndex(n)]) {
+        const Transform &t = scene.GetComponent<Transform>(n);
+        expected = Affine3x4::FromTRS(t.GetPosition(), t.GetRotation(), t.GetScale())
+                     .TransformPoint(expected);
+      }
+      const Vec3 actual = scene.GetComponent<Transform>(e).GetModelMatrix().TransformPoint(probe);
+      REQUIRE(actual.Dist(expected) < 1e-3f * (1.0f + expected.Length()));
+    }
+  }
+
+  TEST_CASE("The Bvh follows moved, added and destroyed nodes") {
+    Scene scene;
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<f32> dist(-20.0f, 20.0f);
+    std::vector<Entity> live;
+    std::vector<f32> radiusOf; // By index, infinite for nodes without bounds
+
+    auto setRadius = [&](Entity e, f32 radius) {
+      radiusOf[EntityHandle::GetIndex(e)] = radius;
+      scene.SetBounds(e, BoundingSphere(Vec3(0.0f), radius));
+    };
+    auto spawn = [&]() {
+      const b8 child = !live.empty() && rng() % 3 == 0;
+      const Entity e = scene.AddNode(child ? live[rng() % live.size()] : NULL_ENTITY);
+      radiusOf.resize(std::max<usize>(radiusOf.size(), EntityHandle::GetIndex(e) + 1));
+      radiusOf[EntityHandle::GetIndex(e)] = INFINITY;
+      scene.GetComponent<Transform>(e).SetPosition(Vec3(dist(rng), dist(rng), dist(rng)));
+      if (rng() % 8 != 0) setRadius(e, 0.5f + (f32)(rng() % 4));
+      live.push_back(e);
+    };
+    // Every node with bounds, by the box of its world sphere, against the tree's answers
+    auto check = [&]() {
+      const Bvh &bvh = scene.GetBvh();
+      for (i32 q = 0; q < 20; q++) {
+        const Vec3 center(dist(rng), dist(rng), dist(rng));
+        const AABB query = AABB::FromCenterExtents(center, Vec3(8.0f));
+        std::vector<Entity> got, expected;
+        bvh.QueryAABB(query, [&](u32 e) { got.push_back(e); });
+        for (const Entity e : live) {
+          const BoundingSphere local(Vec3(0.0f), radiusOf[EntityHandle::GetIndex(e)]);
+          if (std::isinf(local.radius)) continue;
+          const BoundingSphere world =
+            local.Transformed(scene.GetComponent<Transform>(e).GetModelMatrix());
+          const AABB box = AABB::FromCenterExtents(world.center, Vec3(world.radius));
+          b8 overlaps = true;
+          for (i32 i = 0; i < 3; i++) {
+            overlaps = overlaps && box.min[i] <= query.max[i] && box.max[i] >= query.min[i];
+          }
+          if (overlaps) expected.push_back(e);
+        }
+        std::sort(got.begin(), got.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(got == expected);
+      }
+    };
+
+    for (i32 i = 0; i < 400; i++) spawn();
+    scene.UpdateTransforms();
+    scene.UpdateBvh();
+    check();
+
+    for (i32 frame = 0; frame < 30; frame++) {
+      for (i32 i = 0; i < 40; i++) {
+        const Entity e = live[rng() % live.size()];
+        scene.GetComponent<Transform>(e).Move(Vec3(dist(rng), dist(rng), dist(rng)) * 0.1f);
+      }
+      for (i32 i = 0; i < 5; i++) {
+        setRadius(live[rng() % live.size()], 1.0f + (f32)(rng() % 3));
+      }
+      for (i32 i = 0; i < 10; i++) spawn();
+      for (i32 i = 0; i < 10; i++) scene.DestroyEntity(live[rng() % live.size()]);
+      live.erase(
+        std::remove_if(live.begin(), live.end(), [&](Entity e) { return !scene.IsAlive(e); }),
+        live.end()
+      );
+      scene.UpdateTransforms();
+      // Every third frame skips a Bvh update, the next one has to catch up on both
+      if (frame % 3 == 1) continue;
+      scene.UpdateBvh();
+      check();
+    }
+  }
+}
@@ -0,0 +1,180 @@
+#include <doctest.h>
+#include <render/scene_file.h>
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Health {
+  f32 points;
+  u32 team;
+};
+
+constexpr u32 HEALTH_TAG = 0x484C5448; // "HLTH"
+
+// --------------------------------------------------------------------------------
+/// Random forest created depth first, with names "n<i>", bounds, a Health on every third node
+/// and a few subtrees destroyed so the scene has holes
+void BuildScene(Scene &scene, u32 count, u32 seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+  std::vector<Entity> nodes;
+  for (u32 i = 0; i < count; i++) {
+    const Entity parent = i < 8 || rng() % 8 == 0 ? NULL_ENTITY : nodes[rng() % nodes.size()];
+    const Entity e = scene.AddNode(parent);
+    nodes.push_back(e);
+    scene.SetName(e, "n" + std::to_string(i));
+    Transform &t = scene.GetComponent<Transform>(e);
+    t.SetPosition(Vec3(dist(rng), dist(rng), dist(rng)) * 3.0f);
+    t.SetRotation(Quaternion::FromAxisAngle(Vec3(dist(rng), 1.0f, dist(rng)), dist(rng)));
+    t.Scale(Vec3(1.0f + 0.1f * dist(rng)));
+    scene.SetBounds(e, BoundingSphere(Vec3(dist(rng), 0.0f, 0.0f), 0.5f));
+    if (i % 3 == 0) scene.AddComponent<Health>(e, (f32)i, i % 4);
+  }
+  scene.UpdateTransforms();
+  for (u32 i = 0; i < count / 50; i++) scene.DestroyEntity(nodes[rng() % nodes.size()]);
+}
+// --------------------------------------------------------------------------------
+/// Entities of a scene by their unique names
+std::unordered_map<std::string, Entity> ByName(Scene &scene) {
+  std::unordered_map<std::string, Entity> names;
+  scene.GetView<Transform>().Each([&](Entity e, Transform &) { names[scene.GetName(e)] = e; });
+  return names;
+}
+
+} // namespace
+
+TEST_SUITE("Render/SceneFile") {
+  TEST_CASE("A written scene loads back with the same hierarchy, transforms and columns") {
+    Scene scene;
+    BuildScene(scene, 3000, 1);
+    std::vector<u8> data;
+    SceneFile::Write(scene, data, {SceneColumn::Of<Health>(HEALTH_TAG)});
+
+    SceneFileView view;
+    REQUIRE(view.Open(data.data(), data.size()));
+    CHECK(view.GetNodeCount() == scene.GetNodeCount());
+    Scene loaded;
+    REQUIRE(SceneFile::Load(view, loaded, {SceneColumn::Of<Health>(HEALTH_TAG)}));
+    CHECK(loaded.GetNodeCount() == scene.GetNodeCount());
+
+    scene.UpdateTransforms();
+    loaded.UpdateTransforms();
+    const auto originals = ByName(scene);
+    const auto copies = ByName(loaded);
+    REQUIRE(originals.size() == copies.size());
+    for (const auto &[name, e] : originals) {
+      REQUIRE(copies.count(name) == 1);
+      const Entity copy = copies.at(name);
+      const Affine3x4 &a = scene.GetComponent<Transform>(e).GetModelMatrix();
+      const Affine3x4 &b = loaded.GetComponent<Transform>(copy).GetModelMatrix();
+      REQUIRE(std::memcmp(&a, &b, sizeof(Affine3x4)) == 0);
+      REQUIRE(scene.HasComponent<Health>(e) == loaded.HasComponent<Health>(copy));
+      if (scene.HasComponent<Health>(e)) {
+        CHECK(loaded.GetComponent<Health>(copy).points == scene.GetComponent<Health>(e).points);
+        CHECK(loaded.GetComponent<Health>(copy).team == scene.GetComponent<Health>(e).team);
+      }
+    }
+
+    // Same bounds, so the same nodes are visible
+    const Frustum frustum =
+      Frustum::FromViewProjection(Mat4::Ortho(-4.0f, 4.0f, -4.0f, 4.0f, -4.0f, 4.0f));
+    std::vector<std::string> visible, visibleLoaded;
+    for (Entity e : scene.CullVisible(frustum)) visible.push_back(scene.GetName(e));
+    for (Entity e : loaded.CullVisible(frustum)) visibleLoaded.push_back(loaded.GetName(e));
+    CHECK(!visible.empty());
+    CHECK(visible == visibleLoaded);
+
+    // The loaded scene keeps working as a scene
+    const Entity late = loaded.AddNode(copies.at("n0"));
+    loaded.UpdateTransforms();
+    CHECK(loaded.IsAlive(late));
+  }
+
+  TEST_CASE("Saving and loading through a mapped file") {
+    Scene scene;
+    BuildScene(scene, 500, 2);
+    const std::string path =
+      (std::filesystem::temp_directory_path() / "sono_test.snscene").string();
+    REQUIRE(SceneFile::Save(scene, path.c_str()));
+
+    Scene loaded;
+    REQUIRE(SceneFile::Load(path.c_str(), loaded));
+    CHECK(loaded.GetNodeCount() == scene.GetNodeCount());
+    CHECK(loaded.GetPool<Health>().GetSize() == 0); // column not asked for
+    std::filesystem::remove(path);
+
+    Scene missing;
+    CHECK_FALSE(SceneFile::Load(path.c_str(), missing));
+  }
+
+  TEST_CASE("The validator rejects broken files") {
+    Scene scene;
+    BuildScene(scene, 200, 3);
+    std::vector<u8> data;
+    SceneFile::Write(scene, data, {SceneColumn::Of<Health>(HEALTH_TAG)});
+    SceneFileView view;
+    REQUIRE(view.Open(data.data(), data.size()));
+
+    CHECK_FALSE(view.Open(data.data(), data.size() - 1));
+    CHECK_FALSE(view.Open(data.data(), 10));
+
+    auto edited = [&](auto edit) {
+      std::vector<u8> copy = data;
+      edit(copy);
+      return view.Open(copy.data(), copy.size());
+    };
+    auto section = [&](std::vector<u8> &bytes, u32 type) {
+      for (u32 s = 0;; s++) {
+        SceneFileSection *section = reinterpret_cast<SceneFileSection *>(
+          bytes.data() + sizeof(SceneFileHeader) + s * sizeof(SceneFileSection)
+        );
+        if (section->type == type) return section;
+      }
+    };
+    auto node = [&](std::vector<u8> &bytes, u32 i) {
+      u8 *nodes = bytes.data() + section(bytes, SFS_HIERARCHY)->offset;
+      return reinterpret_cast<Hierachy *>(nodes) + i;
+    };
+    CHECK_FALSE(edited([](std::vector<u8> &bytes) { bytes[0] ^= 1; }));
+    CHECK_FALSE(edited([&](std::vector<u8> &bytes) { section(bytes, SFS_BOUNDS)->count--; }));
+    CHECK_FALSE(edited([&](std::vector<u8> &bytes) {
+      section(bytes, SFS_TRANSFORMS)->offset += 4;
+    }));
+    CHECK_FALSE(edited([&](std::vector<u8> &bytes) { node(bytes, 150)->parent = 160; }));
+    CHECK_FALSE(edited([&](std::vector<u8> &bytes) { node(bytes, 20)->nextSibling = 3; }));
+    CHECK_FALSE(edited([&](std::vector<u8> &bytes) { node(bytes, 0)->firstChild = -1; }));
+    CHECK_FALSE(edited([&](std::vector<u8> &bytes) {
+      u32 *nodes = reinterpret_cast<u32 *>(bytes.data() + section(bytes, SFS_COLUMN_NODES)->offset);
+      nodes[1] = nodes[0];
+    }));
+
+    // A column of another size is refused before the scene is touched
+    Scene loaded;
+    REQUIRE(view.Open(data.data(), data.size()));
+    CHECK_FALSE(SceneFile::Load(view, loaded, {SceneColumn::Of<BoundingSphere>(HEALTH_TAG)}));
+    CHECK(loaded.GetNodeCount() == 0);
+  }
+
+  TEST_CASE("Corrupted bytes are rejected or load safely") {
+    Scene scene;
+    BuildScene(scene, 100, 4);
+    std::vector<u8> data;
+    SceneFile::Write(scene, data, {SceneColumn::Of<Health>(HEALTH_TAG)});
+    std::mt19937 rng(9);
+    for (i32 round = 0; round < 500; round++) {
+      std::vector<u8> copy = data;
+      for (i32 flips = 0; flips < 4; flips++) copy[rng() % copy.size()] ^= (u8)(1 << (rng() % 8));
+      SceneFileView view;
+      if (!view.Open(copy.data(), copy.size())) continue;
+      Scene loaded;
+      REQUIRE(SceneFile::Load(view, loaded, {SceneColumn::Of<Health>(HEALTH_TAG)}));
+      loaded.UpdateTransforms();
+    }
+  }
+}
@@ -0,0 +1,125 @@
+#include <doctest.h>
+#include <render/scene.h>
+#include <render/scene_snapshot.h>
+
+#include <cstring>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// --------------------------------------------------------------------------------
+/// The frame holds what the scene holds right now, node for node. localBounds holds what was
+/// given to SetBounds, nodes missing from it have no bounds.
+void CheckFrame(
+  Scene &scene, const SceneFrame &frame, usize indexCount,
+  const std::unordered_map<Entity, BoundingSphere> &localBounds
+) {
+  const BoundingSphere noBounds(Vec3::Zero, std::numeric_limits<f32>::infinity());
+  REQUIRE(frame.GetSize() == indexCount);
+  const ComponentPool<MeshRef> &meshes = scene.GetPool<MeshRef>();
+  usize alive = 0;
+  for (u32 i = 0; i < indexCount; i++) {
+    const Entity e = frame.entities[i];
+    if (e == NULL_ENTITY) continue;
+    REQUIRE(scene.IsAlive(e));
+    alive++;
+
+    // A node moved since the last update is published as of the next one
+    const Transform &transform = scene.GetComponent<Transform>(e);
+    if (!transform.IsDirty()) {
+      const Affine3x4 &world = transform.GetModelMatrix();
+      REQUIRE(std::memcmp(&frame.world[i], &world, sizeof(Affine3x4)) == 0);
+      const auto it = localBounds.find(e);
+      const BoundingSphere &local = it != localBounds.end() ? it->second : noBounds;
+      const BoundingSphere bounds = local.Transformed(world);
+      REQUIRE(std::memcmp(&frame.bounds[i], &bounds, sizeof(BoundingSphere)) == 0);
+    }
+    const MeshRef expected = meshes.Has(e) ? meshes.Get(e) : MeshRef();
+    REQUIRE(frame.meshes[i].mesh == expected.mesh);
+    REQUIRE(frame.meshes[i].subMesh == expected.subMesh);
+  }
+  REQUIRE(alive == scene.GetNodeCount());
+}
+
+} // namespace
+
+TEST_SUITE("Render/SceneSnapshot") {
+  TEST_CASE("Published frames match the scene through moves, spawns and destroys") {
+    Scene scene;
+    SceneSnapshot snapshot;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    std::vector<Entity> nodes;
+    std::unordered_map<Entity, BoundingSphere> localBounds;
+    // Only the addresses are compared
+    const Mesh *fakeMeshes[3] = {
+      reinterpret_cast<const Mesh *>(&nodes), reinterpret_cast<const Mesh *>(&rng),
+      reinterpret_cast<const Mesh *>(&scene)
+    };
+
+    u64 acquired = 0;
+    for (i32 frame = 0; frame < 120; frame++) {
+      for (i32 op = 0; op < 40; op++) {
+        const u32 kind = rng() % 10;
+        if (nodes.empty() || kind < 3) {
+          Entity parent = NULL_ENTITY;
+          if (!nodes.empty() && rng() % 3 != 0) parent = nodes[rng() % nodes.size()];
+          const Entity e = scene.AddNode(scene.IsAlive(parent) ? parent : NULL_ENTITY);
+          scene.GetComponent<Transform>(e).SetPosition(Vec3(dist(rng), dist(rng), dist(rng)));
+          nodes.push_back(e);
+          continue;
+        }
+        const Entity e = nodes[rng() % nodes.size()];
+        if (!scene.IsAlive(e)) continue;
+        if (kind < 6) {
+          Transform &t = scene.GetComponent<Transform>(e);
+          t.SetPosition(t.GetPosition() + Vec3(dist(rng), 0.0f, 0.0f));
+        } else if (kind < 8) {
+          scene.AddComponent<MeshRef>(e, fakeMeshes[rng() % 3], (u32)(rng() % 4));
+        } else if (kind < 9) {
+          scene.RemoveComponent<MeshRef>(e);
+        } else if (frame % 4 == 0) {
+          scene.DestroyEntity(e);
+          localBounds.erase(e);
+        } else {
+          const BoundingSphere bounds(Vec3(dist(rng), 0.0f, 0.0f), 1.0f + dist(rng));
+          scene.SetBounds(e, bounds);
+          localBounds[e] = bounds;
+        }
+      }
+      // Now and then an update is skipped, or two run between publishes
+      if (frame % 17 != 5) scene.UpdateTransforms();
+      if (frame % 13 == 7) scene.UpdateTransforms();
+      scene.PublishSnapshot(snapshot);
+
+      // The reader sometimes falls behind for longer than the kept history
+      if (frame % 11 < 3 || frame % 29 == 0) continue;
+      const SceneFrame &latest = snapshot.Acquire();
+      CHECK(latest.frame == (u64)frame + 1);
+      CheckFrame(scene, latest, latest.GetSize(), localBounds);
+      acquired++;
+    }
+    CHECK(acquired > 50);
+  }
+
+  TEST_CASE("A static scene publishes without copying") {
+    Scene scene;
+    SceneSnapshot snapshot;
+    for (i32 i = 0; i < 100; i++) scene.CreateEntity();
+    scene.UpdateTransforms();
+    for (i32 i = 0; i < 3; i++) scene.PublishSnapshot(snapshot);
+    const SceneFrame &frame = snapshot.Acquire();
+    CHECK(frame.frame == 3);
+    CheckFrame(scene, frame, 100, {});
+
+    // Writes into frames nothing changed for since they were last published would show here
+    SceneFrame &stale = snapshot.GetWriteBuffer();
+    stale.world[5] = Affine3x4::FromTRS(Vec3(9.0f), Quaternion::Identity(), Vec3(1.0f));
+    scene.UpdateTransforms();
+    scene.PublishSnapshot(snapshot);
+    CHECK(std::memcmp(&snapshot.Acquire().world[5], &stale.world[5], sizeof(Affine3x4)) == 0);
+  }
+}
@@ -0,0 +1,136 @@
+#include <doctest.h>
+#include <render/buffer_base.h>
+#include <render/scene.h>
+#include <render/transform_buffer.h>
+
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Keeps what is written to it in memory, and the ranges of the writes
+class MemoryBuffer : public Buffer {
+public:
+  explicit MemoryBuffer(usize count)
+    : Buffer(BufferDesc{count, (u32)sizeof(Affine3x4), BufferUsage::Storage})
+    , bytes(count * sizeof(Affine3x4), 0xCD) {}
+
+  void Bind() const override {}
+  void Unbind() const override {}
+  void *Map() override { return bytes.data(); }
+  void Unmap() override {}
+  void Update(const void *data, usize size, usize offset) override {
+    REQUIRE(offset + size <= bytes.size());
+    std::memcpy(bytes.data() + offset, data, size);
+    writes.emplace_back(offset, size);
+  }
+  void Release() override {}
+
+  std::vector<u8> bytes;
+  std::vector<std::pair<usize, usize>> writes; // Offset and size
+};
+
+// --------------------------------------------------------------------------------
+/// Every live node's world matrix is in the buffer at its entity index
+void CheckBuffer(Scene &scene, const MemoryBuffer &buffer) {
+  usize checked = 0;
+  scene.GetView<Transform>().Each([&](Entity e, Transform &) {
+    const u8 *stored = buffer.bytes.data() + EntityHandle::GetIndex(e) * sizeof(Affine3x4);
+    REQUIRE(std::memcmp(stored, &scene.GetWorldMatrix(e), sizeof(Affine3x4)) == 0);
+    checked++;
+  });
+  REQUIRE(checked == scene.GetNodeCount());
+}
+
+} // namespace
+
+TEST_SUITE("Render/TransformBuffer") {
+  TEST_CASE("Uploads keep the buffer equal to the world matrices") {
+    Scene scene;
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    std::vector<Entity> nodes;
+    for (i32 i = 0; i < 500; i++) {
+      const Entity parent = i > 0 && rng() % 2 ? nodes[rng() % nodes.size()] : NULL_ENTITY;
+      nodes.push_back(scene.AddNode(parent));
+      scene.GetComponent<Transform>(nodes.back()).SetPosition(Vec3(dist(rng), dist(rng), 0.0f));
+    }
+    scene.UpdateTransforms();
+
+    MemoryBuffer buffer(1024);
+    TransformBuffer upload;
+    TransformUploadStats stats = upload.Upload(scene, &buffer);
+    CHECK(stats.full);
+    CheckBuffer(scene, buffer);
+    // Nothing updated since, nothing to send
+    stats = upload.Upload(scene, &buffer);
+    CHECK((!stats.full && stats.updates == 0));
+
+    for (i32 frame = 0; frame < 60; frame++) {
+      for (i32 op = 0; op < 8; op++) {
+        const Entity e = nodes[rng() % nodes.size()];
+        if (!scene.IsAlive(e)) continue;
+        if (op == 0 && frame % 5 == 0) {
+          scene.DestroyEntity(e);
+          nodes.push_back(scene.AddNode(NULL_ENTITY));
+          continue;
+        }
+        Transform &t = scene.GetComponent<Transform>(e);
+        t.SetPosition(t.GetPosition() + Vec3(dist(rng), 0.0f, 0.0f));
+      }
+      // Now and then the uploader misses an update and has to send everything
+      const b8 skipped = frame % 9 == 4;
+      if (skipped) scene.UpdateTransforms();
+      scene.UpdateTransforms();
+
+      buffer.writes.clear();
+      stats = upload.Upload(scene, &buffer);
+      CHECK(stats.full == skipped);
+      CheckBuffer(scene, buffer);
+      if (skipped) continue;
+
+      // Only what the update changed went out, a run per group of close indices
+      u32 sent = 0;
+      for (const auto &[offset, size] : buffer.writes) {
+        REQUIRE(offset % sizeof(Affine3x4) == 0);
+        sent += (u32)(size / sizeof(Affine3x4));
+      }
+      CHECK(sent == stats.matrices);
+      CHECK(stats.updates == buffer.writes.size());
+      CHECK(stats.matrices >= scene.GetChangedTransforms().size());
+      CHECK(stats.matrices < scene.GetEntityCapacity());
+    }
+
+    // A new buffer starts empty, it gets everything
+    MemoryBuffer other(1024);
+    stats = upload.Upload(scene, &other);
+    CHECK(stats.full);
+    CheckBuffer(scene, other);
+  }
+
+  TEST_CASE("Close indices merge into one write") {
+    Scene scene;
+    std::vector<Entity> nodes;
+    for (i32 i = 0; i < 100; i++) nodes.push_back(scene.CreateEntity());
+    scene.UpdateTransforms();
+    MemoryBuffer buffer(128);
+    TransformBuffer upload;
+    upload.Upload(scene, &buffer);
+
+    // 10, 12 and 16 are within the gap of each other, 40 is not
+    for (const u32 i : {10u, 12u, 16u, 40u}) {
+      scene.GetComponent<Transform>(nodes[i]).SetPosition(Vec3((f32)i));
+    }
+    scene.UpdateTransforms();
+    buffer.writes.clear();
+    const TransformUploadStats stats = upload.Upload(scene, &buffer);
+    REQUIRE(buffer.writes.size() == 2);
+    CHECK(buffer.writes[0].first == 10 * sizeof(Affine3x4));
+    CHECK(buffer.writes[0].second == 7 * sizeof(Affine3x4));
+    CHECK(buffer.writes[1].first == 40 * sizeof(Affine3x4));
+    CHECK(stats.matrices == 8);
+    CheckBuffer(scene, buffer);
+  }
+}
@@ -0,0 +1,106 @@
+#include <doctest.h>
+#include <core/math/half.h>
+#include <core/math/quantize.h>
+#include <render/vertex_pack.h>
+#include <render/vertex_type.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST_SUITE("Render/VertexPack") {
+  TEST_CASE("Attribute sizes cover the packed types") {
+    CHECK(VertexAttribute::GetTypeSize(VAT_HALF2) == 4);
+    CHECK(VertexAttribute::GetTypeSize(VAT_HALF4) == 8);
+    CHECK(VertexAttribute::GetTypeSize(VAT_SHORT2_SNORM) == 4);
+    CHECK(VertexAttribute::GetTypeCount(VAT_SHORT4_SNORM) == 4);
+
+    const VertexLayout layout = VertexLayout()
+                                  .Push(VAS_POSITION, VAT_FLOAT3)
+                                  .Push(VAS_NORMAL, VAT_SHORT2_SNORM)
+                                  .Push(VAS_TEXCOORD, VAT_HALF2);
+    CHECK(layout.GetStride() == 20);
+    CHECK(layout.Find(VAS_TEXCOORD)->offset == 16);
+    CHECK(layout.Find(VAS_NORMAL)->normalized);
+    CHECK_FALSE(layout.Find(VAS_TEXCOORD)->normalized);
+  }
+
+  TEST_CASE("VertexPNT repacks into a compact layout and reads back") {
+    constexpr usize kCount = 1000; // a few chunks and a tail
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+    std::vector<VertexPNT> vertices(kCount);
+    for (VertexPNT &v : vertices) {
+      Vec3 n(dist(rng), dist(rng), dist(rng));
+      n.Normalize();
+      v = VertexPNT(Vec3(dist(rng), dist(rng), dist(rng)) * 50.0f, n, Vec2(dist(rng), dist(rng)));
+    }
+
+    const VertexLayout packed = VertexLayout()
+                                  .Push(VAS_POSITION, VAT_FLOAT3)
+                                  .Push(VAS_NORMAL, VAT_SHORT2_SNORM)
+                                  .Push(VAS_TEXCOORD, VAT_HALF2)
+                                  .Push(VAS_COLOR, VAT_BYTE4_NORM);
+    const VertexLayout source = VertexTraits<VertexPNT>::GetLayout();
+    std::vector<u8> out(kCount * packed.GetStride());
+    CHECK_FALSE(Sono::RepackVertices(vertices.data(), source, kCount, out.data(), packed));
+
+    const VertexLayout compact = VertexLayout()
+                                   .Push(VAS_POSITION, VAT_FLOAT3)
+                                   .Push(VAS_NORMAL, VAT_SHORT2_SNORM)
+                                   .Push(VAS_TEXCOORD, VAT_HALF4);
+    REQUIRE(compact.GetStride() == 24);
+    out.assign(kCount * compact.GetStride(), 0xcd);
+    REQUIRE(Sono::RepackVertices(vertices.data(), source, kCount, out.data(), compact));
+
+    for (usize i = 0; i < kCount; i++) {
+      const VertexPNT &v = vertices[i];
+      const u8 *p = out.data() + i * compact.GetStride();
+      CHECK(std::memcmp(p, v.position, sizeof(v.position)) == 0);
+
+      i16 code[2];
+      std::memcpy(code, p + 12, sizeof(code));
+      const Vec3 n = Sono::DecodeOctahedral(code);
+      const f32 d = n.Dist(Vec3(v.normal[0], v.normal[1], v.normal[2]));
+      CHECK(2.0f * std::asin(d / 2.0f) <= Sono::OCTAHEDRAL_MAX_ANGLE * 1.01f);
+
+      u16 uv[4];
+      std::memcpy(uv, p + 16, sizeof(uv));
+      CHECK(uv[0] == Sono::FloatToHalf(v.texCoords[0]));
+      CHECK(uv[1] == Sono::FloatToHalf(v.texCoords[1]));
+      CHECK(uv[2] == 0); // the source has no third and fourth component
+      CHECK(uv[3] == 0);
+    }
+  }
+
+  TEST_CASE("Normalized and same type attributes") {
+    struct Source {
+      f32 color[4];
+      u32 bone;
+    };
+    const VertexLayout source = VertexLayout()
+                                  .Push(VAS_COLOR, VAT_FLOAT4)
+                                  .Push(VAS_BONE_INDICES, VAT_UINT);
+    const VertexLayout packed = VertexLayout()
+                                  .Push(VAS_BONE_INDICES, VAT_UINT)
+                                  .Push(VAS_COLOR, VAT_BYTE4_NORM);
+    const Source vertices[2] = {{{0.0f, 0.5f, 1.0f, 2.0f}, 7}, {{-1.0f, 0.25f, 0.75f, 1.0f}, 9}};
+    u8 out[16];
+    REQUIRE(Sono::RepackVertices(vertices, source, 2, out, packed));
+
+    u32 bone;
+    std::memcpy(&bone, out + 8, sizeof(bone));
+    CHECK(bone == 9);
+    CHECK(out[4] == 0);
+    CHECK(out[5] == 128);
+    CHECK(out[6] == 255);
+    CHECK(out[7] == 255); // clamped
+    CHECK(out[12] == 0);
+    CHECK(out[13] == Sono::FloatToUnorm8(0.25f));
+
+    // Integers only copy to the same type
+    const VertexLayout widened = VertexLayout().Push(VAS_BONE_INDICES, VAT_FLOAT);
+    CHECK_FALSE(Sono::RepackVertices(vertices, source, 2, out, widened));
+  }
+}
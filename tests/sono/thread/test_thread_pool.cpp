@@ -0,0 +1,46 @@
+#include <doctest.h>
+#include <core/thread/thread_pool.h>
+
+#include <atomic>
+#include <vector>
+
+TEST_SUITE("Thread/ThreadPool") {
+  TEST_CASE("ParallelFor covers every element once") {
+    ThreadPool pool(3);
+    CHECK(pool.GetThreadCount() == 4);
+
+    for (usize count : {usize(0), usize(1), usize(100), usize(10007)}) {
+      CAPTURE(count);
+      std::vector<u32> hits(count, 0);
+      std::atomic<u32> chunks{0};
+      pool.ParallelFor(count, 64, [&](usize begin, usize end) {
+        CHECK(end - begin <= 64);
+        for (usize i = begin; i < end; i++) hits[i]++;
+        chunks++;
+      });
+      for (usize i = 0; i < count; i++) REQUIRE(hits[i] == 1);
+      CHECK(chunks == (count + 63) / 64);
+    }
+  }
+
+  TEST_CASE("Back to back and nested loops") {
+    ThreadPool pool(2);
+    std::vector<u64> sums(500, 0);
+    for (usize rep = 0; rep < sums.size(); rep++) {
+      std::atomic<u64> sum{0};
+      pool.ParallelFor(1000, 10, [&](usize begin, usize end) {
+        // Runs serially on the thread of the chunk
+        pool.ParallelFor(end - begin, 1, [&](usize b, usize e) {
+          for (usize i = begin + b; i < begin + e; i++) sum += i;
+        });
+      });
+      sums[rep] = sum;
+    }
+    for (u64 s : sums) REQUIRE(s == 999 * 1000 / 2);
+
+    pool.Shutdown();
+    usize serial = 0;
+    pool.ParallelFor(100, 10, [&](usize begin, usize end) { serial += end - begin; });
+    CHECK(serial == 100);
+  }
+}
@@ -0,0 +1,69 @@
+#include <doctest.h>
+#include <core/thread/triple_buffer.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_SUITE("Thread/TripleBuffer") {
+  TEST_CASE("The consumer gets the latest value and keeps it until the next one") {
+    TripleBuffer<i32> buffer;
+    CHECK_FALSE(buffer.HasNew());
+    CHECK(buffer.Acquire() == 0);
+
+    buffer.GetWriteBuffer() = 1;
+    buffer.Publish();
+    CHECK(buffer.HasNew());
+    CHECK(buffer.Acquire() == 1);
+    CHECK_FALSE(buffer.HasNew());
+
+    // Nothing new, the same value again; values published in between are skipped
+    CHECK(buffer.Acquire() == 1);
+    for (i32 v = 2; v <= 5; v++) {
+      buffer.GetWriteBuffer() = v;
+      buffer.Publish();
+    }
+    const i32 &held = buffer.Acquire();
+    CHECK(held == 5);
+
+    // The producer never writes into what the consumer holds
+    for (i32 v = 6; v <= 10; v++) {
+      buffer.GetWriteBuffer() = v;
+      CHECK(&buffer.GetWriteBuffer() != &held);
+      buffer.Publish();
+    }
+    CHECK(held == 5);
+    CHECK(buffer.Acquire() == 10);
+  }
+
+  TEST_CASE("Values arrive whole and in order across threads") {
+    struct Frame {
+      u64 sequence = 0;
+      std::vector<u64> data = std::vector<u64>(256, 0);
+    };
+    TripleBuffer<Frame> buffer;
+    constexpr u64 LAST = 20000;
+
+    std::thread producer([&]() {
+      for (u64 s = 1; s <= LAST; s++) {
+        Frame &frame = buffer.GetWriteBuffer();
+        frame.sequence = s;
+        for (u64 &d : frame.data) d = s;
+        buffer.Publish();
+      }
+    });
+
+    u64 last = 0, torn = 0, backwards = 0, seen = 0;
+    while (last != LAST) {
+      const Frame &frame = buffer.Acquire();
+      for (const u64 d : frame.data) torn += d != frame.sequence;
+      backwards += frame.sequence < last;
+      seen += frame.sequence != last;
+      last = frame.sequence;
+    }
+    producer.join();
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    CHECK(seen > 0);
+  }
+}